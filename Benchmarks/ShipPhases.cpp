@@ -0,0 +1,325 @@
+#include <Game/GameParameters.h>
+#include <Game/IGameEventHandler.h>
+#include <Game/MaterialDatabase.h>
+#include <Game/Physics.h>
+#include <Game/ResourceLoader.h>
+#include <Game/ShipBuilder.h>
+#include <Game/ShipDefinition.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+
+//
+// Benchmarks of the individual phases of a simulation step, run on real ships.
+//
+// Ships are loaded from the installed ship folder, hence the benchmarks are to be run
+// from the game's root directory.
+//
+
+namespace {
+
+    /*
+     * A ship built from a ship file, with some water in it, and simulated for a while,
+     * so that phases are timed on realistic state rather than on the pristine one.
+     */
+    class WarmedUpShip
+    {
+    public:
+
+        explicit WarmedUpShip(std::string const & shipFileName)
+            : WarmedUpShip(shipFileName, GameParameters().NumberOfSimulationThreads)
+        {}
+
+        WarmedUpShip(
+            std::string const & shipFileName,
+            size_t numberOfSimulationThreads)
+            : mGameEventHandler(std::make_shared<IGameEventHandler>())
+            , mGameParameters()
+            , mResourceLoader()
+            , mMaterialDatabase(MaterialDatabase::Load(mResourceLoader))
+            , mWorld()
+            , mShip()
+            , mCurrentSimulationTime(0.0f)
+        {
+            mGameParameters.NumberOfSimulationThreads = numberOfSimulationThreads;
+
+            mWorld = std::make_unique<Physics::World>(
+                mGameEventHandler,
+                mGameParameters,
+                mResourceLoader);
+
+            mShip = ShipBuilder::Create(
+                0,
+                *mWorld,
+                mGameEventHandler,
+                ShipDefinition::Load(ResourceLoader::GetInstalledShipFolderPath() / shipFileName),
+                mMaterialDatabase,
+                mGameParameters);
+
+            vec2f const center = CalculateCenter();
+
+            for (int step = 0; step < WarmUpStepCount; ++step)
+            {
+                if (step < FloodStepCount)
+                {
+                    mShip->FloodAt(
+                        center,
+                        1.0f,
+                        mGameParameters);
+                }
+
+                mCurrentSimulationTime += GameParameters::SimulationStepTimeDuration<float>;
+
+                mShip->Update(
+                    mCurrentSimulationTime,
+                    mGameParameters,
+                    VectorFieldRenderMode::None);
+            }
+        }
+
+        Physics::Ship & GetShip()
+        {
+            return *mShip;
+        }
+
+        GameParameters const & GetGameParameters() const
+        {
+            return mGameParameters;
+        }
+
+        void AdvanceSimulationTime()
+        {
+            mCurrentSimulationTime += GameParameters::SimulationStepTimeDuration<float>;
+        }
+
+        float GetCurrentSimulationTime() const
+        {
+            return mCurrentSimulationTime;
+        }
+
+    private:
+
+        vec2f CalculateCenter() const
+        {
+            auto const & points = mShip->GetPoints();
+
+            vec2f center = vec2f::zero();
+            for (ElementIndex p = 0; p < points.GetShipPointCount(); ++p)
+            {
+                center += points.GetPosition(p);
+            }
+
+            return center / static_cast<float>(std::max(points.GetShipPointCount(), ElementCount(1)));
+        }
+
+        static constexpr int WarmUpStepCount = 100;
+        static constexpr int FloodStepCount = 50;
+
+        std::shared_ptr<IGameEventHandler> mGameEventHandler;
+        GameParameters mGameParameters;
+        ResourceLoader mResourceLoader;
+        MaterialDatabase mMaterialDatabase;
+        std::unique_ptr<Physics::World> mWorld;
+        std::unique_ptr<Physics::Ship> mShip;
+        float mCurrentSimulationTime;
+    };
+
+    /*
+     * Returns the largest distance between the positions of the same ship points in two
+     * instances of the same ship.
+     */
+    float CalculateMaxPositionDeviation(
+        Physics::Ship const & ship1,
+        Physics::Ship const & ship2)
+    {
+        auto const & points1 = ship1.GetPoints();
+        auto const & points2 = ship2.GetPoints();
+
+        if (points1.GetShipPointCount() != points2.GetShipPointCount())
+            return std::numeric_limits<float>::max();
+
+        float maxDeviation = 0.0f;
+        for (ElementIndex p = 0; p < points1.GetShipPointCount(); ++p)
+        {
+            maxDeviation = std::max(
+                maxDeviation,
+                (points1.GetPosition(p) - points2.GetPosition(p)).length());
+        }
+
+        return maxDeviation;
+    }
+
+    // How far apart - in meters - the positions of the serial and of the partitioned
+    // mechanical dynamics may drift; they only differ by the order in which spring forces
+    // are summed
+    constexpr float MaxPartitionedPositionDeviation = 0.01f;
+
+    std::string const SmallShip = "RMS Titanic (Tiny).shp";
+    std::string const MediumShip = "RMS Titanic (With Lights).shp";
+    std::string const HugeShip = "S.S. American Star.shp";
+}
+
+static void ShipPhases_SpringForces(benchmark::State & state, std::string const & shipFileName)
+{
+    WarmedUpShip warmedUpShip(shipFileName);
+    auto & ship = warmedUpShip.GetShip();
+    auto & points = ship.GetPoints();
+    ElementCount const springCount = ship.GetSprings().GetElementCount();
+
+    for (auto _ : state)
+    {
+        ship.UpdateSpringForces(
+            0,
+            springCount,
+            points.GetForceBufferAsVec2(),
+            warmedUpShip.GetGameParameters());
+    }
+
+    benchmark::DoNotOptimize(points.GetForceBufferAsVec2());
+    state.SetItemsProcessed(state.iterations() * springCount);
+}
+BENCHMARK_CAPTURE(ShipPhases_SpringForces, Small, SmallShip);
+BENCHMARK_CAPTURE(ShipPhases_SpringForces, Medium, MediumShip);
+BENCHMARK_CAPTURE(ShipPhases_SpringForces, Huge, HugeShip);
+
+static void ShipPhases_MechanicalDynamics(benchmark::State & state, std::string const & shipFileName)
+{
+    //
+    // Make sure first that the partitioned mechanical dynamics match the serial ones: both
+    // ships have been warmed up from the same initial state, and the ship with one thread
+    // only never partitions
+    //
+
+    WarmedUpShip serialShip(shipFileName, 1);
+    WarmedUpShip warmedUpShip(shipFileName, std::max(GameParameters().NumberOfSimulationThreads, size_t(2)));
+
+    float const maxPositionDeviation = CalculateMaxPositionDeviation(
+        serialShip.GetShip(),
+        warmedUpShip.GetShip());
+
+    if (maxPositionDeviation > MaxPartitionedPositionDeviation)
+    {
+        state.SkipWithError(("Partitioned mechanical dynamics deviate from serial ones by " + std::to_string(maxPositionDeviation) + "m").c_str());
+        return;
+    }
+
+    auto & ship = warmedUpShip.GetShip();
+
+    for (auto _ : state)
+    {
+        warmedUpShip.AdvanceSimulationTime();
+
+        ship.UpdateMechanicalDynamics(
+            warmedUpShip.GetCurrentSimulationTime(),
+            warmedUpShip.GetGameParameters(),
+            VectorFieldRenderMode::None);
+    }
+
+    benchmark::DoNotOptimize(ship.GetPoints().GetPosition(0));
+    state.SetItemsProcessed(state.iterations() * ship.GetSprings().GetElementCount());
+}
+BENCHMARK_CAPTURE(ShipPhases_MechanicalDynamics, Small, SmallShip);
+BENCHMARK_CAPTURE(ShipPhases_MechanicalDynamics, Medium, MediumShip);
+BENCHMARK_CAPTURE(ShipPhases_MechanicalDynamics, Huge, HugeShip);
+
+static void ShipPhases_Integration(benchmark::State & state, std::string const & shipFileName)
+{
+    WarmedUpShip warmedUpShip(shipFileName);
+    auto & ship = warmedUpShip.GetShip();
+    auto & points = ship.GetPoints();
+    ElementCount const pointCount = points.GetBufferElementCount();
+
+    for (auto _ : state)
+    {
+        ship.IntegrateAndResetPointForces(
+            0,
+            pointCount,
+            warmedUpShip.GetGameParameters());
+    }
+
+    benchmark::DoNotOptimize(points.GetPosition(0));
+    state.SetItemsProcessed(state.iterations() * pointCount);
+}
+BENCHMARK_CAPTURE(ShipPhases_Integration, Small, SmallShip);
+BENCHMARK_CAPTURE(ShipPhases_Integration, Medium, MediumShip);
+BENCHMARK_CAPTURE(ShipPhases_Integration, Huge, HugeShip);
+
+static void ShipPhases_WaterVelocities(benchmark::State & state, std::string const & shipFileName)
+{
+    WarmedUpShip warmedUpShip(shipFileName);
+    auto & ship = warmedUpShip.GetShip();
+
+    float waterSplashed = 0.0f;
+    for (auto _ : state)
+    {
+        ship.UpdateWaterVelocities(
+            warmedUpShip.GetGameParameters(),
+            waterSplashed);
+    }
+
+    benchmark::DoNotOptimize(waterSplashed);
+    state.SetItemsProcessed(state.iterations() * ship.GetPointCount());
+}
+BENCHMARK_CAPTURE(ShipPhases_WaterVelocities, Small, SmallShip);
+BENCHMARK_CAPTURE(ShipPhases_WaterVelocities, Medium, MediumShip);
+BENCHMARK_CAPTURE(ShipPhases_WaterVelocities, Huge, HugeShip);
+
+static void ShipPhases_Strains(benchmark::State & state, std::string const & shipFileName)
+{
+    WarmedUpShip warmedUpShip(shipFileName);
+    auto & ship = warmedUpShip.GetShip();
+    auto & springs = ship.GetSprings();
+
+    bool isAtLeastOneSpringBroken = false;
+    for (auto _ : state)
+    {
+        isAtLeastOneSpringBroken |= springs.UpdateStrains(
+            warmedUpShip.GetCurrentSimulationTime(),
+            warmedUpShip.GetGameParameters(),
+            ship.GetPoints());
+    }
+
+    benchmark::DoNotOptimize(isAtLeastOneSpringBroken);
+    state.SetItemsProcessed(state.iterations() * springs.GetElementCount());
+}
+BENCHMARK_CAPTURE(ShipPhases_Strains, Small, SmallShip);
+BENCHMARK_CAPTURE(ShipPhases_Strains, Medium, MediumShip);
+BENCHMARK_CAPTURE(ShipPhases_Strains, Huge, HugeShip);
+
+static void ShipPhases_ConnectivityVisit(benchmark::State & state, std::string const & shipFileName)
+{
+    WarmedUpShip warmedUpShip(shipFileName);
+    auto & ship = warmedUpShip.GetShip();
+
+    for (auto _ : state)
+    {
+        ship.RunFullConnectivityVisit();
+    }
+
+    benchmark::DoNotOptimize(ship.GetPoints().GetPlaneId(0));
+    state.SetItemsProcessed(state.iterations() * ship.GetPointCount());
+}
+BENCHMARK_CAPTURE(ShipPhases_ConnectivityVisit, Small, SmallShip);
+BENCHMARK_CAPTURE(ShipPhases_ConnectivityVisit, Medium, MediumShip);
+BENCHMARK_CAPTURE(ShipPhases_ConnectivityVisit, Huge, HugeShip);
+
+static void ShipPhases_LightDiffusion(benchmark::State & state, std::string const & shipFileName)
+{
+    WarmedUpShip warmedUpShip(shipFileName);
+    auto & ship = warmedUpShip.GetShip();
+
+    for (auto _ : state)
+    {
+        ship.DiffuseLight(warmedUpShip.GetGameParameters());
+    }
+
+    benchmark::DoNotOptimize(ship.GetPoints().GetLight(0));
+    state.SetItemsProcessed(state.iterations() * ship.GetPointCount());
+}
+BENCHMARK_CAPTURE(ShipPhases_LightDiffusion, Small, SmallShip);
+BENCHMARK_CAPTURE(ShipPhases_LightDiffusion, Medium, MediumShip);
+BENCHMARK_CAPTURE(ShipPhases_LightDiffusion, Huge, HugeShip);
@@ -0,0 +1,53 @@
+#include "Utils.h"
+
+#include <GameCore/ThreadPool.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+static constexpr size_t Size = 4000000;
+
+static void ThreadPool_ParallelFor(benchmark::State& state)
+{
+    ThreadPool threadPool(static_cast<size_t>(state.range(0)));
+
+    auto const size = MakeSize(Size);
+    auto const inputs = MakeFloats(size);
+    std::vector<float> results(size);
+
+    for (auto _ : state)
+    {
+        threadPool.ParallelFor(
+            0,
+            static_cast<ElementIndex>(size),
+            1024,
+            [&inputs, &results](ElementIndex startIndex, ElementIndex endIndex)
+            {
+                for (ElementIndex i = startIndex; i < endIndex; ++i)
+                {
+                    results[i] = std::sqrt(inputs[i] * inputs[i] + 1.0f) / (inputs[i] + 1.0f);
+                }
+            });
+    }
+
+    benchmark::DoNotOptimize(results);
+}
+BENCHMARK(ThreadPool_ParallelFor)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16)->UseRealTime();
+
+static void ThreadPool_ForkJoinOverhead(benchmark::State& state)
+{
+    ThreadPool threadPool(static_cast<size_t>(state.range(0)));
+
+    std::vector<ThreadPool::Task> tasks(
+        threadPool.GetParallelism(),
+        []()
+        {
+        });
+
+    for (auto _ : state)
+    {
+        threadPool.Run(tasks);
+    }
+}
+BENCHMARK(ThreadPool_ForkJoinOverhead)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16)->UseRealTime();
@@ -1,11 +1,8 @@
 #include "Utils.h"
 
+#include <GameCore/LibSimdPp.h>
 #include <GameCore/SysSpecifics.h>
 
-// TODO: move to GameLib's LibSimdPp.h
-#define SIMDPP_ARCH_X86_SSSE3
-#include "simdpp/simd.h"
-
 #include <benchmark/benchmark.h>
 
 #include <algorithm>
@@ -263,3 +260,121 @@ static void UpdateSpringForces_LibSimdPpAndIntrinsics(benchmark::State& state)
     benchmark::DoNotOptimize(pointsForce);
 }
 BENCHMARK(UpdateSpringForces_LibSimdPpAndIntrinsics);
+
+static void UpdateSpringForces_LibSimdPpAndIntrinsics_ConflictFreeBatches(benchmark::State& state)
+{
+    //
+    // As in production: relies on no two springs in a batch of four sharing
+    // an endpoint (true for MakeGraph2), gathering and scattering forces in pairs
+    //
+
+    auto const size = MakeSize(SampleSize);
+
+    std::vector<vec2f> pointsPosition;
+    std::vector<vec2f> pointsVelocity;
+    std::vector<vec2f> pointsForce;
+    std::vector<SpringEndpoints> springsEndpoints;
+    std::vector<float> springsStiffnessCoefficient;
+    std::vector<float> springsDamperCoefficient;
+    std::vector<float> springsRestLength;
+
+    MakeGraph2(size, pointsPosition, pointsVelocity, pointsForce,
+        springsEndpoints, springsStiffnessCoefficient, springsDamperCoefficient, springsRestLength);
+
+    vec2f const * const restrict pointsPositionData = pointsPosition.data();
+    vec2f const * const restrict pointsVelocityData = pointsVelocity.data();
+    vec2f * const restrict pointsForceData = pointsForce.data();
+    SpringEndpoints const * const restrict springsEndpointsData = springsEndpoints.data();
+    float const * const restrict springsStiffnessCoefficientData = springsStiffnessCoefficient.data();
+    float const * const restrict springsDamperCoefficientData = springsDamperCoefficient.data();
+    float const * const restrict springsRestLengthData = springsRestLength.data();
+
+    auto const loadPair = [](vec2f const * restrict v0, vec2f const * restrict v1) -> __m128
+    {
+        return _mm_loadh_pi(
+            _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const *>(v0))),
+            reinterpret_cast<__m64 const *>(v1));
+    };
+
+    auto const storePair = [](__m128 value, vec2f * restrict v0, vec2f * restrict v1)
+    {
+        _mm_store_sd(reinterpret_cast<double *>(v0), _mm_castps_pd(value));
+        _mm_storeh_pi(reinterpret_cast<__m64 *>(v1), value);
+    };
+
+    for (auto _ : state)
+    {
+        for (size_t s = 0; s < springsEndpoints.size(); s += 4)
+        {
+            auto const s0_pA = springsEndpointsData[s].PointAIndex;
+            auto const s0_pB = springsEndpointsData[s].PointBIndex;
+            auto const s1_pA = springsEndpointsData[s + 1].PointAIndex;
+            auto const s1_pB = springsEndpointsData[s + 1].PointBIndex;
+            auto const s2_pA = springsEndpointsData[s + 2].PointAIndex;
+            auto const s2_pB = springsEndpointsData[s + 2].PointBIndex;
+            auto const s3_pA = springsEndpointsData[s + 3].PointAIndex;
+            auto const s3_pB = springsEndpointsData[s + 3].PointBIndex;
+
+            simdpp::float32<4> const s0s1_deltaPos =
+                simdpp::float32<4>(loadPair(&(pointsPositionData[s0_pB]), &(pointsPositionData[s1_pB])))
+                - simdpp::float32<4>(loadPair(&(pointsPositionData[s0_pA]), &(pointsPositionData[s1_pA])));
+            simdpp::float32<4> const s2s3_deltaPos =
+                simdpp::float32<4>(loadPair(&(pointsPositionData[s2_pB]), &(pointsPositionData[s3_pB])))
+                - simdpp::float32<4>(loadPair(&(pointsPositionData[s2_pA]), &(pointsPositionData[s3_pA])));
+
+            simdpp::float32<4> const deltaPosX = simdpp::unzip4_lo(s0s1_deltaPos, s2s3_deltaPos);
+            simdpp::float32<4> const deltaPosY = simdpp::unzip4_hi(s0s1_deltaPos, s2s3_deltaPos);
+
+            simdpp::float32<4> const springLength = simdpp::sqrt(deltaPosX * deltaPosX + deltaPosY * deltaPosY);
+            simdpp::mask_float32<4> const validMask = (springLength != 0.0f);
+            simdpp::float32<4> const springDirX = simdpp::bit_and(deltaPosX / springLength, validMask);
+            simdpp::float32<4> const springDirY = simdpp::bit_and(deltaPosY / springLength, validMask);
+
+            simdpp::float32<4> fS =
+                (springLength - simdpp::load_u<simdpp::float32<4>>(&(springsRestLengthData[s])))
+                * simdpp::load_u<simdpp::float32<4>>(&(springsStiffnessCoefficientData[s]));
+
+            simdpp::float32<4> const s0s1_deltaVel =
+                simdpp::float32<4>(loadPair(&(pointsVelocityData[s0_pB]), &(pointsVelocityData[s1_pB])))
+                - simdpp::float32<4>(loadPair(&(pointsVelocityData[s0_pA]), &(pointsVelocityData[s1_pA])));
+            simdpp::float32<4> const s2s3_deltaVel =
+                simdpp::float32<4>(loadPair(&(pointsVelocityData[s2_pB]), &(pointsVelocityData[s3_pB])))
+                - simdpp::float32<4>(loadPair(&(pointsVelocityData[s2_pA]), &(pointsVelocityData[s3_pA])));
+
+            simdpp::float32<4> const deltaVelX = simdpp::unzip4_lo(s0s1_deltaVel, s2s3_deltaVel);
+            simdpp::float32<4> const deltaVelY = simdpp::unzip4_hi(s0s1_deltaVel, s2s3_deltaVel);
+
+            fS = fS + (deltaVelX * springDirX + deltaVelY * springDirY)
+                * simdpp::load_u<simdpp::float32<4>>(&(springsDamperCoefficientData[s]));
+
+            simdpp::float32<4> const fX = springDirX * fS;
+            simdpp::float32<4> const fY = springDirY * fS;
+
+            simdpp::float32<4> const s0s1_f = simdpp::zip4_lo(fX, fY);
+            simdpp::float32<4> const s2s3_f = simdpp::zip4_hi(fX, fY);
+
+            storePair(
+                (simdpp::float32<4>(loadPair(&(pointsForceData[s0_pA]), &(pointsForceData[s1_pA]))) + s0s1_f).wrapped(),
+                &(pointsForceData[s0_pA]),
+                &(pointsForceData[s1_pA]));
+
+            storePair(
+                (simdpp::float32<4>(loadPair(&(pointsForceData[s2_pA]), &(pointsForceData[s3_pA]))) + s2s3_f).wrapped(),
+                &(pointsForceData[s2_pA]),
+                &(pointsForceData[s3_pA]));
+
+            storePair(
+                (simdpp::float32<4>(loadPair(&(pointsForceData[s0_pB]), &(pointsForceData[s1_pB]))) - s0s1_f).wrapped(),
+                &(pointsForceData[s0_pB]),
+                &(pointsForceData[s1_pB]));
+
+            storePair(
+                (simdpp::float32<4>(loadPair(&(pointsForceData[s2_pB]), &(pointsForceData[s3_pB]))) - s2s3_f).wrapped(),
+                &(pointsForceData[s2_pB]),
+                &(pointsForceData[s3_pB]));
+        }
+    }
+
+    benchmark::DoNotOptimize(pointsForce);
+}
+BENCHMARK(UpdateSpringForces_LibSimdPpAndIntrinsics_ConflictFreeBatches);
@@ -0,0 +1,81 @@
+#include "Utils.h"
+
+#include <Game/IGameEventHandler.h>
+#include <Game/Physics.h>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+static constexpr size_t SamplingSize = 100000;
+
+static std::vector<vec2f> MakeWorldPositions(size_t count)
+{
+    std::vector<vec2f> positions;
+    positions.reserve(count);
+
+    // Spread across the whole width of the world, negative x's included
+    for (size_t i = 0; i < count; ++i)
+    {
+        float const x = -GameParameters::MaxWorldWidth / 2.0f
+            + GameParameters::MaxWorldWidth * static_cast<float>(i) / static_cast<float>(count);
+
+        positions.emplace_back(x, static_cast<float>(i % 100) - 50.0f);
+    }
+
+    return positions;
+}
+
+static std::unique_ptr<Physics::WaterSurface> MakeWaterSurface()
+{
+    GameParameters gameParameters;
+
+    Physics::Wind wind(std::make_shared<IGameEventHandler>());
+    wind.Update(gameParameters);
+
+    auto waterSurface = std::make_unique<Physics::WaterSurface>();
+    waterSurface->Update(3.0f, wind, gameParameters);
+
+    return waterSurface;
+}
+
+static void WaterHeights_Scalar(benchmark::State& state)
+{
+    auto const waterSurface = MakeWaterSurface();
+    auto const positions = MakeWorldPositions(SamplingSize);
+    std::vector<float> heights(SamplingSize);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < SamplingSize; ++i)
+        {
+            heights[i] = waterSurface->GetWaterHeightAt(positions[i].x);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    benchmark::DoNotOptimize(heights);
+}
+BENCHMARK(WaterHeights_Scalar);
+
+static void WaterHeights_Bulk(benchmark::State& state)
+{
+    auto const waterSurface = MakeWaterSurface();
+    auto const positions = MakeWorldPositions(SamplingSize);
+    std::vector<float> heights(SamplingSize);
+
+    for (auto _ : state)
+    {
+        waterSurface->GetWaterHeightsAt(
+            positions.data(),
+            heights.data(),
+            SamplingSize);
+
+        benchmark::ClobberMemory();
+    }
+
+    benchmark::DoNotOptimize(heights);
+}
+BENCHMARK(WaterHeights_Bulk);
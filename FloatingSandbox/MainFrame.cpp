@@ -7,6 +7,7 @@
 
 #include "ShipDescriptionDialog.h"
 #include "SplashScreenDialog.h"
+#include "StandardSystemPaths.h"
 #include "StartupTipDialog.h"
 #include "Version.h"
 
@@ -16,6 +17,7 @@
 
 #include <GameCore/GameException.h>
 #include <GameCore/Log.h>
+#include <GameCore/TraceRecorder.h>
 #include <GameCore/Utils.h>
 
 #include <wx/intl.h>
@@ -46,6 +48,7 @@ const long ID_AMBIENT_LIGHT_UP_MENUITEM = wxNewId();
 const long ID_AMBIENT_LIGHT_DOWN_MENUITEM = wxNewId();
 const long ID_PAUSE_MENUITEM = wxNewId();
 const long ID_STEP_MENUITEM = wxNewId();
+const long ID_FAST_FORWARD_MENUITEM = wxNewId();
 const long ID_RESET_VIEW_MENUITEM = wxNewId();
 
 const long ID_MOVE_MENUITEM = wxNewId();
@@ -72,6 +75,8 @@ const long ID_SHOW_EVENT_TICKER_MENUITEM = wxNewId();
 const long ID_SHOW_PROBE_PANEL_MENUITEM = wxNewId();
 const long ID_SHOW_STATUS_TEXT_MENUITEM = wxNewId();
 const long ID_SHOW_EXTENDED_STATUS_TEXT_MENUITEM = wxNewId();
+const long ID_RECORD_TRACE_MENUITEM = wxNewId();
+const long ID_SAVE_TRACE_MENUITEM = wxNewId();
 const long ID_FULL_SCREEN_MENUITEM = wxNewId();
 const long ID_NORMAL_SCREEN_MENUITEM = wxNewId();
 const long ID_MUTE_MENUITEM = wxNewId();
@@ -117,6 +122,8 @@ MainFrame::MainFrame(wxApp * mainApp)
     wxPanel* mainPanel = new wxPanel(this, wxID_ANY, wxDefaultPosition, wxSize(-1, -1), wxWANTS_CHARS);
     mainPanel->Bind(wxEVT_CHAR_HOOK, &MainFrame::OnKeyDown, this);
 
+    TraceRecorder::GetInstance().SetCurrentThreadName("Main");
+
     mMainFrameSizer = new wxBoxSizer(wxVERTICAL);
 
 
@@ -253,6 +260,11 @@ MainFrame::MainFrame(wxApp * mainApp)
     controlsMenu->Append(mStepMenuItem);
     Connect(ID_STEP_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnStepMenuItemSelected);
 
+    mFastForwardMenuItem = new wxMenuItem(controlsMenu, ID_FAST_FORWARD_MENUITEM, _("Fast Forward\tCtrl+Space"), _("Run multiple simulation steps per frame"), wxITEM_CHECK);
+    controlsMenu->Append(mFastForwardMenuItem);
+    mFastForwardMenuItem->Check(false);
+    Connect(ID_FAST_FORWARD_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnFastForwardMenuItemSelected);
+
     controlsMenu->Append(new wxMenuItem(controlsMenu, wxID_SEPARATOR));
 
     wxMenuItem * resetViewMenuItem = new wxMenuItem(controlsMenu, ID_RESET_VIEW_MENUITEM, _("Reset View\tHOME"), wxEmptyString, wxITEM_NORMAL);
@@ -378,6 +390,16 @@ MainFrame::MainFrame(wxApp * mainApp)
     mShowExtendedStatusTextMenuItem->Check(StartWithExtendedStatusText);
     Connect(ID_SHOW_EXTENDED_STATUS_TEXT_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnShowExtendedStatusTextMenuItemSelected);
 
+    mRecordTraceMenuItem = new wxMenuItem(optionsMenu, ID_RECORD_TRACE_MENUITEM, _("Record Trace\tCtrl+Shift+T"), _("Record the timeline of the simulation and rendering phases"), wxITEM_CHECK);
+    optionsMenu->Append(mRecordTraceMenuItem);
+    mRecordTraceMenuItem->Check(false);
+    Connect(ID_RECORD_TRACE_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnRecordTraceMenuItemSelected);
+
+    mSaveTraceMenuItem = new wxMenuItem(optionsMenu, ID_SAVE_TRACE_MENUITEM, _("Save Trace\tCtrl+Shift+S"), _("Save the recorded timeline in the Chrome trace format"), wxITEM_NORMAL);
+    optionsMenu->Append(mSaveTraceMenuItem);
+    mSaveTraceMenuItem->Enable(false);
+    Connect(ID_SAVE_TRACE_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnSaveTraceMenuItemSelected);
+
     optionsMenu->Append(new wxMenuItem(optionsMenu, wxID_SEPARATOR));
 
     mFullScreenMenuItem = new wxMenuItem(optionsMenu, ID_FULL_SCREEN_MENUITEM, _("Full Screen\tF11"), wxEmptyString, wxITEM_NORMAL);
@@ -519,12 +541,14 @@ void MainFrame::OnPostInitializeTrigger(wxTimerEvent & /*event*/)
         mGameController = GameController::Create(
             StartWithStatusText,
             StartWithExtendedStatusText,
+            RunSimulationOnSeparateThread,
             [this]()
             {
                 assert(!!mMainGLCanvas);
                 mMainGLCanvas->SwapBuffers();
             },
             mResourceLoader,
+            StandardSystemPaths::GetInstance().GetUserSettingsGameFolderPath() / "ShipBuildCache",
             [&splash, this](float progress, std::string const & message)
             {
                 splash->UpdateProgress(progress / 2.0f, message);
@@ -1105,6 +1129,24 @@ void MainFrame::OnStepMenuItemSelected(wxCommandEvent & /*event*/)
     mGameController->Update();
 }
 
+void MainFrame::OnFastForwardMenuItemSelected(wxCommandEvent & /*event*/)
+{
+    assert(!!mGameController);
+
+    if (mFastForwardMenuItem->IsChecked())
+    {
+        mGameController->SetFastForward(
+            FastForwardMaxStepCount,
+            FastForwardFrameBudget);
+    }
+    else
+    {
+        mGameController->SetFastForward(
+            1,
+            std::chrono::steady_clock::duration::zero());
+    }
+}
+
 void MainFrame::OnResetViewMenuItemSelected(wxCommandEvent & /*event*/)
 {
     assert(!!mGameController);
@@ -1318,6 +1360,62 @@ void MainFrame::OnShowExtendedStatusTextMenuItemSelected(wxCommandEvent & /*even
     mGameController->SetExtendedStatusTextEnabled(mShowExtendedStatusTextMenuItem->IsChecked());
 }
 
+void MainFrame::OnRecordTraceMenuItemSelected(wxCommandEvent & /*event*/)
+{
+    if (mRecordTraceMenuItem->IsChecked())
+    {
+        TraceRecorder::GetInstance().StartRecording();
+
+        mSaveTraceMenuItem->Enable(true);
+    }
+    else
+    {
+        TraceRecorder::GetInstance().StopRecording();
+    }
+}
+
+void MainFrame::OnSaveTraceMenuItemSelected(wxCommandEvent & /*event*/)
+{
+    //
+    // Choose filename
+    //
+
+    auto const now = std::chrono::system_clock::now();
+    auto const now_time_t = std::chrono::system_clock::to_time_t(now);
+    auto const tm = std::localtime(&now_time_t);
+
+    std::stringstream ssFilename;
+    ssFilename.fill('0');
+    ssFilename
+        << "Trace_"
+        << std::setw(4) << (1900 + tm->tm_year) << std::setw(2) << (1 + tm->tm_mon) << std::setw(2) << tm->tm_mday
+        << "_"
+        << std::setw(2) << tm->tm_hour << std::setw(2) << tm->tm_min << std::setw(2) << tm->tm_sec
+        << ".json";
+
+    std::filesystem::path const traceFilePath =
+        StandardSystemPaths::GetInstance().GetUserSettingsGameFolderPath()
+        / "Traces"
+        / ssFilename.str();
+
+    //
+    // Save trace
+    //
+
+    try
+    {
+        TraceRecorder::GetInstance().SaveTrace(traceFilePath);
+
+        LogMessage("Saved trace to \"", traceFilePath.string(), "\"");
+    }
+    catch (std::exception const & ex)
+    {
+        OnError(
+            std::string("Could not save trace to file \"") + traceFilePath.string() + "\": " + ex.what(),
+            false);
+    }
+}
+
 void MainFrame::OnFullScreenMenuItemSelected(wxCommandEvent & /*event*/)
 {
     mFullScreenMenuItem->Enable(false);
@@ -46,6 +46,10 @@ public:
     static constexpr bool StartInFullScreenMode = true;
     static constexpr bool StartWithStatusText = true;
     static constexpr bool StartWithExtendedStatusText = false;
+    // Rendering only reads the published render snapshots, hence it never waits for the simulation
+    static constexpr bool RunSimulationOnSeparateThread = true;
+    static constexpr size_t FastForwardMaxStepCount = 8;
+    static constexpr std::chrono::milliseconds FastForwardFrameBudget = std::chrono::milliseconds(15);
     static constexpr int CursorStep = 30;
     static constexpr int PowerBarThickness = 2;
 
@@ -71,6 +75,7 @@ private:
     wxBoxSizer * mMainFrameSizer;
     wxMenuItem * mPauseMenuItem;
     wxMenuItem * mStepMenuItem;
+    wxMenuItem * mFastForwardMenuItem;
     wxMenu * mToolsMenu;
     wxMenuItem * mRCBombsDetonateMenuItem;
     wxMenuItem * mAntiMatterBombsDetonateMenuItem;
@@ -78,6 +83,8 @@ private:
     wxMenuItem * mShowProbePanelMenuItem;
     wxMenuItem * mShowStatusTextMenuItem;
     wxMenuItem * mShowExtendedStatusTextMenuItem;
+    wxMenuItem * mRecordTraceMenuItem;
+    wxMenuItem * mSaveTraceMenuItem;
     wxMenuItem * mFullScreenMenuItem;
     wxMenuItem * mNormalScreenMenuItem;
     wxMenuItem * mMuteMenuItem;
@@ -138,6 +145,7 @@ private:
     void OnAmbientLightDownMenuItemSelected(wxCommandEvent& event);
     void OnPauseMenuItemSelected(wxCommandEvent& event);
     void OnStepMenuItemSelected(wxCommandEvent& event);
+    void OnFastForwardMenuItemSelected(wxCommandEvent& event);
     void OnResetViewMenuItemSelected(wxCommandEvent& event);
     void OnLoadShipMenuItemSelected(wxCommandEvent& event);
     void OnReloadLastShipMenuItemSelected(wxCommandEvent& event);
@@ -165,6 +173,8 @@ private:
     void OnShowProbePanelMenuItemSelected(wxCommandEvent& event);
     void OnShowStatusTextMenuItemSelected(wxCommandEvent& event);
     void OnShowExtendedStatusTextMenuItemSelected(wxCommandEvent& event);
+    void OnRecordTraceMenuItemSelected(wxCommandEvent& event);
+    void OnSaveTraceMenuItemSelected(wxCommandEvent& event);
     void OnFullScreenMenuItemSelected(wxCommandEvent& event);
     void OnNormalScreenMenuItemSelected(wxCommandEvent& event);
     void OnMuteMenuItemSelected(wxCommandEvent& event);
@@ -34,6 +34,17 @@ ProbePanel::ProbePanel(wxWindow* parent)
     mFrameRateProbe = AddScalarTimeSeriesProbe("Frame Rate", 200);
     mURRatioProbe = AddScalarTimeSeriesProbe("U/R Ratio", 200);
 
+    mUpdateTimeP50Probe = AddScalarTimeSeriesProbe("Update P50 (ms)", 100);
+    mUpdateTimeP95Probe = AddScalarTimeSeriesProbe("Update P95 (ms)", 100);
+    mUpdateTimeP99Probe = AddScalarTimeSeriesProbe("Update P99 (ms)", 100);
+    mUpdateTimeMaxProbe = AddScalarTimeSeriesProbe("Update Max (ms)", 100);
+    mRenderTimeP50Probe = AddScalarTimeSeriesProbe("Render P50 (ms)", 100);
+    mRenderTimeP95Probe = AddScalarTimeSeriesProbe("Render P95 (ms)", 100);
+    mRenderTimeP99Probe = AddScalarTimeSeriesProbe("Render P99 (ms)", 100);
+    mRenderTimeMaxProbe = AddScalarTimeSeriesProbe("Render Max (ms)", 100);
+    mFrameTimeP95Probe = AddScalarTimeSeriesProbe("Frame P95 (ms)", 100);
+    mOverBudgetProbe = AddScalarTimeSeriesProbe("Frames Over Budget", 100);
+
     mWaterTakenProbe = AddScalarTimeSeriesProbe("Water Inflow", 120);
     mWaterSplashProbe = AddScalarTimeSeriesProbe("Water Splash", 200);
 
@@ -60,6 +71,16 @@ void ProbePanel::Update()
     {
         mFrameRateProbe->Update();
         mURRatioProbe->Update();
+        mUpdateTimeP50Probe->Update();
+        mUpdateTimeP95Probe->Update();
+        mUpdateTimeP99Probe->Update();
+        mUpdateTimeMaxProbe->Update();
+        mRenderTimeP50Probe->Update();
+        mRenderTimeP95Probe->Update();
+        mRenderTimeP99Probe->Update();
+        mRenderTimeMaxProbe->Update();
+        mFrameTimeP95Probe->Update();
+        mOverBudgetProbe->Update();
         mWaterTakenProbe->Update();
         mWaterSplashProbe->Update();
         mWindSpeedProbe->Update();
@@ -68,6 +89,12 @@ void ProbePanel::Update()
         {
             p.second->Update();
         }
+
+        for (auto const & p : mPhaseProbes)
+        {
+            if (!!p)
+                p->Update();
+        }
     }
 }
 
@@ -96,6 +123,11 @@ void ProbePanel::OnGameReset()
 {
     mFrameRateProbe->Reset();
     mURRatioProbe->Reset();
+    mUpdateTimeP99Probe->Reset();
+    mUpdateTimeMaxProbe->Reset();
+    mRenderTimeP99Probe->Reset();
+    mRenderTimeMaxProbe->Reset();
+    mOverBudgetProbe->Reset();
     mWaterTakenProbe->Reset();
     mWaterSplashProbe->Reset();
     mWindSpeedProbe->Reset();
@@ -104,6 +136,12 @@ void ProbePanel::OnGameReset()
     {
         p.second->Reset();
     }
+
+    for (auto const & p : mPhaseProbes)
+    {
+        if (!!p)
+            p->Reset();
+    }
 }
 
 void ProbePanel::OnWaterTaken(float waterTaken)
@@ -151,4 +189,42 @@ void ProbePanel::OnUpdateToRenderRatioUpdated(
     float immediateURRatio)
 {
     mURRatioProbe->RegisterSample(immediateURRatio);
-}
\ No newline at end of file
+}
+
+void ProbePanel::OnFrameTimesUpdated(
+    DurationHistogram::Statistics const & updateTimes,
+    DurationHistogram::Statistics const & renderTimes,
+    DurationHistogram::Statistics const & frameTimes)
+{
+    mUpdateTimeP50Probe->RegisterSample(updateTimes.P50Millis);
+    mUpdateTimeP95Probe->RegisterSample(updateTimes.P95Millis);
+    mUpdateTimeP99Probe->RegisterSample(updateTimes.P99Millis);
+    mUpdateTimeMaxProbe->RegisterSample(updateTimes.MaxMillis);
+    mRenderTimeP50Probe->RegisterSample(renderTimes.P50Millis);
+    mRenderTimeP95Probe->RegisterSample(renderTimes.P95Millis);
+    mRenderTimeP99Probe->RegisterSample(renderTimes.P99Millis);
+    mRenderTimeMaxProbe->RegisterSample(renderTimes.MaxMillis);
+    mFrameTimeP95Probe->RegisterSample(frameTimes.P95Millis);
+    mOverBudgetProbe->RegisterSample(static_cast<float>(frameTimes.OverBudgetCount));
+}
+
+void ProbePanel::OnPhaseTimingsUpdated(
+    std::vector<Profiler::PhaseStatistics> const & phaseStatistics)
+{
+    bool isAtLeastOneProbeAdded = false;
+
+    for (auto const & ps : phaseStatistics)
+    {
+        auto & probe = mPhaseProbes[static_cast<size_t>(ps.Phase)];
+        if (!probe)
+        {
+            probe = AddScalarTimeSeriesProbe(std::string(Profiler::GetPhaseName(ps.Phase)) + " (ms)", 100);
+            isAtLeastOneProbeAdded = true;
+        }
+
+        probe->RegisterSample(ps.MeanMillis);
+    }
+
+    if (isAtLeastOneProbeAdded)
+        mProbesSizer->Layout();
+}
@@ -12,6 +12,7 @@
 #include <wx/sizer.h>
 #include <wx/wx.h>
 
+#include <array>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -56,6 +57,14 @@ public:
     virtual void OnUpdateToRenderRatioUpdated(
         float immediateURRatio) override;
 
+    virtual void OnFrameTimesUpdated(
+        DurationHistogram::Statistics const & updateTimes,
+        DurationHistogram::Statistics const & renderTimes,
+        DurationHistogram::Statistics const & frameTimes) override;
+
+    virtual void OnPhaseTimingsUpdated(
+        std::vector<Profiler::PhaseStatistics> const & phaseStatistics) override;
+
 private:
 
     bool IsActive() const
@@ -77,8 +86,21 @@ private:
 
     std::unique_ptr<ScalarTimeSeriesProbeControl> mFrameRateProbe;
     std::unique_ptr<ScalarTimeSeriesProbeControl> mURRatioProbe;
+    std::unique_ptr<ScalarTimeSeriesProbeControl> mUpdateTimeP50Probe;
+    std::unique_ptr<ScalarTimeSeriesProbeControl> mUpdateTimeP95Probe;
+    std::unique_ptr<ScalarTimeSeriesProbeControl> mUpdateTimeP99Probe;
+    std::unique_ptr<ScalarTimeSeriesProbeControl> mUpdateTimeMaxProbe;
+    std::unique_ptr<ScalarTimeSeriesProbeControl> mRenderTimeP50Probe;
+    std::unique_ptr<ScalarTimeSeriesProbeControl> mRenderTimeP95Probe;
+    std::unique_ptr<ScalarTimeSeriesProbeControl> mRenderTimeP99Probe;
+    std::unique_ptr<ScalarTimeSeriesProbeControl> mRenderTimeMaxProbe;
+    std::unique_ptr<ScalarTimeSeriesProbeControl> mFrameTimeP95Probe;
+    std::unique_ptr<ScalarTimeSeriesProbeControl> mOverBudgetProbe;
     std::unique_ptr<ScalarTimeSeriesProbeControl> mWaterTakenProbe;
     std::unique_ptr<ScalarTimeSeriesProbeControl> mWaterSplashProbe;
     std::unique_ptr<ScalarTimeSeriesProbeControl> mWindSpeedProbe;
     std::unordered_map<std::string, std::unique_ptr<ScalarTimeSeriesProbeControl>> mCustomProbes;
+
+    // Mean duration of each profiled phase; created when the phase gets its first timing
+    std::array<std::unique_ptr<ScalarTimeSeriesProbeControl>, static_cast<size_t>(ProfilePhase::_Last) + 1> mPhaseProbes;
 };
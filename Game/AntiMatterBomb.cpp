@@ -270,9 +270,7 @@ bool AntiMatterBomb::Update(
     }
 }
 
-void AntiMatterBomb::Upload(
-    ShipId shipId,
-    Render::RenderContext & renderContext) const
+void AntiMatterBomb::Upload(RenderSnapshot & renderSnapshot) const
 {
     switch (mState)
     {
@@ -280,8 +278,7 @@ void AntiMatterBomb::Upload(
         case State::TriggeringPreImploding_2:
         {
             // Armor
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::AntiMatterBombArmor, 0),
                 GetPosition(),
@@ -291,8 +288,7 @@ void AntiMatterBomb::Upload(
                 1.0f);
 
             // Sphere
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::AntiMatterBombSphere, 0),
                 GetPosition(),
@@ -302,8 +298,7 @@ void AntiMatterBomb::Upload(
                 1.0f);
 
             // Rotating cloud
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::AntiMatterBombSphereCloud, 0),
                 GetPosition(),
@@ -317,8 +312,7 @@ void AntiMatterBomb::Upload(
         case State::PreImploding_3:
         {
             // Armor
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::AntiMatterBombArmor, 0),
                 GetPosition(),
@@ -328,8 +322,7 @@ void AntiMatterBomb::Upload(
                 1.0f);
 
             // Sphere
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::AntiMatterBombSphere, 0),
                 GetPosition(),
@@ -339,8 +332,7 @@ void AntiMatterBomb::Upload(
                 1.0f);
 
             // Rotating cloud
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::AntiMatterBombSphereCloud, 0),
                 GetPosition(),
@@ -354,8 +346,7 @@ void AntiMatterBomb::Upload(
         case State::Imploding_4:
         {
             // Armor
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::AntiMatterBombArmor, 0),
                 GetPosition(),
@@ -365,8 +356,7 @@ void AntiMatterBomb::Upload(
                 1.0f);
 
             // Sphere
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::AntiMatterBombSphere, 0),
                 GetPosition(),
@@ -376,8 +366,7 @@ void AntiMatterBomb::Upload(
                 1.0f);
 
             // Rotating cloud
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::AntiMatterBombSphereCloud, 0),
                 GetPosition(),
@@ -391,7 +380,7 @@ void AntiMatterBomb::Upload(
         case State::PreExploding_5:
         {
             // Cross-of-light
-            renderContext.UploadCrossOfLight(
+            renderSnapshot.UploadCrossOfLight(
                 GetPosition(),
                 mCurrentStateProgress);
 
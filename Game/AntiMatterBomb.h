@@ -65,9 +65,7 @@ public:
         Detonate();
     }
 
-    virtual void Upload(
-        ShipId shipId,
-        Render::RenderContext & renderContext) const override;
+    virtual void Upload(RenderSnapshot & renderSnapshot) const override;
 
     void Detonate();
 
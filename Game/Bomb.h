@@ -8,7 +8,7 @@
 #include "GameParameters.h"
 #include "IGameEventHandler.h"
 #include "Physics.h"
-#include "RenderContext.h"
+#include "RenderSnapshot.h"
 
 #include <GameCore/GameTypes.h>
 #include <GameCore/GameWallClock.h>
@@ -84,11 +84,9 @@ public:
     virtual void OnNeighborhoodDisturbed() = 0;
 
     /*
-     * Uploads rendering information to the render context.
+     * Uploads rendering information to the render snapshot.
      */
-    virtual void Upload(
-        ShipId shipId,
-        Render::RenderContext & renderContext) const = 0;
+    virtual void Upload(RenderSnapshot & renderSnapshot) const = 0;
 
     /*
      * If the bomb is attached, saves its current position and detaches itself from the Springs container;
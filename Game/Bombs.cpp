@@ -109,13 +109,11 @@ void Bombs::DetonateAntiMatterBombs()
     }
 }
 
-void Bombs::Upload(
-    ShipId shipId,
-    Render::RenderContext & renderContext) const
+void Bombs::Upload(RenderSnapshot & renderSnapshot) const
 {
     for (auto & bomb : mCurrentBombs)
     {
-        bomb->Upload(shipId, renderContext);
+        bomb->Upload(renderSnapshot);
     }
 }
 
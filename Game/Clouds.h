@@ -6,7 +6,7 @@
 #pragma once
 
 #include "GameParameters.h"
-#include "RenderContext.h"
+#include "RenderSnapshot.h"
 
 #include <memory>
 #include <vector>
@@ -27,19 +27,17 @@ public:
         float currentSimulationTime,
         GameParameters const & gameParameters);
 
-    void Upload(Render::RenderContext & renderContext) const
+    void Upload(WorldRenderSnapshot & renderSnapshot) const
     {
-        renderContext.UploadCloudsStart(mClouds.size());
+        renderSnapshot.UploadCloudsStart(mClouds.size());
 
         for (auto const & cloud : mClouds)
         {
-            renderContext.UploadCloud(
+            renderSnapshot.UploadCloud(
                 cloud->GetX(),
                 cloud->GetY(),
                 cloud->GetScale());
         }
-
-        renderContext.UploadCloudsEnd();
     }
 
 private:
@@ -0,0 +1,531 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2019-04-06
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <GameCore/GameTypes.h>
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <optional>
+#include <queue>
+#include <vector>
+
+//#define RENDER_FLOOD_DISTANCE
+
+namespace Physics
+{
+
+/*
+ * The visits that propagate connectivity information to the network of points of a ship
+ * (NOT including the ephemerals - they're assigned their own plane ID's at creation time):
+ *
+ * - PlaneID: all points belonging to the same connected component, including "strings",
+ *            are assigned the same plane ID
+ *
+ * - Connected Component ID: at this moment we assign the same value as the plane ID; in the future
+ *                           we might want to only assign a connected component ID to "solids" by only
+ *                           assigning it to points that are not string points
+ *                           (this will then require a separate visit pass)
+ *
+ * The first time we flood the entire network, assigning plane IDs in reverse point order;
+ * afterwards, since springs are only ever destroyed, we only re-examine the components
+ * whose springs have been destroyed since the last visit, and the pieces that split off
+ * a component are given new plane IDs, on top of all the existing ones.
+ *
+ * Plane IDs of destroyed components are thus never re-used; once too many have accumulated
+ * we flood the entire network again, but - so that planes do not change their drawing
+ * order - the new plane IDs are assigned in the order of the current ones, only compacted.
+ * Hence an incremental visit and a full visit of the same network yield the same components
+ * in the same order, and plane IDs are always between zero and GetMaxPlaneId().
+ *
+ * The visits are templates over the points container, so that they may be exercised on their own.
+ */
+class ConnectivityVisit
+{
+public:
+
+    ConnectivityVisit()
+        : mCurrentVisitSequenceNumber()
+        , mPlaneTrianglesCounts()
+        , mLastFullVisitPlaneCount(0)
+        , mPendingSeedPoints()
+        , mPlaneRepresentativePoints()
+        , mSearchPointsA()
+        , mSearchPointsB()
+        , mFloodedPlaneOldPlaneIds()
+        , mFloodedPlaneNewPlaneIds()
+    {}
+
+    /*
+     * Number of (non-deleted) triangles in each plane ID, kept up-to-date
+     * as triangles are destroyed and as planes are split.
+     */
+    std::vector<size_t> const & GetPlaneTrianglesCounts() const
+    {
+        return mPlaneTrianglesCounts;
+    }
+
+    size_t GetPlaneCount() const
+    {
+        return mPlaneTrianglesCounts.size();
+    }
+
+    PlaneId GetMaxPlaneId() const
+    {
+        return mPlaneTrianglesCounts.empty()
+            ? 0
+            : static_cast<PlaneId>(mPlaneTrianglesCounts.size() - 1);
+    }
+
+    /*
+     * Remembers that the endpoints of the spring may now belong to different components.
+     */
+    void OnSpringDestroyed(
+        ElementIndex pointAIndex,
+        ElementIndex pointBIndex)
+    {
+        mPendingSeedPoints.push_back(pointAIndex);
+        mPendingSeedPoints.push_back(pointBIndex);
+    }
+
+    void OnTriangleDestroyed(PlaneId planeId)
+    {
+        assert(planeId < mPlaneTrianglesCounts.size());
+        assert(mPlaneTrianglesCounts[planeId] > 0);
+        --(mPlaneTrianglesCounts[planeId]);
+    }
+
+    /*
+     * Runs a full or an incremental visit, whichever is due; returns true when it was a
+     * full visit, i.e. when all plane IDs might have changed.
+     */
+    template<typename TPoints>
+    bool Run(TPoints & points)
+    {
+        if (mPlaneTrianglesCounts.empty()
+            || mPlaneTrianglesCounts.size() > 2 * static_cast<size_t>(mLastFullVisitPlaneCount) + 16)
+        {
+            RunFull(points);
+            return true;
+        }
+        else
+        {
+            RunIncremental(points);
+            return false;
+        }
+    }
+
+    /*
+     * Visits the entire network of points and floods each connected component in turn.
+     *
+     * At the end of a visit *ALL* (non-ephemeral) points will have a Plane ID.
+     *
+     * We also piggyback the visit to count the triangles in each plane.
+     */
+    template<typename TPoints>
+    void RunFull(TPoints & points)
+    {
+        bool const isFirstVisit = mPlaneTrianglesCounts.empty();
+
+        if (!isFirstVisit)
+        {
+            // Split the components that have lost springs first, as the incremental visit
+            // would do; from now on, each component has its own current plane ID, whose
+            // order we keep
+            RunIncremental(points);
+        }
+
+        size_t const oldPlaneCount = mPlaneTrianglesCounts.size();
+
+        // Generate a new visit sequence number
+        auto const visitSequenceNumber = ++mCurrentVisitSequenceNumber;
+
+        // Initialize plane ID, in flood order for now
+        PlaneId currentPlaneId = 0; // Also serves as Connected Component ID
+        float currentPlaneIdFloat = 0.0f;
+
+#ifdef RENDER_FLOOD_DISTANCE
+        std::optional<float> floodDistanceColor;
+#endif
+
+        // The set of (already) marked points, from which we still
+        // have to propagate out
+        std::queue<ElementIndex> pointsToPropagateFrom;
+
+        // Reset per-plane triangle counts
+        mPlaneTrianglesCounts.clear();
+        mFloodedPlaneOldPlaneIds.clear();
+
+        // Visit all non-ephemeral points
+        for (auto pointIndex : points.NonEphemeralPointsReverse())
+        {
+            // Don't visit destroyed points, or we run the risk of creating a zillion planes for nothing;
+            // also, don't re-visit already-visited points
+            if (!points.IsDeleted(pointIndex)
+                && points.GetCurrentConnectivityVisitSequenceNumber(pointIndex) != visitSequenceNumber)
+            {
+                //
+                // Flood a new plane from this point
+                //
+
+                // Remember the plane ID the component had so far, which is the
+                // same for all of its points
+                mFloodedPlaneOldPlaneIds.push_back(isFirstVisit ? NonePlaneId : points.GetPlaneId(pointIndex));
+
+                size_t planeTrianglesCount = 0;
+
+                // Visit this point first
+                points.SetPlaneId(pointIndex, currentPlaneId, currentPlaneIdFloat);
+                points.SetConnectedComponentId(pointIndex, static_cast<ConnectedComponentId>(currentPlaneId));
+                points.SetCurrentConnectivityVisitSequenceNumber(pointIndex, visitSequenceNumber);
+
+                // Add point to queue
+                assert(pointsToPropagateFrom.empty());
+                pointsToPropagateFrom.push(pointIndex);
+
+                // Visit all points reachable from this point via springs
+                while (!pointsToPropagateFrom.empty())
+                {
+                    // Pop point that we have to propagate from
+                    auto const currentPointIndex = pointsToPropagateFrom.front();
+                    pointsToPropagateFrom.pop();
+
+                    // This point has been visited already
+                    assert(visitSequenceNumber == points.GetCurrentConnectivityVisitSequenceNumber(currentPointIndex));
+
+#ifdef RENDER_FLOOD_DISTANCE
+                    if (!floodDistanceColor)
+                    {
+                        points.GetColor(currentPointIndex) = vec4f(0.0f, 0.0f, 0.75f, 1.0f);
+                        floodDistanceColor = 0.0f;
+                    }
+                    else
+                        points.GetColor(currentPointIndex) = vec4f(*floodDistanceColor, 0.0f, 0.0f, 1.0f);
+                    floodDistanceColor = *floodDistanceColor + 1.0f / 128.0f;
+                    if (*floodDistanceColor > 1.0f)
+                        floodDistanceColor = 0.0f;
+#endif
+
+                    // Visit all its non-visited connected points
+                    for (auto const & cs : points.GetConnectedSprings(currentPointIndex))
+                    {
+                        assert(!points.IsDeleted(cs.OtherEndpointIndex));
+                        assert(isFirstVisit || points.GetPlaneId(cs.OtherEndpointIndex) == mFloodedPlaneOldPlaneIds.back()
+                            || points.GetCurrentConnectivityVisitSequenceNumber(cs.OtherEndpointIndex) == visitSequenceNumber);
+
+                        if (visitSequenceNumber != points.GetCurrentConnectivityVisitSequenceNumber(cs.OtherEndpointIndex))
+                        {
+                            //
+                            // Visit point
+                            //
+
+                            points.SetPlaneId(cs.OtherEndpointIndex, currentPlaneId, currentPlaneIdFloat);
+                            points.SetConnectedComponentId(cs.OtherEndpointIndex, static_cast<ConnectedComponentId>(currentPlaneId));
+                            points.SetCurrentConnectivityVisitSequenceNumber(cs.OtherEndpointIndex, visitSequenceNumber);
+
+                            // Add point to queue
+                            pointsToPropagateFrom.push(cs.OtherEndpointIndex);
+                        }
+                    }
+
+                    // Update count of triangles with this points's triangles
+                    planeTrianglesCount += points.GetConnectedOwnedTrianglesCount(currentPointIndex);
+                }
+
+                // Remember the count of triangles in this plane
+                assert(mPlaneTrianglesCounts.size() == static_cast<size_t>(currentPlaneId));
+                mPlaneTrianglesCounts.push_back(planeTrianglesCount);
+
+                //
+                // Flood completed
+                //
+
+                // Next we begin a new plane and connected component
+                ++currentPlaneId;
+                currentPlaneIdFloat = static_cast<float>(currentPlaneId);
+            }
+        }
+
+        //
+        // Re-assign plane IDs in the order of the old ones; the first time, all
+        // old plane IDs are the same, hence we keep the flood order
+        //
+
+        mFloodedPlaneNewPlaneIds.resize(mFloodedPlaneOldPlaneIds.size());
+        std::iota(mFloodedPlaneNewPlaneIds.begin(), mFloodedPlaneNewPlaneIds.end(), PlaneId(0));
+        std::stable_sort(
+            mFloodedPlaneNewPlaneIds.begin(),
+            mFloodedPlaneNewPlaneIds.end(),
+            [this](PlaneId a, PlaneId b)
+            {
+                return mFloodedPlaneOldPlaneIds[a] < mFloodedPlaneOldPlaneIds[b];
+            });
+
+        // We now have the flooded planes by new plane ID; invert that
+        std::vector<PlaneId> floodedPlanesByNewPlaneId;
+        floodedPlanesByNewPlaneId.swap(mFloodedPlaneNewPlaneIds);
+        mFloodedPlaneNewPlaneIds.resize(floodedPlanesByNewPlaneId.size());
+        for (size_t p = 0; p < floodedPlanesByNewPlaneId.size(); ++p)
+            mFloodedPlaneNewPlaneIds[floodedPlanesByNewPlaneId[p]] = static_cast<PlaneId>(p);
+
+        bool const isReordered = !std::is_sorted(floodedPlanesByNewPlaneId.cbegin(), floodedPlanesByNewPlaneId.cend());
+
+        if (isReordered)
+        {
+            for (auto pointIndex : points.NonEphemeralPoints())
+            {
+                if (!points.IsDeleted(pointIndex))
+                {
+                    PlaneId const newPlaneId = mFloodedPlaneNewPlaneIds[points.GetPlaneId(pointIndex)];
+                    points.SetPlaneId(pointIndex, newPlaneId, static_cast<float>(newPlaneId));
+                    points.SetConnectedComponentId(pointIndex, static_cast<ConnectedComponentId>(newPlaneId));
+                }
+            }
+
+            std::vector<size_t> floodedPlaneTrianglesCounts;
+            floodedPlaneTrianglesCounts.swap(mPlaneTrianglesCounts);
+            for (auto const floodedPlaneId : floodedPlanesByNewPlaneId)
+                mPlaneTrianglesCounts.push_back(floodedPlaneTrianglesCounts[floodedPlaneId]);
+        }
+
+        // Make sure there's always at least one plane, so to tell a visited ship apart
+        if (mPlaneTrianglesCounts.empty())
+            mPlaneTrianglesCounts.push_back(0);
+
+        mLastFullVisitPlaneCount = static_cast<PlaneId>(mPlaneTrianglesCounts.size());
+
+        //
+        // Ephemeral points have been given the plane IDs of the points they came from, or the
+        // max plane ID; move them along with those planes, so they stay within the max plane ID
+        //
+
+        if (!isFirstVisit)
+        {
+            std::vector<PlaneId> newPlaneIdsByOldPlaneId(oldPlaneCount, NonePlaneId);
+            for (size_t p = 0; p < mFloodedPlaneOldPlaneIds.size(); ++p)
+            {
+                assert(mFloodedPlaneOldPlaneIds[p] < oldPlaneCount);
+                newPlaneIdsByOldPlaneId[mFloodedPlaneOldPlaneIds[p]] = mFloodedPlaneNewPlaneIds[p];
+            }
+
+            for (auto pointIndex : points.EphemeralPoints())
+            {
+                PlaneId const oldPlaneId = points.GetPlaneId(pointIndex);
+                PlaneId const newPlaneId =
+                    (oldPlaneId < newPlaneIdsByOldPlaneId.size() && NonePlaneId != newPlaneIdsByOldPlaneId[oldPlaneId])
+                    ? newPlaneIdsByOldPlaneId[oldPlaneId]
+                    : GetMaxPlaneId();
+
+                points.SetPlaneId(pointIndex, newPlaneId, static_cast<float>(newPlaneId));
+            }
+
+            points.MarkPlaneIdBufferEphemeralAsDirty();
+        }
+
+#ifdef RENDER_FLOOD_DISTANCE
+        // Remember colors are dirty
+        points.MarkColorBufferAsDirty();
+#endif
+
+        // Remember non-ephemeral portion of plane IDs is dirty
+        points.MarkPlaneIdBufferNonEphemeralAsDirty();
+
+        mPendingSeedPoints.clear();
+    }
+
+    /*
+     * A component may only have split if it has lost springs, and each piece it has split into
+     * contains at least one endpoint of the lost springs. So for each component we pick one of
+     * these endpoints as a representative, and check whether each other endpoint in the same
+     * component is still connected to it; when it's not, one of the two pieces is moved to a new plane.
+     *
+     * Since the pieces moved to new planes are complete connected components, we don't need to
+     * look any further at their points.
+     */
+    template<typename TPoints>
+    void RunIncremental(TPoints & points)
+    {
+        // Sort the seed points, so that duplicates go away and the visit is deterministic
+        std::sort(mPendingSeedPoints.begin(), mPendingSeedPoints.end());
+        mPendingSeedPoints.erase(
+            std::unique(mPendingSeedPoints.begin(), mPendingSeedPoints.end()),
+            mPendingSeedPoints.end());
+
+        size_t const oldPlaneCount = mPlaneTrianglesCounts.size();
+
+        mPlaneRepresentativePoints.assign(oldPlaneCount, NoneElementIndex);
+
+        for (auto const pointIndex : mPendingSeedPoints)
+        {
+            if (points.IsDeleted(pointIndex))
+                continue;
+
+            PlaneId const planeId = points.GetPlaneId(pointIndex);
+            if (planeId >= oldPlaneCount)
+            {
+                // This point belongs to a piece we've already found in this visit
+                continue;
+            }
+
+            ElementIndex const representativePointIndex = mPlaneRepresentativePoints[planeId];
+            if (NoneElementIndex == representativePointIndex)
+            {
+                // First point we see in this component
+                mPlaneRepresentativePoints[planeId] = pointIndex;
+            }
+            else
+            {
+                assert(points.GetPlaneId(representativePointIndex) == planeId);
+
+                auto const separatedPointIndex = SeparateIfDisconnected(points, representativePointIndex, pointIndex);
+                if (separatedPointIndex == representativePointIndex)
+                {
+                    // The representative has moved away, this point now represents what's left
+                    mPlaneRepresentativePoints[planeId] = pointIndex;
+                }
+            }
+        }
+
+        mPendingSeedPoints.clear();
+    }
+
+private:
+
+    /*
+     * Bidirectional search: we grow the two sets of points reachable from each endpoint, one point
+     * at a time from the smaller set, until either the two sets meet - in which case the endpoints
+     * are connected - or one of the two sets is exhausted - in which case that set is a whole
+     * connected component, which we move to a new plane.
+     *
+     * The cost is thus proportional to the smaller of the two pieces, rather than to the whole ship.
+     *
+     * Returns the point from which the separated piece has been grown, if any.
+     */
+    template<typename TPoints>
+    std::optional<ElementIndex> SeparateIfDisconnected(
+        TPoints & points,
+        ElementIndex pointAIndex,
+        ElementIndex pointBIndex)
+    {
+        assert(pointAIndex != pointBIndex);
+
+        auto const visitSequenceNumberA = ++mCurrentVisitSequenceNumber;
+        auto const visitSequenceNumberB = ++mCurrentVisitSequenceNumber;
+
+        mSearchPointsA.clear();
+        mSearchPointsA.push_back(pointAIndex);
+        points.SetCurrentConnectivityVisitSequenceNumber(pointAIndex, visitSequenceNumberA);
+
+        mSearchPointsB.clear();
+        mSearchPointsB.push_back(pointBIndex);
+        points.SetCurrentConnectivityVisitSequenceNumber(pointBIndex, visitSequenceNumberB);
+
+        // The search points double as the queues of points to propagate from
+        size_t nextPointA = 0;
+        size_t nextPointB = 0;
+
+        while (true)
+        {
+            std::vector<ElementIndex> * separatedPoints;
+            if (nextPointA == mSearchPointsA.size())
+                separatedPoints = &mSearchPointsA;
+            else if (nextPointB == mSearchPointsB.size())
+                separatedPoints = &mSearchPointsB;
+            else
+                separatedPoints = nullptr;
+
+            if (nullptr != separatedPoints)
+            {
+                //
+                // Move the exhausted set to a new plane
+                //
+
+                PlaneId const oldPlaneId = points.GetPlaneId(separatedPoints->front());
+                PlaneId const newPlaneId = static_cast<PlaneId>(mPlaneTrianglesCounts.size());
+                float const newPlaneIdFloat = static_cast<float>(newPlaneId);
+
+                size_t planeTrianglesCount = 0;
+                for (auto const pointIndex : *separatedPoints)
+                {
+                    assert(points.GetPlaneId(pointIndex) == oldPlaneId);
+
+                    points.SetPlaneId(pointIndex, newPlaneId, newPlaneIdFloat);
+                    points.SetConnectedComponentId(pointIndex, static_cast<ConnectedComponentId>(newPlaneId));
+
+                    planeTrianglesCount += points.GetConnectedOwnedTrianglesCount(pointIndex);
+                }
+
+                assert(mPlaneTrianglesCounts[oldPlaneId] >= planeTrianglesCount);
+                mPlaneTrianglesCounts[oldPlaneId] -= planeTrianglesCount;
+                mPlaneTrianglesCounts.push_back(planeTrianglesCount);
+
+                // Remember non-ephemeral portion of plane IDs is dirty
+                points.MarkPlaneIdBufferNonEphemeralAsDirty();
+
+                return separatedPoints->front();
+            }
+
+            //
+            // Propagate from the smaller set
+            //
+
+            bool const isA = mSearchPointsA.size() <= mSearchPointsB.size();
+
+            auto & searchPoints = isA ? mSearchPointsA : mSearchPointsB;
+            auto & nextPoint = isA ? nextPointA : nextPointB;
+            auto const visitSequenceNumber = isA ? visitSequenceNumberA : visitSequenceNumberB;
+            auto const otherVisitSequenceNumber = isA ? visitSequenceNumberB : visitSequenceNumberA;
+
+            auto const currentPointIndex = searchPoints[nextPoint++];
+
+            for (auto const & cs : points.GetConnectedSprings(currentPointIndex))
+            {
+                assert(!points.IsDeleted(cs.OtherEndpointIndex));
+
+                auto const otherEndpointVisitSequenceNumber = points.GetCurrentConnectivityVisitSequenceNumber(cs.OtherEndpointIndex);
+
+                if (otherVisitSequenceNumber == otherEndpointVisitSequenceNumber)
+                {
+                    // The two sets have met, hence the two endpoints are still connected
+                    return std::nullopt;
+                }
+
+                if (visitSequenceNumber != otherEndpointVisitSequenceNumber)
+                {
+                    points.SetCurrentConnectivityVisitSequenceNumber(cs.OtherEndpointIndex, visitSequenceNumber);
+                    searchPoints.push_back(cs.OtherEndpointIndex);
+                }
+            }
+        }
+    }
+
+private:
+
+    // The current visit sequence number
+    SequenceNumber mCurrentVisitSequenceNumber;
+
+    // Number of (non-deleted) triangles in each plane ID
+    std::vector<size_t> mPlaneTrianglesCounts;
+
+    // Number of plane IDs assigned by the last full visit
+    PlaneId mLastFullVisitPlaneCount;
+
+    // The endpoints of the springs destroyed since the last visit;
+    // a connected component may only have split at these points
+    std::vector<ElementIndex> mPendingSeedPoints;
+
+    // Scratch buffers for the incremental visit
+    std::vector<ElementIndex> mPlaneRepresentativePoints;
+    std::vector<ElementIndex> mSearchPointsA;
+    std::vector<ElementIndex> mSearchPointsB;
+
+    // Scratch buffers for the full visit: for each plane in flood order, its old and new plane ID
+    std::vector<PlaneId> mFloodedPlaneOldPlaneIds;
+    std::vector<PlaneId> mFloodedPlaneNewPlaneIds;
+};
+
+}
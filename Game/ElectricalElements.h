@@ -59,6 +59,39 @@ public:
     {
     }
 
+    /*
+     * Makes a copy of the specified electrical elements - bulk-copying all of their buffers -
+     * which belongs to the specified world. The copy has no destroy handler.
+     */
+    ElectricalElements(
+        ElectricalElements const & other,
+        World & parentWorld,
+        std::shared_ptr<IGameEventHandler> gameEventHandler)
+        : ElementContainer(other)
+        //////////////////////////////////
+        // Buffers
+        //////////////////////////////////
+        , mIsDeletedBuffer(other.mIsDeletedBuffer)
+        , mPointIndexBuffer(other.mPointIndexBuffer)
+        , mTypeBuffer(other.mTypeBuffer)
+        , mLuminiscenceBuffer(other.mLuminiscenceBuffer)
+        , mLightColorBuffer(other.mLightColorBuffer)
+        , mLightSpreadBuffer(other.mLightSpreadBuffer)
+        , mConnectedElectricalElementsBuffer(other.mConnectedElectricalElementsBuffer)
+        , mElementStateBuffer(other.mElementStateBuffer)
+        , mAvailableCurrentBuffer(other.mAvailableCurrentBuffer)
+        , mCurrentConnectivityVisitSequenceNumberBuffer(other.mCurrentConnectivityVisitSequenceNumberBuffer)
+        //////////////////////////////////
+        // Container
+        //////////////////////////////////
+        , mParentWorld(parentWorld)
+        , mGameEventHandler(std::move(gameEventHandler))
+        , mDestroyHandler()
+        , mGenerators(other.mGenerators)
+        , mLamps(other.mLamps)
+    {
+    }
+
     ElectricalElements(ElectricalElements && other) = default;
 
     /*
@@ -11,6 +11,7 @@ namespace Physics {
 
 void DrawForceField::Apply(
     Points & points,
+    PointGridProvider const & /*pointGridProvider*/,
     float /*currentSimulationTime*/,
     GameParameters const & /*gameParameters*/) const
 {
@@ -29,6 +30,7 @@ void DrawForceField::Apply(
 
 void SwirlForceField::Apply(
     Points & points,
+    PointGridProvider const & /*pointGridProvider*/,
     float /*currentSimulationTime*/,
     GameParameters const & /*gameParameters*/) const
 {
@@ -48,6 +50,7 @@ void SwirlForceField::Apply(
 
 void BlastForceField::Apply(
     Points & points,
+    PointGridProvider const & pointGridProvider,
     float currentSimulationTime,
     GameParameters const & gameParameters) const
 {
@@ -64,32 +67,44 @@ void BlastForceField::Apply(
     float closestPointSquareDistance = std::numeric_limits<float>::max();
     ElementIndex closestPointIndex = NoneElementIndex;
 
-    // Visit all (non-ephemeral) points (ephemerals would be blown immediately away otherwise)
-    for (auto pointIndex : points.NonEphemeralPoints())
-    {
-        vec2f pointRadius = points.GetPosition(pointIndex) - mCenterPosition;
-        float squarePointDistance = pointRadius.squareLength();
-        if (squarePointDistance < squareBlastRadius)
-        {
-            // Check whether this point is the closest, non-deleted point
-            // (we don't want to waste destroy's on already-deleted points)
-            if (squarePointDistance < closestPointSquareDistance
-                && !points.IsDeleted(pointIndex))
+    // Visit all (non-ephemeral) points in the neighborhood of the blast (ephemerals would be
+    // blown immediately away otherwise); the grid is as of the beginning of the step, hence
+    // we widen the search a bit to account for points that have moved since then
+    float const searchRadius = mBlastRadius + BlastSearchRadiusMargin;
+    pointGridProvider().VisitPointsInBox(
+        Geometry::AABB(
+            mCenterPosition.x - searchRadius,
+            mCenterPosition.x + searchRadius,
+            mCenterPosition.y + searchRadius,
+            mCenterPosition.y - searchRadius),
+        [&](ElementIndex pointIndex)
             {
-                closestPointSquareDistance = squarePointDistance;
-                closestPointIndex = pointIndex;
-            }
-
-            // Create acceleration to flip the point
-            vec2f flippedRadius = pointRadius.normalise() * (mBlastRadius + (mBlastRadius - pointRadius.length()));
-            vec2f newPosition = mCenterPosition + flippedRadius;
-            points.GetForce(pointIndex) +=
-                (newPosition - points.GetPosition(pointIndex))
-                / DtSquared
-                * mStrength
-                * points.GetMass(pointIndex);
-        }
-    }
+                if (points.IsEphemeral(pointIndex))
+                    return;
+
+                vec2f pointRadius = points.GetPosition(pointIndex) - mCenterPosition;
+                float squarePointDistance = pointRadius.squareLength();
+                if (squarePointDistance < squareBlastRadius)
+                {
+                    // Check whether this point is the closest, non-deleted point
+                    // (we don't want to waste destroy's on already-deleted points)
+                    if (squarePointDistance < closestPointSquareDistance
+                        && !points.IsDeleted(pointIndex))
+                    {
+                        closestPointSquareDistance = squarePointDistance;
+                        closestPointIndex = pointIndex;
+                    }
+
+                    // Create acceleration to flip the point
+                    vec2f flippedRadius = pointRadius.normalise() * (mBlastRadius + (mBlastRadius - pointRadius.length()));
+                    vec2f newPosition = mCenterPosition + flippedRadius;
+                    points.GetForce(pointIndex) +=
+                        (newPosition - points.GetPosition(pointIndex))
+                        / DtSquared
+                        * mStrength
+                        * points.GetMass(pointIndex);
+                }
+            });
 
 
     //
@@ -110,6 +125,7 @@ void BlastForceField::Apply(
 
 void RadialSpaceWarpForceField::Apply(
     Points & points,
+    PointGridProvider const & /*pointGridProvider*/,
     float /*currentSimulationTime*/,
     GameParameters const & /*gameParameters*/) const
 {
@@ -134,6 +150,7 @@ void RadialSpaceWarpForceField::Apply(
 
 void ImplosionForceField::Apply(
     Points & points,
+    PointGridProvider const & /*pointGridProvider*/,
     float /*currentSimulationTime*/,
     GameParameters const & /*gameParameters*/) const
 {
@@ -165,6 +182,7 @@ void ImplosionForceField::Apply(
 
 void RadialExplosionForceField::Apply(
     Points & points,
+    PointGridProvider const & /*pointGridProvider*/,
     float /*currentSimulationTime*/,
     GameParameters const & /*gameParameters*/) const
 {
@@ -10,6 +10,8 @@
 
 #include <GameCore/Vectors.h>
 
+#include <functional>
+
 namespace Physics
 {
 
@@ -18,13 +20,26 @@ namespace Physics
  */
 class ForceField
 {
+public:
+
+    /*
+     * Returns the grid over the points, building it if needed; the grid is a snapshot of
+     * the points' positions as of the beginning of the current simulation step.
+     */
+    using PointGridProvider = std::function<PointGrid const &()>;
+
 public:
 
     virtual ~ForceField()
     {}
 
+    /*
+     * Applies the force field to the points; fields that only affect a limited area may
+     * obtain the grid from the provider, for limiting the search to that area.
+     */
     virtual void Apply(
         Points & points,
+        PointGridProvider const & pointGridProvider,
         float currentSimulationTime,
         GameParameters const & gameParameters) const = 0;
 };
@@ -45,6 +60,7 @@ public:
 
     virtual void Apply(
         Points & points,
+        PointGridProvider const & pointGridProvider,
         float currentSimulationTime,
         GameParameters const & gameParameters) const override;
 
@@ -70,6 +86,7 @@ public:
 
     virtual void Apply(
         Points & points,
+        PointGridProvider const & pointGridProvider,
         float currentSimulationTime,
         GameParameters const & gameParameters) const override;
 
@@ -99,11 +116,16 @@ public:
 
     virtual void Apply(
         Points & points,
+        PointGridProvider const & pointGridProvider,
         float currentSimulationTime,
         GameParameters const & gameParameters) const override;
 
 private:
 
+    // How much farther than the blast radius we look for points, so to
+    // include points that have entered the blast since the grid was built
+    static constexpr float BlastSearchRadiusMargin = 2.0f;
+
     vec2f const mCenterPosition;
     float const mBlastRadius;
     float const mStrength;
@@ -130,6 +152,7 @@ public:
 
     virtual void Apply(
         Points & points,
+        PointGridProvider const & pointGridProvider,
         float currentSimulationTime,
         GameParameters const & gameParameters) const override;
 
@@ -158,6 +181,7 @@ public:
 
     virtual void Apply(
         Points & points,
+        PointGridProvider const & pointGridProvider,
         float currentSimulationTime,
         GameParameters const & gameParameters) const override;
 
@@ -183,6 +207,7 @@ public:
 
     virtual void Apply(
         Points & points,
+        PointGridProvider const & pointGridProvider,
         float currentSimulationTime,
         GameParameters const & gameParameters) const override;
 
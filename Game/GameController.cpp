@@ -7,17 +7,27 @@
 
 #include <GameCore/GameMath.h>
 #include <GameCore/Log.h>
+#include <GameCore/Profiler.h>
+
+#include <algorithm>
 
 std::unique_ptr<GameController> GameController::Create(
     bool isStatusTextEnabled,
     bool isExtendedStatusTextEnabled,
+    bool isSimulationThreadEnabled,
     std::function<void()> swapRenderBuffersFunction,
     std::shared_ptr<ResourceLoader> resourceLoader,
+    std::optional<std::filesystem::path> const & shipBuildCacheFolderPath,
     ProgressCallback const & progressCallback)
 {
     // Load materials
     MaterialDatabase materialDatabase = MaterialDatabase::Load(*resourceLoader);
 
+    // Create ship build cache, if requested
+    std::unique_ptr<ShipBuildCache> shipBuildCache;
+    if (!!shipBuildCacheFolderPath)
+        shipBuildCache = std::make_unique<ShipBuildCache>(*shipBuildCacheFolderPath);
+
     // Create game dispatcher
     std::unique_ptr<GameEventDispatcher> gameEventDispatcher = std::make_unique<GameEventDispatcher>();
 
@@ -45,7 +55,25 @@ std::unique_ptr<GameController> GameController::Create(
             std::move(gameEventDispatcher),
             std::move(textLayer),
             std::move(materialDatabase),
-            resourceLoader));
+            std::move(shipBuildCache),
+            resourceLoader,
+            isSimulationThreadEnabled));
+}
+
+GameController::~GameController()
+{
+    if (mSimulationThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> const lock(mWorldMutex);
+
+            mIsSimulationThreadStopRequested = true;
+        }
+
+        mSimulationThreadSignal.notify_one();
+
+        mSimulationThread.join();
+    }
 }
 
 void GameController::RegisterGameEventHandler(IGameEventHandler * gameEventHandler)
@@ -63,26 +91,34 @@ ShipMetadata GameController::ResetAndLoadShip(std::filesystem::path const & ship
         *mResourceLoader);
 
     // Load ship definition
+    auto const shipDefinitionLastWriteTime = ShipDefinition::GetLastWriteTime(shipDefinitionFilepath);
     auto shipDefinition = ShipDefinition::Load(shipDefinitionFilepath);
 
     // Save metadata
     ShipMetadata shipMetadata(shipDefinition.Metadata);
 
     // Add ship to new world
+    std::shared_ptr<Physics::ShipPristineState const> pristineState;
     ShipId shipId = newWorld->AddShip(
         shipDefinition,
         mMaterialDatabase,
-        mGameParameters);
+        mGameParameters,
+        mShipBuildCache.get(),
+        &pristineState);
 
     //
     // No errors, so we may continue
     //
 
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
+
     Reset(std::move(newWorld));
 
     OnShipAdded(
         std::move(shipDefinition),
         shipDefinitionFilepath,
+        shipDefinitionLastWriteTime,
+        std::move(pristineState),
         shipId);
 
     return shipMetadata;
@@ -91,16 +127,22 @@ ShipMetadata GameController::ResetAndLoadShip(std::filesystem::path const & ship
 ShipMetadata GameController::AddShip(std::filesystem::path const & shipDefinitionFilepath)
 {
     // Load ship definition
+    auto const shipDefinitionLastWriteTime = ShipDefinition::GetLastWriteTime(shipDefinitionFilepath);
     auto shipDefinition = ShipDefinition::Load(shipDefinitionFilepath);
 
     // Save metadata
     ShipMetadata shipMetadata(shipDefinition.Metadata);
 
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
+
     // Load ship into current world
+    std::shared_ptr<Physics::ShipPristineState const> pristineState;
     ShipId shipId = mWorld->AddShip(
         shipDefinition,
         mMaterialDatabase,
-        mGameParameters);
+        mGameParameters,
+        mShipBuildCache.get(),
+        &pristineState);
 
     //
     // No errors, so we may continue
@@ -109,6 +151,8 @@ ShipMetadata GameController::AddShip(std::filesystem::path const & shipDefinitio
     OnShipAdded(
         std::move(shipDefinition),
         shipDefinitionFilepath,
+        shipDefinitionLastWriteTime,
+        std::move(pristineState),
         shipId);
 
     return shipMetadata;
@@ -116,36 +160,70 @@ ShipMetadata GameController::AddShip(std::filesystem::path const & shipDefinitio
 
 void GameController::ReloadLastShip()
 {
+    if (mLastShipLoadedFilepath.empty())
+    {
+        throw std::runtime_error("No ship has been loaded yet");
+    }
+
     // Create a new world
     auto newWorld = std::make_unique<Physics::World>(
         mGameEventDispatcher,
         mGameParameters,
         *mResourceLoader);
 
-    // Load ship definition
+    //
+    // Re-create the ship from its pristine state, unless its definition has changed
+    // in the meantime
+    //
 
-    if (mLastShipLoadedFilepath.empty())
+    auto const shipDefinitionLastWriteTime = ShipDefinition::GetLastWriteTime(mLastShipLoadedFilepath);
+
+    if (!!mLastShipLoadedPristineState
+        && mLastShipLoadedPristineState->DefinitionLastWriteTime == shipDefinitionLastWriteTime)
     {
-        throw std::runtime_error("No ship has been loaded yet");
+        ShipId shipId = newWorld->AddShip(
+            mLastShipLoadedPristineState->State,
+            mMaterialDatabase);
+
+        std::lock_guard<std::mutex> const lock(mWorldMutex);
+
+        Reset(std::move(newWorld));
+
+        OnShipAdded(
+            shipId,
+            mLastShipLoadedPristineState->TextureLayerImage.Clone(),
+            mLastShipLoadedPristineState->TextureOrigin,
+            mLastShipLoadedPristineState->Metadata);
+
+        return;
     }
 
+    // Load ship definition
+
     auto shipDefinition = ShipDefinition::Load(mLastShipLoadedFilepath);
 
     // Load ship into new world
+    std::shared_ptr<Physics::ShipPristineState const> pristineState;
     ShipId shipId = newWorld->AddShip(
         shipDefinition,
         mMaterialDatabase,
-        mGameParameters);
+        mGameParameters,
+        mShipBuildCache.get(),
+        &pristineState);
 
     //
     // No errors, so we may continue
     //
 
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
+
     Reset(std::move(newWorld));
 
     OnShipAdded(
         std::move(shipDefinition),
         mLastShipLoadedFilepath,
+        shipDefinitionLastWriteTime,
+        std::move(pristineState),
         shipId);
 }
 
@@ -156,21 +234,54 @@ RgbImageData GameController::TakeScreenshot()
 
 void GameController::RunGameIteration()
 {
+    auto const frameStartTime = std::chrono::steady_clock::now();
+
     ///////////////////////////////////////////////////////////
     // Update simulation
     ///////////////////////////////////////////////////////////
 
-    // Make sure we're not paused
-    if (!mIsPaused && !mIsMoveToolEngaged)
+    if (mIsSimulationThreadEnabled)
+    {
+        // The simulation runs on its own; we just hand it the current parameters,
+        // and deliver the events that it has generated in the meantime - unless
+        // it's in the middle of a step, in which case we don't wait for it and
+        // rather do so at the next frame
+
+        std::unique_lock<std::mutex> const lock(mWorldMutex, std::try_to_lock);
+
+        if (lock.owns_lock())
+        {
+            if (!!mSimulationThreadException)
+            {
+                // The simulation thread has stopped
+                std::rethrow_exception(mSimulationThreadException);
+            }
+
+            mSimulationGameParameters = mGameParameters;
+
+            // Update text layer
+            mTextLayer->Update();
+
+            // Flush events
+            mGameEventDispatcher->Flush();
+        }
+    }
+    else
     {
-        auto const startTime = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> const lock(mWorldMutex);
 
-        InternalUpdate();
+        // Make sure we're not paused
+        if (!mIsPaused && !mIsMoveToolEngaged)
+        {
+            InternalUpdate(mGameParameters, mFastForwardMaxStepCount);
+        }
 
-        auto const endTime = std::chrono::steady_clock::now();
-        mTotalUpdateDuration += endTime - startTime;
+        // Publish regardless, as tools might still be changing the world
+        PublishRenderSnapshots();
     }
 
+    auto const frameUpdateEndTime = std::chrono::steady_clock::now();
+
 
     ///////////////////////////////////////////////////////////
     // Render
@@ -190,11 +301,14 @@ void GameController::RunGameIteration()
 
         mTotalFrameCount = 0u;
         mLastFrameCount = 0u;
+        mTotalSimulationStepCount = 0u;
+        mLastSimulationStepCount = 0u;
 
         // In order to start from zero at first render, take global origin here
         mOriginTimestampGame = nowReal;
 
         // Render initial status text
+        std::lock_guard<std::mutex> const lock(mWorldMutex);
         PublishStats(nowReal);
     }
 
@@ -208,12 +322,20 @@ void GameController::RunGameIteration()
     // Flip the (previous) back buffer onto the screen
     mSwapRenderBuffersFunction();
 
+    auto const renderStartTime = std::chrono::steady_clock::now();
+
     // Render
     InternalRender();
 
     auto const endTime = std::chrono::steady_clock::now();
     mTotalRenderDuration += endTime - startTime;
 
+    // Not including the flip, as that might be waiting for the display
+    mRenderTimeHistogram.Record(endTime - renderStartTime);
+
+    // The whole frame: this is what has to fit in the refresh interval
+    mFrameTimeHistogram.Record((frameUpdateEndTime - frameStartTime) + (endTime - renderStartTime));
+
 
     //
     // Update stats
@@ -227,6 +349,8 @@ void GameController::LowFrequencyUpdate()
 {
     std::chrono::steady_clock::time_point nowReal = std::chrono::steady_clock::now();
 
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
+
     if (mSkippedFirstStatPublishes >= 1)
     {
         //
@@ -241,8 +365,12 @@ void GameController::LowFrequencyUpdate()
         //
 
         mLastFrameCount = 0u;
+        mLastSimulationStepCount = 0u;
         mLastTotalUpdateDuration = mTotalUpdateDuration;
         mLastTotalRenderDuration = mTotalRenderDuration;
+        mUpdateTimeHistogram.Reset();
+        mRenderTimeHistogram.Reset();
+        mFrameTimeHistogram.Reset();
     }
     else
     {
@@ -252,6 +380,11 @@ void GameController::LowFrequencyUpdate()
 
         mTotalFrameCount = 0u;
         mLastFrameCount = 0u;
+        mTotalSimulationStepCount = 0u;
+        mLastSimulationStepCount = 0u;
+        mUpdateTimeHistogram.Reset();
+        mRenderTimeHistogram.Reset();
+        mFrameTimeHistogram.Reset();
         mRenderStatsOriginTimestampReal = nowReal;
 
         ++mSkippedFirstStatPublishes;
@@ -262,7 +395,10 @@ void GameController::LowFrequencyUpdate()
 
 void GameController::Update()
 {
-    InternalUpdate();
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
+
+    // Exactly one step, regardless of fast-forwarding
+    InternalUpdate(mGameParameters, 1);
 }
 
 void GameController::Render()
@@ -276,11 +412,15 @@ void GameController::Render()
 
 void GameController::SetPaused(bool isPaused)
 {
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
+
     mIsPaused = isPaused;
 }
 
 void GameController::SetMoveToolEngaged(bool isEngaged)
 {
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
+
     mIsMoveToolEngaged = isEngaged;
 }
 
@@ -296,6 +436,18 @@ void GameController::SetExtendedStatusTextEnabled(bool isEnabled)
     mTextLayer->SetExtendedStatusTextEnabled(isEnabled);
 }
 
+void GameController::SetFastForward(
+    size_t maxStepCount,
+    std::chrono::steady_clock::duration frameBudget)
+{
+    assert(maxStepCount >= 1);
+
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
+
+    mFastForwardMaxStepCount = maxStepCount;
+    mFastForwardFrameBudget = frameBudget;
+}
+
 void GameController::MoveBy(
     ShipId shipId,
     vec2f const & screenOffset)
@@ -303,6 +455,7 @@ void GameController::MoveBy(
     vec2f const worldOffset = mRenderContext->ScreenOffsetToWorldOffset(screenOffset);
 
     // Apply action
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
     assert(!!mWorld);
     mWorld->MoveBy(
         shipId,
@@ -323,6 +476,7 @@ void GameController::RotateBy(
     vec2f const worldCenter = mRenderContext->ScreenToWorld(screenCenter);
 
     // Apply action
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
     assert(!!mWorld);
     mWorld->RotateBy(
         shipId,
@@ -338,6 +492,7 @@ void GameController::DestroyAt(
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
     // Apply action
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
     assert(!!mWorld);
     mWorld->DestroyAt(
         worldCoordinates,
@@ -353,6 +508,7 @@ void GameController::SawThrough(
     vec2f const endWorldCoordinates = mRenderContext->ScreenToWorld(endScreenCoordinates);
 
     // Apply action
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
     assert(!!mWorld);
     mWorld->SawThrough(
         startWorldCoordinates,
@@ -369,6 +525,7 @@ void GameController::DrawTo(
     float strength = 2000.0f * strengthMultiplier;
 
     // Apply action
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
     assert(!!mWorld);
     mWorld->DrawTo(
         worldCoordinates,
@@ -385,6 +542,7 @@ void GameController::SwirlAt(
     float strength = 30.0f * strengthMultiplier;
 
     // Apply action
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
     assert(!!mWorld);
     mWorld->SwirlAt(
         worldCoordinates,
@@ -397,6 +555,7 @@ void GameController::TogglePinAt(vec2f const & screenCoordinates)
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
     // Apply action
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
     assert(!!mWorld);
     mWorld->TogglePinAt(
         worldCoordinates,
@@ -408,6 +567,7 @@ bool GameController::InjectBubblesAt(vec2f const & screenCoordinates)
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
     // Apply action
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
     assert(!!mWorld);
     return mWorld->InjectBubblesAt(
         worldCoordinates,
@@ -421,6 +581,7 @@ bool GameController::FloodAt(
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
     // Apply action
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
     assert(!!mWorld);
     return mWorld->FloodAt(
         worldCoordinates,
@@ -433,6 +594,7 @@ void GameController::ToggleAntiMatterBombAt(vec2f const & screenCoordinates)
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
     // Apply action
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
     assert(!!mWorld);
     mWorld->ToggleAntiMatterBombAt(
         worldCoordinates,
@@ -444,6 +606,7 @@ void GameController::ToggleImpactBombAt(vec2f const & screenCoordinates)
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
     // Apply action
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
     assert(!!mWorld);
     mWorld->ToggleImpactBombAt(
         worldCoordinates,
@@ -455,6 +618,7 @@ void GameController::ToggleRCBombAt(vec2f const & screenCoordinates)
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
     // Apply action
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
     assert(!!mWorld);
     mWorld->ToggleRCBombAt(
         worldCoordinates,
@@ -466,6 +630,7 @@ void GameController::ToggleTimerBombAt(vec2f const & screenCoordinates)
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
     // Apply action
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
     assert(!!mWorld);
     mWorld->ToggleTimerBombAt(
         worldCoordinates,
@@ -475,6 +640,7 @@ void GameController::ToggleTimerBombAt(vec2f const & screenCoordinates)
 void GameController::DetonateRCBombs()
 {
     // Apply action
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
     assert(!!mWorld);
     mWorld->DetonateRCBombs();
 }
@@ -482,6 +648,7 @@ void GameController::DetonateRCBombs()
 void GameController::DetonateAntiMatterBombs()
 {
     // Apply action
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
     assert(!!mWorld);
     mWorld->DetonateAntiMatterBombs();
 }
@@ -490,6 +657,7 @@ bool GameController::AdjustOceanFloorTo(vec2f const & screenCoordinates)
 {
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
     assert(!!mWorld);
     return mWorld->AdjustOceanFloorTo(worldCoordinates.x, worldCoordinates.y);
 }
@@ -502,6 +670,7 @@ bool GameController::ScrubThrough(
     vec2f const endWorldCoordinates = mRenderContext->ScreenToWorld(endScreenCoordinates);
 
     // Apply action
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
     assert(!!mWorld);
     return mWorld->ScrubThrough(
         startWorldCoordinates,
@@ -513,6 +682,7 @@ std::optional<ObjectId> GameController::GetNearestPointAt(vec2f const & screenCo
 {
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
     assert(!!mWorld);
     return mWorld->GetNearestPointAt(worldCoordinates, 1.0f);
 }
@@ -521,25 +691,125 @@ void GameController::QueryNearestPointAt(vec2f const & screenCoordinates) const
 {
     vec2f const worldCoordinates = mRenderContext->ScreenToWorld(screenCoordinates);
 
+    std::lock_guard<std::mutex> const lock(mWorldMutex);
     assert(!!mWorld);
     mWorld->QueryNearestPointAt(worldCoordinates, 1.0f);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
 
-void GameController::InternalUpdate()
+void GameController::InternalUpdate(
+    GameParameters const & gameParameters,
+    size_t maxStepCount)
+{
+    assert(maxStepCount >= 1);
+
+    //
+    // Update world, once for each step; events are aggregated across
+    // the steps, as we only flush them once at the end
+    //
+
+    auto const startTime = std::chrono::steady_clock::now();
+    auto endTime = startTime;
+
+    for (size_t stepCount = 1; ; ++stepCount)
+    {
+        assert(!!mWorld);
+        mWorld->Update(
+            gameParameters,
+            mRenderContext->GetVectorFieldRenderMode());
+
+        auto const stepEndTime = std::chrono::steady_clock::now();
+        mUpdateTimeHistogram.Record(stepEndTime - endTime);
+        endTime = stepEndTime;
+
+        ++mTotalSimulationStepCount;
+        ++mLastSimulationStepCount;
+
+        if (stepCount >= maxStepCount)
+            break;
+
+        if (mFastForwardFrameBudget != std::chrono::steady_clock::duration::zero())
+        {
+            // Stop if one more step - assuming it takes as long as the average
+            // step so far - would exceed the budget
+            auto const elapsed = endTime - startTime;
+            auto const averageStepDuration = elapsed / static_cast<std::chrono::steady_clock::rep>(stepCount);
+            if (elapsed + averageStepDuration > mFastForwardFrameBudget)
+                break;
+        }
+    }
+
+    mTotalUpdateDuration += endTime - startTime;
+
+    if (!mIsSimulationThreadEnabled)
+    {
+        // Update text layer
+        mTextLayer->Update();
+
+        // Flush events
+        mGameEventDispatcher->Flush();
+    }
+
+    // Otherwise, the text layer and the events are taken care of at the next frame
+}
+
+void GameController::PublishRenderSnapshots()
 {
-    // Update world
     assert(!!mWorld);
-    mWorld->Update(
-        mGameParameters,
-        *mRenderContext);
 
-    // Update text layer
-    mTextLayer->Update();
+    // Publish under the world mutex only...
+    mWorld->PublishRenderSnapshots(mRenderContext->GetVectorFieldRenderMode());
+
+    // ...and only hold the render snapshot mutex to hand them over
+    std::lock_guard<std::mutex> const lock(mRenderSnapshotMutex);
+
+    mWorld->HandOverRenderSnapshots();
+}
+
+void GameController::RunSimulationThread()
+{
+    TraceRecorder::GetInstance().SetCurrentThreadName("Simulation");
+
+    auto const stepDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<float>(GameParameters::SimulationStepTimeDuration<float>));
+
+    auto nextStepTime = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(mWorldMutex);
+
+    while (true)
+    {
+        // Wait until it's time for the next step, leaving the world to the others in the meantime
+        if (mSimulationThreadSignal.wait_until(lock, nextStepTime, [this]() { return mIsSimulationThreadStopRequested; }))
+        {
+            break;
+        }
+
+        try
+        {
+            if (!mIsPaused && !mIsMoveToolEngaged)
+            {
+                InternalUpdate(mSimulationGameParameters, mFastForwardMaxStepCount);
+            }
+
+            // Publish regardless, as tools might still be changing the world
+            PublishRenderSnapshots();
+        }
+        catch (...)
+        {
+            // Let the main thread know at its next iteration
+            mSimulationThreadException = std::current_exception();
+
+            break;
+        }
 
-    // Flush events
-    mGameEventDispatcher->Flush();
+        // Schedule the next step; when a step takes longer than its duration we do not
+        // try to catch up, and we always leave the world to the others for a little while
+        nextStepTime = std::max(
+            nextStepTime + stepDuration,
+            std::chrono::steady_clock::now() + MinSimulationThreadIdleDuration);
+    }
 }
 
 void GameController::InternalRender()
@@ -594,6 +864,13 @@ void GameController::InternalRender()
     //
 
     assert(!!mWorld);
+
+    {
+        std::lock_guard<std::mutex> const lock(mRenderSnapshotMutex);
+
+        mWorld->AcquireRenderSnapshots(mIsSimulationThreadEnabled);
+    }
+
     mWorld->Render(mGameParameters, *mRenderContext);
 
 
@@ -656,23 +933,47 @@ void GameController::Reset(std::unique_ptr<Physics::World> newWorld)
 void GameController::OnShipAdded(
     ShipDefinition shipDefinition,
     std::filesystem::path const & shipDefinitionFilepath,
+    std::filesystem::file_time_type shipDefinitionLastWriteTime,
+    std::shared_ptr<Physics::ShipPristineState const> pristineState,
     ShipId shipId)
+{
+    // Keep what it takes to reload this ship
+    auto pristineShip = std::make_unique<PristineShip>(
+        std::move(pristineState),
+        shipDefinitionLastWriteTime,
+        shipDefinition.TextureLayerImage.Clone(),
+        shipDefinition.TextureOrigin,
+        shipDefinition.Metadata);
+
+    OnShipAdded(
+        shipId,
+        std::move(shipDefinition.TextureLayerImage),
+        shipDefinition.TextureOrigin,
+        shipDefinition.Metadata);
+
+    // Remember last loaded ship
+    mLastShipLoadedFilepath = shipDefinitionFilepath;
+    mLastShipLoadedPristineState = std::move(pristineShip);
+}
+
+void GameController::OnShipAdded(
+    ShipId shipId,
+    RgbaImageData textureLayerImage,
+    ShipDefinition::TextureOriginType textureOrigin,
+    ShipMetadata const & shipMetadata)
 {
     // Add ship to rendering engine
     mRenderContext->AddShip(
         shipId,
         mWorld->GetShipPointCount(shipId),
-        std::move(shipDefinition.TextureLayerImage),
-        shipDefinition.TextureOrigin);
+        std::move(textureLayerImage),
+        textureOrigin);
 
     // Notify
     mGameEventDispatcher->OnShipLoaded(
         shipId,
-        shipDefinition.Metadata.ShipName,
-        shipDefinition.Metadata.Author);
-
-    // Remember last loaded ship
-    mLastShipLoadedFilepath = shipDefinitionFilepath;
+        shipMetadata.ShipName,
+        shipMetadata.Author);
 }
 
 void GameController::PublishStats(std::chrono::steady_clock::time_point nowReal)
@@ -707,6 +1008,13 @@ void GameController::PublishStats(std::chrono::steady_clock::time_point nowReal)
         ? static_cast<float>(lastUpdateDurationNs.count()) / static_cast<float>(lastRenderDurationNs.count())
         : 0.0f;
 
+    // Calculate simulation speed multiplier, i.e. simulated time per real time
+
+    float const lastSimulationSpeedMultiplier =
+        lastElapsedReal.count() != 0.0f
+        ? static_cast<float>(mLastSimulationStepCount) * GameParameters::SimulationStepTimeDuration<float> / lastElapsedReal.count()
+        : 0.0f;
+
 
     // Publish frame rate
     assert(!!mGameEventDispatcher);
@@ -716,6 +1024,18 @@ void GameController::PublishStats(std::chrono::steady_clock::time_point nowReal)
     assert(!!mGameEventDispatcher);
     mGameEventDispatcher->OnUpdateToRenderRatioUpdated(lastURRatio);
 
+    // Publish frame times
+    assert(!!mGameEventDispatcher);
+    mGameEventDispatcher->OnFrameTimesUpdated(
+        mUpdateTimeHistogram.GetStatistics(),
+        mRenderTimeHistogram.GetStatistics(),
+        mFrameTimeHistogram.GetStatistics());
+
+    // Publish phase timings
+    auto const phaseStatistics = Profiler::GetInstance().GetStatistics();
+    assert(!!mGameEventDispatcher);
+    mGameEventDispatcher->OnPhaseTimingsUpdated(phaseStatistics);
+
     // Update status text
     assert(!!mTextLayer);
     mTextLayer->SetStatusText(
@@ -726,5 +1046,7 @@ void GameController::PublishStats(std::chrono::steady_clock::time_point nowReal)
         mRenderContext->GetZoom(),
         totalURRatio,
         lastURRatio,
-        mRenderContext->GetStatistics());
+        lastSimulationSpeedMultiplier,
+        mRenderContext->GetStatistics(),
+        phaseStatistics);
 }
\ No newline at end of file
@@ -11,10 +11,13 @@
 #include "Physics.h"
 #include "RenderContext.h"
 #include "ResourceLoader.h"
+#include "ShipBuildCache.h"
+#include "ShipDefinition.h"
 #include "ShipMetadata.h"
 #include "TextLayer.h"
 
 #include <GameCore/Colors.h>
+#include <GameCore/DurationHistogram.h>
 #include <GameCore/GameTypes.h>
 #include <GameCore/GameWallClock.h>
 #include <GameCore/ImageData.h>
@@ -23,14 +26,27 @@
 
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
+#include <exception>
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 
 /*
  * This class is responsible for managing the game, from its lifetime to the user
  * interactions.
+ *
+ * The simulation may either run on the calling thread, one step for each rendered frame,
+ * or on a thread of its own, at the fixed rate of one step every SimulationStepTimeDuration;
+ * in the latter case ships are rendered from the snapshots of their points published by
+ * the simulation, and events are delivered at each frame on the calling thread.
+ *
+ * When fast-forwarding, each frame - or each tick of the simulation thread - runs multiple
+ * simulation steps in a row, while rendering and delivering events only once.
  */
 class GameController
 {
@@ -39,10 +55,14 @@ public:
     static std::unique_ptr<GameController> Create(
         bool isStatusTextEnabled,
         bool isExtendedStatusTextEnabled,
+        bool isSimulationThreadEnabled,
         std::function<void()> swapRenderBuffersFunction,
         std::shared_ptr<ResourceLoader> resourceLoader,
+        std::optional<std::filesystem::path> const & shipBuildCacheFolderPath,
         ProgressCallback const & progressCallback);
 
+    ~GameController();
+
     std::shared_ptr<IGameEventHandler> GetGameEventHandler()
     {
         assert(!!mGameEventDispatcher);
@@ -73,6 +93,15 @@ public:
     void SetStatusTextEnabled(bool isEnabled);
     void SetExtendedStatusTextEnabled(bool isEnabled);
 
+    /*
+     * Runs up to maxStepCount simulation steps per frame, stopping earlier if the next step
+     * is not expected to fit in the frame budget; a zero budget means that all of the steps
+     * are run regardless. A step count of one - the default - means normal speed.
+     */
+    void SetFastForward(
+        size_t maxStepCount,
+        std::chrono::steady_clock::duration frameBudget);
+
     void MoveBy(ShipId shipId, vec2f const & screenOffset);
     void RotateBy(ShipId shipId, float screenDeltaY, vec2f const & screenCenter);
     void DestroyAt(vec2f const & screenCoordinates, float radiusMultiplier);
@@ -156,6 +185,8 @@ public:
 
     inline bool IsUnderwater(vec2f const & screenCoordinates) const
     {
+        std::lock_guard<std::mutex> const lock(mWorldMutex);
+
         return mWorld->IsUnderwater(ScreenToWorld(screenCoordinates));
     }
 
@@ -183,6 +214,20 @@ public:
     float GetMinSpringStrengthAdjustment() const { return GameParameters::MinSpringStrengthAdjustment;  }
     float GetMaxSpringStrengthAdjustment() const { return GameParameters::MaxSpringStrengthAdjustment; }
 
+    bool GetDoAdaptMechanicalDynamicsIterations() const { return mGameParameters.DoAdaptMechanicalDynamicsIterations; }
+    void SetDoAdaptMechanicalDynamicsIterations(bool value) { mGameParameters.DoAdaptMechanicalDynamicsIterations = value; }
+
+    bool GetDoVectorizeSpringForces() const { return mGameParameters.DoVectorizeSpringForces; }
+    void SetDoVectorizeSpringForces(bool value) { mGameParameters.DoVectorizeSpringForces = value; }
+
+    bool GetDoSleepSettledComponents() const { return mGameParameters.DoSleepSettledComponents; }
+    void SetDoSleepSettledComponents(bool value) { mGameParameters.DoSleepSettledComponents = value; }
+
+    size_t GetNumberOfSimulationThreads() const { return mGameParameters.NumberOfSimulationThreads; }
+    void SetNumberOfSimulationThreads(size_t value) { mGameParameters.NumberOfSimulationThreads = value; }
+    size_t GetMinNumberOfSimulationThreads() const { return GameParameters::MinNumberOfSimulationThreads; }
+    size_t GetMaxNumberOfSimulationThreads() const { return GameParameters::MaxNumberOfSimulationThreads; }
+
     float GetRotAcceler8r() const { return mGameParameters.RotAcceler8r; }
     void SetRotAcceler8r(float value) { mGameParameters.RotAcceler8r = value; }
     float GetMinRotAcceler8r() const { return GameParameters::MinRotAcceler8r; }
@@ -208,6 +253,9 @@ public:
     float GetMinWaterCrazyness() const { return GameParameters::MinWaterCrazyness; }
     float GetMaxWaterCrazyness() const { return GameParameters::MaxWaterCrazyness; }
 
+    bool GetDoPullWaterDiffusion() const { return mGameParameters.DoPullWaterDiffusion; }
+    void SetDoPullWaterDiffusion(bool value) { mGameParameters.DoPullWaterDiffusion = value; }
+
     float GetWaterDiffusionSpeedAdjustment() const { return mGameParameters.WaterDiffusionSpeedAdjustment; }
     void SetWaterDiffusionSpeedAdjustment(float value) { mGameParameters.WaterDiffusionSpeedAdjustment = value; }
     float GetMinWaterDiffusionSpeedAdjustment() const { return GameParameters::MinWaterDiffusionSpeedAdjustment; }
@@ -352,7 +400,7 @@ public:
     void SetFlatLandColor(rgbColor const & color) { mRenderContext->SetFlatLandColor(color); }
 
     VectorFieldRenderMode GetVectorFieldRenderMode() const { return mRenderContext->GetVectorFieldRenderMode(); }
-    void SetVectorFieldRenderMode(VectorFieldRenderMode VectorFieldRenderMode) { mRenderContext->SetVectorFieldRenderMode(VectorFieldRenderMode); }
+    void SetVectorFieldRenderMode(VectorFieldRenderMode VectorFieldRenderMode) { std::lock_guard<std::mutex> const lock(mWorldMutex); mRenderContext->SetVectorFieldRenderMode(VectorFieldRenderMode); }
 
     bool GetShowShipStress() const { return mRenderContext->GetShowStressedSprings(); }
     void SetShowShipStress(bool value) { mRenderContext->SetShowStressedSprings(value); }
@@ -365,11 +413,16 @@ private:
         std::unique_ptr<GameEventDispatcher> gameEventDispatcher,
         std::unique_ptr<TextLayer> textLayer,
         MaterialDatabase materialDatabase,
-        std::shared_ptr<ResourceLoader> resourceLoader)
+        std::unique_ptr<ShipBuildCache> shipBuildCache,
+        std::shared_ptr<ResourceLoader> resourceLoader,
+        bool isSimulationThreadEnabled)
         : mGameParameters()
         , mLastShipLoadedFilepath()
+        , mLastShipLoadedPristineState()
         , mIsPaused(false)
         , mIsMoveToolEngaged(false)
+        , mFastForwardMaxStepCount(1)
+        , mFastForwardFrameBudget(std::chrono::steady_clock::duration::zero())
         // Doers
         , mRenderContext(std::move(renderContext))
         , mSwapRenderBuffersFunction(std::move(swapRenderBuffersFunction))
@@ -381,6 +434,7 @@ private:
             mGameParameters,
             *mResourceLoader))
         , mMaterialDatabase(std::move(materialDatabase))
+        , mShipBuildCache(std::move(shipBuildCache))
          // Smoothing
         , mCurrentZoom(mRenderContext->GetZoom())
         , mTargetZoom(mCurrentZoom)
@@ -393,18 +447,47 @@ private:
         // Stats
         , mTotalFrameCount(0u)
         , mLastFrameCount(0u)
+        , mTotalSimulationStepCount(0u)
+        , mLastSimulationStepCount(0u)
         , mRenderStatsOriginTimestampReal(std::chrono::steady_clock::time_point::min())
         , mRenderStatsLastTimestampReal(std::chrono::steady_clock::time_point::min())
         , mTotalUpdateDuration(std::chrono::steady_clock::duration::zero())
         , mLastTotalUpdateDuration(std::chrono::steady_clock::duration::zero())
         , mTotalRenderDuration(std::chrono::steady_clock::duration::zero())
         , mLastTotalRenderDuration(std::chrono::steady_clock::duration::zero())
+        , mUpdateTimeHistogram(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(GameParameters::SimulationStepTimeDuration<float>)))
+        , mRenderTimeHistogram(FrameTimeBudget)
+        , mFrameTimeHistogram(FrameTimeBudget)
         , mOriginTimestampGame(GameWallClock::time_point::min())
         , mSkippedFirstStatPublishes(0)
+        // Simulation thread
+        , mIsSimulationThreadEnabled(isSimulationThreadEnabled)
+        , mWorldMutex()
+        , mRenderSnapshotMutex()
+        , mSimulationGameParameters(mGameParameters)
+        , mIsSimulationThreadStopRequested(false)
+        , mSimulationThreadException()
+        , mSimulationThreadSignal()
+        , mSimulationThread()
     {
+        if (mIsSimulationThreadEnabled)
+        {
+            // Events may now be generated on the simulation thread
+            mGameEventDispatcher->SetDeliveryDeferred(true);
+
+            mSimulationThread = std::thread(&GameController::RunSimulationThread, this);
+        }
     }
 
-    void InternalUpdate();
+    // Requires the world mutex
+    void InternalUpdate(
+        GameParameters const & gameParameters,
+        size_t maxStepCount);
+
+    // Requires the world mutex
+    void PublishRenderSnapshots();
+
+    void RunSimulationThread();
 
     void InternalRender();
 
@@ -414,13 +497,25 @@ private:
         float targetValue,
         std::chrono::steady_clock::time_point startingTime);
 
+    // Requires the world mutex
     void Reset(std::unique_ptr<Physics::World> newWorld);
 
+    // Requires the world mutex
     void OnShipAdded(
         ShipDefinition shipDefinition,
         std::filesystem::path const & shipDefinitionFilepath,
+        std::filesystem::file_time_type shipDefinitionLastWriteTime,
+        std::shared_ptr<Physics::ShipPristineState const> pristineState,
         ShipId shipId);
 
+    // Requires the world mutex
+    void OnShipAdded(
+        ShipId shipId,
+        RgbaImageData textureLayerImage,
+        ShipDefinition::TextureOriginType textureOrigin,
+        ShipMetadata const & shipMetadata);
+
+    // Requires the world mutex
     void PublishStats(std::chrono::steady_clock::time_point nowReal);
 
 private:
@@ -431,8 +526,37 @@ private:
 
     GameParameters mGameParameters;
     std::filesystem::path mLastShipLoadedFilepath;
+
+    /*
+     * What it takes to reload the last loaded ship without loading and building it again.
+     */
+    struct PristineShip
+    {
+        std::shared_ptr<Physics::ShipPristineState const> State;
+        std::filesystem::file_time_type DefinitionLastWriteTime;
+        RgbaImageData TextureLayerImage;
+        ShipDefinition::TextureOriginType TextureOrigin;
+        ShipMetadata const Metadata;
+
+        PristineShip(
+            std::shared_ptr<Physics::ShipPristineState const> state,
+            std::filesystem::file_time_type definitionLastWriteTime,
+            RgbaImageData textureLayerImage,
+            ShipDefinition::TextureOriginType textureOrigin,
+            ShipMetadata const & metadata)
+            : State(std::move(state))
+            , DefinitionLastWriteTime(definitionLastWriteTime)
+            , TextureLayerImage(std::move(textureLayerImage))
+            , TextureOrigin(textureOrigin)
+            , Metadata(metadata)
+        {}
+    };
+
+    std::unique_ptr<PristineShip> mLastShipLoadedPristineState;
     bool mIsPaused;
     bool mIsMoveToolEngaged;
+    size_t mFastForwardMaxStepCount;
+    std::chrono::steady_clock::duration mFastForwardFrameBudget;
 
 
     //
@@ -452,6 +576,9 @@ private:
     std::unique_ptr<Physics::World> mWorld;
     MaterialDatabase mMaterialDatabase;
 
+    // Optional
+    std::unique_ptr<ShipBuildCache> mShipBuildCache;
+
 
     //
     // The current render parameters that we're smoothing to
@@ -476,6 +603,8 @@ private:
 
     uint64_t mTotalFrameCount;
     uint64_t mLastFrameCount;
+    uint64_t mTotalSimulationStepCount;
+    uint64_t mLastSimulationStepCount;
     std::chrono::steady_clock::time_point mRenderStatsOriginTimestampReal;
     std::chrono::steady_clock::time_point mRenderStatsLastTimestampReal;
     std::chrono::steady_clock::duration mTotalUpdateDuration;
@@ -483,5 +612,44 @@ private:
     std::chrono::steady_clock::duration mTotalRenderDuration;
     std::chrono::steady_clock::duration mLastTotalRenderDuration;
     GameWallClock::time_point mOriginTimestampGame;
+
+    // Frames - and renders - longer than this miss a 60Hz refresh
+    static constexpr std::chrono::microseconds FrameTimeBudget = std::chrono::microseconds(16667);
+
+    // The durations of the single simulation steps - whose budget is the time they simulate -
+    // of the single renders, and of the whole frames (update + render), since the last publish
+    DurationHistogram mUpdateTimeHistogram;
+    DurationHistogram mRenderTimeHistogram;
+    DurationHistogram mFrameTimeHistogram;
     int mSkippedFirstStatPublishes;
+
+
+    //
+    // The simulation thread
+    //
+    // The world - together with the event dispatcher, the pause and fast-forward state,
+    // and the update stats - is guarded by the world mutex, regardless of whether or not
+    // the simulation runs on its own thread.
+    //
+    // The renderer never takes the world mutex: it renders from the render snapshots of
+    // the world, which are handed over and acquired under the render snapshot mutex - only
+    // held for the time of swapping their buffers
+    //
+
+    // The least time the simulation thread leaves the world to the others between steps
+    static constexpr std::chrono::milliseconds MinSimulationThreadIdleDuration = std::chrono::milliseconds(1);
+
+    bool const mIsSimulationThreadEnabled;
+
+    mutable std::mutex mWorldMutex;
+
+    std::mutex mRenderSnapshotMutex;
+
+    // The game parameters the simulation thread runs with; refreshed at each frame
+    GameParameters mSimulationGameParameters;
+
+    bool mIsSimulationThreadStopRequested;
+    std::exception_ptr mSimulationThreadException;
+    std::condition_variable mSimulationThreadSignal;
+    std::thread mSimulationThread;
 };
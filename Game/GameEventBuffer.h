@@ -0,0 +1,362 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2019-03-25
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "IGameEventHandler.h"
+
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/*
+ * A game event handler that sits in front of another handler and, while buffering,
+ * records events instead of forwarding them; the recorded events are forwarded later,
+ * in the order in which they were recorded, when buffering ends.
+ *
+ * Each ship gets its own buffer, so that ships may be updated in parallel while
+ * their events still reach the (non-thread-safe) target handler in a deterministic order.
+ * When not buffering, events are forwarded immediately.
+ */
+class GameEventBuffer : public IGameEventHandler
+{
+public:
+
+    explicit GameEventBuffer(std::shared_ptr<IGameEventHandler> target)
+        : mTarget(std::move(target))
+        , mIsBuffering(false)
+        , mBufferedEvents()
+    {
+        assert(!!mTarget);
+    }
+
+    void BeginBuffering()
+    {
+        assert(!mIsBuffering);
+        assert(mBufferedEvents.empty());
+
+        mIsBuffering = true;
+    }
+
+    /*
+     * Forwards all of the buffered events to the target and stops buffering.
+     */
+    void EndBuffering()
+    {
+        assert(mIsBuffering);
+
+        mIsBuffering = false;
+
+        for (auto const & event : mBufferedEvents)
+        {
+            event(*mTarget);
+        }
+
+        mBufferedEvents.clear();
+    }
+
+public:
+
+    virtual void OnGameReset() override
+    {
+        Publish(
+            [](IGameEventHandler & target)
+            {
+                target.OnGameReset();
+            });
+    }
+
+    virtual void OnShipLoaded(
+        unsigned int id,
+        std::string const & name,
+        std::optional<std::string> const & author) override
+    {
+        Publish(
+            [id, name, author](IGameEventHandler & target)
+            {
+                target.OnShipLoaded(id, name, author);
+            });
+    }
+
+    virtual void OnDestroy(
+        StructuralMaterial const & structuralMaterial,
+        bool isUnderwater,
+        unsigned int size) override
+    {
+        // Materials live in the material database, hence they outlive the buffer
+        StructuralMaterial const * const structuralMaterialPtr = &structuralMaterial;
+
+        Publish(
+            [structuralMaterialPtr, isUnderwater, size](IGameEventHandler & target)
+            {
+                target.OnDestroy(*structuralMaterialPtr, isUnderwater, size);
+            });
+    }
+
+    virtual void OnSawed(
+        bool isMetal,
+        unsigned int size) override
+    {
+        Publish(
+            [isMetal, size](IGameEventHandler & target)
+            {
+                target.OnSawed(isMetal, size);
+            });
+    }
+
+    virtual void OnPinToggled(
+        bool isPinned,
+        bool isUnderwater) override
+    {
+        Publish(
+            [isPinned, isUnderwater](IGameEventHandler & target)
+            {
+                target.OnPinToggled(isPinned, isUnderwater);
+            });
+    }
+
+    virtual void OnStress(
+        StructuralMaterial const & structuralMaterial,
+        bool isUnderwater,
+        unsigned int size) override
+    {
+        StructuralMaterial const * const structuralMaterialPtr = &structuralMaterial;
+
+        Publish(
+            [structuralMaterialPtr, isUnderwater, size](IGameEventHandler & target)
+            {
+                target.OnStress(*structuralMaterialPtr, isUnderwater, size);
+            });
+    }
+
+    virtual void OnBreak(
+        StructuralMaterial const & structuralMaterial,
+        bool isUnderwater,
+        unsigned int size) override
+    {
+        StructuralMaterial const * const structuralMaterialPtr = &structuralMaterial;
+
+        Publish(
+            [structuralMaterialPtr, isUnderwater, size](IGameEventHandler & target)
+            {
+                target.OnBreak(*structuralMaterialPtr, isUnderwater, size);
+            });
+    }
+
+    virtual void OnSinkingBegin(ShipId shipId) override
+    {
+        Publish(
+            [shipId](IGameEventHandler & target)
+            {
+                target.OnSinkingBegin(shipId);
+            });
+    }
+
+    virtual void OnLightFlicker(
+        DurationShortLongType duration,
+        bool isUnderwater,
+        unsigned int size) override
+    {
+        Publish(
+            [duration, isUnderwater, size](IGameEventHandler & target)
+            {
+                target.OnLightFlicker(duration, isUnderwater, size);
+            });
+    }
+
+    virtual void OnWaterTaken(float waterTaken) override
+    {
+        Publish(
+            [waterTaken](IGameEventHandler & target)
+            {
+                target.OnWaterTaken(waterTaken);
+            });
+    }
+
+    virtual void OnWaterSplashed(float waterSplashed) override
+    {
+        Publish(
+            [waterSplashed](IGameEventHandler & target)
+            {
+                target.OnWaterSplashed(waterSplashed);
+            });
+    }
+
+    virtual void OnWindSpeedUpdated(
+        float const zeroSpeedMagnitude,
+        float const baseSpeedMagnitude,
+        float const preMaxSpeedMagnitude,
+        float const maxSpeedMagnitude,
+        vec2f const & windSpeed) override
+    {
+        Publish(
+            [zeroSpeedMagnitude, baseSpeedMagnitude, preMaxSpeedMagnitude, maxSpeedMagnitude, windSpeed](IGameEventHandler & target)
+            {
+                target.OnWindSpeedUpdated(zeroSpeedMagnitude, baseSpeedMagnitude, preMaxSpeedMagnitude, maxSpeedMagnitude, windSpeed);
+            });
+    }
+
+    virtual void OnCustomProbe(
+        std::string const & name,
+        float value) override
+    {
+        Publish(
+            [name, value](IGameEventHandler & target)
+            {
+                target.OnCustomProbe(name, value);
+            });
+    }
+
+    virtual void OnFrameRateUpdated(
+        float immediateFps,
+        float averageFps) override
+    {
+        Publish(
+            [immediateFps, averageFps](IGameEventHandler & target)
+            {
+                target.OnFrameRateUpdated(immediateFps, averageFps);
+            });
+    }
+
+    virtual void OnUpdateToRenderRatioUpdated(
+        float immediateURRatio) override
+    {
+        Publish(
+            [immediateURRatio](IGameEventHandler & target)
+            {
+                target.OnUpdateToRenderRatioUpdated(immediateURRatio);
+            });
+    }
+
+    //
+    // Bombs
+    //
+
+    virtual void OnBombPlaced(
+        ObjectId bombId,
+        BombType bombType,
+        bool isUnderwater) override
+    {
+        Publish(
+            [bombId, bombType, isUnderwater](IGameEventHandler & target)
+            {
+                target.OnBombPlaced(bombId, bombType, isUnderwater);
+            });
+    }
+
+    virtual void OnBombRemoved(
+        ObjectId bombId,
+        BombType bombType,
+        std::optional<bool> isUnderwater) override
+    {
+        Publish(
+            [bombId, bombType, isUnderwater](IGameEventHandler & target)
+            {
+                target.OnBombRemoved(bombId, bombType, isUnderwater);
+            });
+    }
+
+    virtual void OnBombExplosion(
+        BombType bombType,
+        bool isUnderwater,
+        unsigned int size) override
+    {
+        Publish(
+            [bombType, isUnderwater, size](IGameEventHandler & target)
+            {
+                target.OnBombExplosion(bombType, isUnderwater, size);
+            });
+    }
+
+    virtual void OnRCBombPing(
+        bool isUnderwater,
+        unsigned int size) override
+    {
+        Publish(
+            [isUnderwater, size](IGameEventHandler & target)
+            {
+                target.OnRCBombPing(isUnderwater, size);
+            });
+    }
+
+    virtual void OnTimerBombFuse(
+        ObjectId bombId,
+        std::optional<bool> isFast) override
+    {
+        Publish(
+            [bombId, isFast](IGameEventHandler & target)
+            {
+                target.OnTimerBombFuse(bombId, isFast);
+            });
+    }
+
+    virtual void OnTimerBombDefused(
+        bool isUnderwater,
+        unsigned int size) override
+    {
+        Publish(
+            [isUnderwater, size](IGameEventHandler & target)
+            {
+                target.OnTimerBombDefused(isUnderwater, size);
+            });
+    }
+
+    virtual void OnAntiMatterBombContained(
+        ObjectId bombId,
+        bool isContained) override
+    {
+        Publish(
+            [bombId, isContained](IGameEventHandler & target)
+            {
+                target.OnAntiMatterBombContained(bombId, isContained);
+            });
+    }
+
+    virtual void OnAntiMatterBombPreImploding() override
+    {
+        Publish(
+            [](IGameEventHandler & target)
+            {
+                target.OnAntiMatterBombPreImploding();
+            });
+    }
+
+    virtual void OnAntiMatterBombImploding() override
+    {
+        Publish(
+            [](IGameEventHandler & target)
+            {
+                target.OnAntiMatterBombImploding();
+            });
+    }
+
+private:
+
+    using BufferedEvent = std::function<void(IGameEventHandler &)>;
+
+    template<typename TEvent>
+    void Publish(TEvent && event)
+    {
+        if (mIsBuffering)
+        {
+            mBufferedEvents.emplace_back(std::forward<TEvent>(event));
+        }
+        else
+        {
+            event(*mTarget);
+        }
+    }
+
+private:
+
+    std::shared_ptr<IGameEventHandler> mTarget;
+
+    bool mIsBuffering;
+
+    std::vector<BufferedEvent> mBufferedEvents;
+};
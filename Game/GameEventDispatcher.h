@@ -10,6 +10,7 @@
 #include <GameCore/TupleKeys.h>
 
 #include <algorithm>
+#include <functional>
 #include <optional>
 #include <vector>
 
@@ -25,6 +26,8 @@ public:
         , mBombExplosionEvents()
         , mRCBombPingEvents()
         , mTimerBombDefusedEvents()
+        , mIsDeliveryDeferred(false)
+        , mDeferredDeliveries()
         , mSinks()
     {
     }
@@ -34,10 +37,11 @@ public:
     virtual void OnGameReset() override
     {
         // No need to aggregate this one
-        for (auto sink : mSinks)
-        {
-            sink->OnGameReset();
-        }
+        Deliver(
+            [](IGameEventHandler * sink)
+            {
+                sink->OnGameReset();
+            });
     }
 
     virtual void OnShipLoaded(
@@ -46,10 +50,11 @@ public:
         std::optional<std::string> const & author) override
     {
         // No need to aggregate this one
-        for (auto sink : mSinks)
-        {
-            sink->OnShipLoaded(id, name, author);
-        }
+        Deliver(
+            [id, name, author](IGameEventHandler * sink)
+            {
+                sink->OnShipLoaded(id, name, author);
+            });
     }
 
     virtual void OnDestroy(
@@ -58,10 +63,11 @@ public:
         unsigned int size) override
     {
         // No need to aggregate this one
-        for (auto sink : mSinks)
-        {
-            sink->OnDestroy(structuralMaterial, isUnderwater, size);
-        }
+        Deliver(
+            [&structuralMaterial, isUnderwater, size](IGameEventHandler * sink)
+            {
+                sink->OnDestroy(structuralMaterial, isUnderwater, size);
+            });
     }
 
     virtual void OnSawed(
@@ -69,10 +75,11 @@ public:
         unsigned int size) override
     {
         // No need to aggregate this one
-        for (auto sink : mSinks)
-        {
-            sink->OnSawed(isMetal, size);
-        }
+        Deliver(
+            [isMetal, size](IGameEventHandler * sink)
+            {
+                sink->OnSawed(isMetal, size);
+            });
     }
 
     virtual void OnPinToggled(
@@ -80,10 +87,11 @@ public:
         bool isUnderwater) override
     {
         // No need to aggregate this one
-        for (auto sink : mSinks)
-        {
-            sink->OnPinToggled(isPinned, isUnderwater);
-        }
+        Deliver(
+            [isPinned, isUnderwater](IGameEventHandler * sink)
+            {
+                sink->OnPinToggled(isPinned, isUnderwater);
+            });
     }
 
     virtual void OnStress(
@@ -121,19 +129,21 @@ public:
     virtual void OnWaterTaken(float waterTaken) override
     {
         // No need to aggregate this one
-        for (auto sink : mSinks)
-        {
-            sink->OnWaterTaken(waterTaken);
-        }
+        Deliver(
+            [waterTaken](IGameEventHandler * sink)
+            {
+                sink->OnWaterTaken(waterTaken);
+            });
     }
 
     virtual void OnWaterSplashed(float waterSplashed) override
     {
         // No need to aggregate this one
-        for (auto sink : mSinks)
-        {
-            sink->OnWaterSplashed(waterSplashed);
-        }
+        Deliver(
+            [waterSplashed](IGameEventHandler * sink)
+            {
+                sink->OnWaterSplashed(waterSplashed);
+            });
     }
 
     virtual void OnWindSpeedUpdated(
@@ -144,15 +154,16 @@ public:
         vec2f const & windSpeed) override
     {
         // No need to aggregate this one
-        for (auto sink : mSinks)
-        {
-            sink->OnWindSpeedUpdated(
-                zeroSpeedMagnitude,
-                baseSpeedMagnitude,
-                preMaxSpeedMagnitude,
-                maxSpeedMagnitude,
-                windSpeed);
-        }
+        Deliver(
+            [zeroSpeedMagnitude, baseSpeedMagnitude, preMaxSpeedMagnitude, maxSpeedMagnitude, windSpeed](IGameEventHandler * sink)
+            {
+                sink->OnWindSpeedUpdated(
+                    zeroSpeedMagnitude,
+                    baseSpeedMagnitude,
+                    preMaxSpeedMagnitude,
+                    maxSpeedMagnitude,
+                    windSpeed);
+            });
     }
 
     virtual void OnCustomProbe(
@@ -160,12 +171,13 @@ public:
         float value) override
     {
         // No need to aggregate this one
-        for (auto sink : mSinks)
-        {
-            sink->OnCustomProbe(
-                name,
-                value);
-        }
+        Deliver(
+            [name, value](IGameEventHandler * sink)
+            {
+                sink->OnCustomProbe(
+                    name,
+                    value);
+            });
     }
 
     virtual void OnFrameRateUpdated(
@@ -173,23 +185,53 @@ public:
         float averageFps) override
     {
         // No need to aggregate this one
-        for (auto sink : mSinks)
-        {
-            sink->OnFrameRateUpdated(
-                immediateFps,
-                averageFps);
-        }
+        Deliver(
+            [immediateFps, averageFps](IGameEventHandler * sink)
+            {
+                sink->OnFrameRateUpdated(
+                    immediateFps,
+                    averageFps);
+            });
     }
 
     virtual void OnUpdateToRenderRatioUpdated(
         float immediateURRatio)
     {
         // No need to aggregate this one
-        for (auto sink : mSinks)
-        {
-            sink->OnUpdateToRenderRatioUpdated(
-                immediateURRatio);
-        }
+        Deliver(
+            [immediateURRatio](IGameEventHandler * sink)
+            {
+                sink->OnUpdateToRenderRatioUpdated(
+                    immediateURRatio);
+            });
+    }
+
+    virtual void OnFrameTimesUpdated(
+        DurationHistogram::Statistics const & updateTimes,
+        DurationHistogram::Statistics const & renderTimes,
+        DurationHistogram::Statistics const & frameTimes) override
+    {
+        // No need to aggregate this one
+        Deliver(
+            [updateTimes, renderTimes, frameTimes](IGameEventHandler * sink)
+            {
+                sink->OnFrameTimesUpdated(
+                    updateTimes,
+                    renderTimes,
+                    frameTimes);
+            });
+    }
+
+    virtual void OnPhaseTimingsUpdated(
+        std::vector<Profiler::PhaseStatistics> const & phaseStatistics) override
+    {
+        // No need to aggregate this one
+        Deliver(
+            [phaseStatistics](IGameEventHandler * sink)
+            {
+                sink->OnPhaseTimingsUpdated(
+                    phaseStatistics);
+            });
     }
 
     //
@@ -202,13 +244,14 @@ public:
         bool isUnderwater) override
     {
         // No need to aggregate this one
-        for (auto sink : mSinks)
-        {
-            sink->OnBombPlaced(
-                bombId,
-                bombType,
-                isUnderwater);
-        }
+        Deliver(
+            [bombId, bombType, isUnderwater](IGameEventHandler * sink)
+            {
+                sink->OnBombPlaced(
+                    bombId,
+                    bombType,
+                    isUnderwater);
+            });
     }
 
     virtual void OnBombRemoved(
@@ -217,13 +260,14 @@ public:
         std::optional<bool> isUnderwater) override
     {
         // No need to aggregate this one
-        for (auto sink : mSinks)
-        {
-            sink->OnBombRemoved(
-                bombId,
-                bombType,
-                isUnderwater);
-        }
+        Deliver(
+            [bombId, bombType, isUnderwater](IGameEventHandler * sink)
+            {
+                sink->OnBombRemoved(
+                    bombId,
+                    bombType,
+                    isUnderwater);
+            });
     }
 
     virtual void OnBombExplosion(
@@ -246,12 +290,13 @@ public:
         std::optional<bool> isFast)
     {
         // No need to aggregate this one
-        for (auto sink : mSinks)
-        {
-            sink->OnTimerBombFuse(
-                bombId,
-                isFast);
-        }
+        Deliver(
+            [bombId, isFast](IGameEventHandler * sink)
+            {
+                sink->OnTimerBombFuse(
+                    bombId,
+                    isFast);
+            });
     }
 
     virtual void OnTimerBombDefused(
@@ -266,39 +311,65 @@ public:
         bool isContained)
     {
         // No need to aggregate this one
-        for (auto sink : mSinks)
-        {
-            sink->OnAntiMatterBombContained(
-                bombId,
-                isContained);
-        }
+        Deliver(
+            [bombId, isContained](IGameEventHandler * sink)
+            {
+                sink->OnAntiMatterBombContained(
+                    bombId,
+                    isContained);
+            });
     }
 
     virtual void OnAntiMatterBombPreImploding()
     {
         // No need to aggregate this one
-        for (auto sink : mSinks)
-        {
-            sink->OnAntiMatterBombPreImploding();
-        }
+        Deliver(
+            [](IGameEventHandler * sink)
+            {
+                sink->OnAntiMatterBombPreImploding();
+            });
     }
 
     virtual void OnAntiMatterBombImploding()
     {
         // No need to aggregate this one
-        for (auto sink : mSinks)
-        {
-            sink->OnAntiMatterBombImploding();
-        }
+        Deliver(
+            [](IGameEventHandler * sink)
+            {
+                sink->OnAntiMatterBombImploding();
+            });
     }
 
 public:
 
+    /*
+     * When set, the events that are not aggregated are not delivered right away either;
+     * they are delivered - in order - at the next Flush(), before the aggregated ones. This
+     * way events are only delivered on the thread that flushes, regardless of the thread
+     * that generates them; however, the caller is responsible for serializing the
+     * generation of events with flushes.
+     */
+    void SetDeliveryDeferred(bool isDeferred)
+    {
+        mIsDeliveryDeferred = isDeferred;
+    }
+
     /*
      * Flushes all events aggregated so far and clears the state.
      */
     void Flush()
     {
+        // Deliver deferred events
+        for (auto const & delivery : mDeferredDeliveries)
+        {
+            for (IGameEventHandler * sink : mSinks)
+            {
+                delivery(sink);
+            }
+        }
+
+        mDeferredDeliveries.clear();
+
         // Publish aggregations
         for (IGameEventHandler * sink : mSinks)
         {
@@ -353,6 +424,26 @@ public:
         mSinks.push_back(sink);
     }
 
+private:
+
+    using Delivery = std::function<void(IGameEventHandler *)>;
+
+    template<typename TDelivery>
+    void Deliver(TDelivery && delivery)
+    {
+        if (mIsDeliveryDeferred)
+        {
+            mDeferredDeliveries.emplace_back(std::forward<TDelivery>(delivery));
+        }
+        else
+        {
+            for (IGameEventHandler * sink : mSinks)
+            {
+                delivery(sink);
+            }
+        }
+    }
+
 private:
 
     // The current events being aggregated
@@ -364,6 +455,10 @@ private:
     unordered_tuple_map<std::tuple<bool>, unsigned int> mRCBombPingEvents;
     unordered_tuple_map<std::tuple<bool>, unsigned int> mTimerBombDefusedEvents;
 
+    // The events that are waiting for the next flush to be delivered
+    bool mIsDeliveryDeferred;
+    std::vector<Delivery> mDeferredDeliveries;
+
     // The registered sinks
     std::vector<IGameEventHandler *> mSinks;
 };
@@ -7,12 +7,19 @@
 
 #include "GameParameters.h"
 
+#include <algorithm>
+#include <thread>
+
 GameParameters::GameParameters()
     // Dynamics
     : NumMechanicalDynamicsIterationsAdjustment(1.0f)
     , SpringStiffnessAdjustment(1.0f)
     , SpringDampingAdjustment(1.0f)
     , SpringStrengthAdjustment(1.0f)
+    , DoAdaptMechanicalDynamicsIterations(false)
+    , DoVectorizeSpringForces(true)
+    , DoSleepSettledComponents(false)
+    , NumberOfSimulationThreads(std::clamp(static_cast<size_t>(std::thread::hardware_concurrency()), MinNumberOfSimulationThreads, MaxNumberOfSimulationThreads))
     , RotAcceler8r(1.0f)
     // Water
     , WaterDensityAdjustment(1.0f)
@@ -20,6 +27,7 @@ GameParameters::GameParameters()
     , WaterIntakeAdjustment(1.0f)
     , WaterDiffusionSpeedAdjustment(1.0f)
     , WaterCrazyness(1.0f)
+    , DoPullWaterDiffusion(false)
     // Ephemeral particles
     , DoGenerateDebris(true)
     , DoGenerateSparkles(true)
@@ -108,6 +108,28 @@ struct GameParameters
     static constexpr float MinSpringStrengthAdjustment = 0.01f;
     static constexpr float MaxSpringStrengthAdjustment = 10.0f;
 
+    // When set, the number of mechanical iterations is lowered - down to a fraction of the
+    // configured number - while springs are barely strained, and brought back up as soon as
+    // they are not; otherwise, the configured number of iterations is always run
+    bool DoAdaptMechanicalDynamicsIterations;
+
+    // When set, springs forces are calculated with the vectorized kernel;
+    // otherwise, with the naive scalar loop
+    bool DoVectorizeSpringForces;
+
+    // When set, connected components that have come to rest on the sea floor are put to sleep,
+    // and skipped by the dynamics until something wakes them up.
+    // Off by default until the settle thresholds (see Ship) are tuned on the stock ships: a
+    // component put to sleep too eagerly freezes in mid-settling, which is visible, while one
+    // never put to sleep only costs time. The headless runner's --sleep option compares the two.
+    bool DoSleepSettledComponents;
+
+    // The number of threads - including the main thread - that the simulation may use;
+    // large ships split their mechanical dynamics among these threads
+    size_t NumberOfSimulationThreads;
+    static constexpr size_t MinNumberOfSimulationThreads = 1;
+    static constexpr size_t MaxNumberOfSimulationThreads = 32;
+
     static constexpr float GlobalDamp = 0.9996f; // // We've shipped 1.7.5 with 0.9997, but splinter springs used to dance for too long
 
     float RotAcceler8r;
@@ -140,6 +162,11 @@ struct GameParameters
     static constexpr float MinWaterCrazyness = 0.0f;
     static constexpr float MaxWaterCrazyness = 2.0f;
 
+    // When set, water is diffused in two phases that may be split among threads - points
+    // first calculate their outbound flows, and then gather their inbound ones; otherwise,
+    // each point pushes its water into its neighbors, one point at a time
+    bool DoPullWaterDiffusion;
+
     // Ephemeral particles
 
     static constexpr ElementCount MaxEphemeralParticles = 512;
@@ -7,9 +7,12 @@
 
 #include "Materials.h"
 
+#include <GameCore/DurationHistogram.h>
 #include <GameCore/GameTypes.h>
+#include <GameCore/Profiler.h>
 
 #include <optional>
+#include <vector>
 
 /*
  * This interface defines the methods that game event handlers must implement.
@@ -129,6 +132,20 @@ public:
         // Default-implemented
     }
 
+    virtual void OnFrameTimesUpdated(
+        DurationHistogram::Statistics const & /*updateTimes*/,
+        DurationHistogram::Statistics const & /*renderTimes*/,
+        DurationHistogram::Statistics const & /*frameTimes*/)
+    {
+        // Default-implemented
+    }
+
+    virtual void OnPhaseTimingsUpdated(
+        std::vector<Profiler::PhaseStatistics> const & /*phaseStatistics*/)
+    {
+        // Default-implemented
+    }
+
     //
     // Bombs
     //
@@ -80,17 +80,14 @@ bool ImpactBomb::Update(
     }
 }
 
-void ImpactBomb::Upload(
-    ShipId shipId,
-    Render::RenderContext & renderContext) const
+void ImpactBomb::Upload(RenderSnapshot & renderSnapshot) const
 {
     switch (mState)
     {
         case State::Idle:
         case State::TriggeringExplosion:
         {
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::ImpactBomb, 0),
                 GetPosition(),
@@ -107,8 +104,7 @@ void ImpactBomb::Upload(
             assert(mExplodingStepCounter >= 0);
             assert(mExplodingStepCounter < ExplosionStepsCount);
 
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::RcBombExplosion, mExplodingStepCounter), // Squat on RC bomb explosion
                 GetPosition(),
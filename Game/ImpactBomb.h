@@ -63,9 +63,7 @@ public:
         }
     }
 
-    virtual void Upload(
-        ShipId shipId,
-        Render::RenderContext & renderContext) const override;
+    virtual void Upload(RenderSnapshot & renderSnapshot) const override;
 
 private:
 
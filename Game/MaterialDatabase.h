@@ -9,6 +9,7 @@
 #include "ResourceLoader.h"
 
 #include <GameCore/Colors.h>
+#include <GameCore/ContentHasher.h>
 #include <GameCore/GameException.h>
 #include <GameCore/Utils.h>
 
@@ -16,8 +17,11 @@
 
 #include <cassert>
 #include <cstdint>
+#include <limits>
 #include <map>
+#include <memory>
 #include <optional>
+#include <vector>
 
 class MaterialDatabase
 {
@@ -31,6 +35,18 @@ private:
 
     static constexpr auto RopeUniqueMaterialIndex = static_cast<size_t>(StructuralMaterial::MaterialUniqueType::Rope);
 
+    /*
+     * The entries of the color index: the ordinals of the materials with a given color key,
+     * zero meaning no material.
+     */
+    struct MaterialOrdinals
+    {
+        uint8_t Structural;
+        uint8_t Electrical;
+    };
+
+    static constexpr size_t ColorIndexSize = 1 << 24;
+
 public:
 
     static MaterialDatabase Load(ResourceLoader const & resourceLoader)
@@ -160,14 +176,28 @@ public:
                     material));
         }
 
+        //
+        // Content hash, for detecting changes to the definitions
+        //
+
+        ContentHasher contentHasher;
+        contentHasher.Add(structuralMaterialsRoot.serialize());
+        contentHasher.Add(electricalMaterialsRoot.serialize());
+
         return MaterialDatabase(
             std::move(structuralMaterialsMap),
             std::move(electricalMaterialsMap),
-            uniqueStructuralMaterials);
+            uniqueStructuralMaterials,
+            contentHasher.GetHash());
     }
 
     StructuralMaterial const * FindStructuralMaterial(ColorKey const & colorKey) const
     {
+        if (!!mColorIndex)
+        {
+            return mStructuralMaterialsByOrdinal[mColorIndex[GetColorIndex(colorKey)].Structural];
+        }
+
         auto srchIt = mStructuralMaterialMap.find(colorKey);
         if (srchIt != mStructuralMaterialMap.end())
         {
@@ -192,6 +222,11 @@ public:
 
     ElectricalMaterial const * FindElectricalMaterial(ColorKey const & colorKey) const
     {
+        if (!!mColorIndex)
+        {
+            return mElectricalMaterialsByOrdinal[mColorIndex[GetColorIndex(colorKey)].Electrical];
+        }
+
         auto srchIt = mElectricalMaterialMap.find(colorKey);
         if (srchIt != mElectricalMaterialMap.end())
         {
@@ -202,6 +237,11 @@ public:
         return nullptr;
     }
 
+    auto const & GetElectricalMaterials() const
+    {
+        return mElectricalMaterialMap;
+    }
+
     StructuralMaterial const & GetUniqueStructuralMaterial(StructuralMaterial::MaterialUniqueType uniqueType) const
     {
         assert(static_cast<size_t>(uniqueType) < mUniqueStructuralMaterials.size());
@@ -220,19 +260,111 @@ public:
         return colorKey == mUniqueStructuralMaterials[static_cast<size_t>(uniqueType)].first;
     }
 
+    /*
+     * A hash of the material definitions, which changes whenever any definition changes.
+     */
+    uint64_t GetContentHash() const
+    {
+        return mContentHash;
+    }
+
 private:
 
+    friend class ShipBuildCacheTests;
+
     MaterialDatabase(
         std::map<ColorKey, StructuralMaterial> structuralMaterialMap,
         std::map<ColorKey, ElectricalMaterial> electricalMaterialMap,
-        UniqueMaterialsArray uniqueStructuralMaterials)
+        UniqueMaterialsArray uniqueStructuralMaterials,
+        uint64_t contentHash)
         : mStructuralMaterialMap(std::move(structuralMaterialMap))
         , mElectricalMaterialMap(std::move(electricalMaterialMap))
         , mUniqueStructuralMaterials(uniqueStructuralMaterials)
+        , mContentHash(contentHash)
+        , mColorIndex()
+        , mStructuralMaterialsByOrdinal()
+        , mElectricalMaterialsByOrdinal()
     {
+        MakeColorIndex();
+    }
+
+    static inline size_t GetColorIndex(ColorKey const & colorKey)
+    {
+        return (static_cast<size_t>(colorKey.r) << 16)
+            | (static_cast<size_t>(colorKey.g) << 8)
+            | static_cast<size_t>(colorKey.b);
+    }
+
+    /*
+     * Makes a table with an entry for each possible color key, so that finding the
+     * materials of a color key - which happens for each pixel of a ship's layers -
+     * takes a single memory access rather than a visit of the maps.
+     *
+     * The table is only made when the materials' ordinals fit its entries; otherwise,
+     * lookups fall back to the maps.
+     */
+    void MakeColorIndex()
+    {
+        constexpr size_t MaxOrdinalCount = static_cast<size_t>(std::numeric_limits<uint8_t>::max()) + 1;
+
+        // Structural ordinals are for no material, for rope endpoints, and for the materials;
+        // electrical ordinals are for no material and for the materials
+        if (mStructuralMaterialMap.size() + 2 > MaxOrdinalCount
+            || mElectricalMaterialMap.size() + 1 > MaxOrdinalCount)
+        {
+            return;
+        }
+
+        // Ordinal zero is for no material
+        mStructuralMaterialsByOrdinal.push_back(nullptr);
+        mElectricalMaterialsByOrdinal.push_back(nullptr);
+
+        mColorIndex = std::make_unique<MaterialOrdinals[]>(ColorIndexSize);
+
+        //
+        // Structural
+        //
+
+        // Rope endpoints first, as actual materials take precedence over them
+        {
+            ColorKey const & ropeColorKey = mUniqueStructuralMaterials[RopeUniqueMaterialIndex].first;
+
+            uint8_t const ropeOrdinal = static_cast<uint8_t>(mStructuralMaterialsByOrdinal.size());
+            mStructuralMaterialsByOrdinal.push_back(mUniqueStructuralMaterials[RopeUniqueMaterialIndex].second);
+
+            for (size_t g = (ropeColorKey.g & 0xF0); g <= (ropeColorKey.g | 0x0F); ++g)
+            {
+                for (size_t b = 0; b <= 0xFF; ++b)
+                {
+                    mColorIndex[(static_cast<size_t>(ropeColorKey.r) << 16) | (g << 8) | b].Structural = ropeOrdinal;
+                }
+            }
+        }
+
+        for (auto const & entry : mStructuralMaterialMap)
+        {
+            mColorIndex[GetColorIndex(entry.first)].Structural = static_cast<uint8_t>(mStructuralMaterialsByOrdinal.size());
+            mStructuralMaterialsByOrdinal.push_back(&(entry.second));
+        }
+
+        //
+        // Electrical
+        //
+
+        for (auto const & entry : mElectricalMaterialMap)
+        {
+            mColorIndex[GetColorIndex(entry.first)].Electrical = static_cast<uint8_t>(mElectricalMaterialsByOrdinal.size());
+            mElectricalMaterialsByOrdinal.push_back(&(entry.second));
+        }
     }
 
     std::map<ColorKey, StructuralMaterial> mStructuralMaterialMap;
     std::map<ColorKey, ElectricalMaterial> mElectricalMaterialMap;
     UniqueMaterialsArray mUniqueStructuralMaterials;
+    uint64_t mContentHash;
+
+    // The color index, when there's one
+    std::unique_ptr<MaterialOrdinals[]> mColorIndex;
+    std::vector<StructuralMaterial const *> mStructuralMaterialsByOrdinal;
+    std::vector<ElectricalMaterial const *> mElectricalMaterialsByOrdinal;
 };
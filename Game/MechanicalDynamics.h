@@ -0,0 +1,266 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2019-03-31
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <GameCore/Buffer.h>
+#include <GameCore/GameTypes.h>
+#include <GameCore/SysSpecifics.h>
+#include <GameCore/ThreadPool.h>
+#include <GameCore/Vectors.h>
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <vector>
+
+namespace Physics
+{
+
+/*
+ * Runs the iterations of the mechanical dynamics update of a ship, either serially or
+ * split among threads.
+ *
+ * When split, each partition owns a range of springs and a range of points: point forces
+ * are written directly into the force buffer, while the forces of a partition's springs -
+ * which may land on any point - are accumulated in the partition's private force buffer
+ * and merged into the force buffer once all partitions are done. The results differ from
+ * the serial ones only by the order in which forces are summed.
+ *
+ * The actual physics is left to the callbacks, which are invoked with ranges of elements,
+ * so that the iterations may be exercised on their own.
+ */
+class MechanicalDynamics
+{
+public:
+
+    MechanicalDynamics()
+        : mPartitions()
+    {}
+
+    MechanicalDynamics(MechanicalDynamics && other) = default;
+
+    size_t GetPartitionCount() const
+    {
+        return mPartitions.size();
+    }
+
+    /*
+     * Splits the points and the springs in the specified number of partitions - unless they
+     * are already split that way; with less than two partitions, the iterations run serially.
+     *
+     * Springs are split along their build order, which follows the tiling of the ship
+     * and hence keeps each partition's springs spatially close; boundaries are kept
+     * at multiples of the SIMD batch size so that vectorized batches are never split.
+     *
+     * Points are split evenly along their build order - which follows the springs - with
+     * boundaries at multiples of the vectorization word size; the last partition also
+     * covers the buffer's padding, so that integration still runs on whole buffers.
+     */
+    template<typename TAllocateForceBuffer>
+    void SetPartitionCount(
+        size_t partitionCount,
+        ElementCount pointBufferCount,
+        ElementCount springCount,
+        size_t springBatchSize,
+        TAllocateForceBuffer && allocateForceBuffer)
+    {
+        if (partitionCount <= 1)
+        {
+            mPartitions.clear();
+            return;
+        }
+
+        if (partitionCount == mPartitions.size())
+        {
+            return;
+        }
+
+        mPartitions.clear();
+
+        auto const makeBoundary = [partitionCount](size_t p, size_t count, size_t alignment)
+        {
+            if (p == partitionCount)
+                return count;
+            else
+                return ((count * p / partitionCount) / alignment) * alignment;
+        };
+
+        for (size_t p = 0; p < partitionCount; ++p)
+        {
+            std::shared_ptr<Buffer<vec2f>> springForceBuffer = allocateForceBuffer();
+            springForceBuffer->fill(vec2f::zero());
+
+            mPartitions.emplace_back(
+                static_cast<ElementIndex>(makeBoundary(p, pointBufferCount, VectorizationWordSize)),
+                static_cast<ElementIndex>(makeBoundary(p + 1, pointBufferCount, VectorizationWordSize)),
+                static_cast<ElementIndex>(makeBoundary(p, springCount, springBatchSize)),
+                static_cast<ElementIndex>(makeBoundary(p + 1, springCount, springBatchSize)),
+                std::move(springForceBuffer));
+        }
+    }
+
+    /*
+     * Runs the specified number of iterations, each one made of:
+     *  - onIterationStart(iteration)
+     *  - updatePointForces(startPointIndex, endPointIndex), over the points
+     *  - updateSpringForces(startSpringIndex, endSpringIndex, forceBuffer), over the springs
+     *  - onForcesUpdated(iteration), once the force buffer holds all forces
+     *  - integrate(startPointIndex, endPointIndex), over the whole point buffer, padding
+     *    included; it's also expected to reset the forces to zero
+     */
+    template<
+        typename TOnIterationStart,
+        typename TUpdatePointForces,
+        typename TUpdateSpringForces,
+        typename TOnForcesUpdated,
+        typename TIntegrate>
+    void RunIterations(
+        int iterationCount,
+        ElementCount pointCount,
+        ElementCount pointBufferCount,
+        ElementCount springCount,
+        vec2f * restrict forceBuffer,
+        ThreadPool & threadPool,
+        TOnIterationStart && onIterationStart,
+        TUpdatePointForces && updatePointForces,
+        TUpdateSpringForces && updateSpringForces,
+        TOnForcesUpdated && onForcesUpdated,
+        TIntegrate && integrate)
+    {
+        //
+        // Prepare tasks, if we're running in parallel
+        //
+
+        std::vector<ThreadPool::Task> updateForcesTasks;
+        std::vector<ThreadPool::Task> mergeForcesTasks;
+        std::vector<ThreadPool::Task> integrateTasks;
+
+        for (auto const & partition : mPartitions)
+        {
+            updateForcesTasks.emplace_back(
+                [&partition, pointCount, &updatePointForces, &updateSpringForces]()
+                {
+                    updatePointForces(
+                        partition.StartPointIndex,
+                        std::min(partition.EndPointIndex, pointCount));
+
+                    updateSpringForces(
+                        partition.StartSpringIndex,
+                        partition.EndSpringIndex,
+                        partition.SpringForceBuffer->data());
+                });
+
+            mergeForcesTasks.emplace_back(
+                [this, &partition, forceBuffer]()
+                {
+                    MergeSpringForces(
+                        partition.StartPointIndex,
+                        partition.EndPointIndex,
+                        forceBuffer);
+                });
+
+            integrateTasks.emplace_back(
+                [&partition, &integrate]()
+                {
+                    integrate(
+                        partition.StartPointIndex,
+                        partition.EndPointIndex);
+                });
+        }
+
+        //
+        // Run iterations
+        //
+
+        for (int iter = 0; iter < iterationCount; ++iter)
+        {
+            onIterationStart(iter);
+
+            if (mPartitions.empty())
+            {
+                updatePointForces(0, pointCount);
+
+                updateSpringForces(0, springCount, forceBuffer);
+            }
+            else
+            {
+                // Update point and spring forces
+                threadPool.Run(updateForcesTasks);
+
+                // Merge spring forces into point forces
+                threadPool.Run(mergeForcesTasks);
+            }
+
+            onForcesUpdated(iter);
+
+            if (mPartitions.empty())
+            {
+                integrate(0, pointBufferCount);
+            }
+            else
+            {
+                threadPool.Run(integrateTasks);
+            }
+        }
+    }
+
+private:
+
+    void MergeSpringForces(
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex,
+        vec2f * restrict forceBuffer)
+    {
+        float * restrict const forceBufferData = reinterpret_cast<float *>(forceBuffer);
+
+        for (auto const & partition : mPartitions)
+        {
+            float * restrict springForceBuffer = reinterpret_cast<float *>(partition.SpringForceBuffer->data());
+
+            for (size_t i = startPointIndex * 2; i < endPointIndex * 2; ++i)
+            {
+                forceBufferData[i] += springForceBuffer[i];
+
+                // Zero out now that we've merged it
+                springForceBuffer[i] = 0.0f;
+            }
+        }
+    }
+
+private:
+
+    /*
+     * A slice of the ship that is processed by a single thread.
+     */
+    struct Partition
+    {
+        ElementIndex StartPointIndex;
+        ElementIndex EndPointIndex;
+        ElementIndex StartSpringIndex;
+        ElementIndex EndSpringIndex;
+
+        // Where the forces of this partition's springs are accumulated, to be merged
+        // into the points' force buffer once all partitions are done
+        std::shared_ptr<Buffer<vec2f>> SpringForceBuffer;
+
+        Partition(
+            ElementIndex startPointIndex,
+            ElementIndex endPointIndex,
+            ElementIndex startSpringIndex,
+            ElementIndex endSpringIndex,
+            std::shared_ptr<Buffer<vec2f>> springForceBuffer)
+            : StartPointIndex(startPointIndex)
+            , EndPointIndex(endPointIndex)
+            , StartSpringIndex(startSpringIndex)
+            , EndSpringIndex(endSpringIndex)
+            , SpringForceBuffer(std::move(springForceBuffer))
+        {}
+    };
+
+    std::vector<Partition> mPartitions;
+};
+
+}
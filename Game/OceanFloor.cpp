@@ -5,6 +5,8 @@
 ***************************************************************************************/
 #include "Physics.h"
 
+#include "PeriodicSamples.h"
+
 namespace Physics {
 
 OceanFloor::OceanFloor(ResourceLoader & resourceLoader)
@@ -145,4 +147,17 @@ void OceanFloor::Update(GameParameters const & gameParameters)
     }
 }
 
-}
\ No newline at end of file
+void OceanFloor::GetFloorHeightsAt(
+    vec2f const * restrict positions,
+    float * restrict heights,
+    size_t count) const
+{
+    SamplePeriodicHeightsAt<SamplesCount>(
+        mSamples.get(),
+        Dx,
+        positions,
+        heights,
+        count);
+}
+
+}
@@ -9,9 +9,12 @@
 
 #include "GameParameters.h"
 #include "ImageFileTools.h"
+#include "PeriodicSamples.h"
 #include "ResourceLoader.h"
 
 #include <GameCore/GameMath.h>
+#include <GameCore/SysSpecifics.h>
+#include <GameCore/Vectors.h>
 
 #include <memory>
 
@@ -63,6 +66,25 @@ public:
             + mSamples[sampleIndexI].SampleValuePlusOneMinusSampleValue * sampleIndexDx;
     }
 
+    /*
+     * Samples the height of the ocean floor at the x coordinates of the specified positions,
+     * storing the results in the specified height buffer; equivalent to - but faster than -
+     * invoking GetFloorHeightAt() for each position.
+     */
+    void GetFloorHeightsAt(
+        vec2f const * restrict positions,
+        float * restrict heights,
+        size_t count) const;
+
+    /*
+     * Copies the samples of the ocean floor, so that its height may be sampled
+     * without it - e.g. by the renderer.
+     */
+    void CopySamplesTo(PeriodicSamplesCopy & samples) const
+    {
+        samples.CopyFrom(mSamples.get(), SamplesCount, Dx);
+    }
+
 private:
 
     // Frequencies of the wave components
@@ -0,0 +1,157 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2019-03-25
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <GameCore/SysSpecifics.h>
+#include <GameCore/Vectors.h>
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <emmintrin.h>
+
+namespace Physics
+{
+
+/*
+ * Samples a periodic height function - stored as a table of samples, each one with its
+ * value and the delta to the next sample, the last one wrapping around to the first -
+ * at the x coordinates of the specified positions, storing the results in the specified
+ * height buffer.
+ *
+ * Equivalent to linearly interpolating the table at each x, but four positions at a time
+ * and without branches: we calculate the floor of the fractional index - rather than its
+ * truncation - so that the wrap-around of negative indices is just a mask.
+ *
+ * The sample lookup itself is still done one position at a time, as there's no
+ * gather in SSE2.
+ */
+template<int64_t SamplesCount, typename TSample>
+inline void SamplePeriodicHeightsAt(
+    TSample const * restrict samples,
+    float dx,
+    vec2f const * restrict positions,
+    float * restrict heights,
+    size_t count)
+{
+    static_assert(0 == (SamplesCount & (SamplesCount - 1)), "SamplesCount is a power of two");
+
+    __m128 const dx_4 = _mm_set1_ps(dx);
+    __m128i const sampleIndexMask_4 = _mm_set1_epi32(static_cast<int32_t>(SamplesCount - 1));
+
+    alignas(16) int32_t sampleIndices[4];
+    alignas(16) float sampleIndexDxs[4];
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // x0 y0 x1 y1 | x2 y2 x3 y3 -> x0 x1 x2 x3
+        __m128 const p01 = _mm_loadu_ps(reinterpret_cast<float const *>(positions + i));
+        __m128 const p23 = _mm_loadu_ps(reinterpret_cast<float const *>(positions + i + 2));
+        __m128 const x_4 = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0));
+
+        // Fractional absolute index in the (infinite) sample array
+        __m128 const absoluteSampleIndexF_4 = _mm_div_ps(x_4, dx_4);
+
+        // Floor: truncate, and then subtract one where truncation went up
+        __m128i absoluteSampleIndexI_4 = _mm_cvttps_epi32(absoluteSampleIndexF_4);
+        __m128 const truncatedF_4 = _mm_cvtepi32_ps(absoluteSampleIndexI_4);
+        __m128 const isTruncationAbove_4 = _mm_cmpgt_ps(truncatedF_4, absoluteSampleIndexF_4);
+        absoluteSampleIndexI_4 = _mm_add_epi32(absoluteSampleIndexI_4, _mm_castps_si128(isTruncationAbove_4)); // -1 where true
+        __m128 const flooredF_4 = _mm_cvtepi32_ps(absoluteSampleIndexI_4);
+
+        _mm_store_si128(
+            reinterpret_cast<__m128i *>(sampleIndices),
+            _mm_and_si128(absoluteSampleIndexI_4, sampleIndexMask_4));
+
+        _mm_store_ps(
+            sampleIndexDxs,
+            _mm_sub_ps(absoluteSampleIndexF_4, flooredF_4));
+
+        for (size_t j = 0; j < 4; ++j)
+        {
+            assert(sampleIndices[j] >= 0 && sampleIndices[j] < SamplesCount);
+            assert(sampleIndexDxs[j] >= 0.0f && sampleIndexDxs[j] <= 1.0f);
+
+            heights[i + j] =
+                samples[sampleIndices[j]].SampleValue
+                + samples[sampleIndices[j]].SampleValuePlusOneMinusSampleValue * sampleIndexDxs[j];
+        }
+    }
+
+    // Leftovers, same as above one at a time
+    for (; i < count; ++i)
+    {
+        float const absoluteSampleIndexF = positions[i].x / dx;
+        float const flooredF = std::floor(absoluteSampleIndexF);
+        int32_t const sampleIndex = static_cast<int32_t>(flooredF) & static_cast<int32_t>(SamplesCount - 1);
+        float const sampleIndexDx = absoluteSampleIndexF - flooredF;
+
+        assert(sampleIndex >= 0 && sampleIndex < SamplesCount);
+        assert(sampleIndexDx >= 0.0f && sampleIndexDx <= 1.0f);
+
+        heights[i] =
+            samples[sampleIndex].SampleValue
+            + samples[sampleIndex].SampleValuePlusOneMinusSampleValue * sampleIndexDx;
+    }
+}
+
+/*
+ * A copy of the table of samples of a periodic height function, which may be sampled
+ * away from the function itself - e.g. by the renderer, while the function keeps changing.
+ */
+struct PeriodicSamplesCopy
+{
+    struct Sample
+    {
+        float SampleValue;
+        float SampleValuePlusOneMinusSampleValue;
+    };
+
+    std::vector<Sample> Samples;
+    float Dx;
+
+    PeriodicSamplesCopy()
+        : Samples()
+        , Dx(1.0f)
+    {}
+
+    template<typename TSample>
+    void CopyFrom(
+        TSample const * samples,
+        size_t samplesCount,
+        float dx)
+    {
+        assert(0 == (samplesCount & (samplesCount - 1)));
+
+        Samples.resize(samplesCount);
+        for (size_t s = 0; s < samplesCount; ++s)
+        {
+            Samples[s].SampleValue = samples[s].SampleValue;
+            Samples[s].SampleValuePlusOneMinusSampleValue = samples[s].SampleValuePlusOneMinusSampleValue;
+        }
+
+        Dx = dx;
+    }
+
+    float GetHeightAt(float x) const
+    {
+        assert(!Samples.empty());
+
+        // Same as the leftovers of SamplePeriodicHeightsAt()
+        float const absoluteSampleIndexF = x / Dx;
+        float const flooredF = std::floor(absoluteSampleIndexF);
+        int64_t const sampleIndex = static_cast<int64_t>(flooredF) & static_cast<int64_t>(Samples.size() - 1);
+        float const sampleIndexDx = absoluteSampleIndexF - flooredF;
+
+        return Samples[sampleIndex].SampleValue
+            + Samples[sampleIndex].SampleValuePlusOneMinusSampleValue * sampleIndexDx;
+    }
+};
+
+}
@@ -12,11 +12,16 @@ namespace Physics
     class ElectricalElements;
     class OceanFloor;
     class PinnedPoints;
+    class PointGrid;
 	class Points;
+    class RenderSnapshot;
 	class Ship;
+    class ShipPristineState;
 	class Springs;
+    class SpringBvh;
     class Stars;
 	class Triangles;
+    class WaterDiffusion;
     class WaterSurface;
     class Wind;
 	class World;
@@ -45,5 +50,12 @@ namespace Physics
 
 #include "ForceFields.h"
 #include "PinnedPoints.h"
+#include "ConnectivityVisit.h"
+#include "MechanicalDynamics.h"
+#include "PointGrid.h"
+#include "RenderSnapshot.h"
+#include "ShipPristineState.h"
+#include "SpringBvh.h"
+#include "WaterDiffusion.h"
 
 #include "Ship.h"
@@ -36,7 +36,7 @@ void PinnedPoints::OnSpringDestroyed(ElementIndex springElementIndex)
     auto const pointBIndex = mShipSprings.GetPointBIndex(springElementIndex);
 
     if (mShipPoints.IsPinned(pointAIndex)
-        && mShipPoints.GetConnectedSprings(pointAIndex).ConnectedSprings.empty())
+        && mShipPoints.GetConnectedSprings(pointAIndex).empty())
     {
         // Unpin it
         mShipPoints.Unpin(pointAIndex);
@@ -46,7 +46,7 @@ void PinnedPoints::OnSpringDestroyed(ElementIndex springElementIndex)
     }
 
     if (mShipPoints.IsPinned(pointBIndex)
-        && mShipPoints.GetConnectedSprings(pointBIndex).ConnectedSprings.empty())
+        && mShipPoints.GetConnectedSprings(pointBIndex).empty())
     {
         // Unpin it
         mShipPoints.Unpin(pointBIndex);
@@ -56,17 +56,14 @@ void PinnedPoints::OnSpringDestroyed(ElementIndex springElementIndex)
     }
 }
 
-void PinnedPoints::Upload(
-    ShipId shipId,
-    Render::RenderContext & renderContext) const
+void PinnedPoints::Upload(RenderSnapshot & renderSnapshot) const
 {
     for (auto pinnedPointIndex : mCurrentPinnedPoints)
     {
         assert(!mShipPoints.IsDeleted(pinnedPointIndex));
         assert(mShipPoints.IsPinned(pinnedPointIndex));
 
-        renderContext.UploadShipGenericTextureRenderSpecification(
-            shipId,
+        renderSnapshot.UploadGenericTextureRenderSpecification(
             mShipPoints.GetPlaneId(pinnedPointIndex),
             TextureFrameId(TextureGroupType::PinnedPoint, 0),
             mShipPoints.GetPosition(pinnedPointIndex));
@@ -8,7 +8,7 @@
 #include "GameParameters.h"
 #include "IGameEventHandler.h"
 #include "Physics.h"
-#include "RenderContext.h"
+#include "RenderSnapshot.h"
 
 #include <GameCore/CircularList.h>
 #include <GameCore/Vectors.h>
@@ -145,9 +145,7 @@ public:
     // Render
     //
 
-    void Upload(
-        ShipId shipId,
-        Render::RenderContext & renderContext) const;
+    void Upload(RenderSnapshot & renderSnapshot) const;
 
 private:
 
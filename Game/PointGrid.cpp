@@ -0,0 +1,152 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2019-03-26
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "Physics.h"
+
+namespace Physics {
+
+PointGrid::PointGrid()
+    : mIsValid(false)
+    , mIsInUse(false)
+    , mOrigin(vec2f::zero())
+    , mInverseCellSize(1.0f / DefaultCellSize)
+    , mWidth(1)
+    , mHeight(1)
+    , mCellStarts()
+    , mPointIndices()
+    , mPointCells()
+{
+}
+
+void PointGrid::Rebuild(Points const & points)
+{
+    //
+    // Counting sort of the points by cell
+    //
+
+    mPointIndices.clear();
+    mPointCells.clear();
+
+    // Calculate extent of the points
+    vec2f minPosition(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+    vec2f maxPosition(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
+    size_t pointCount = 0;
+    for (auto pointIndex : points)
+    {
+        if (!points.IsDeleted(pointIndex))
+        {
+            vec2f const & position = points.GetPosition(pointIndex);
+            minPosition.x = std::min(minPosition.x, position.x);
+            minPosition.y = std::min(minPosition.y, position.y);
+            maxPosition.x = std::max(maxPosition.x, position.x);
+            maxPosition.y = std::max(maxPosition.y, position.y);
+
+            ++pointCount;
+        }
+    }
+
+    if (0 == pointCount)
+    {
+        mOrigin = vec2f::zero();
+        mWidth = 1;
+        mHeight = 1;
+        mCellStarts.assign(2, 0);
+    }
+    else
+    {
+        // Choose cell size, making cells larger if points are too sparse
+        float const extentWidth = maxPosition.x - minPosition.x;
+        float const extentHeight = maxPosition.y - minPosition.y;
+        float const maxCellCount = static_cast<float>(std::max(size_t(1024), pointCount * MaxCellsPerPoint));
+        float const cellSize = std::max(
+            DefaultCellSize,
+            std::sqrt((extentWidth + DefaultCellSize) * (extentHeight + DefaultCellSize) / maxCellCount));
+
+        mOrigin = minPosition;
+        mInverseCellSize = 1.0f / cellSize;
+        mWidth = static_cast<int32_t>(extentWidth * mInverseCellSize) + 1;
+        mHeight = static_cast<int32_t>(extentHeight * mInverseCellSize) + 1;
+
+        size_t const cellCount = static_cast<size_t>(mWidth) * static_cast<size_t>(mHeight);
+
+        // Count points per cell
+        mCellStarts.assign(cellCount + 1, 0);
+        for (auto pointIndex : points)
+        {
+            if (!points.IsDeleted(pointIndex))
+            {
+                vec2f const & position = points.GetPosition(pointIndex);
+
+                uint32_t const cell = static_cast<uint32_t>(ToCellY(position.y)) * static_cast<uint32_t>(mWidth)
+                    + static_cast<uint32_t>(ToCellX(position.x));
+
+                mPointCells.push_back(cell);
+
+                ++(mCellStarts[cell + 1]);
+            }
+        }
+
+        // Prefix sum
+        for (size_t c = 1; c <= cellCount; ++c)
+        {
+            mCellStarts[c] += mCellStarts[c - 1];
+        }
+
+        // Scatter points, using cell starts as insertion cursors - which leaves each cell start
+        // at the start of the next cell
+        mPointIndices.resize(pointCount);
+        size_t p = 0;
+        for (auto pointIndex : points)
+        {
+            if (!points.IsDeleted(pointIndex))
+            {
+                mPointIndices[mCellStarts[mPointCells[p]]++] = pointIndex;
+                ++p;
+            }
+        }
+
+        assert(p == pointCount);
+
+        // Shift cell starts back
+        for (size_t c = cellCount; c > 0; --c)
+        {
+            mCellStarts[c] = mCellStarts[c - 1];
+        }
+
+        mCellStarts[0] = 0;
+    }
+
+    assert(mCellStarts.back() == mPointIndices.size());
+
+    mIsValid = true;
+    mIsInUse = false;
+}
+
+ElementIndex PointGrid::FindNearestPointInRadius(
+    vec2f const & center,
+    float radius,
+    Points const & points) const
+{
+    ElementIndex bestPointIndex = NoneElementIndex;
+    float bestSquareDistance = std::numeric_limits<float>::max();
+
+    VisitPointsInRadius(
+        center,
+        radius,
+        points,
+        [&](ElementIndex pointIndex, float squareDistance)
+        {
+            if (squareDistance < bestSquareDistance
+                && !points.IsDeleted(pointIndex))
+            {
+                bestPointIndex = pointIndex;
+                bestSquareDistance = squareDistance;
+            }
+        });
+
+    return bestPointIndex;
+}
+
+}
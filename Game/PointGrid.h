@@ -0,0 +1,176 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2019-03-26
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "Physics.h"
+
+#include <GameCore/AABB.h>
+#include <GameCore/GameTypes.h>
+#include <GameCore/Vectors.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Physics
+{
+
+/*
+ * A uniform grid over the positions of the (non-deleted) points of a ship,
+ * for answering spatial queries in time proportional to the queried area
+ * rather than to the number of points.
+ *
+ * The grid is a snapshot of the positions as of the last Rebuild(); points that have
+ * moved since then are still found at their old cells, hence it is up to the owner
+ * to rebuild the grid when the points move. The queries themselves always test the
+ * current positions of the points.
+ */
+class PointGrid
+{
+public:
+
+    PointGrid();
+
+    PointGrid(PointGrid && other) = default;
+
+    bool IsValid() const
+    {
+        return mIsValid;
+    }
+
+    void Invalidate()
+    {
+        mIsValid = false;
+    }
+
+    /*
+     * Whether the grid has been queried since the last rebuild.
+     */
+    bool IsInUse() const
+    {
+        return mIsInUse;
+    }
+
+    void Rebuild(Points const & points);
+
+    /*
+     * Invokes the visitor with the index of each point whose grid cell intersects
+     * the specified box; the points are not otherwise tested.
+     */
+    template<typename TVisitor>
+    void VisitPointsInBox(
+        Geometry::AABB const & box,
+        TVisitor && visitor) const
+    {
+        assert(mIsValid);
+
+        mIsInUse = true;
+
+        if (mPointIndices.empty())
+            return;
+
+        int32_t const minCellX = ToCellX(box.BottomLeft.x);
+        int32_t const maxCellX = ToCellX(box.TopRight.x);
+        int32_t const minCellY = ToCellY(box.BottomLeft.y);
+        int32_t const maxCellY = ToCellY(box.TopRight.y);
+
+        for (int32_t cellY = minCellY; cellY <= maxCellY; ++cellY)
+        {
+            size_t const rowStart = static_cast<size_t>(cellY) * mWidth;
+
+            // Cells of a row are contiguous, and so are their points
+            ElementIndex const start = mCellStarts[rowStart + minCellX];
+            ElementIndex const end = mCellStarts[rowStart + maxCellX + 1];
+
+            for (ElementIndex i = start; i < end; ++i)
+            {
+                visitor(mPointIndices[i]);
+            }
+        }
+    }
+
+    /*
+     * Invokes the visitor with the index and the square distance of each point
+     * currently strictly within the specified radius.
+     */
+    template<typename TVisitor>
+    void VisitPointsInRadius(
+        vec2f const & center,
+        float radius,
+        Points const & points,
+        TVisitor && visitor) const
+    {
+        float const squareRadius = radius * radius;
+
+        VisitPointsInBox(
+            Geometry::AABB(
+                center.x - radius,
+                center.x + radius,
+                center.y + radius,
+                center.y - radius),
+            [&](ElementIndex pointIndex)
+            {
+                float const squareDistance = (points.GetPosition(pointIndex) - center).squareLength();
+                if (squareDistance < squareRadius)
+                {
+                    visitor(pointIndex, squareDistance);
+                }
+            });
+    }
+
+    /*
+     * Returns the nearest non-deleted point currently strictly within the specified radius,
+     * or NoneElementIndex if there's none.
+     */
+    ElementIndex FindNearestPointInRadius(
+        vec2f const & center,
+        float radius,
+        Points const & points) const;
+
+private:
+
+    // The default size of the side of a cell, in world units
+    static constexpr float DefaultCellSize = 2.0f;
+
+    // Cells are made larger when the points are so sparse that we would end up
+    // with more than this number of cells per point
+    static constexpr size_t MaxCellsPerPoint = 4;
+
+    inline int32_t ToCellX(float x) const
+    {
+        float const cellX = std::floor((x - mOrigin.x) * mInverseCellSize);
+        return static_cast<int32_t>(std::clamp(cellX, 0.0f, static_cast<float>(mWidth - 1)));
+    }
+
+    inline int32_t ToCellY(float y) const
+    {
+        float const cellY = std::floor((y - mOrigin.y) * mInverseCellSize);
+        return static_cast<int32_t>(std::clamp(cellY, 0.0f, static_cast<float>(mHeight - 1)));
+    }
+
+private:
+
+    bool mIsValid;
+    mutable bool mIsInUse;
+
+    vec2f mOrigin; // Bottom-left corner of cell (0, 0)
+    float mInverseCellSize;
+    int32_t mWidth;
+    int32_t mHeight;
+
+    // The points of cell c are mPointIndices[mCellStarts[c], mCellStarts[c + 1]);
+    // cells are stored row by row
+    std::vector<ElementIndex> mCellStarts;
+    std::vector<ElementIndex> mPointIndices;
+
+    // Scratch buffer with the cell of each point, only used while rebuilding
+    std::vector<uint32_t> mPointCells;
+};
+
+}
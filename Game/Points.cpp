@@ -8,6 +8,7 @@
 #include <GameCore/GameRandomEngine.h>
 #include <GameCore/Log.h>
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
@@ -52,9 +53,14 @@ void Points::Add(
     mWaterVelocityBuffer.emplace_back(vec2f::zero());
     mWaterMomentumBuffer.emplace_back(vec2f::zero());
     mCumulatedIntakenWater.emplace_back(0.0f);
-    mIsLeakingBuffer.emplace_back(isLeaking);
+    mIsLeakingBuffer.emplace_back(false);
     if (isLeaking)
         SetLeaking(pointIndex);
+    mIsWaterActiveBuffer.emplace_back(false);
+
+    // World samples - these will be recalculated each time
+    mWaterHeightBuffer.emplace_back(0.0f);
+    mOceanFloorHeightBuffer.emplace_back(0.0f);
 
     // Electrical dynamics
     mElectricalElementBuffer.emplace_back(electricalElementIndex);
@@ -70,7 +76,7 @@ void Points::Add(
     mEphemeralStateBuffer.emplace_back(EphemeralState::DebrisState());
 
     // Structure
-    mConnectedSpringsBuffer.emplace_back();
+    mConnectedOwnedSpringsCountBuffer.emplace_back(0);
     mConnectedTrianglesBuffer.emplace_back();
 
     mConnectedComponentIdBuffer.emplace_back(NoneConnectedComponentId);
@@ -119,6 +125,9 @@ void Points::CreateEphemeralParticleAirBubble(
     mWaterBuffer[pointIndex] = 0.0f;
     assert(false == mIsLeakingBuffer[pointIndex]);
 
+    // Air bubbles need the water height right away, before the next sampling
+    mWaterHeightBuffer[pointIndex] = mParentWorld.GetWaterHeightAt(position.x);
+
     mLightBuffer[pointIndex] = 0.0f;
 
     mWindReceptivityBuffer[pointIndex] = 0.0f;
@@ -294,6 +303,30 @@ void Points::Destroy(
     mEphemeralTypeBuffer[pointElementIndex] = EphemeralType::None;
 }
 
+void Points::SampleWaterHeights(
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex)
+{
+    assert(startPointIndex <= endPointIndex && endPointIndex <= mAllPointCount);
+
+    mParentWorld.GetWaterHeightsAt(
+        mPositionBuffer.data() + startPointIndex,
+        mWaterHeightBuffer.data() + startPointIndex,
+        endPointIndex - startPointIndex);
+}
+
+void Points::SampleOceanFloorHeights(
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex)
+{
+    assert(startPointIndex <= endPointIndex && endPointIndex <= mAllPointCount);
+
+    mParentWorld.GetOceanFloorHeightsAt(
+        mPositionBuffer.data() + startPointIndex,
+        mOceanFloorHeightBuffer.data() + startPointIndex,
+        endPointIndex - startPointIndex);
+}
+
 void Points::UpdateGameParameters(GameParameters const & gameParameters)
 {
     float const numMechanicalDynamicsIterations = gameParameters.NumMechanicalDynamicsIterations<float>();
@@ -336,7 +369,7 @@ void Points::UpdateEphemeralParticles(
             {
                 case EphemeralType::AirBubble:
                 {
-                    float const waterHeight = mParentWorld.GetWaterHeightAt(GetPosition(pointIndex).x);
+                    float const waterHeight = GetWaterHeight(pointIndex);
                     float const deltaY = waterHeight - GetPosition(pointIndex).y;
 
                     if (deltaY <= 0.0f)
@@ -441,132 +474,79 @@ void Points::Query(ElementIndex pointElementIndex) const
     LogMessage("ConnectedComponentID: ", mConnectedComponentIdBuffer[pointElementIndex]);
 }
 
-void Points::UploadAttributes(
-    ShipId shipId,
-    Render::RenderContext & renderContext) const
+void Points::CopyRenderAttributes(RenderSnapshot::PointAttributes & attributes) const
 {
-    // Upload immutable attributes, if we haven't uploaded them yet
-    if (mIsTextureCoordinatesBufferDirty)
-    {
-        renderContext.UploadShipPointImmutableAttributes(
-            shipId,
-            mTextureCoordinatesBuffer.data());
+    attributes.Position.assign(mPositionBuffer.data(), mPositionBuffer.data() + mAllPointCount);
+    attributes.Light.assign(mLightBuffer.data(), mLightBuffer.data() + mAllPointCount);
+    attributes.Water.assign(mWaterBuffer.data(), mWaterBuffer.data() + mAllPointCount);
+    attributes.EphemeralColor.assign(mColorBuffer.data() + mShipPointCount, mColorBuffer.data() + mAllPointCount);
 
-        mIsTextureCoordinatesBufferDirty = false;
-    }
+    //
+    // The seldom-changing attributes are only copied when dirty, and then as a whole,
+    // as the snapshot may have handed over its buffers in the meantime
+    //
 
-    // Upload colors, if dirty
     if (mIsWholeColorBufferDirty)
     {
-        renderContext.UploadShipPointColors(
-            shipId,
-            mColorBuffer.data(),
-            0,
-            mAllPointCount);
+        attributes.Color.assign(mColorBuffer.data(), mColorBuffer.data() + mShipPointCount);
+        attributes.IsColorDirty = true;
 
         mIsWholeColorBufferDirty = false;
     }
-    else
-    {
-        // Only upload ephemeral particle portion
-        renderContext.UploadShipPointColors(
-            shipId,
-            &(mColorBuffer.data()[mShipPointCount]),
-            mShipPointCount,
-            mEphemeralPointCount);
-    }
-
-    //
-    // Upload mutable attributes
-    //
-
-    renderContext.UploadShipPointMutableAttributesStart(shipId);
-
-    renderContext.UploadShipPointMutableAttributes(
-        shipId,
-        mPositionBuffer.data(),
-        mLightBuffer.data(),
-        mWaterBuffer.data());
 
     if (mIsPlaneIdBufferNonEphemeralDirty)
     {
-        if (mIsPlaneIdBufferEphemeralDirty)
-        {
-            // Whole
-
-            renderContext.UploadShipPointMutableAttributesPlaneId(
-                shipId,
-                mPlaneIdFloatBuffer.data(),
-                0,
-                mAllPointCount);
-
-            mIsPlaneIdBufferEphemeralDirty = false;
-        }
-        else
-        {
-            // Just non-ephemeral portion
-
-            renderContext.UploadShipPointMutableAttributesPlaneId(
-                shipId,
-                mPlaneIdFloatBuffer.data(),
-                0,
-                mShipPointCount);
-        }
+        attributes.PlaneId.assign(mPlaneIdFloatBuffer.data(), mPlaneIdFloatBuffer.data() + mShipPointCount);
+        attributes.IsPlaneIdDirty = true;
 
         mIsPlaneIdBufferNonEphemeralDirty = false;
     }
-    else if (mIsPlaneIdBufferEphemeralDirty)
-    {
-        // Just ephemeral portion
 
-        renderContext.UploadShipPointMutableAttributesPlaneId(
-            shipId,
-            &(mPlaneIdFloatBuffer.data()[mShipPointCount]),
-            mShipPointCount,
-            mEphemeralPointCount);
+    if (mIsPlaneIdBufferEphemeralDirty)
+    {
+        attributes.EphemeralPlaneId.assign(mPlaneIdFloatBuffer.data() + mShipPointCount, mPlaneIdFloatBuffer.data() + mAllPointCount);
+        attributes.IsEphemeralPlaneIdDirty = true;
 
         mIsPlaneIdBufferEphemeralDirty = false;
     }
 
     if (mIsDecayBufferDirty)
     {
-        renderContext.UploadShipPointMutableAttributesDecay(
-            shipId,
-            mDecayBuffer.data(),
-            0,
-            mAllPointCount);
+        attributes.Decay.assign(mDecayBuffer.data(), mDecayBuffer.data() + mAllPointCount);
+        attributes.IsDecayDirty = true;
 
         mIsDecayBufferDirty = false;
     }
 
-    renderContext.UploadShipPointMutableAttributesEnd(shipId);
+    if (mIsTextureCoordinatesBufferDirty)
+    {
+        attributes.TextureCoordinates.assign(mTextureCoordinatesBuffer.data(), mTextureCoordinatesBuffer.data() + mAllPointCount);
+        attributes.IsTextureCoordinatesDirty = true;
+
+        mIsTextureCoordinatesBufferDirty = false;
+    }
 }
 
-void Points::UploadElements(
-    ShipId shipId,
-    Render::RenderContext & renderContext) const
+void Points::UploadElements(RenderSnapshot & renderSnapshot) const
 {
     for (ElementIndex pointIndex : NonEphemeralPoints())
     {
         if (!mIsDeletedBuffer[pointIndex])
         {
-            renderContext.UploadShipElementPoint(
-                shipId,
-                pointIndex);
+            renderSnapshot.UploadElementPoint(pointIndex);
         }
     }
 }
 
 void Points::UploadVectors(
-    ShipId shipId,
-    Render::RenderContext & renderContext) const
+    VectorFieldRenderMode vectorFieldRenderMode,
+    RenderSnapshot & renderSnapshot) const
 {
     static constexpr vec4f VectorColor(0.5f, 0.1f, 0.f, 1.0f);
 
-    if (renderContext.GetVectorFieldRenderMode() == VectorFieldRenderMode::PointVelocity)
+    if (vectorFieldRenderMode == VectorFieldRenderMode::PointVelocity)
     {
-        renderContext.UploadShipVectors(
-            shipId,
+        renderSnapshot.UploadVectors(
             mElementCount,
             mPositionBuffer.data(),
             mPlaneIdFloatBuffer.data(),
@@ -574,10 +554,9 @@ void Points::UploadVectors(
             0.25f,
             VectorColor);
     }
-    else if (renderContext.GetVectorFieldRenderMode() == VectorFieldRenderMode::PointForce)
+    else if (vectorFieldRenderMode == VectorFieldRenderMode::PointForce)
     {
-        renderContext.UploadShipVectors(
-            shipId,
+        renderSnapshot.UploadVectors(
             mElementCount,
             mPositionBuffer.data(),
             mPlaneIdFloatBuffer.data(),
@@ -585,10 +564,9 @@ void Points::UploadVectors(
             0.0005f,
             VectorColor);
     }
-    else if (renderContext.GetVectorFieldRenderMode() == VectorFieldRenderMode::PointWaterVelocity)
+    else if (vectorFieldRenderMode == VectorFieldRenderMode::PointWaterVelocity)
     {
-        renderContext.UploadShipVectors(
-            shipId,
+        renderSnapshot.UploadVectors(
             mElementCount,
             mPositionBuffer.data(),
             mPlaneIdFloatBuffer.data(),
@@ -596,10 +574,9 @@ void Points::UploadVectors(
             1.0f,
             VectorColor);
     }
-    else if (renderContext.GetVectorFieldRenderMode() == VectorFieldRenderMode::PointWaterMomentum)
+    else if (vectorFieldRenderMode == VectorFieldRenderMode::PointWaterMomentum)
     {
-        renderContext.UploadShipVectors(
-            shipId,
+        renderSnapshot.UploadVectors(
             mElementCount,
             mPositionBuffer.data(),
             mPlaneIdFloatBuffer.data(),
@@ -609,9 +586,7 @@ void Points::UploadVectors(
     }
 }
 
-void Points::UploadEphemeralParticles(
-    ShipId shipId,
-    Render::RenderContext & renderContext) const
+void Points::UploadEphemeralParticles(RenderSnapshot & renderSnapshot) const
 {
     //
     // Upload points and/or textures
@@ -619,7 +594,7 @@ void Points::UploadEphemeralParticles(
 
     if (mAreEphemeralParticlesDirty)
     {
-        renderContext.UploadShipElementEphemeralPointsStart(shipId);
+        renderSnapshot.UploadElementEphemeralPointsStart();
     }
 
     for (ElementIndex pointIndex : this->EphemeralPoints())
@@ -630,8 +605,7 @@ void Points::UploadEphemeralParticles(
         {
             case EphemeralType::AirBubble:
             {
-                renderContext.UploadShipGenericTextureRenderSpecification(
-                    shipId,
+                renderSnapshot.UploadGenericTextureRenderSpecification(
                     GetPlaneId(pointIndex),
                     TextureFrameId(TextureGroupType::AirBubble, mEphemeralStateBuffer[pointIndex].AirBubble.FrameIndex),
                     GetPosition(pointIndex),
@@ -647,9 +621,7 @@ void Points::UploadEphemeralParticles(
                 // Don't upload point unless there's been a change
                 if (mAreEphemeralParticlesDirty)
                 {
-                    renderContext.UploadShipElementEphemeralPoint(
-                        shipId,
-                        pointIndex);
+                    renderSnapshot.UploadElementEphemeralPoint(pointIndex);
                 }
 
                 break;
@@ -657,8 +629,7 @@ void Points::UploadEphemeralParticles(
 
             case EphemeralType::Sparkle:
             {
-                renderContext.UploadShipGenericTextureRenderSpecification(
-                    shipId,
+                renderSnapshot.UploadGenericTextureRenderSpecification(
                     GetPlaneId(pointIndex),
                     TextureFrameId(TextureGroupType::SawSparkle, mEphemeralStateBuffer[pointIndex].Sparkle.FrameIndex),
                     GetPosition(pointIndex),
@@ -678,12 +649,7 @@ void Points::UploadEphemeralParticles(
         }
     }
 
-    if (mAreEphemeralParticlesDirty)
-    {
-        renderContext.UploadShipElementEphemeralPointsEnd(shipId);
-
-        mAreEphemeralParticlesDirty = false;
-    }
+    mAreEphemeralParticlesDirty = false;
 }
 
 void Points::SetMassToStructuralMaterialOffset(
@@ -696,12 +662,45 @@ void Points::SetMassToStructuralMaterialOffset(
     mMassBuffer[pointElementIndex] = GetStructuralMaterial(pointElementIndex).Mass + offset;
 
     // Notify all springs
-    for (auto connectedSpring : mConnectedSpringsBuffer[pointElementIndex].ConnectedSprings)
+    for (auto const & connectedSpring : mConnectedSprings[pointElementIndex])
     {
         springs.OnPointMassUpdated(connectedSpring.SpringIndex, *this);
     }
 }
 
+void Points::UpdateWaterActiveSet()
+{
+    //
+    // Remove the points that have dried out or fallen asleep, making sure that their water
+    // velocities and momenta are zero, as the water dynamics won't update them anymore
+    //
+
+    auto const newEnd = std::remove_if(
+        mWaterActivePoints.begin(),
+        mWaterActivePoints.end(),
+        [this](ElementIndex pointIndex)
+        {
+            // Deleted points don't exchange water anymore, and sleeping points
+            // only neighbor other sleeping points
+            if (mWaterBuffer[pointIndex] == 0.0f || mIsDeletedBuffer[pointIndex] || mIsAsleepBuffer[pointIndex])
+            {
+                mIsWaterActiveBuffer[pointIndex] = false;
+                mWaterVelocityBuffer[pointIndex] = vec2f::zero();
+                mWaterMomentumBuffer[pointIndex] = vec2f::zero();
+
+                return true;
+            }
+
+            return false;
+        });
+
+    mWaterActivePoints.erase(newEnd, mWaterActivePoints.end());
+
+    // Restore index order, so that water moves in the same order as it would if
+    // we visited all points
+    std::sort(mWaterActivePoints.begin(), mWaterActivePoints.end());
+}
+
 void Points::UpdateTotalMasses(GameParameters const & gameParameters)
 {
     //
@@ -8,8 +8,9 @@
 #include "GameParameters.h"
 #include "IGameEventHandler.h"
 #include "Materials.h"
-#include "RenderContext.h"
+#include "RenderSnapshot.h"
 
+#include <GameCore/AdjacencyList.h>
 #include <GameCore/Buffer.h>
 #include <GameCore/BufferAllocator.h>
 #include <GameCore/ElementContainer.h>
@@ -20,6 +21,7 @@
 #include <GameCore/GameTypes.h>
 #include <GameCore/Vectors.h>
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cstring>
@@ -156,19 +158,7 @@ private:
         {}
     };
 
-    /*
-     * The metadata of all the springs connected to a point.
-     */
-    struct ConnectedSpringsVector
-    {
-        FixedSizeVector<ConnectedSpring, GameParameters::MaxSpringsPerPoint> ConnectedSprings;
-        size_t OwnedConnectedSpringsCount;
-
-        ConnectedSpringsVector()
-            : ConnectedSprings()
-            , OwnedConnectedSpringsCount(0u)
-        {}
-    };
+    using ConnectedSpringsList = AdjacencyList<ConnectedSpring>::List;
 
     /*
      * The metadata of all the triangles connected to a point.
@@ -238,6 +228,12 @@ public:
         , mWaterMomentumBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
         , mCumulatedIntakenWater(mBufferElementCount, shipPointCount, 0.0f)
         , mIsLeakingBuffer(mBufferElementCount, shipPointCount, false)
+        , mLeakingPoints()
+        , mIsWaterActiveBuffer(mBufferElementCount, shipPointCount, false)
+        , mWaterActivePoints()
+        // World samples
+        , mWaterHeightBuffer(mBufferElementCount, shipPointCount, 0.0f)
+        , mOceanFloorHeightBuffer(mBufferElementCount, shipPointCount, 0.0f)
         // Electrical dynamics
         , mElectricalElementBuffer(mBufferElementCount, shipPointCount, NoneElementIndex)
         , mLightBuffer(mBufferElementCount, shipPointCount, 0.0f)
@@ -249,7 +245,8 @@ public:
         , mEphemeralMaxLifetimeBuffer(mBufferElementCount, shipPointCount, 0.0f)
         , mEphemeralStateBuffer(mBufferElementCount, shipPointCount, EphemeralState::DebrisState())
         // Structure
-        , mConnectedSpringsBuffer(mBufferElementCount, shipPointCount, ConnectedSpringsVector())
+        , mConnectedSprings(mBufferElementCount)
+        , mConnectedOwnedSpringsCountBuffer(mBufferElementCount, shipPointCount, 0)
         , mConnectedTrianglesBuffer(mBufferElementCount, shipPointCount, ConnectedTrianglesVector())
         // Connected component and plane ID
         , mConnectedComponentIdBuffer(mBufferElementCount, shipPointCount, NoneConnectedComponentId)
@@ -260,6 +257,8 @@ public:
         , mCurrentConnectivityVisitSequenceNumberBuffer(mBufferElementCount, shipPointCount, SequenceNumber())
         // Pinning
         , mIsPinnedBuffer(mBufferElementCount, shipPointCount, false)
+        // Sleep
+        , mIsAsleepBuffer(mBufferElementCount, shipPointCount, false)
         // Immutable render attributes
         , mColorBuffer(mBufferElementCount, shipPointCount, vec4f::zero())
         , mIsWholeColorBufferDirty(true)
@@ -282,8 +281,112 @@ public:
     {
     }
 
+    /*
+     * Makes a copy of the specified points - bulk-copying all of their buffers - which
+     * belongs to the specified world. The copy has no destroy handler.
+     */
+    Points(
+        Points const & other,
+        World & parentWorld,
+        std::shared_ptr<IGameEventHandler> gameEventHandler)
+        : ElementContainer(other)
+        //////////////////////////////////
+        // Buffers
+        //////////////////////////////////
+        , mIsDeletedBuffer(other.mIsDeletedBuffer)
+        // Materials
+        , mMaterialsBuffer(other.mMaterialsBuffer)
+        , mIsRopeBuffer(other.mIsRopeBuffer)
+        // Mechanical dynamics
+        , mPositionBuffer(other.mPositionBuffer)
+        , mVelocityBuffer(other.mVelocityBuffer)
+        , mForceBuffer(other.mForceBuffer)
+        , mMassBuffer(other.mMassBuffer)
+        , mDecayBuffer(other.mDecayBuffer)
+        , mIsDecayBufferDirty(true)
+        , mIntegrationFactorTimeCoefficientBuffer(other.mIntegrationFactorTimeCoefficientBuffer)
+        , mTotalMassBuffer(other.mTotalMassBuffer)
+        , mIntegrationFactorBuffer(other.mIntegrationFactorBuffer)
+        , mForceRenderBuffer(other.mForceRenderBuffer)
+        // Water dynamics
+        , mIsHullBuffer(other.mIsHullBuffer)
+        , mWaterVolumeFillBuffer(other.mWaterVolumeFillBuffer)
+        , mWaterIntakeBuffer(other.mWaterIntakeBuffer)
+        , mWaterRestitutionBuffer(other.mWaterRestitutionBuffer)
+        , mWaterDiffusionSpeedBuffer(other.mWaterDiffusionSpeedBuffer)
+        , mWaterBuffer(other.mWaterBuffer)
+        , mWaterVelocityBuffer(other.mWaterVelocityBuffer)
+        , mWaterMomentumBuffer(other.mWaterMomentumBuffer)
+        , mCumulatedIntakenWater(other.mCumulatedIntakenWater)
+        , mIsLeakingBuffer(other.mIsLeakingBuffer)
+        , mLeakingPoints(other.mLeakingPoints)
+        , mIsWaterActiveBuffer(other.mIsWaterActiveBuffer)
+        , mWaterActivePoints(other.mWaterActivePoints)
+        // World samples
+        , mWaterHeightBuffer(other.mWaterHeightBuffer)
+        , mOceanFloorHeightBuffer(other.mOceanFloorHeightBuffer)
+        // Electrical dynamics
+        , mElectricalElementBuffer(other.mElectricalElementBuffer)
+        , mLightBuffer(other.mLightBuffer)
+        // Wind dynamics
+        , mWindReceptivityBuffer(other.mWindReceptivityBuffer)
+        // Ephemeral particles
+        , mEphemeralTypeBuffer(other.mEphemeralTypeBuffer)
+        , mEphemeralStartTimeBuffer(other.mEphemeralStartTimeBuffer)
+        , mEphemeralMaxLifetimeBuffer(other.mEphemeralMaxLifetimeBuffer)
+        , mEphemeralStateBuffer(other.mEphemeralStateBuffer)
+        // Structure
+        , mConnectedSprings(other.mConnectedSprings)
+        , mConnectedOwnedSpringsCountBuffer(other.mConnectedOwnedSpringsCountBuffer)
+        , mConnectedTrianglesBuffer(other.mConnectedTrianglesBuffer)
+        // Connected component and plane ID
+        , mConnectedComponentIdBuffer(other.mConnectedComponentIdBuffer)
+        , mPlaneIdBuffer(other.mPlaneIdBuffer)
+        , mPlaneIdFloatBuffer(other.mPlaneIdFloatBuffer)
+        , mIsPlaneIdBufferNonEphemeralDirty(true)
+        , mIsPlaneIdBufferEphemeralDirty(true)
+        , mCurrentConnectivityVisitSequenceNumberBuffer(other.mCurrentConnectivityVisitSequenceNumberBuffer)
+        // Pinning
+        , mIsPinnedBuffer(other.mIsPinnedBuffer)
+        // Sleep
+        , mIsAsleepBuffer(other.mIsAsleepBuffer)
+        // Immutable render attributes
+        , mColorBuffer(other.mColorBuffer)
+        , mIsWholeColorBufferDirty(true)
+        , mTextureCoordinatesBuffer(other.mTextureCoordinatesBuffer)
+        , mIsTextureCoordinatesBufferDirty(true)
+        //////////////////////////////////
+        // Container
+        //////////////////////////////////
+        , mShipPointCount(other.mShipPointCount)
+        , mEphemeralPointCount(other.mEphemeralPointCount)
+        , mAllPointCount(other.mAllPointCount)
+        , mParentWorld(parentWorld)
+        , mGameEventHandler(std::move(gameEventHandler))
+        , mDestroyHandler()
+        , mCurrentNumMechanicalDynamicsIterations(other.mCurrentNumMechanicalDynamicsIterations)
+        , mFloatBufferAllocator(mBufferElementCount)
+        , mVec2fBufferAllocator(mBufferElementCount)
+        , mFreeEphemeralParticleSearchStartIndex(other.mFreeEphemeralParticleSearchStartIndex)
+        , mAreEphemeralParticlesDirty(true)
+    {
+    }
+
     Points(Points && other) = default;
 
+    inline bool IsEphemeral(ElementIndex pointElementIndex) const
+    {
+        return pointElementIndex >= mShipPointCount;
+    }
+
+    /*
+     * Returns the number of non-ephemeral points; ephemeral points follow them.
+     */
+    inline ElementCount GetShipPointCount() const
+    {
+        return mShipPointCount;
+    }
+
     /*
      * Returns an iterator for the non-ephemeral points only.
      */
@@ -379,21 +482,20 @@ public:
     // Render
     //
 
-    void UploadAttributes(
-        ShipId shipId,
-        Render::RenderContext & renderContext) const;
+    /*
+     * Copies the attributes of the points into the specified render snapshot buffers;
+     * only copies the seldom-changing attributes when they are dirty, and then clears
+     * their dirtiness.
+     */
+    void CopyRenderAttributes(RenderSnapshot::PointAttributes & attributes) const;
 
-    void UploadElements(
-        ShipId shipId,
-        Render::RenderContext & renderContext) const;
+    void UploadElements(RenderSnapshot & renderSnapshot) const;
 
     void UploadVectors(
-        ShipId shipId,
-        Render::RenderContext & renderContext) const;
+        VectorFieldRenderMode vectorFieldRenderMode,
+        RenderSnapshot & renderSnapshot) const;
 
-    void UploadEphemeralParticles(
-        ShipId shipId,
-        Render::RenderContext & renderContext) const;
+    void UploadEphemeralParticles(RenderSnapshot & renderSnapshot) const;
 
 public:
 
@@ -481,6 +583,11 @@ public:
         return mForceBuffer[pointElementIndex];
     }
 
+    vec2f * restrict GetForceBufferAsVec2()
+    {
+        return mForceBuffer.data();
+    }
+
     float * restrict GetForceBufferAsFloat()
     {
         return reinterpret_cast<float *>(mForceBuffer.data());
@@ -638,13 +745,17 @@ public:
         return mWaterMomentumBuffer.data();
     }
 
+    /*
+     * Only updates the points in the water active set; all other points are dry,
+     * and thus have zero water momenta.
+     */
     void UpdateWaterMomentaFromVelocities()
     {
         float * const restrict waterBuffer = mWaterBuffer.data();
         vec2f * const restrict waterVelocityBuffer = mWaterVelocityBuffer.data();
         vec2f * restrict waterMomentumBuffer = mWaterMomentumBuffer.data();
 
-        for (ElementIndex p = 0; p < mBufferElementCount; ++p)
+        for (ElementIndex p : mWaterActivePoints)
         {
             waterMomentumBuffer[p] =
                 waterVelocityBuffer[p]
@@ -652,13 +763,17 @@ public:
         }
     }
 
+    /*
+     * Only updates the points in the water active set; all other points are dry,
+     * and thus have zero water velocities.
+     */
     void UpdateWaterVelocitiesFromMomenta()
     {
         float * const restrict waterBuffer = mWaterBuffer.data();
         vec2f * restrict waterVelocityBuffer = mWaterVelocityBuffer.data();
         vec2f * const restrict waterMomentumBuffer = mWaterMomentumBuffer.data();
 
-        for (ElementIndex p = 0; p < mBufferElementCount; ++p)
+        for (ElementIndex p : mWaterActivePoints)
         {
             if (waterBuffer[p] != 0.0f)
             {
@@ -674,6 +789,40 @@ public:
         }
     }
 
+    //
+    // Water active set
+    //
+    // The set of points that might have water, so that the water dynamics may skip dry points;
+    // it is a superset of the (non-deleted) awake points that have water, hence whoever gives
+    // water to a point - or wakes it up - must also add the point to the set.
+    //
+
+    /*
+     * Returns the points in the set; these are in index order right after
+     * UpdateWaterActiveSet(), with any points added later at the end.
+     */
+    std::vector<ElementIndex> const & GetWaterActivePoints() const
+    {
+        return mWaterActivePoints;
+    }
+
+    /*
+     * Adds the point to the set, if it's not there already.
+     */
+    void AddToWaterActiveSet(ElementIndex pointElementIndex)
+    {
+        if (!mIsWaterActiveBuffer[pointElementIndex])
+        {
+            mIsWaterActiveBuffer[pointElementIndex] = true;
+            mWaterActivePoints.push_back(pointElementIndex);
+        }
+    }
+
+    /*
+     * Removes dry, deleted, and sleeping points from the set, and restores index order.
+     */
+    void UpdateWaterActiveSet();
+
     float GetCumulatedIntakenWater(ElementIndex pointElementIndex) const
     {
         return mCumulatedIntakenWater[pointElementIndex];
@@ -691,7 +840,15 @@ public:
 
     void SetLeaking(ElementIndex pointElementIndex)
     {
-        mIsLeakingBuffer[pointElementIndex] = true;
+        if (!mIsLeakingBuffer[pointElementIndex])
+        {
+            mIsLeakingBuffer[pointElementIndex] = true;
+
+            // Keep leaking points in index order
+            mLeakingPoints.insert(
+                std::upper_bound(mLeakingPoints.begin(), mLeakingPoints.end(), pointElementIndex),
+                pointElementIndex);
+        }
 
         // Randomize the initial water intaken, so that air bubbles won't come out all at the same moment
         mCumulatedIntakenWater[pointElementIndex] = GameRandomEngine::GetInstance().GenerateRandomReal(
@@ -699,6 +856,39 @@ public:
             GameParameters::CumulatedIntakenWaterThresholdForAirBubbles);
     }
 
+    /*
+     * Returns the points that are leaking - including deleted ones - in index order.
+     */
+    std::vector<ElementIndex> const & GetLeakingPoints() const
+    {
+        return mLeakingPoints;
+    }
+
+    //
+    // World samples
+    //
+    // The heights of the water surface and of the ocean floor are sampled in bulk, at the
+    // points' current positions, and cached until the next sampling.
+    //
+
+    void SampleWaterHeights(
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex);
+
+    void SampleOceanFloorHeights(
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex);
+
+    float GetWaterHeight(ElementIndex pointElementIndex) const
+    {
+        return mWaterHeightBuffer[pointElementIndex];
+    }
+
+    float GetOceanFloorHeight(ElementIndex pointElementIndex) const
+    {
+        return mOceanFloorHeightBuffer[pointElementIndex];
+    }
+
     //
     // Electrical dynamics
     //
@@ -740,9 +930,19 @@ public:
     // Network
     //
 
-    auto const & GetConnectedSprings(ElementIndex pointElementIndex) const
+    /*
+     * Returns the springs connected to the point, the ones owned by the point first.
+     *
+     * The returned list is invalidated by any change to the springs connected to any point.
+     */
+    ConnectedSpringsList GetConnectedSprings(ElementIndex pointElementIndex) const
+    {
+        return mConnectedSprings[pointElementIndex];
+    }
+
+    size_t GetConnectedOwnedSpringsCount(ElementIndex pointElementIndex) const
     {
-        return mConnectedSpringsBuffer[pointElementIndex];
+        return mConnectedOwnedSpringsCountBuffer[pointElementIndex];
     }
 
     void AddConnectedSpring(
@@ -754,12 +954,12 @@ public:
         // Add so that all springs owned by this point come first
         if (isAtOwner)
         {
-            mConnectedSpringsBuffer[pointElementIndex].ConnectedSprings.emplace_front(springElementIndex, otherEndpointElementIndex);
-            ++(mConnectedSpringsBuffer[pointElementIndex].OwnedConnectedSpringsCount);
+            mConnectedSprings.push_front(pointElementIndex, ConnectedSpring(springElementIndex, otherEndpointElementIndex));
+            ++(mConnectedOwnedSpringsCountBuffer[pointElementIndex]);
         }
         else
         {
-            mConnectedSpringsBuffer[pointElementIndex].ConnectedSprings.emplace_back(springElementIndex, otherEndpointElementIndex);
+            mConnectedSprings.push_back(pointElementIndex, ConnectedSpring(springElementIndex, otherEndpointElementIndex));
         }
     }
 
@@ -768,7 +968,8 @@ public:
         ElementIndex springElementIndex,
         bool isAtOwner)
     {
-        bool found = mConnectedSpringsBuffer[pointElementIndex].ConnectedSprings.erase_first(
+        bool found = mConnectedSprings.erase_first(
+            pointElementIndex,
             [springElementIndex](ConnectedSpring const & c)
             {
                 return c.SpringIndex == springElementIndex;
@@ -780,11 +981,30 @@ public:
         // Update count of owned springs, if this spring is owned
         if (isAtOwner)
         {
-            assert(mConnectedSpringsBuffer[pointElementIndex].OwnedConnectedSpringsCount > 0);
-            --(mConnectedSpringsBuffer[pointElementIndex].OwnedConnectedSpringsCount);
+            assert(mConnectedOwnedSpringsCountBuffer[pointElementIndex] > 0);
+            --(mConnectedOwnedSpringsCountBuffer[pointElementIndex]);
         }
     }
 
+    /*
+     * Whether removed springs have left enough holes in the layout of the connected springs
+     * to make it worth compacting it.
+     */
+    bool AreConnectedSpringsFragmented() const
+    {
+        return mConnectedSprings.IsFragmented();
+    }
+
+    /*
+     * Lays out the springs connected to all points contiguously, in point order.
+     *
+     * Invalidates all lists of connected springs.
+     */
+    void CompactConnectedSprings()
+    {
+        mConnectedSprings.Compact();
+    }
+
     auto const & GetConnectedTriangles(ElementIndex pointElementIndex) const
     {
         return mConnectedTrianglesBuffer[pointElementIndex];
@@ -870,6 +1090,11 @@ public:
         mIsPlaneIdBufferNonEphemeralDirty = true;
     }
 
+    void MarkPlaneIdBufferEphemeralAsDirty()
+    {
+        mIsPlaneIdBufferEphemeralDirty = true;
+    }
+
     SequenceNumber GetCurrentConnectivityVisitSequenceNumber(ElementIndex pointElementIndex) const
     {
         return mCurrentConnectivityVisitSequenceNumberBuffer[pointElementIndex];
@@ -910,6 +1135,25 @@ public:
         Thaw(pointElementIndex);
     }
 
+    //
+    // Sleep
+    //
+    // Points of connected components that have settled are put to sleep, and
+    // the dynamics skip them until they are woken up.
+    //
+
+    bool IsAsleep(ElementIndex pointElementIndex) const
+    {
+        return mIsAsleepBuffer[pointElementIndex];
+    }
+
+    void SetAsleep(
+        ElementIndex pointElementIndex,
+        bool isAsleep)
+    {
+        mIsAsleepBuffer[pointElementIndex] = isAsleep;
+    }
+
     //
     // Immutable attributes
     //
@@ -1021,6 +1265,18 @@ private:
     Buffer<float> mCumulatedIntakenWater;
 
     Buffer<bool> mIsLeakingBuffer;
+    std::vector<ElementIndex> mLeakingPoints;
+
+    // The water active set
+    Buffer<bool> mIsWaterActiveBuffer;
+    std::vector<ElementIndex> mWaterActivePoints;
+
+    //
+    // World samples - heights at the point's position, as of the last sampling
+    //
+
+    Buffer<float> mWaterHeightBuffer;
+    Buffer<float> mOceanFloorHeightBuffer;
 
     //
     // Electrical dynamics
@@ -1051,7 +1307,8 @@ private:
     // Structure
     //
 
-    Buffer<ConnectedSpringsVector> mConnectedSpringsBuffer;
+    AdjacencyList<ConnectedSpring> mConnectedSprings;
+    Buffer<size_t> mConnectedOwnedSpringsCountBuffer;
     Buffer<ConnectedTrianglesVector> mConnectedTrianglesBuffer;
 
     //
@@ -1071,6 +1328,12 @@ private:
 
     Buffer<bool> mIsPinnedBuffer;
 
+    //
+    // Sleep
+    //
+
+    Buffer<bool> mIsAsleepBuffer;
+
     //
     // Immutable render attributes
     //
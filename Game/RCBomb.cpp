@@ -136,16 +136,13 @@ bool RCBomb::Update(
     }
 }
 
-void RCBomb::Upload(
-    ShipId shipId,
-    Render::RenderContext & renderContext) const
+void RCBomb::Upload(RenderSnapshot & renderSnapshot) const
 {
     switch (mState)
     {
         case State::IdlePingOff:
         {
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::RcBomb, 0),
                 GetPosition(),
@@ -159,8 +156,7 @@ void RCBomb::Upload(
 
         case State::IdlePingOn:
         {
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::RcBomb, 0),
                 GetPosition(),
@@ -169,8 +165,7 @@ void RCBomb::Upload(
                 GetRotationOffsetAxis(),
                 1.0f);
 
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::RcBombPing, (mPingOnStepCounter - 1) % PingFramesCount),
                 GetPosition(),
@@ -184,8 +179,7 @@ void RCBomb::Upload(
 
         case State::DetonationLeadIn:
         {
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::RcBomb, 0),
                 GetPosition(),
@@ -194,8 +188,7 @@ void RCBomb::Upload(
                 GetRotationOffsetAxis(),
                 1.0f);
 
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::RcBombPing, (mPingOnStepCounter - 1) % PingFramesCount),
                 GetPosition(),
@@ -212,8 +205,7 @@ void RCBomb::Upload(
             assert(mExplodingStepCounter >= 0);
             assert(mExplodingStepCounter < ExplosionStepsCount);
 
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::RcBombExplosion, mExplodingStepCounter),
                 GetPosition(),
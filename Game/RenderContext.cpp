@@ -7,6 +7,7 @@
 
 #include <GameCore/GameException.h>
 #include <GameCore/Log.h>
+#include <GameCore/Profiler.h>
 
 #include <cstring>
 
@@ -631,6 +632,8 @@ void RenderContext::UploadCloudsEnd()
 
 void RenderContext::RenderSkyEnd()
 {
+    PROFILE_PHASE(SkyDraw);
+
     ////////////////////////////////////////////////////
     // Draw ocean stencil
     ////////////////////////////////////////////////////
@@ -759,6 +762,8 @@ void RenderContext::UploadLandAndOceanEnd()
 
 void RenderContext::RenderLand()
 {
+    PROFILE_PHASE(LandDraw);
+
     glBindVertexArray(*mLandVAO);
 
     switch (mLandRenderMode)
@@ -786,6 +791,8 @@ void RenderContext::RenderLand()
 
 void RenderContext::RenderOcean()
 {
+    PROFILE_PHASE(OceanDraw);
+
     glBindVertexArray(*mOceanVAO);
 
     switch (mOceanRenderMode)
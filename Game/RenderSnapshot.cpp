@@ -0,0 +1,614 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-03-30
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "Physics.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Physics {
+
+RenderSnapshot::Stage::Stage()
+    : MaxPlaneId(0)
+    , ShipPointCount(0)
+    , Timestamp()
+    , StressedSpringElements()
+    , GenericTextures()
+    , CrossesOfLight()
+    , VectorPosition()
+    , VectorPlaneId()
+    , Vector()
+    , VectorLengthAdjustment(1.0f)
+    , VectorColor()
+    , HasVectors(false)
+    , Points()
+    , PointElements()
+    , SpringElements()
+    , TriangleElements()
+    , AreElementsDirty(false)
+    , EphemeralPointElements()
+    , AreEphemeralPointElementsDirty(false)
+    , IsNew(false)
+{
+}
+
+RenderSnapshot::RenderSnapshot()
+    : mPublished()
+    , mShared()
+    , mFront()
+    , mPreviousPosition()
+    , mPreviousTimestamp()
+    , mDoInterpolatePositions(false)
+    , mInterpolatedPosition()
+    , mIsAcquired(false)
+    , mLastDebugShipRenderMode()
+{
+}
+
+void RenderSnapshot::PublishStart(
+    PlaneId maxPlaneId,
+    size_t shipPointCount)
+{
+    mPublished.MaxPlaneId = maxPlaneId;
+    mPublished.ShipPointCount = shipPointCount;
+
+    mPublished.StressedSpringElements.clear();
+    mPublished.GenericTextures.clear();
+    mPublished.CrossesOfLight.clear();
+    mPublished.HasVectors = false;
+}
+
+void RenderSnapshot::PublishEnd()
+{
+    mPublished.Timestamp = std::chrono::steady_clock::now();
+    mPublished.IsNew = true;
+}
+
+void RenderSnapshot::UploadElementsStart()
+{
+    mPublished.PointElements.clear();
+    mPublished.SpringElements.clear();
+    mPublished.TriangleElements.clear();
+    mPublished.AreElementsDirty = true;
+}
+
+void RenderSnapshot::UploadElementEphemeralPointsStart()
+{
+    mPublished.EphemeralPointElements.clear();
+    mPublished.AreEphemeralPointElementsDirty = true;
+}
+
+void RenderSnapshot::UploadVectors(
+    size_t count,
+    vec2f const * position,
+    float const * planeId,
+    vec2f const * vector,
+    float lengthAdjustment,
+    vec4f const & color)
+{
+    mPublished.VectorPosition.assign(position, position + count);
+    mPublished.VectorPlaneId.assign(planeId, planeId + count);
+    mPublished.Vector.assign(vector, vector + count);
+    mPublished.VectorLengthAdjustment = lengthAdjustment;
+    mPublished.VectorColor = color;
+    mPublished.HasVectors = true;
+}
+
+void RenderSnapshot::HandOver()
+{
+    Forward(mPublished, mShared);
+}
+
+void RenderSnapshot::Acquire(bool doInterpolatePositions)
+{
+    if (!mShared.IsNew)
+        return;
+
+    // The latest positions become the previous ones, and we re-use the
+    // buffer of the previous ones for the new latest
+    std::swap(mPreviousPosition, mFront.Points.Position);
+    mPreviousTimestamp = mFront.Timestamp;
+
+    Forward(mShared, mFront);
+
+    if (!mIsAcquired)
+    {
+        // Nothing to interpolate from yet
+        mPreviousPosition = mFront.Points.Position;
+        mPreviousTimestamp = mFront.Timestamp;
+
+        mIsAcquired = true;
+    }
+
+    mDoInterpolatePositions = doInterpolatePositions;
+}
+
+void RenderSnapshot::Upload(
+    ShipId shipId,
+    Render::RenderContext & renderContext)
+{
+    if (!mIsAcquired)
+    {
+        // Nothing published yet
+        return;
+    }
+
+    PointAttributes & points = mFront.Points;
+
+    size_t const pointCount = points.Position.size();
+    size_t const shipPointCount = mFront.ShipPointCount;
+    assert(shipPointCount <= pointCount);
+    assert(mPreviousPosition.size() == pointCount);
+
+
+    //
+    // Initialize render
+    //
+
+    renderContext.RenderShipStart(
+        shipId,
+        mFront.MaxPlaneId);
+
+
+    //
+    // Upload points's attributes
+    //
+
+    if (points.IsTextureCoordinatesDirty)
+    {
+        renderContext.UploadShipPointImmutableAttributes(
+            shipId,
+            points.TextureCoordinates.data());
+
+        points.IsTextureCoordinatesDirty = false;
+    }
+
+    if (points.IsColorDirty)
+    {
+        renderContext.UploadShipPointColors(
+            shipId,
+            points.Color.data(),
+            0,
+            shipPointCount);
+
+        points.IsColorDirty = false;
+    }
+
+    renderContext.UploadShipPointColors(
+        shipId,
+        points.EphemeralColor.data(),
+        shipPointCount,
+        pointCount - shipPointCount);
+
+    //
+    // Interpolate positions between the previous and the latest steps; we are
+    // as far from the previous step as the latest step is from now, as in the
+    // meantime the simulation is about to publish the next step
+    //
+
+    vec2f const * position = points.Position.data();
+
+    if (mDoInterpolatePositions)
+    {
+        auto const stepDuration = mFront.Timestamp - mPreviousTimestamp;
+        auto const sinceLatest = std::chrono::steady_clock::now() - mFront.Timestamp;
+
+        float const alpha = (stepDuration.count() > 0)
+            ? std::min(
+                std::chrono::duration<float>(sinceLatest).count() / std::chrono::duration<float>(stepDuration).count(),
+                1.0f)
+            : 1.0f;
+
+        mInterpolatedPosition.resize(pointCount);
+
+        vec2f const * restrict const previousPosition = mPreviousPosition.data();
+        vec2f const * restrict const latestPosition = points.Position.data();
+        vec2f * restrict const interpolatedPosition = mInterpolatedPosition.data();
+
+        // Ephemeral particles are re-used at will, hence we do not interpolate them
+        for (size_t i = 0; i < shipPointCount; ++i)
+        {
+            interpolatedPosition[i] = previousPosition[i] + (latestPosition[i] - previousPosition[i]) * alpha;
+        }
+
+        std::copy(
+            points.Position.cbegin() + shipPointCount,
+            points.Position.cend(),
+            mInterpolatedPosition.begin() + shipPointCount);
+
+        position = mInterpolatedPosition.data();
+    }
+
+    renderContext.UploadShipPointMutableAttributesStart(shipId);
+
+    renderContext.UploadShipPointMutableAttributes(
+        shipId,
+        position,
+        points.Light.data(),
+        points.Water.data());
+
+    if (points.IsPlaneIdDirty)
+    {
+        renderContext.UploadShipPointMutableAttributesPlaneId(
+            shipId,
+            points.PlaneId.data(),
+            0,
+            shipPointCount);
+
+        points.IsPlaneIdDirty = false;
+    }
+
+    if (points.IsEphemeralPlaneIdDirty)
+    {
+        renderContext.UploadShipPointMutableAttributesPlaneId(
+            shipId,
+            points.EphemeralPlaneId.data(),
+            shipPointCount,
+            pointCount - shipPointCount);
+
+        points.IsEphemeralPlaneIdDirty = false;
+    }
+
+    if (points.IsDecayDirty)
+    {
+        renderContext.UploadShipPointMutableAttributesDecay(
+            shipId,
+            points.Decay.data(),
+            0,
+            pointCount);
+
+        points.IsDecayDirty = false;
+    }
+
+    renderContext.UploadShipPointMutableAttributesEnd(shipId);
+
+
+    //
+    // Upload elements, if needed
+    //
+
+    if (mFront.AreElementsDirty
+        || !mLastDebugShipRenderMode
+        || *mLastDebugShipRenderMode != renderContext.GetDebugShipRenderMode())
+    {
+        renderContext.UploadShipElementsStart(shipId);
+
+        for (ElementIndex pointIndex : mFront.PointElements)
+        {
+            renderContext.UploadShipElementPoint(
+                shipId,
+                pointIndex);
+        }
+
+        // Either upload all springs, or just the edge springs
+        bool const doUploadAllSprings = (DebugShipRenderMode::Springs == renderContext.GetDebugShipRenderMode());
+
+        // Ropes are uploaded as springs only if DebugRenderMode is springs or edge springs
+        bool const doUploadRopesAsSprings = (
+            DebugShipRenderMode::Springs == renderContext.GetDebugShipRenderMode()
+            || DebugShipRenderMode::EdgeSprings == renderContext.GetDebugShipRenderMode());
+
+        for (auto const & spring : mFront.SpringElements)
+        {
+            if (SpringElementType::Rope == spring.Type && !doUploadRopesAsSprings)
+            {
+                renderContext.UploadShipElementRope(
+                    shipId,
+                    spring.PointIndex1,
+                    spring.PointIndex2);
+            }
+            else if (SpringElementType::InnerSpring != spring.Type || doUploadAllSprings)
+            {
+                renderContext.UploadShipElementSpring(
+                    shipId,
+                    spring.PointIndex1,
+                    spring.PointIndex2);
+            }
+        }
+
+        // Triangles only when they have changed, as the render context
+        // keeps the last uploaded ones otherwise
+        if (mFront.AreElementsDirty)
+        {
+            renderContext.UploadShipElementTrianglesStart(
+                shipId,
+                mFront.TriangleElements.size());
+
+            for (size_t t = 0; t < mFront.TriangleElements.size(); ++t)
+            {
+                renderContext.UploadShipElementTriangle(
+                    shipId,
+                    t,
+                    mFront.TriangleElements[t].PointIndex1,
+                    mFront.TriangleElements[t].PointIndex2,
+                    mFront.TriangleElements[t].PointIndex3);
+            }
+
+            renderContext.UploadShipElementTrianglesEnd(shipId);
+        }
+
+        renderContext.UploadShipElementsEnd(shipId);
+
+        mFront.AreElementsDirty = false;
+        mLastDebugShipRenderMode = renderContext.GetDebugShipRenderMode();
+    }
+
+
+    //
+    // Upload stressed springs
+    //
+
+    renderContext.UploadShipElementStressedSpringsStart(shipId);
+
+    if (renderContext.GetShowStressedSprings())
+    {
+        for (auto const & stressedSpring : mFront.StressedSpringElements)
+        {
+            renderContext.UploadShipElementStressedSpring(
+                shipId,
+                stressedSpring.PointIndex1,
+                stressedSpring.PointIndex2);
+        }
+    }
+
+    renderContext.UploadShipElementStressedSpringsEnd(shipId);
+
+
+    //
+    // Upload generic textures - bombs, pinned points, and ephemeral particles - and crosses of light
+    //
+
+    for (auto const & genericTexture : mFront.GenericTextures)
+    {
+        renderContext.UploadShipGenericTextureRenderSpecification(
+            shipId,
+            genericTexture.Plane,
+            genericTexture.FrameId,
+            genericTexture.Position,
+            genericTexture.Scale,
+            genericTexture.Angle,
+            genericTexture.Alpha);
+    }
+
+    for (auto const & crossOfLight : mFront.CrossesOfLight)
+    {
+        renderContext.UploadCrossOfLight(
+            crossOfLight.CenterPosition,
+            crossOfLight.Progress);
+    }
+
+
+    //
+    // Upload ephemeral points, if they have changed
+    //
+
+    if (mFront.AreEphemeralPointElementsDirty)
+    {
+        renderContext.UploadShipElementEphemeralPointsStart(shipId);
+
+        for (ElementIndex pointIndex : mFront.EphemeralPointElements)
+        {
+            renderContext.UploadShipElementEphemeralPoint(
+                shipId,
+                pointIndex);
+        }
+
+        renderContext.UploadShipElementEphemeralPointsEnd(shipId);
+
+        mFront.AreEphemeralPointElementsDirty = false;
+    }
+
+
+    //
+    // Upload vector fields
+    //
+
+    if (mFront.HasVectors)
+    {
+        renderContext.UploadShipVectors(
+            shipId,
+            mFront.Vector.size(),
+            mFront.VectorPosition.data(),
+            mFront.VectorPlaneId.data(),
+            mFront.Vector.data(),
+            mFront.VectorLengthAdjustment,
+            mFront.VectorColor);
+    }
+
+
+    //
+    // Finalize render
+    //
+
+    renderContext.RenderShipEnd(shipId);
+}
+
+void RenderSnapshot::Forward(
+    Stage & source,
+    Stage & target)
+{
+    if (!source.IsNew)
+        return;
+
+    //
+    // Changing at each step: swapped as a whole
+    //
+
+    target.MaxPlaneId = source.MaxPlaneId;
+    target.ShipPointCount = source.ShipPointCount;
+    target.Timestamp = source.Timestamp;
+
+    std::swap(source.StressedSpringElements, target.StressedSpringElements);
+    std::swap(source.GenericTextures, target.GenericTextures);
+    std::swap(source.CrossesOfLight, target.CrossesOfLight);
+
+    std::swap(source.VectorPosition, target.VectorPosition);
+    std::swap(source.VectorPlaneId, target.VectorPlaneId);
+    std::swap(source.Vector, target.Vector);
+    target.VectorLengthAdjustment = source.VectorLengthAdjustment;
+    target.VectorColor = source.VectorColor;
+    target.HasVectors = source.HasVectors;
+
+    PointAttributes & sourcePoints = source.Points;
+    PointAttributes & targetPoints = target.Points;
+
+    std::swap(sourcePoints.Position, targetPoints.Position);
+    std::swap(sourcePoints.Light, targetPoints.Light);
+    std::swap(sourcePoints.Water, targetPoints.Water);
+    std::swap(sourcePoints.EphemeralColor, targetPoints.EphemeralColor);
+
+    //
+    // Seldom changing: swapped only when dirty, staying dirty in the target
+    // until it's either forwarded or uploaded
+    //
+
+    auto const forwardIfDirty = [](auto & sourceBuffer, bool & isSourceDirty, auto & targetBuffer, bool & isTargetDirty)
+    {
+        if (isSourceDirty)
+        {
+            std::swap(sourceBuffer, targetBuffer);
+            isTargetDirty = true;
+            isSourceDirty = false;
+        }
+    };
+
+    forwardIfDirty(sourcePoints.Color, sourcePoints.IsColorDirty, targetPoints.Color, targetPoints.IsColorDirty);
+    forwardIfDirty(sourcePoints.PlaneId, sourcePoints.IsPlaneIdDirty, targetPoints.PlaneId, targetPoints.IsPlaneIdDirty);
+    forwardIfDirty(sourcePoints.EphemeralPlaneId, sourcePoints.IsEphemeralPlaneIdDirty, targetPoints.EphemeralPlaneId, targetPoints.IsEphemeralPlaneIdDirty);
+    forwardIfDirty(sourcePoints.Decay, sourcePoints.IsDecayDirty, targetPoints.Decay, targetPoints.IsDecayDirty);
+    forwardIfDirty(sourcePoints.TextureCoordinates, sourcePoints.IsTextureCoordinatesDirty, targetPoints.TextureCoordinates, targetPoints.IsTextureCoordinatesDirty);
+
+    if (source.AreElementsDirty)
+    {
+        std::swap(source.PointElements, target.PointElements);
+        std::swap(source.SpringElements, target.SpringElements);
+        std::swap(source.TriangleElements, target.TriangleElements);
+        target.AreElementsDirty = true;
+        source.AreElementsDirty = false;
+    }
+
+    forwardIfDirty(source.EphemeralPointElements, source.AreEphemeralPointElementsDirty, target.EphemeralPointElements, target.AreEphemeralPointElementsDirty);
+
+    target.IsNew = true;
+    source.IsNew = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+
+WorldRenderSnapshot::WorldRenderSnapshot()
+    : mPublished()
+    , mShared()
+    , mFront()
+    , mIsAcquired(false)
+{
+}
+
+void WorldRenderSnapshot::PublishStart()
+{
+}
+
+void WorldRenderSnapshot::PublishEnd()
+{
+    mPublished.IsNew = true;
+}
+
+void WorldRenderSnapshot::HandOver()
+{
+    Forward(mPublished, mShared);
+}
+
+void WorldRenderSnapshot::Acquire()
+{
+    if (mShared.IsNew)
+    {
+        Forward(mShared, mFront);
+
+        mIsAcquired = true;
+    }
+}
+
+void WorldRenderSnapshot::UploadLandAndOcean(
+    float seaDepth,
+    Render::RenderContext & renderContext) const
+{
+    assert(mIsAcquired);
+
+    size_t constexpr SlicesCount = 500;
+
+    float const visibleWorldWidth = renderContext.GetVisibleWorldWidth();
+    float const sliceWidth = visibleWorldWidth / static_cast<float>(SlicesCount);
+    float sliceX = renderContext.GetCameraWorldPosition().x - (visibleWorldWidth / 2.0f);
+
+    renderContext.UploadLandAndOceanStart(SlicesCount);
+
+    // We do one extra iteration as the number of slices is the number of quads, and the last vertical
+    // quad side must be at the end of the width
+    for (size_t i = 0; i <= SlicesCount; ++i, sliceX += sliceWidth)
+    {
+        renderContext.UploadLandAndOcean(
+            sliceX,
+            mFront.OceanFloorSamples.GetHeightAt(sliceX),
+            mFront.WaterSurfaceSamples.GetHeightAt(sliceX),
+            seaDepth);
+    }
+
+    renderContext.UploadLandAndOceanEnd();
+}
+
+void WorldRenderSnapshot::UploadStars(Render::RenderContext & renderContext)
+{
+    if (mFront.AreStarsDirty)
+    {
+        renderContext.UploadStarsStart(mFront.Stars.size());
+
+        for (auto const & star : mFront.Stars)
+        {
+            renderContext.UploadStar(star.NdcX, star.NdcY, star.Brightness);
+        }
+
+        renderContext.UploadStarsEnd();
+
+        mFront.AreStarsDirty = false;
+    }
+}
+
+void WorldRenderSnapshot::UploadClouds(Render::RenderContext & renderContext) const
+{
+    renderContext.UploadCloudsStart(mFront.Clouds.size());
+
+    for (auto const & cloud : mFront.Clouds)
+    {
+        renderContext.UploadCloud(
+            cloud.VirtualX,
+            cloud.VirtualY,
+            cloud.Scale);
+    }
+
+    renderContext.UploadCloudsEnd();
+}
+
+void WorldRenderSnapshot::Forward(
+    Stage & source,
+    Stage & target)
+{
+    if (!source.IsNew)
+        return;
+
+    std::swap(source.Clouds, target.Clouds);
+    std::swap(source.OceanFloorSamples, target.OceanFloorSamples);
+    std::swap(source.WaterSurfaceSamples, target.WaterSurfaceSamples);
+
+    if (source.AreStarsDirty)
+    {
+        std::swap(source.Stars, target.Stars);
+        target.AreStarsDirty = true;
+        source.AreStarsDirty = false;
+    }
+
+    target.IsNew = true;
+    source.IsNew = false;
+}
+
+}
@@ -0,0 +1,538 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2019-03-30
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "PeriodicSamples.h"
+#include "RenderContext.h"
+
+#include <GameCore/GameTypes.h>
+#include <GameCore/Vectors.h>
+
+#include <cassert>
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace Physics
+{
+
+/*
+ * Everything that the renderer needs of a ship, so that the renderer never reads the
+ * live state of the ship - which the simulation keeps changing, possibly on a thread
+ * of its own.
+ *
+ * The snapshot comes in three stages:
+ *  - The published stage, which the simulation records into - under the world lock - with
+ *    calls that mirror those of the render context;
+ *  - The shared stage, into which the simulation hands the published stage over, and from
+ *    which the renderer acquires it - both under a lock of their own, which is only held
+ *    for the time of swapping buffers;
+ *  - The front stage, which the renderer uploads from - without any lock.
+ *
+ * The attributes that change at each step are swapped forward as a whole; those that seldom
+ * change - e.g. colors, plane IDs, and elements - are only recorded when they have changed,
+ * and only swapped forward and uploaded in that case.
+ *
+ * Positions are double-buffered in the front stage, so that the renderer, which runs at its
+ * own pace, may interpolate them; the rendered positions thus lag behind the simulation by at
+ * most one step.
+ */
+class RenderSnapshot
+{
+public:
+
+    /*
+     * The attributes of the points, which the points copy themselves into the published stage.
+     */
+    struct PointAttributes
+    {
+        //
+        // Changing at each step
+        //
+
+        // All points, ephemeral ones included
+        std::vector<vec2f> Position;
+        std::vector<float> Light;
+        std::vector<float> Water;
+
+        // Ephemeral points only
+        std::vector<vec4f> EphemeralColor;
+
+        //
+        // Seldom changing; always copied as a whole, and only when dirty
+        //
+
+        // Non-ephemeral points only
+        std::vector<vec4f> Color;
+        bool IsColorDirty;
+
+        // Non-ephemeral points only
+        std::vector<float> PlaneId;
+        bool IsPlaneIdDirty;
+
+        // Ephemeral points only
+        std::vector<float> EphemeralPlaneId;
+        bool IsEphemeralPlaneIdDirty;
+
+        // All points
+        std::vector<float> Decay;
+        bool IsDecayDirty;
+
+        // All points
+        std::vector<vec2f> TextureCoordinates;
+        bool IsTextureCoordinatesDirty;
+
+        PointAttributes()
+            : Position()
+            , Light()
+            , Water()
+            , EphemeralColor()
+            , Color()
+            , IsColorDirty(false)
+            , PlaneId()
+            , IsPlaneIdDirty(false)
+            , EphemeralPlaneId()
+            , IsEphemeralPlaneIdDirty(false)
+            , Decay()
+            , IsDecayDirty(false)
+            , TextureCoordinates()
+            , IsTextureCoordinatesDirty(false)
+        {}
+    };
+
+public:
+
+    RenderSnapshot();
+
+    RenderSnapshot(RenderSnapshot && other) = default;
+
+    //
+    // Simulation side, under the world lock
+    //
+
+    void PublishStart(
+        PlaneId maxPlaneId,
+        size_t shipPointCount);
+
+    void PublishEnd();
+
+    PointAttributes & GetPointAttributes()
+    {
+        return mPublished.Points;
+    }
+
+    void UploadElementsStart();
+
+    void UploadElementPoint(ElementIndex pointIndex)
+    {
+        mPublished.PointElements.push_back(pointIndex);
+    }
+
+    void UploadElementSpring(
+        ElementIndex pointIndex1,
+        ElementIndex pointIndex2)
+    {
+        mPublished.SpringElements.emplace_back(pointIndex1, pointIndex2, SpringElementType::Spring);
+    }
+
+    /*
+     * Springs covered by two super-triangles, which are only rendered in springs render mode.
+     */
+    void UploadElementInnerSpring(
+        ElementIndex pointIndex1,
+        ElementIndex pointIndex2)
+    {
+        mPublished.SpringElements.emplace_back(pointIndex1, pointIndex2, SpringElementType::InnerSpring);
+    }
+
+    void UploadElementRope(
+        ElementIndex pointIndex1,
+        ElementIndex pointIndex2)
+    {
+        mPublished.SpringElements.emplace_back(pointIndex1, pointIndex2, SpringElementType::Rope);
+    }
+
+    void UploadElementTrianglesStart(size_t trianglesCount)
+    {
+        mPublished.TriangleElements.resize(trianglesCount);
+    }
+
+    void UploadElementTriangle(
+        size_t triangleIndex,
+        ElementIndex pointIndex1,
+        ElementIndex pointIndex2,
+        ElementIndex pointIndex3)
+    {
+        assert(triangleIndex < mPublished.TriangleElements.size());
+        mPublished.TriangleElements[triangleIndex] = { pointIndex1, pointIndex2, pointIndex3 };
+    }
+
+    void UploadElementStressedSpring(
+        ElementIndex pointIndex1,
+        ElementIndex pointIndex2)
+    {
+        mPublished.StressedSpringElements.push_back({ pointIndex1, pointIndex2 });
+    }
+
+    void UploadGenericTextureRenderSpecification(
+        PlaneId planeId,
+        TextureFrameId const & textureFrameId,
+        vec2f const & position,
+        float scale,
+        float angle,
+        float alpha)
+    {
+        mPublished.GenericTextures.push_back({ planeId, textureFrameId, position, scale, angle, alpha });
+    }
+
+    void UploadGenericTextureRenderSpecification(
+        PlaneId planeId,
+        TextureFrameId const & textureFrameId,
+        vec2f const & position,
+        float scale,
+        vec2f const & rotationBase,
+        vec2f const & rotationOffset,
+        float alpha)
+    {
+        UploadGenericTextureRenderSpecification(
+            planeId,
+            textureFrameId,
+            position,
+            scale,
+            rotationBase.angle(rotationOffset),
+            alpha);
+    }
+
+    void UploadGenericTextureRenderSpecification(
+        PlaneId planeId,
+        TextureFrameId const & textureFrameId,
+        vec2f const & position)
+    {
+        UploadGenericTextureRenderSpecification(
+            planeId,
+            textureFrameId,
+            position,
+            1.0f,
+            0.0f,
+            1.0f);
+    }
+
+    void UploadCrossOfLight(
+        vec2f const & centerPosition,
+        float progress)
+    {
+        mPublished.CrossesOfLight.push_back({ centerPosition, progress });
+    }
+
+    void UploadElementEphemeralPointsStart();
+
+    void UploadElementEphemeralPoint(ElementIndex pointIndex)
+    {
+        mPublished.EphemeralPointElements.push_back(pointIndex);
+    }
+
+    void UploadVectors(
+        size_t count,
+        vec2f const * position,
+        float const * planeId,
+        vec2f const * vector,
+        float lengthAdjustment,
+        vec4f const & color);
+
+    //
+    // Simulation side, under the snapshot lock
+    //
+
+    void HandOver();
+
+    //
+    // Render side, under the snapshot lock
+    //
+
+    /*
+     * Acquires the stage that has been handed over last, if it's new; when positions are not
+     * interpolated, the latest ones are rendered as they are.
+     */
+    void Acquire(bool doInterpolatePositions);
+
+    //
+    // Render side
+    //
+
+    /*
+     * Uploads the acquired stage; does nothing until a stage has been acquired.
+     */
+    void Upload(
+        ShipId shipId,
+        Render::RenderContext & renderContext);
+
+private:
+
+    enum class SpringElementType
+    {
+        Spring,
+        InnerSpring,
+        Rope
+    };
+
+    struct SpringElement
+    {
+        ElementIndex PointIndex1;
+        ElementIndex PointIndex2;
+        SpringElementType Type;
+
+        SpringElement(
+            ElementIndex pointIndex1,
+            ElementIndex pointIndex2,
+            SpringElementType type)
+            : PointIndex1(pointIndex1)
+            , PointIndex2(pointIndex2)
+            , Type(type)
+        {}
+    };
+
+    struct StressedSpringElement
+    {
+        ElementIndex PointIndex1;
+        ElementIndex PointIndex2;
+    };
+
+    struct TriangleElement
+    {
+        ElementIndex PointIndex1;
+        ElementIndex PointIndex2;
+        ElementIndex PointIndex3;
+    };
+
+    struct GenericTexture
+    {
+        PlaneId Plane;
+        TextureFrameId FrameId;
+        vec2f Position;
+        float Scale;
+        float Angle;
+        float Alpha;
+    };
+
+    struct CrossOfLight
+    {
+        vec2f CenterPosition;
+        float Progress;
+    };
+
+    struct Stage
+    {
+        //
+        // Changing at each step
+        //
+
+        PlaneId MaxPlaneId;
+        size_t ShipPointCount;
+        std::chrono::steady_clock::time_point Timestamp;
+
+        std::vector<StressedSpringElement> StressedSpringElements;
+        std::vector<GenericTexture> GenericTextures;
+        std::vector<CrossOfLight> CrossesOfLight;
+
+        std::vector<vec2f> VectorPosition;
+        std::vector<float> VectorPlaneId;
+        std::vector<vec2f> Vector;
+        float VectorLengthAdjustment;
+        vec4f VectorColor;
+        bool HasVectors;
+
+        //
+        // Points, partly seldom changing
+        //
+
+        PointAttributes Points;
+
+        //
+        // Seldom changing
+        //
+
+        std::vector<ElementIndex> PointElements;
+        std::vector<SpringElement> SpringElements;
+        std::vector<TriangleElement> TriangleElements; // In {PlaneID, Tessellation Order} order
+        bool AreElementsDirty;
+
+        std::vector<ElementIndex> EphemeralPointElements;
+        bool AreEphemeralPointElementsDirty;
+
+        // Whether the stage holds a step that hasn't been forwarded yet
+        bool IsNew;
+
+        Stage();
+    };
+
+    // Moves the new content of the source stage into the target stage
+    static void Forward(
+        Stage & source,
+        Stage & target);
+
+private:
+
+    Stage mPublished;
+    Stage mShared;
+    Stage mFront;
+
+    // The positions of the step acquired before the front one, to interpolate from
+    std::vector<vec2f> mPreviousPosition;
+    std::chrono::steady_clock::time_point mPreviousTimestamp;
+
+    bool mDoInterpolatePositions;
+
+    // Work buffer for the interpolated positions
+    std::vector<vec2f> mInterpolatedPosition;
+
+    // Whether the front stage holds anything
+    bool mIsAcquired;
+
+    // The debug ship render mode that was in effect the last time we've uploaded elements;
+    // used to detect changes and eventually re-upload
+    std::optional<DebugShipRenderMode> mLastDebugShipRenderMode;
+};
+
+/*
+ * Everything that the renderer needs of the world besides its ships; works in stages like
+ * the ship render snapshot.
+ */
+class WorldRenderSnapshot
+{
+public:
+
+    WorldRenderSnapshot();
+
+    //
+    // Simulation side, under the world lock
+    //
+
+    void PublishStart();
+
+    void PublishEnd();
+
+    void UploadStarsStart(size_t starCount)
+    {
+        mPublished.Stars.clear();
+        mPublished.Stars.reserve(starCount);
+        mPublished.AreStarsDirty = true;
+    }
+
+    void UploadStar(
+        float ndcX,
+        float ndcY,
+        float brightness)
+    {
+        mPublished.Stars.push_back({ ndcX, ndcY, brightness });
+    }
+
+    void UploadCloudsStart(size_t cloudCount)
+    {
+        mPublished.Clouds.clear();
+        mPublished.Clouds.reserve(cloudCount);
+    }
+
+    void UploadCloud(
+        float virtualX,
+        float virtualY,
+        float scale)
+    {
+        mPublished.Clouds.push_back({ virtualX, virtualY, scale });
+    }
+
+    PeriodicSamplesCopy & GetOceanFloorSamples()
+    {
+        return mPublished.OceanFloorSamples;
+    }
+
+    PeriodicSamplesCopy & GetWaterSurfaceSamples()
+    {
+        return mPublished.WaterSurfaceSamples;
+    }
+
+    //
+    // Simulation side, under the snapshot lock
+    //
+
+    void HandOver();
+
+    //
+    // Render side, under the snapshot lock
+    //
+
+    void Acquire();
+
+    //
+    // Render side
+    //
+
+    bool IsAcquired() const
+    {
+        return mIsAcquired;
+    }
+
+    void UploadLandAndOcean(
+        float seaDepth,
+        Render::RenderContext & renderContext) const;
+
+    void UploadStars(Render::RenderContext & renderContext);
+
+    void UploadClouds(Render::RenderContext & renderContext) const;
+
+private:
+
+    struct Star
+    {
+        float NdcX;
+        float NdcY;
+        float Brightness;
+    };
+
+    struct Cloud
+    {
+        float VirtualX;
+        float VirtualY;
+        float Scale;
+    };
+
+    struct Stage
+    {
+        // Changing at each step
+        std::vector<Cloud> Clouds;
+        PeriodicSamplesCopy OceanFloorSamples;
+        PeriodicSamplesCopy WaterSurfaceSamples;
+
+        // Seldom changing
+        std::vector<Star> Stars;
+        bool AreStarsDirty;
+
+        // Whether the stage holds a step that hasn't been forwarded yet
+        bool IsNew;
+
+        Stage()
+            : Clouds()
+            , OceanFloorSamples()
+            , WaterSurfaceSamples()
+            , Stars()
+            , AreStarsDirty(false)
+            , IsNew(false)
+        {}
+    };
+
+    static void Forward(
+        Stage & source,
+        Stage & target);
+
+private:
+
+    Stage mPublished;
+    Stage mShared;
+    Stage mFront;
+
+    bool mIsAcquired;
+};
+
+}
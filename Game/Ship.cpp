@@ -11,12 +11,16 @@
 #include <GameCore/GameDebug.h>
 #include <GameCore/GameMath.h>
 #include <GameCore/GameRandomEngine.h>
+#include <GameCore/LibSimdPp.h>
 #include <GameCore/Log.h>
+#include <GameCore/Profiler.h>
 #include <GameCore/Segment.h>
+#include <GameCore/ThreadPool.h>
 
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cmath>
 #include <cstring>
 #include <limits>
 #include <queue>
@@ -52,15 +56,21 @@ Ship::Ship(
     , mTriangles(std::move(triangles))
     , mElectricalElements(std::move(electricalElements))
     , mCurrentSimulationSequenceNumber()
-    , mCurrentConnectivityVisitSequenceNumber()
-    , mMaxMaxPlaneId(0)
+    , mConnectivityVisit()
     , mCurrentElectricalVisitSequenceNumber()
     , mIsStructureDirty(true)
-    , mLastDebugShipRenderMode()
+    , mIsConnectivityDirty(false)
     , mPlaneTrianglesRenderIndices()
     , mIsSinking(false)
     , mTotalWater(0.0)
     , mWaterSplashedRunningAverage()
+    , mDiffusedLampLights()
+    , mDiffusedLampPositions()
+    , mDiffusedLightSpreadAdjustment(0.0f)
+    , mIsLightDirty(true)
+    , mStepsSinceLightDiffusion(0)
+    , mIsAnyDiffusedLampLit(false)
+    , mLitPoints()
     , mPinnedPoints(
         mParentWorld,
         mId,
@@ -75,6 +85,17 @@ Ship::Ship(
         mPoints,
         mSprings)
     , mCurrentForceFields()
+    , mPointGrid()
+    , mSpringBvh()
+    , mWaterDiffusion()
+    , mRenderSnapshot()
+    , mMechanicalDynamics()
+    , mMechanicalDynamicsIterationsFraction(1.0f)
+    , mAdaptiveIterationsCalmStepCount(0)
+    , mConnectedComponentSleepStates()
+    , mAwakePointRuns()
+    , mAwakeSpringRuns()
+    , mAreAwakeRunsDirty(true)
 {
     // Set destroy handlers
     mPoints.RegisterDestroyHandler(std::bind(&Ship::PointDestroyHandler, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
@@ -108,6 +129,12 @@ void Ship::MoveBy(
         positionBuffer[p] += offset;
         velocityBuffer[p] = velocity;
     }
+
+    mPointGrid.Invalidate();
+    mSpringBvh.Invalidate();
+
+    // The whole ship is moving now
+    WakeAllConnectedComponents();
 }
 
 void Ship::RotateBy(
@@ -134,6 +161,12 @@ void Ship::RotateBy(
         velocityBuffer[p] = (pos - positionBuffer[p]) * inertia;
         positionBuffer[p] = pos;
     }
+
+    mPointGrid.Invalidate();
+    mSpringBvh.Invalidate();
+
+    // The whole ship is moving now
+    WakeAllConnectedComponents();
 }
 
 void Ship::DestroyAt(
@@ -147,17 +180,17 @@ void Ship::DestroyAt(
         * radiusMultiplier
         * (gameParameters.IsUltraViolentMode ? 10.0f : 1.0f);
 
-    float const squareRadius = radius * radius;
-
     // Destroy all points within the radius
-    for (auto pointIndex : mPoints)
-    {
-        // The only ephemeral points we allow to delete are air bubbles
-        if (!mPoints.IsDeleted(pointIndex)
-            && (Points::EphemeralType::None == mPoints.GetEphemeralType(pointIndex)
-                || Points::EphemeralType::AirBubble == mPoints.GetEphemeralType(pointIndex)))
+    GetPointGrid().VisitPointsInRadius(
+        targetPos,
+        radius,
+        mPoints,
+        [&](ElementIndex pointIndex, float /*squareDistance*/)
         {
-            if ((mPoints.GetPosition(pointIndex) - targetPos).squareLength() < squareRadius)
+            // The only ephemeral points we allow to delete are air bubbles
+            if (!mPoints.IsDeleted(pointIndex)
+                && (Points::EphemeralType::None == mPoints.GetEphemeralType(pointIndex)
+                    || Points::EphemeralType::AirBubble == mPoints.GetEphemeralType(pointIndex)))
             {
                 // Destroy point
                 mPoints.Destroy(
@@ -166,8 +199,7 @@ void Ship::DestroyAt(
                     currentSimulationTime,
                     gameParameters);
             }
-        }
-    }
+        });
 }
 
 void Ship::SawThrough(
@@ -183,47 +215,50 @@ void Ship::SawThrough(
     unsigned int metalsSawed = 0;
     unsigned int nonMetalsSawed = 0;
 
-    for (auto springIndex : mSprings)
-    {
-        if (!mSprings.IsDeleted(springIndex))
+    GetSpringBvh().VisitSpringsNearSegment(
+        startPos,
+        endPos,
+        [&](ElementIndex springIndex)
         {
-            if (Geometry::Segment::ProperIntersectionTest(
-                startPos,
-                endPos,
-                mSprings.GetPointAPosition(springIndex, mPoints),
-                mSprings.GetPointBPosition(springIndex, mPoints)))
+            if (!mSprings.IsDeleted(springIndex))
             {
-                // Destroy spring
-                mSprings.Destroy(
-                    springIndex,
-                    Springs::DestroyOptions::FireBreakEvent
-                    | Springs::DestroyOptions::DestroyOnlyConnectedTriangle,
-                    currentSimulationTime,
-                    gameParameters,
-                    mPoints);
-
-                bool const isMetal =
-                    mSprings.GetBaseStructuralMaterial(springIndex).MaterialSound == StructuralMaterial::MaterialSoundType::Metal;
-
-                if (isMetal)
+                if (Geometry::Segment::ProperIntersectionTest(
+                    startPos,
+                    endPos,
+                    mSprings.GetPointAPosition(springIndex, mPoints),
+                    mSprings.GetPointBPosition(springIndex, mPoints)))
                 {
-                    // Emit sparkles
-                    GenerateSparkles(
+                    // Destroy spring
+                    mSprings.Destroy(
                         springIndex,
-                        startPos,
-                        endPos,
+                        Springs::DestroyOptions::FireBreakEvent
+                        | Springs::DestroyOptions::DestroyOnlyConnectedTriangle,
                         currentSimulationTime,
-                        gameParameters);
-                }
+                        gameParameters,
+                        mPoints);
 
-                // Remember we have sawed this material
-                if (isMetal)
-                    metalsSawed++;
-                else
-                    nonMetalsSawed++;
+                    bool const isMetal =
+                        mSprings.GetBaseStructuralMaterial(springIndex).MaterialSound == StructuralMaterial::MaterialSoundType::Metal;
+
+                    if (isMetal)
+                    {
+                        // Emit sparkles
+                        GenerateSparkles(
+                            springIndex,
+                            startPos,
+                            endPos,
+                            currentSimulationTime,
+                            gameParameters);
+                    }
+
+                    // Remember we have sawed this material
+                    if (isMetal)
+                        metalsSawed++;
+                    else
+                        nonMetalsSawed++;
+                }
             }
-        }
-    }
+        });
 
     // Notify (including zero)
     mGameEventHandler->OnSawed(true, metalsSawed);
@@ -258,9 +293,15 @@ bool Ship::TogglePinAt(
     vec2f const & targetPos,
     GameParameters const & gameParameters)
 {
-    return mPinnedPoints.ToggleAt(
+    bool const isToggled = mPinnedPoints.ToggleAt(
         targetPos,
         gameParameters);
+
+    // An unpinned point might now be free to move
+    if (isToggled)
+        WakeAllConnectedComponents();
+
+    return isToggled;
 }
 
 bool Ship::InjectBubblesAt(
@@ -273,7 +314,7 @@ bool Ship::InjectBubblesAt(
         GenerateAirBubbles(
             targetPos,
             currentSimulationTime,
-            mMaxMaxPlaneId,
+            mConnectivityVisit.GetMaxPlaneId(),
             gameParameters);
 
         return true;
@@ -300,26 +341,32 @@ bool Ship::FloodAt(
     // Find the (non-ephemeral) non-hull points in the radius
     //
 
-    float const searchSquareRadius = searchRadius * searchRadius;
-
     bool anyHasFlooded = false;
-    for (auto pointIndex : mPoints.NonEphemeralPoints())
-    {
-        if (!mPoints.IsDeleted(pointIndex)
-            && !mPoints.IsHull(pointIndex))
+    GetPointGrid().VisitPointsInRadius(
+        targetPos,
+        searchRadius,
+        mPoints,
+        [&](ElementIndex pointIndex, float /*squareDistance*/)
         {
-            float squareDistance = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
-            if (squareDistance < searchSquareRadius)
+            if (!mPoints.IsEphemeral(pointIndex)
+                && !mPoints.IsDeleted(pointIndex)
+                && !mPoints.IsHull(pointIndex))
             {
                 if (quantityOfWater >= 0.0f)
+                {
                     mPoints.GetWater(pointIndex) += quantityOfWater;
+                    mPoints.AddToWaterActiveSet(pointIndex);
+                }
                 else
+                {
                     mPoints.GetWater(pointIndex) -= std::min(-quantityOfWater, mPoints.GetWater(pointIndex));
+                }
+
+                WakeConnectedComponent(mPoints.GetConnectedComponentId(pointIndex));
 
                 anyHasFlooded = true;
             }
-        }
-    }
+        });
 
     return anyHasFlooded;
 }
@@ -392,36 +439,40 @@ bool Ship::ScrubThrough(
         std::max(startPos.y, endPos.y) + scrubRadius,   // Top
         std::min(startPos.y, endPos.y) - scrubRadius);  // Bottom
 
-    // Visit all points (excluding ephemerals, we don't want to scrub air bubbles)
+    // Visit all points in the bounding box's neighborhood (excluding ephemerals,
+    // we don't want to scrub air bubbles)
     bool hasScrubbed = false;
-    for (auto pointIndex : mPoints.NonEphemeralPoints())
-    {
-        auto const & pointPosition = mPoints.GetPosition(pointIndex);
-
-        // First check whether the point is in the bounding box
-        if (boundingBox.Contains(pointPosition))
+    GetPointGrid().VisitPointsInBox(
+        boundingBox,
+        [&](ElementIndex pointIndex)
         {
-            // Distance = projection of (start->point) vector on segment normal
-            float const distance = abs((pointPosition - startPos).dot(segmentNormal));
+            auto const & pointPosition = mPoints.GetPosition(pointIndex);
 
-            // Check whether this point is in the radius
-            if (distance <= scrubRadius)
+            // First check whether the point is in the bounding box
+            if (!mPoints.IsEphemeral(pointIndex)
+                && boundingBox.Contains(pointPosition))
             {
-                //
-                // Scrub this point, with magnitude dependent from distance
-                //
+                // Distance = projection of (start->point) vector on segment normal
+                float const distance = abs((pointPosition - startPos).dot(segmentNormal));
+
+                // Check whether this point is in the radius
+                if (distance <= scrubRadius)
+                {
+                    //
+                    // Scrub this point, with magnitude dependent from distance
+                    //
 
-                float newDecay =
-                    mPoints.GetDecay(pointIndex)
-                    + 0.5f * (1.0f - mPoints.GetDecay(pointIndex)) * (scrubRadius - distance) / scrubRadius;
+                    float newDecay =
+                        mPoints.GetDecay(pointIndex)
+                        + 0.5f * (1.0f - mPoints.GetDecay(pointIndex)) * (scrubRadius - distance) / scrubRadius;
 
-                    mPoints.SetDecay(pointIndex, newDecay);
+                        mPoints.SetDecay(pointIndex, newDecay);
 
-                // Remember at least one point has been scrubbed
-                hasScrubbed |= true;
+                    // Remember at least one point has been scrubbed
+                    hasScrubbed |= true;
+                }
             }
-        }
-    }
+        });
 
     if (hasScrubbed)
     {
@@ -436,48 +487,20 @@ ElementIndex Ship::GetNearestPointAt(
     vec2f const & targetPos,
     float radius) const
 {
-    float const squareRadius = radius * radius;
-
-    ElementIndex bestPointIndex = NoneElementIndex;
-    float bestSquareDistance = std::numeric_limits<float>::max();
-
-    for (auto pointIndex : mPoints)
-    {
-        if (!mPoints.IsDeleted(pointIndex))
-        {
-            float squareDistance = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
-            if (squareDistance < squareRadius && squareDistance < bestSquareDistance)
-            {
-                bestPointIndex = pointIndex;
-                bestSquareDistance = squareDistance;
-            }
-        }
-    }
-
-    return bestPointIndex;
+    return GetPointGrid().FindNearestPointInRadius(
+        targetPos,
+        radius,
+        mPoints);
 }
 
 bool Ship::QueryNearestPointAt(
     vec2f const & targetPos,
     float radius) const
 {
-    float const squareRadius = radius * radius;
-
-    ElementIndex bestPointIndex = NoneElementIndex;
-    float bestSquareDistance = std::numeric_limits<float>::max();
-
-    for (auto pointIndex : mPoints)
-    {
-        if (!mPoints.IsDeleted(pointIndex))
-        {
-            float squareDistance = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
-            if (squareDistance < squareRadius && squareDistance < bestSquareDistance)
-            {
-                bestPointIndex = pointIndex;
-                bestSquareDistance = squareDistance;
-            }
-        }
-    }
+    ElementIndex const bestPointIndex = GetPointGrid().FindNearestPointInRadius(
+        targetPos,
+        radius,
+        mPoints);
 
     if (NoneElementIndex != bestPointIndex)
     {
@@ -491,8 +514,10 @@ bool Ship::QueryNearestPointAt(
 void Ship::Update(
     float currentSimulationTime,
     GameParameters const & gameParameters,
-    Render::RenderContext const & renderContext)
+    VectorFieldRenderMode vectorFieldRenderMode)
 {
+    PROFILE_PHASE(ShipUpdate);
+
     // Get the current wall clock time
     auto const currentWallClockTime = GameWallClock::GetInstance().Now();
 
@@ -503,17 +528,45 @@ void Ship::Update(
     VerifyInvariants();
 #endif
 
+    //
+    // Force fields wake everything up, as they may reach anywhere, and
+    // require all of the mechanical iterations
+    //
+
+    if (!mCurrentForceFields.empty())
+    {
+        WakeAllConnectedComponents();
+
+        mMechanicalDynamicsIterationsFraction = 1.0f;
+        mAdaptiveIterationsCalmStepCount = 0;
+    }
+
+    //
+    // Scale the number of mechanical iterations; everything that depends on it - integration
+    // factors, spring coefficients, damping, and spring strengths - follows the scaled number
+    //
+
+    GameParameters mechanicalGameParameters = gameParameters;
+    mechanicalGameParameters.NumMechanicalDynamicsIterationsAdjustment *= mMechanicalDynamicsIterationsFraction;
+
     //
     // Process eventual parameter changes
     //
 
     mPoints.UpdateGameParameters(
-        gameParameters);
+        mechanicalGameParameters);
 
     mSprings.UpdateGameParameters(
-        gameParameters,
+        mechanicalGameParameters,
         mPoints);
 
+    //
+    // Find the elements that are awake
+    //
+
+    if (mAreAwakeRunsDirty)
+        UpdateAwakeRuns();
+
     //
     // Rot points
     //
@@ -545,8 +598,8 @@ void Ship::Update(
 
     UpdateMechanicalDynamics(
         currentSimulationTime,
-        gameParameters,
-        renderContext);
+        mechanicalGameParameters,
+        vectorFieldRenderMode);
 
 
     //
@@ -565,9 +618,13 @@ void Ship::Update(
     // (which would flag our structure as dirty)
     //
 
-    mBombs.Update(
-        currentWallClockTime,
-        gameParameters);
+    {
+        PROFILE_PHASE(Bombs);
+
+        mBombs.Update(
+            currentWallClockTime,
+            gameParameters);
+    }
 
 
     //
@@ -575,10 +632,20 @@ void Ship::Update(
     // (which would flag our structure as dirty)
     //
 
-    mSprings.UpdateStrains(
-        currentSimulationTime,
-        gameParameters,
-        mPoints);
+    bool isAtLeastOneSpringBroken;
+
+    {
+        PROFILE_PHASE(Strains);
+
+        isAtLeastOneSpringBroken = mSprings.UpdateStrains(
+            currentSimulationTime,
+            mechanicalGameParameters,
+            mPoints);
+    }
+
+    UpdateMechanicalDynamicsIterationsFraction(
+        isAtLeastOneSpringBroken,
+        gameParameters);
 
 
 
@@ -591,6 +658,13 @@ void Ship::Update(
         gameParameters);
 
 
+    //
+    // Put connected components that have settled to sleep
+    //
+
+    UpdateSleep(gameParameters);
+
+
     //
     // Update electrical dynamics
     //
@@ -608,6 +682,35 @@ void Ship::Update(
         currentSimulationTime,
         gameParameters);
 
+
+    //
+    // Refresh the spatial indices, now that points have moved; we rebuild them right away
+    // only if they're being used (e.g. by a tool being dragged), so that the next interaction
+    // does not pay for it, otherwise we'll rebuild them if and when they're needed
+    //
+
+    {
+        PROFILE_PHASE(SpatialIndices);
+
+        if (mPointGrid.IsInUse())
+            mPointGrid.Rebuild(mPoints);
+        else
+            mPointGrid.Invalidate();
+
+        if (mSpringBvh.IsInUse())
+            mSpringBvh.Refit(mSprings, mPoints);
+        else
+            mSpringBvh.Invalidate();
+    }
+
+    //
+    // Compact the springs connected to the points, if destroyed springs have left
+    // too many holes in their layout
+    //
+
+    if (mPoints.AreConnectedSpringsFragmented())
+        mPoints.CompactConnectedSprings();
+
 #ifdef _DEBUG
     VerifyInvariants();
 #endif
@@ -616,155 +719,125 @@ void Ship::Update(
 void Ship::Render(
     GameParameters const & /*gameParameters*/,
     Render::RenderContext & renderContext)
+{
+    PROFILE_PHASE(ShipRender);
+
+    mRenderSnapshot.Upload(
+        mId,
+        renderContext);
+}
+
+void Ship::PublishRenderSnapshot(VectorFieldRenderMode vectorFieldRenderMode)
 {
     //
-    // Run connectivity visit, if there have been any deletions
+    // Run connectivity visit, if there have been any deletions, so that
+    // plane IDs are current with the structure that we publish
     //
 
-    if (mIsStructureDirty)
+    if (mIsConnectivityDirty)
     {
         RunConnectivityVisit();
     }
 
 
     //
-    // Initialize render
+    // Initialize publish
     //
 
-    renderContext.RenderShipStart(
-        mId,
-        mMaxMaxPlaneId);
+    mRenderSnapshot.PublishStart(
+        mConnectivityVisit.GetMaxPlaneId(),
+        mPoints.GetShipPointCount());
 
 
     //
-    // Upload points's attributes
+    // Publish points's attributes
     //
 
-    mPoints.UploadAttributes(
-        mId,
-        renderContext);
+    mPoints.CopyRenderAttributes(mRenderSnapshot.GetPointAttributes());
 
 
     //
-    // Upload elements, if needed
+    // Publish elements, if they have changed
     //
 
-    if (mIsStructureDirty
-        || !mLastDebugShipRenderMode
-        || *mLastDebugShipRenderMode != renderContext.GetDebugShipRenderMode())
+    if (mIsStructureDirty)
     {
-        renderContext.UploadShipElementsStart(mId);
+        mRenderSnapshot.UploadElementsStart();
 
         //
-        // Upload all the point elements
+        // Publish all the point elements
         //
 
-        mPoints.UploadElements(
-            mId,
-            renderContext);
+        mPoints.UploadElements(mRenderSnapshot);
 
         //
-        // Upload all the spring elements (including ropes)
+        // Publish all the spring elements (including ropes)
         //
 
-        mSprings.UploadElements(
-            mId,
-            renderContext);
+        mSprings.UploadElements(mRenderSnapshot);
 
         //
-        // Upload triangles, but only if structure is dirty
-        // (we can't upload otherwise as mPlaneTrianglesRenderIndices is one-time use)
+        // Publish triangles
         //
 
-        if (mIsStructureDirty)
-        {
-            assert(mPlaneTrianglesRenderIndices.size() >= 1);
-
-            renderContext.UploadShipElementTrianglesStart(
-                mId,
-                mPlaneTrianglesRenderIndices.back());
+        assert(mPlaneTrianglesRenderIndices.size() >= 1);
 
-            mTriangles.UploadElements(
-                mPlaneTrianglesRenderIndices,
-                mId,
-                mPoints,
-                renderContext);
+        mRenderSnapshot.UploadElementTrianglesStart(mPlaneTrianglesRenderIndices.back());
 
-            renderContext.UploadShipElementTrianglesEnd(mId);
-        }
+        mTriangles.UploadElements(
+            mPlaneTrianglesRenderIndices,
+            mPoints,
+            mRenderSnapshot);
 
-        renderContext.UploadShipElementsEnd(mId);
+        mIsStructureDirty = false;
     }
 
 
     //
-    // Upload stressed springs
+    // Publish stressed springs
     //
     // We do this regardless of whether or not elements are dirty,
-    // as the set of stressed springs is bound to change from frame to frame
+    // as the set of stressed springs is bound to change from step to step
     //
 
-    renderContext.UploadShipElementStressedSpringsStart(mId);
-
-    if (renderContext.GetShowStressedSprings())
-    {
-        mSprings.UploadStressedSpringElements(
-            mId,
-            renderContext);
-    }
-
-    renderContext.UploadShipElementStressedSpringsEnd(mId);
+    mSprings.UploadStressedSpringElements(mRenderSnapshot);
 
 
     //
-    // Upload bombs
+    // Publish bombs
     //
 
-    mBombs.Upload(
-        mId,
-        renderContext);
+    mBombs.Upload(mRenderSnapshot);
 
 
     //
-    // Upload pinned points
+    // Publish pinned points
     //
 
-    mPinnedPoints.Upload(
-        mId,
-        renderContext);
+    mPinnedPoints.Upload(mRenderSnapshot);
 
 
     //
-    // Upload ephemeral points
+    // Publish ephemeral points
     //
 
-    mPoints.UploadEphemeralParticles(
-        mId,
-        renderContext);
+    mPoints.UploadEphemeralParticles(mRenderSnapshot);
 
 
     //
-    // Upload vector fields
+    // Publish vector fields
     //
 
     mPoints.UploadVectors(
-        mId,
-        renderContext);
+        vectorFieldRenderMode,
+        mRenderSnapshot);
 
 
     //
-    // Finalize render
+    // Finalize publish
     //
 
-    renderContext.RenderShipEnd(mId);
-
-
-    //
-    // Reset render state
-    //
-
-    mIsStructureDirty = false;
-    mLastDebugShipRenderMode = renderContext.GetDebugShipRenderMode();
+    mRenderSnapshot.PublishEnd();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////
@@ -779,8 +852,10 @@ void Ship::Render(
 void Ship::UpdateMechanicalDynamics(
     float currentSimulationTime,
     GameParameters const & gameParameters,
-    Render::RenderContext const & renderContext)
+    VectorFieldRenderMode vectorFieldRenderMode)
 {
+    PROFILE_PHASE(MechanicalDynamics);
+
     //
     // 1. Recalculate total masses and everything else that derives from them, once and for all
     //
@@ -788,47 +863,165 @@ void Ship::UpdateMechanicalDynamics(
     mPoints.UpdateTotalMasses(gameParameters);
 
     //
-    // 2. Run iterations
+    // 2. Decide whether we're worth parallelizing
     //
 
-    int const numMechanicalDynamicsIterations = gameParameters.NumMechanicalDynamicsIterations<int>();
+    ThreadPool & threadPool = mParentWorld.GetThreadPool();
 
-    for (int iter = 0; iter < numMechanicalDynamicsIterations; ++iter)
-    {
-        // Apply force fields - if we have any
-        for (auto const & forceField : mCurrentForceFields)
+    mMechanicalDynamics.SetPartitionCount(
+        std::min(
+            threadPool.GetParallelism(),
+            static_cast<size_t>(mSprings.GetElementCount()) / MinSpringsPerMechanicalDynamicsPartition),
+        mPoints.GetBufferElementCount(),
+        mSprings.GetElementCount(),
+        Springs::SimdBatchSize,
+        [this]()
         {
-            forceField->Apply(
-                mPoints,
-                currentSimulationTime,
-                gameParameters);
-        }
+            return mPoints.AllocateWorkBufferVec2f();
+        });
 
-        // Update point forces
-        UpdatePointForces(gameParameters);
+    //
+    // 3. Run iterations
+    //
+    // Only the points and springs that are awake are visited; sleeping points do not move,
+    // and the forces that they might still receive from merges and from the springs that
+    // share a SIMD batch with awake springs are discarded when they wake up
+    //
 
-        // Update springs forces
-        UpdateSpringForces(gameParameters);
+    int const numMechanicalDynamicsIterations = gameParameters.NumMechanicalDynamicsIterations<int>();
 
-        // Check whether we need to save the last force buffer before we zero it out
-        if (iter == numMechanicalDynamicsIterations - 1
-            && VectorFieldRenderMode::PointForce == renderContext.GetVectorFieldRenderMode())
+    // Only the force fields that need the grid get it built
+    ForceField::PointGridProvider const pointGridProvider =
+        [this]() -> PointGrid const &
         {
-            mPoints.CopyForceBufferToForceRenderBuffer();
-        }
+            return GetPointGrid();
+        };
+
+    mMechanicalDynamics.RunIterations(
+        numMechanicalDynamicsIterations,
+        mPoints.GetElementCount(),
+        mPoints.GetBufferElementCount(),
+        mSprings.GetElementCount(),
+        mPoints.GetForceBufferAsVec2(),
+        threadPool,
+        [&](int /*iter*/)
+        {
+            // Apply force fields - if we have any
+            for (auto const & forceField : mCurrentForceFields)
+            {
+                forceField->Apply(
+                    mPoints,
+                    pointGridProvider,
+                    currentSimulationTime,
+                    gameParameters);
+            }
+        },
+        [&](ElementIndex startPointIndex, ElementIndex endPointIndex)
+        {
+            VisitRuns(
+                mAwakePointRuns,
+                startPointIndex,
+                endPointIndex,
+                [&](ElementIndex runStartPointIndex, ElementIndex runEndPointIndex)
+                {
+                    UpdatePointForces(runStartPointIndex, runEndPointIndex, gameParameters);
+                });
+        },
+        [&](ElementIndex startSpringIndex, ElementIndex endSpringIndex, vec2f * restrict forceBuffer)
+        {
+            VisitRuns(
+                mAwakeSpringRuns,
+                startSpringIndex,
+                endSpringIndex,
+                [&](ElementIndex runStartSpringIndex, ElementIndex runEndSpringIndex)
+                {
+                    UpdateSpringForces(runStartSpringIndex, runEndSpringIndex, forceBuffer, gameParameters);
+                });
+        },
+        [&](int iter)
+        {
+            // Check whether we need to save the last force buffer before we zero it out
+            if (iter == numMechanicalDynamicsIterations - 1
+                && VectorFieldRenderMode::PointForce == vectorFieldRenderMode)
+            {
+                mPoints.CopyForceBufferToForceRenderBuffer();
+            }
+        },
+        [&](ElementIndex startPointIndex, ElementIndex endPointIndex)
+        {
+            // Integrate and reset forces to zero
+            VisitRuns(
+                mAwakePointRuns,
+                startPointIndex,
+                endPointIndex,
+                [&](ElementIndex runStartPointIndex, ElementIndex runEndPointIndex)
+                {
+                    IntegrateAndResetPointForces(runStartPointIndex, runEndPointIndex, gameParameters);
+                });
+
+            // Handle collisions with sea floor
+            VisitRuns(
+                mAwakePointRuns,
+                startPointIndex,
+                std::min(endPointIndex, mPoints.GetElementCount()),
+                [&](ElementIndex runStartPointIndex, ElementIndex runEndPointIndex)
+                {
+                    HandleCollisionsWithSeaFloor(runStartPointIndex, runEndPointIndex, gameParameters);
+                });
+        });
+
+    // Consume force fields
+    mCurrentForceFields.clear();
+
+    //
+    // 4. Re-sample water heights at the final positions, for the
+    //    water dynamics and the ephemeral particles
+    //
 
-        // Integrate and reset forces to zero
-        IntegrateAndResetPointForces(gameParameters);
+    mPoints.SampleWaterHeights(0, mPoints.GetElementCount());
+}
+
+void Ship::UpdateMechanicalDynamicsIterationsFraction(
+    bool isAtLeastOneSpringBroken,
+    GameParameters const & gameParameters)
+{
+    //
+    // The number of iterations is adapted between steps rather than within a step, as
+    // each iteration advances the simulation by the step's duration divided by the
+    // number of iterations; it only changes rarely, as each change requires
+    // re-calculating the coefficients of all points and springs
+    //
 
-        // Handle collisions with sea floor
-        HandleCollisionsWithSeaFloor(gameParameters);
+    if (!gameParameters.DoAdaptMechanicalDynamicsIterations
+        || isAtLeastOneSpringBroken
+        || mSprings.GetMaxStrain() > AdaptiveIterationsMinAgitatedStrain)
+    {
+        // Back to all iterations at once
+        mMechanicalDynamicsIterationsFraction = 1.0f;
+        mAdaptiveIterationsCalmStepCount = 0;
     }
+    else if (mSprings.GetMaxStrain() <= AdaptiveIterationsMaxCalmStrain)
+    {
+        if (++mAdaptiveIterationsCalmStepCount >= AdaptiveIterationsCalmStepCount)
+        {
+            mMechanicalDynamicsIterationsFraction = std::max(
+                mMechanicalDynamicsIterationsFraction * 0.5f,
+                MinMechanicalDynamicsIterationsFraction);
 
-    // Consume force fields
-    mCurrentForceFields.clear();
+            mAdaptiveIterationsCalmStepCount = 0;
+        }
+    }
+    else
+    {
+        // Neither calm nor agitated - stay where we are
+        mAdaptiveIterationsCalmStepCount = 0;
+    }
 }
 
-void Ship::UpdatePointForces(GameParameters const & gameParameters)
+void Ship::UpdatePointForces(
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex,
+    GameParameters const & gameParameters)
 {
     float const densityAdjustedWaterMass = GameParameters::WaterMass * gameParameters.WaterDensityAdjustment;
 
@@ -848,10 +1041,13 @@ void Ship::UpdatePointForces(GameParameters const & gameParameters)
         GameParameters::WaterDragLinearCoefficient
         * gameParameters.WaterDragAdjustment;
 
-    for (auto pointIndex : mPoints)
+    // Sample the height of water at all of the points, in one go
+    mPoints.SampleWaterHeights(startPointIndex, endPointIndex);
+
+    for (ElementIndex pointIndex = startPointIndex; pointIndex < endPointIndex; ++pointIndex)
     {
         // Get height of water at this point
-        float const waterHeightAtThisPoint = mParentWorld.GetWaterHeightAt(mPoints.GetPosition(pointIndex).x);
+        float const waterHeightAtThisPoint = mPoints.GetWaterHeight(pointIndex);
 
         //
         // 1. Add gravity and buoyancy
@@ -921,9 +1117,34 @@ void Ship::UpdatePointForces(GameParameters const & gameParameters)
     }
 }
 
-void Ship::UpdateSpringForces(GameParameters const & /*gameParameters*/)
+void Ship::UpdateSpringForces(
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex,
+    vec2f * restrict forceBuffer,
+    GameParameters const & gameParameters)
 {
-    for (auto springIndex : mSprings)
+    if (gameParameters.DoVectorizeSpringForces)
+    {
+        // Batched springs first, then the springs that could not be batched
+        ElementIndex const vectorizedEndSpringIndex = std::max(
+            startSpringIndex,
+            std::min(endSpringIndex, mSprings.GetSimdBatchedElementCount()));
+
+        UpdateSpringForces_Vectorized(startSpringIndex, vectorizedEndSpringIndex, forceBuffer);
+        UpdateSpringForces_Naive(vectorizedEndSpringIndex, endSpringIndex, forceBuffer);
+    }
+    else
+    {
+        UpdateSpringForces_Naive(startSpringIndex, endSpringIndex, forceBuffer);
+    }
+}
+
+void Ship::UpdateSpringForces_Naive(
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex,
+    vec2f * restrict forceBuffer)
+{
+    for (ElementIndex springIndex = startSpringIndex; springIndex < endSpringIndex; ++springIndex)
     {
         auto const pointAIndex = mSprings.GetPointAIndex(springIndex);
         auto const pointBIndex = mSprings.GetPointBIndex(springIndex);
@@ -965,50 +1186,193 @@ void Ship::UpdateSpringForces(GameParameters const & /*gameParameters*/)
         // Apply forces
         //
 
-        mPoints.GetForce(pointAIndex) += fSpringA + fDampA;
-        mPoints.GetForce(pointBIndex) -= fSpringA + fDampA;
+        forceBuffer[pointAIndex] += fSpringA + fDampA;
+        forceBuffer[pointBIndex] -= fSpringA + fDampA;
     }
 }
 
-void Ship::IntegrateAndResetPointForces(GameParameters const & gameParameters)
+void Ship::UpdateSpringForces_Vectorized(
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex,
+    vec2f * restrict forceBuffer)
 {
-    float const dt = gameParameters.MechanicalSimulationStepTimeDuration<float>();
-
-    // Global damp - lowers velocity uniformly, damping oscillations originating between gravity and buoyancy
-    //
-    // Considering that:
-    //
-    //  v1 = d*v0
-    //  v2 = d*v1 =(d^2)*v0
-    //  ...
-    //  vN = (d^N)*v0
     //
-    // ...the more the number of iterations, the more damped the initial velocity would be.
-    // We want damping to be independent from the number of iterations though, so we need to find the value
-    // d such that after N iterations the damping is the same as our reference value, which is based on
-    // 12 (basis) iterations. For example, double the number of iterations requires square root (1/2) of
-    // this value.
+    // Processes springs four at a time; relies on the springs in each batch
+    // not sharing any endpoints, which is guaranteed by ShipBuilder
     //
 
-    float const globalDampCoefficient = pow(
-        GameParameters::GlobalDamp,
-        12.0f / gameParameters.NumMechanicalDynamicsIterations<float>());
+    static_assert(Springs::SimdBatchSize == 4);
+    assert(0 == (startSpringIndex % Springs::SimdBatchSize));
+    assert(0 == (endSpringIndex % Springs::SimdBatchSize));
+    assert(endSpringIndex <= mSprings.GetSimdBatchedElementCount());
 
-    //
-    // Take the four buffers that we need as restrict pointers, so that the compiler
-    // can better see it should parallelize this loop as much as possible
-    //
-    // This loop is compiled with single-precision packet SSE instructions on MSVC 17,
-    // integrating two points at each iteration
-    //
+    vec2f const * const restrict positionBuffer = mPoints.GetPositionBufferAsVec2();
+    vec2f const * const restrict velocityBuffer = mPoints.GetVelocityBufferAsVec2();
+    Springs::Endpoints const * const restrict endpointsBuffer = mSprings.GetEndpointsBuffer();
+    float const * const restrict restLengthBuffer = mSprings.GetRestLengthBufferAsFloat();
+    float const * const restrict coefficientsBuffer = mSprings.GetCoefficientsBufferAsFloat();
 
-    float * restrict positionBuffer = mPoints.GetPositionBufferAsFloat();
-    float * restrict velocityBuffer = mPoints.GetVelocityBufferAsFloat();
-    float * restrict forceBuffer = mPoints.GetForceBufferAsFloat();
-    float * restrict integrationFactorBuffer = mPoints.GetIntegrationFactorBufferAsFloat();
+    // Loads two vec2f's into one register: x0,y0,x1,y1
+    auto const loadPair = [](vec2f const * restrict v0, vec2f const * restrict v1) -> __m128
+    {
+        return _mm_loadh_pi(
+            _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const *>(v0))),
+            reinterpret_cast<__m64 const *>(v1));
+    };
 
-    size_t const count = mPoints.GetBufferElementCount() * 2; // Two components per vector
-    for (size_t i = 0; i < count; ++i)
+    // Stores one register into two vec2f's
+    auto const storePair = [](__m128 value, vec2f * restrict v0, vec2f * restrict v1)
+    {
+        _mm_store_sd(reinterpret_cast<double *>(v0), _mm_castps_pd(value));
+        _mm_storeh_pi(reinterpret_cast<__m64 *>(v1), value);
+    };
+
+    for (ElementIndex s = startSpringIndex; s < endSpringIndex; s += 4)
+    {
+        // No need to check whether the springs are deleted, as a deleted spring
+        // has zero coefficients
+
+        ElementIndex const s0_pA = endpointsBuffer[s].PointAIndex;
+        ElementIndex const s0_pB = endpointsBuffer[s].PointBIndex;
+        ElementIndex const s1_pA = endpointsBuffer[s + 1].PointAIndex;
+        ElementIndex const s1_pB = endpointsBuffer[s + 1].PointBIndex;
+        ElementIndex const s2_pA = endpointsBuffer[s + 2].PointAIndex;
+        ElementIndex const s2_pB = endpointsBuffer[s + 2].PointBIndex;
+        ElementIndex const s3_pA = endpointsBuffer[s + 3].PointAIndex;
+        ElementIndex const s3_pB = endpointsBuffer[s + 3].PointBIndex;
+
+        //
+        // Spring directions
+        //
+
+        simdpp::float32<4> const s0s1_deltaPos =
+            simdpp::float32<4>(loadPair(&(positionBuffer[s0_pB]), &(positionBuffer[s1_pB])))
+            - simdpp::float32<4>(loadPair(&(positionBuffer[s0_pA]), &(positionBuffer[s1_pA]))); // x0,y0,x1,y1
+        simdpp::float32<4> const s2s3_deltaPos =
+            simdpp::float32<4>(loadPair(&(positionBuffer[s2_pB]), &(positionBuffer[s3_pB])))
+            - simdpp::float32<4>(loadPair(&(positionBuffer[s2_pA]), &(positionBuffer[s3_pA]))); // x2,y2,x3,y3
+
+        simdpp::float32<4> const deltaPosX = simdpp::unzip4_lo(s0s1_deltaPos, s2s3_deltaPos); // x0,x1,x2,x3
+        simdpp::float32<4> const deltaPosY = simdpp::unzip4_hi(s0s1_deltaPos, s2s3_deltaPos); // y0,y1,y2,y3
+
+        simdpp::float32<4> const springLength = simdpp::sqrt(deltaPosX * deltaPosX + deltaPosY * deltaPosY);
+
+        // Zero-length springs get a zero direction, as vec2f::normalise() does
+        simdpp::mask_float32<4> const validMask = (springLength != 0.0f);
+        simdpp::float32<4> const springDirX = simdpp::bit_and(deltaPosX / springLength, validMask);
+        simdpp::float32<4> const springDirY = simdpp::bit_and(deltaPosY / springLength, validMask);
+
+        // Coefficients are interleaved: stiffness0,damping0,stiffness1,damping1,...
+        simdpp::float32<4> const s0s1_coefficients = simdpp::load_u<simdpp::float32<4>>(&(coefficientsBuffer[s * 2]));
+        simdpp::float32<4> const s2s3_coefficients = simdpp::load_u<simdpp::float32<4>>(&(coefficientsBuffer[s * 2 + 4]));
+        simdpp::float32<4> const stiffnessCoefficient = simdpp::unzip4_lo(s0s1_coefficients, s2s3_coefficients);
+        simdpp::float32<4> const dampingCoefficient = simdpp::unzip4_hi(s0s1_coefficients, s2s3_coefficients);
+
+        //
+        // 1. Hooke's law
+        //
+
+        // Scalar force on point A along each spring
+        simdpp::float32<4> fS =
+            (springLength - simdpp::load_u<simdpp::float32<4>>(&(restLengthBuffer[s])))
+            * stiffnessCoefficient;
+
+        //
+        // 2. Damper forces
+        //
+        // Damp the velocities of the two points, as if the points were also connected by a damper
+        // along the same direction as the spring
+        //
+
+        simdpp::float32<4> const s0s1_deltaVel =
+            simdpp::float32<4>(loadPair(&(velocityBuffer[s0_pB]), &(velocityBuffer[s1_pB])))
+            - simdpp::float32<4>(loadPair(&(velocityBuffer[s0_pA]), &(velocityBuffer[s1_pA]))); // x0,y0,x1,y1
+        simdpp::float32<4> const s2s3_deltaVel =
+            simdpp::float32<4>(loadPair(&(velocityBuffer[s2_pB]), &(velocityBuffer[s3_pB])))
+            - simdpp::float32<4>(loadPair(&(velocityBuffer[s2_pA]), &(velocityBuffer[s3_pA]))); // x2,y2,x3,y3
+
+        simdpp::float32<4> const deltaVelX = simdpp::unzip4_lo(s0s1_deltaVel, s2s3_deltaVel); // x0,x1,x2,x3
+        simdpp::float32<4> const deltaVelY = simdpp::unzip4_hi(s0s1_deltaVel, s2s3_deltaVel); // y0,y1,y2,y3
+
+        fS = fS + (deltaVelX * springDirX + deltaVelY * springDirY) * dampingCoefficient;
+
+        //
+        // Apply forces
+        //
+        // Since no two springs in this batch share an endpoint, we may gather all of the
+        // endpoint forces at once and scatter them back without any read-after-write hazard
+        //
+
+        simdpp::float32<4> const fX = springDirX * fS;
+        simdpp::float32<4> const fY = springDirY * fS;
+
+        simdpp::float32<4> const s0s1_f = simdpp::zip4_lo(fX, fY); // f0.x,f0.y,f1.x,f1.y
+        simdpp::float32<4> const s2s3_f = simdpp::zip4_hi(fX, fY); // f2.x,f2.y,f3.x,f3.y
+
+        storePair(
+            (simdpp::float32<4>(loadPair(&(forceBuffer[s0_pA]), &(forceBuffer[s1_pA]))) + s0s1_f).wrapped(),
+            &(forceBuffer[s0_pA]),
+            &(forceBuffer[s1_pA]));
+
+        storePair(
+            (simdpp::float32<4>(loadPair(&(forceBuffer[s2_pA]), &(forceBuffer[s3_pA]))) + s2s3_f).wrapped(),
+            &(forceBuffer[s2_pA]),
+            &(forceBuffer[s3_pA]));
+
+        storePair(
+            (simdpp::float32<4>(loadPair(&(forceBuffer[s0_pB]), &(forceBuffer[s1_pB]))) - s0s1_f).wrapped(),
+            &(forceBuffer[s0_pB]),
+            &(forceBuffer[s1_pB]));
+
+        storePair(
+            (simdpp::float32<4>(loadPair(&(forceBuffer[s2_pB]), &(forceBuffer[s3_pB]))) - s2s3_f).wrapped(),
+            &(forceBuffer[s2_pB]),
+            &(forceBuffer[s3_pB]));
+    }
+}
+
+void Ship::IntegrateAndResetPointForces(
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex,
+    GameParameters const & gameParameters)
+{
+    float const dt = gameParameters.MechanicalSimulationStepTimeDuration<float>();
+
+    // Global damp - lowers velocity uniformly, damping oscillations originating between gravity and buoyancy
+    //
+    // Considering that:
+    //
+    //  v1 = d*v0
+    //  v2 = d*v1 =(d^2)*v0
+    //  ...
+    //  vN = (d^N)*v0
+    //
+    // ...the more the number of iterations, the more damped the initial velocity would be.
+    // We want damping to be independent from the number of iterations though, so we need to find the value
+    // d such that after N iterations the damping is the same as our reference value, which is based on
+    // 12 (basis) iterations. For example, double the number of iterations requires square root (1/2) of
+    // this value.
+    //
+
+    float const globalDampCoefficient = pow(
+        GameParameters::GlobalDamp,
+        12.0f / gameParameters.NumMechanicalDynamicsIterations<float>());
+
+    //
+    // Take the four buffers that we need as restrict pointers, so that the compiler
+    // can better see it should parallelize this loop as much as possible
+    //
+    // This loop is compiled with single-precision packet SSE instructions on MSVC 17,
+    // integrating two points at each iteration
+    //
+
+    float * restrict positionBuffer = mPoints.GetPositionBufferAsFloat();
+    float * restrict velocityBuffer = mPoints.GetVelocityBufferAsFloat();
+    float * restrict forceBuffer = mPoints.GetForceBufferAsFloat();
+    float * restrict integrationFactorBuffer = mPoints.GetIntegrationFactorBufferAsFloat();
+
+    size_t const end = endPointIndex * 2; // Two components per vector
+    for (size_t i = startPointIndex * 2; i < end; ++i)
     {
         //
         // Verlet integration (fourth order, with velocity being first order)
@@ -1023,7 +1387,10 @@ void Ship::IntegrateAndResetPointForces(GameParameters const & gameParameters)
     }
 }
 
-void Ship::HandleCollisionsWithSeaFloor(GameParameters const & gameParameters)
+void Ship::HandleCollisionsWithSeaFloor(
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex,
+    GameParameters const & gameParameters)
 {
     //
     // We handle collisions really simplistically: we move back points to where they were
@@ -1044,10 +1411,13 @@ void Ship::HandleCollisionsWithSeaFloor(GameParameters const & gameParameters)
 
     float const dt = gameParameters.MechanicalSimulationStepTimeDuration<float>();
 
-    for (auto pointIndex : mPoints)
+    // Sample the height of the sea floor at all of the points, in one go
+    mPoints.SampleOceanFloorHeights(startPointIndex, endPointIndex);
+
+    for (ElementIndex pointIndex = startPointIndex; pointIndex < endPointIndex; ++pointIndex)
     {
         // Check if point is now below the sea floor
-        float const floorheight = mParentWorld.GetOceanFloorHeightAt(mPoints.GetPosition(pointIndex).x);
+        float const floorheight = mPoints.GetOceanFloorHeight(pointIndex);
         if (mPoints.GetPosition(pointIndex).y < floorheight)
         {
             // Move point back to where it was
@@ -1119,6 +1489,8 @@ void Ship::UpdateWaterDynamics(
     float currentSimulationTime,
     GameParameters const & gameParameters)
 {
+    PROFILE_PHASE(WaterDynamics);
+
     //
     // Update intake of water
     //
@@ -1168,98 +1540,107 @@ void Ship::UpdateWaterInflow(
     // Intake/outtake water into/from all the leaking nodes that are underwater
     //
 
-    for (auto pointIndex : mPoints)
+    for (auto pointIndex : mPoints.GetLeakingPoints())
     {
-        // Avoid taking water into points that are destroyed, as that would change total water taken
-        if (!mPoints.IsDeleted(pointIndex))
+        // Avoid taking water into points that are destroyed, as that would change total water taken;
+        // also, sleeping points do not take any water
+        if (!mPoints.IsDeleted(pointIndex)
+            && !mPoints.IsAsleep(pointIndex))
         {
-            if (mPoints.IsLeaking(pointIndex))
-            {
-                //
-                // 1) Calculate velocity of incoming water, based off Bernoulli's equation applied to point:
-                //  v**2/2 + p/density = c (assuming y of incoming water does not change along the intake)
-                //      With: p = pressure of water at point = d*wh*g (d = water density, wh = water height in point)
-                //
-                // Considering that at equilibrium we have v=0 and p=external_pressure,
-                // then c=external_pressure/density;
-                // external_pressure is height_of_water_at_y*g*density, then c=height_of_water_at_y*g;
-                // hence, the velocity of water incoming at point p, when the "water height" in the point is already
-                // wh and the external water pressure is d*height_of_water_at_y*g, is:
-                //  v = +/- sqrt(2*g*|height_of_water_at_y-wh|)
-                //
+            assert(mPoints.IsLeaking(pointIndex));
 
-                float const externalWaterHeight = std::max(
-                    mParentWorld.GetWaterHeightAt(mPoints.GetPosition(pointIndex).x) - mPoints.GetPosition(pointIndex).y,
-                    0.0f);
+            //
+            // 1) Calculate velocity of incoming water, based off Bernoulli's equation applied to point:
+            //  v**2/2 + p/density = c (assuming y of incoming water does not change along the intake)
+            //      With: p = pressure of water at point = d*wh*g (d = water density, wh = water height in point)
+            //
+            // Considering that at equilibrium we have v=0 and p=external_pressure,
+            // then c=external_pressure/density;
+            // external_pressure is height_of_water_at_y*g*density, then c=height_of_water_at_y*g;
+            // hence, the velocity of water incoming at point p, when the "water height" in the point is already
+            // wh and the external water pressure is d*height_of_water_at_y*g, is:
+            //  v = +/- sqrt(2*g*|height_of_water_at_y-wh|)
+            //
 
-                float const internalWaterHeight = mPoints.GetWater(pointIndex);
+            float const externalWaterHeight = std::max(
+                mPoints.GetWaterHeight(pointIndex) - mPoints.GetPosition(pointIndex).y,
+                0.0f);
 
-                float incomingWaterVelocity;
-                if (externalWaterHeight >= internalWaterHeight)
-                {
-                    // Incoming water
-                    incomingWaterVelocity = sqrtf(2.0f * GameParameters::GravityMagnitude * (externalWaterHeight - internalWaterHeight));
-                }
-                else
-                {
-                    // Outgoing water
-                    incomingWaterVelocity = - sqrtf(2.0f * GameParameters::GravityMagnitude * (internalWaterHeight - externalWaterHeight));
-                }
+            float const internalWaterHeight = mPoints.GetWater(pointIndex);
 
-                //
-                // 2) In/Outtake water according to velocity:
-                // - During dt, we move a volume of water Vw equal to A*v*dt; the equivalent change in water
-                //   height is thus Vw/A, i.e. v*dt
-                //
+            float incomingWaterVelocity;
+            if (externalWaterHeight >= internalWaterHeight)
+            {
+                // Incoming water
+                incomingWaterVelocity = sqrtf(2.0f * GameParameters::GravityMagnitude * (externalWaterHeight - internalWaterHeight));
+            }
+            else
+            {
+                // Outgoing water
+                incomingWaterVelocity = - sqrtf(2.0f * GameParameters::GravityMagnitude * (internalWaterHeight - externalWaterHeight));
+            }
 
-                float newWater =
-                    incomingWaterVelocity
-                    * GameParameters::SimulationStepTimeDuration<float>
-                    * mPoints.GetWaterIntake(pointIndex)
-                    * gameParameters.WaterIntakeAdjustment;
+            //
+            // 2) In/Outtake water according to velocity:
+            // - During dt, we move a volume of water Vw equal to A*v*dt; the equivalent change in water
+            //   height is thus Vw/A, i.e. v*dt
+            //
 
-                if (newWater < 0.0f)
-                {
-                    // Outgoing water
+            float newWater =
+                incomingWaterVelocity
+                * GameParameters::SimulationStepTimeDuration<float>
+                * mPoints.GetWaterIntake(pointIndex)
+                * gameParameters.WaterIntakeAdjustment;
 
-                    // Make sure we don't over-drain the point
-                    newWater = -std::min(-newWater, mPoints.GetWater(pointIndex));
+            if (newWater < 0.0f)
+            {
+                // Outgoing water
 
-                    // Honor the water retention of this material
-                    newWater *= mPoints.GetWaterRestitution(pointIndex);
-                }
+                // Make sure we don't over-drain the point
+                newWater = -std::min(-newWater, mPoints.GetWater(pointIndex));
 
-                // Adjust water
-                mPoints.GetWater(pointIndex) += newWater;
+                // Honor the water retention of this material
+                newWater *= mPoints.GetWaterRestitution(pointIndex);
+            }
 
-                // Adjust total cumulated intaken water at this point
-                mPoints.GetCumulatedIntakenWater(pointIndex) += newWater;
+            // Adjust water
+            mPoints.GetWater(pointIndex) += newWater;
+            if (newWater > 0.0f)
+                mPoints.AddToWaterActiveSet(pointIndex);
 
-                // Check if it's time to produce air bubbles
-                if (mPoints.GetCumulatedIntakenWater(pointIndex) > gameParameters.CumulatedIntakenWaterThresholdForAirBubbles)
-                {
-                    // Generate air bubbles - but not on ropes as that looks awful
-                    //
-                    // FUTURE: and for the time being, also not on orphaned points as those are not visible
-                    // at the moment; this may be removed later when orphaned points will be visible
-                    if (gameParameters.DoGenerateAirBubbles
-                        && !mPoints.IsRope(pointIndex)
-                        && mPoints.GetConnectedSprings(pointIndex).ConnectedSprings.size() > 0)
-                    {
-                        GenerateAirBubbles(
-                            mPoints.GetPosition(pointIndex),
-                            currentSimulationTime,
-                            mPoints.GetPlaneId(pointIndex),
-                            gameParameters);
-                    }
+            // Adjust total cumulated intaken water at this point
+            mPoints.GetCumulatedIntakenWater(pointIndex) += newWater;
 
-                    // Consume all cumulated water
-                    mPoints.GetCumulatedIntakenWater(pointIndex) = 0.0f;
+            // Check if it's time to produce air bubbles
+            if (mPoints.GetCumulatedIntakenWater(pointIndex) > gameParameters.CumulatedIntakenWaterThresholdForAirBubbles)
+            {
+                // Generate air bubbles - but not on ropes as that looks awful
+                //
+                // FUTURE: and for the time being, also not on orphaned points as those are not visible
+                // at the moment; this may be removed later when orphaned points will be visible
+                if (gameParameters.DoGenerateAirBubbles
+                    && !mPoints.IsRope(pointIndex)
+                    && !mPoints.GetConnectedSprings(pointIndex).empty())
+                {
+                    GenerateAirBubbles(
+                        mPoints.GetPosition(pointIndex),
+                        currentSimulationTime,
+                        mPoints.GetPlaneId(pointIndex),
+                        gameParameters);
                 }
 
-                // Adjust total water taken during step
-                waterTaken += newWater;
+                // Consume all cumulated water
+                mPoints.GetCumulatedIntakenWater(pointIndex) = 0.0f;
             }
+
+            // Adjust total water taken during step
+            waterTaken += newWater;
+
+            // Adjust water taken by the point's connected component, which
+            // keeps it awake
+            ConnectedComponentId const connectedComponentId = mPoints.GetConnectedComponentId(pointIndex);
+            if (connectedComponentId < mConnectedComponentSleepStates.size())
+                mConnectedComponentSleepStates[connectedComponentId].TotalWaterTaken += std::abs(newWater);
         }
     }
 }
@@ -1272,8 +1653,10 @@ void Ship::UpdateWaterVelocities(
     // For each point, move each spring's outgoing water momentum to
     // its destination point
     //
-    // Implementation of https://gabrielegiuseppini.wordpress.com/2018/09/08/momentum-based-simulation-of-water-flooding-2d-spaces/
-    //
+
+    // Drop the points that have dried out from the active set - we only need to visit
+    // the points that have water, as dry points have no water to move
+    mPoints.UpdateWaterActiveSet();
 
     // Calculate water momenta
     mPoints.UpdateWaterMomentaFromVelocities();
@@ -1285,268 +1668,49 @@ void Ship::UpdateWaterVelocities(
     vec2f * restrict oldPointWaterVelocityBufferData = mPoints.GetWaterVelocityBufferAsVec2();
     vec2f * restrict newPointWaterMomentumBufferData = mPoints.GetWaterMomentumBufferAsVec2f();
 
-    // Weights of outbound water flows along each spring, including impermeable ones;
-    // set to zero for springs whose resultant scalar water velocities are
-    // directed towards the point being visited
-    std::array<float, GameParameters::MaxSpringsPerPoint> springOutboundWaterFlowWeights;
-
-    // Total weight
-    float totalOutboundWaterFlowWeight;
-
-    // Resultant water velocities along each spring
-    std::array<vec2f, GameParameters::MaxSpringsPerPoint> springOutboundWaterVelocities;
-
-    //
-    // Precalculate point "freeness factors", i.e. how much each point's
-    // quantity of water "suppresses" splashes from adjacent kinetic energy losses
-    //
-
-    auto pointFreenessFactorBuffer = mPoints.AllocateWorkBufferFloat();
-    float * restrict pointFreenessFactorBufferData = pointFreenessFactorBuffer->data();
-    for (auto pointIndex : mPoints)
-    {
-        pointFreenessFactorBufferData[pointIndex] =
-            FastExp(-oldPointWaterBufferData[pointIndex] * 10.0f);
-    }
-
-
     //
-    // Visit all points and move water and its momenta
+    // Visit all wet points and move water and its momenta
     //
 
-    for (auto pointIndex : mPoints)
-    {
-        //
-        // 1) Calculate water momenta along all springs
-        //
-
-        // A higher crazyness gives more emphasys to bernoulli's velocity, as if pressures
-        // and gravity were exaggerated
-        //
-        // WV[t] = WV[t-1] + alpha * Bernoulli
-        //
-        // WaterCrazyness=0   -> alpha=1
-        // WaterCrazyness=0.5 -> alpha=0.5 + 0.5*Wh
-        // WaterCrazyness=1   -> alpha=Wh
-        float const alphaCrazyness = 1.0f + gameParameters.WaterCrazyness * (oldPointWaterBufferData[pointIndex] - 1.0f);
-
-        // Kinetic energy lost at this point
-        float pointKineticEnergyLoss = 0.0f;
-
-        // Count of non-hull free and drowned neighbor points
-        float pointSplashNeighbors = 0.0f;
-        float pointSplashFreeNeighbors = 0.0f;
-
-        totalOutboundWaterFlowWeight = 0.0f;
-
-        size_t const connectedSpringCount = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings.size();
-        for (size_t s = 0; s < connectedSpringCount; ++s)
-        {
-            auto const & cs = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings[s];
-
-            // Normalized spring vector, oriented point -> other endpoint
-            vec2f const springNormalizedVector = (mPoints.GetPosition(cs.OtherEndpointIndex) - mPoints.GetPosition(pointIndex)).normalise();
-
-            // Component of the point's own water velocity along the spring
-            float const pointWaterVelocityAlongSpring =
-                oldPointWaterVelocityBufferData[pointIndex]
-                .dot(springNormalizedVector);
-
-            //
-            // Calulate Bernoulli's velocity gained along this spring, from this point to
-            // the other endpoint
-            //
-
-            // Pressure difference (positive implies point -> other endpoint flow)
-            float const dw = oldPointWaterBufferData[pointIndex] - oldPointWaterBufferData[cs.OtherEndpointIndex];
-
-            // Gravity potential difference (positive implies point -> other endpoint flow)
-            float const dy = mPoints.GetPosition(pointIndex).y - mPoints.GetPosition(cs.OtherEndpointIndex).y;
-
-            // Calculate gained water velocity along this spring, from point to other endpoint
-            // (Bernoulli, 1738)
-            float bernoulliVelocityAlongSpring;
-            float const dwy = dw + dy;
-            if (dwy >= 0.0f)
-            {
-                // Gained velocity goes from point to other endpoint
-                bernoulliVelocityAlongSpring = sqrtf(2.0f * GameParameters::GravityMagnitude * dwy);
-            }
-            else
-            {
-                // Gained velocity goes from other endpoint to point
-                bernoulliVelocityAlongSpring = -sqrtf(2.0f * GameParameters::GravityMagnitude * -dwy);
-            }
-
-            // Resultant scalar velocity along spring; outbound only, as
-            // if this were inbound it wouldn't result in any movement of the point's
-            // water between these two springs. Morevoer, Bernoulli's velocity injected
-            // along this spring will be picked up later also by the other endpoint,
-            // and at that time it would move water if it agrees with its velocity
-            float const springOutboundScalarWaterVelocity = std::max(
-                pointWaterVelocityAlongSpring + bernoulliVelocityAlongSpring * alphaCrazyness,
-                0.0f);
-
-            // Store weight along spring, scaling for the greater distance traveled along
-            // diagonalsprings
-            springOutboundWaterFlowWeights[s] =
-                springOutboundScalarWaterVelocity
-                / mSprings.GetRestLength(cs.SpringIndex);
-
-            // Resultant outbound velocity along spring
-            springOutboundWaterVelocities[s] =
-                springNormalizedVector
-                * springOutboundScalarWaterVelocity;
-
-            // Update total outbound flow weight
-            totalOutboundWaterFlowWeight += springOutboundWaterFlowWeights[s];
-
-
-            //
-            // Update splash neighbors counts
-            //
-
-            pointSplashFreeNeighbors +=
-                mSprings.GetWaterPermeability(cs.SpringIndex)
-                * pointFreenessFactorBufferData[cs.OtherEndpointIndex];
-
-            pointSplashNeighbors += mSprings.GetWaterPermeability(cs.SpringIndex);
-        }
-
-
-
-        //
-        // 2) Calculate normalization factor for water flows:
-        //    the quantity of water along a spring is proportional to the weight of the spring
-        //    (resultant velocity along that spring), and the sum of all outbound water flows must
-        //    match the water currently at the point times the water speed fraction and the adjustment
-        //
-
-        assert(totalOutboundWaterFlowWeight >= 0.0f);
-
-        float waterQuantityNormalizationFactor = 0.0f;
-        if (totalOutboundWaterFlowWeight != 0.0f)
+    auto const onWaterReceived =
+        [this](ElementIndex pointIndex)
         {
-            waterQuantityNormalizationFactor =
-                oldPointWaterBufferData[pointIndex]
-                * mPoints.GetWaterDiffusionSpeed(pointIndex)
-                * gameParameters.WaterDiffusionSpeedAdjustment
-                / totalOutboundWaterFlowWeight;
-        }
-
-
-        //
-        // 3) Move water along all springs according to their flows,
-        //    and update destination's momenta accordingly
-        //
-
-        for (size_t s = 0; s < connectedSpringCount; ++s)
-        {
-            auto const & cs = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings[s];
-
-            // Calculate quantity of water directed outwards
-            float const springOutboundQuantityOfWater =
-                springOutboundWaterFlowWeights[s]
-                * waterQuantityNormalizationFactor;
-
-            assert(springOutboundQuantityOfWater >= 0.0f);
+            mPoints.AddToWaterActiveSet(pointIndex);
+        };
 
-            if (mSprings.GetWaterPermeability(cs.SpringIndex) != 0.0f)
-            {
-                //
-                // Water - and momentum - move from point to endpoint
-                //
-
-                // Move water quantity
-                newPointWaterBufferData[pointIndex] -= springOutboundQuantityOfWater;
-                newPointWaterBufferData[cs.OtherEndpointIndex] += springOutboundQuantityOfWater;
-
-                // Remove "old momentum" (old velocity) from point
-                newPointWaterMomentumBufferData[pointIndex] -=
-                    oldPointWaterVelocityBufferData[pointIndex]
-                    * springOutboundQuantityOfWater;
-
-                // Add "new momentum" (old velocity + velocity gained) to other endpoint
-                newPointWaterMomentumBufferData[cs.OtherEndpointIndex] +=
-                    springOutboundWaterVelocities[s]
-                    * springOutboundQuantityOfWater;
-
-
-                //
-                // Update point's kinetic energy loss:
-                // splintered water colliding with whole other endpoint
-                //
-
-                // FUTURE: get rid of this re-calculation once we pre-calculate all spring normalized vectors
-                vec2f const springNormalizedVector = (mPoints.GetPosition(cs.OtherEndpointIndex) - mPoints.GetPosition(pointIndex)).normalise();
-
-                float ma = springOutboundQuantityOfWater;
-                float va = springOutboundWaterVelocities[s].length();
-                float mb = oldPointWaterBufferData[cs.OtherEndpointIndex];
-                float vb = oldPointWaterVelocityBufferData[cs.OtherEndpointIndex].dot(springNormalizedVector);
-
-                float vf = 0.0f;
-                if (ma + mb != 0.0f)
-                    vf = (ma * va + mb * vb) / (ma + mb);
-
-                float deltaKa =
-                    0.5f
-                    * ma
-                    * (va * va - vf * vf);
-
-                // Note: deltaKa might be negative, in which case deltaKb would have been
-                // more positive (perfectly inelastic -> deltaK == max); we will pickup
-                // deltaKb later
-                pointKineticEnergyLoss += std::max(deltaKa, 0.0f);
-            }
-            else
+    if (gameParameters.DoPullWaterDiffusion)
+    {
+        ThreadPool & threadPool = mParentWorld.GetThreadPool();
+
+        mWaterDiffusion.Pull(
+            mPoints,
+            mSprings,
+            mPoints.GetWaterActivePoints(),
+            oldPointWaterBufferData,
+            oldPointWaterVelocityBufferData,
+            newPointWaterBufferData,
+            newPointWaterMomentumBufferData,
+            gameParameters,
+            [&threadPool](ElementIndex startIndex, ElementIndex endIndex, auto const & body)
             {
-                // Deleted springs are removed from points' connected springs
-                assert(!mSprings.IsDeleted(cs.SpringIndex));
-
-                //
-                // New momentum (old velocity + velocity gained) bounces back
-                // (and zeroes outgoing), assuming perfectly inelastic collision
-                //
-                // No changes to other endpoint
-                //
-
-                newPointWaterMomentumBufferData[pointIndex] -=
-                    springOutboundWaterVelocities[s]
-                    * springOutboundQuantityOfWater;
-
-
-                //
-                // Update point's kinetic energy loss:
-                // entire splintered water
-                //
-
-                float ma = springOutboundQuantityOfWater;
-                float va = springOutboundWaterVelocities[s].length();
-
-                float deltaKa =
-                    0.5f
-                    * ma
-                    * va * va;
-
-                assert(deltaKa >= 0.0f);
-                pointKineticEnergyLoss += deltaKa;
-            }
-        }
-
-        //
-        // 4) Update water splash
-        //
-
-        if (pointSplashNeighbors != 0.0f)
-        {
-            // Water splashed is proportional to kinetic energy loss that took
-            // place near free points (i.e. not drowned by water)
-            waterSplashed +=
-                pointKineticEnergyLoss
-                * pointSplashFreeNeighbors
-                / pointSplashNeighbors;
-        }
+                threadPool.ParallelFor(startIndex, endIndex, MinWaterDiffusionChunkSize, body);
+            },
+            onWaterReceived,
+            waterSplashed);
+    }
+    else
+    {
+        WaterDiffusion::Push(
+            mPoints,
+            mSprings,
+            mPoints.GetWaterActivePoints(),
+            oldPointWaterBufferData,
+            oldPointWaterVelocityBufferData,
+            newPointWaterBufferData,
+            newPointWaterMomentumBufferData,
+            gameParameters,
+            onWaterReceived,
+            waterSplashed);
     }
 
 
@@ -1575,6 +1739,8 @@ void Ship::UpdateElectricalDynamics(
     GameWallClock::time_point currentWallclockTime,
     GameParameters const & gameParameters)
 {
+    PROFILE_PHASE(ElectricalDynamics);
+
     // Generate a new visit sequence number
     ++mCurrentElectricalVisitSequenceNumber;
 
@@ -1653,8 +1819,75 @@ void Ship::DiffuseLight(GameParameters const & gameParameters)
 {
     //
     // Diffuse light from each lamp to all points on the same or lower plane ID,
-    // inverse-proportionally to the nth power of the distance, where n is the spread
+    // inverse-proportionally to the nth power of the distance, where n is the spread.
+    //
+    // The light of a lamp fades below LightEpsilon at a distance which only depends on the lamp,
+    // hence we only visit the points within that distance. Also, since the light at the points
+    // only changes when the lamps do, we only diffuse light again when the light or the position
+    // of any lamp has changed appreciably.
     //
+    // Points may also move relative to a lamp that stays put - e.g. a part drifting away
+    // after breaking off - and checking all of them at each step would cost as much as
+    // diffusing again; hence, while any lamp is lit, we also diffuse again at a low rate.
+    //
+
+    // Light below this value is indistinguishable from darkness
+    static constexpr float LightEpsilon = 1.0f / 256.0f;
+
+    // Lamps have to move at least this much for us to diffuse light again
+    static constexpr float LampPositionTolerance = 0.1f;
+
+    // Points may have moved away from their cells in the point grid by this much
+    static constexpr float LightSearchRadiusMargin = 2.0f;
+
+    // Lit points are caught up with after this many steps (half a second of simulated time)
+    static constexpr unsigned int LightRefreshPeriodSteps = 25;
+
+    auto const & lamps = mElectricalElements.Lamps();
+
+    auto const calculateEffectiveLampLight = [&](ElementIndex lampIndex) -> float
+    {
+        return gameParameters.LuminiscenceAdjustment >= 1.0f
+            ?   FastPow(
+                    mElectricalElements.GetAvailableCurrent(lampIndex)
+                    * mElectricalElements.GetLuminiscence(lampIndex),
+                    1.0f / gameParameters.LuminiscenceAdjustment)
+            :   mElectricalElements.GetAvailableCurrent(lampIndex)
+                * mElectricalElements.GetLuminiscence(lampIndex)
+                * gameParameters.LuminiscenceAdjustment;
+    };
+
+    //
+    // Check whether anything has changed since the last time we've diffused light
+    //
+
+    ++mStepsSinceLightDiffusion;
+
+    bool isDirty =
+        mIsLightDirty
+        || mDiffusedLampLights.size() != lamps.size()
+        || mDiffusedLightSpreadAdjustment != gameParameters.LightSpreadAdjustment
+        || (mIsAnyDiffusedLampLit && mStepsSinceLightDiffusion >= LightRefreshPeriodSteps);
+
+    for (size_t l = 0; l < lamps.size() && !isDirty; ++l)
+    {
+        if (std::abs(calculateEffectiveLampLight(lamps[l]) - mDiffusedLampLights[l]) >= LightEpsilon
+            || (mPoints.GetPosition(mElectricalElements.GetPointIndex(lamps[l])) - mDiffusedLampPositions[l]).squareLength()
+                >= LampPositionTolerance * LampPositionTolerance)
+        {
+            isDirty = true;
+        }
+    }
+
+    if (!isDirty)
+        return;
+
+    mDiffusedLampLights.resize(lamps.size());
+    mDiffusedLampPositions.resize(lamps.size());
+    mDiffusedLightSpreadAdjustment = gameParameters.LightSpreadAdjustment;
+    mIsLightDirty = false;
+    mStepsSinceLightDiffusion = 0;
+    mIsAnyDiffusedLampLit = false;
 
     // Zero-out light at all points first
     for (auto pointIndex : mPoints)
@@ -1665,25 +1898,33 @@ void Ship::DiffuseLight(GameParameters const & gameParameters)
 
     // Go through all lamps;
     // can safely visit deleted lamps as their current will always be zero
-    for (auto lampIndex : mElectricalElements.Lamps())
+    for (size_t l = 0; l < lamps.size(); ++l)
     {
-        auto const lampPointIndex = mElectricalElements.GetPointIndex(lampIndex);
+        auto const lampPointIndex = mElectricalElements.GetPointIndex(lamps[l]);
 
-        float const effectiveLampLight =
-            gameParameters.LuminiscenceAdjustment >= 1.0f
-            ?   FastPow(
-                    mElectricalElements.GetAvailableCurrent(lampIndex)
-                    * mElectricalElements.GetLuminiscence(lampIndex),
-                    1.0f / gameParameters.LuminiscenceAdjustment)
-            :   mElectricalElements.GetAvailableCurrent(lampIndex)
-                * mElectricalElements.GetLuminiscence(lampIndex)
-                * gameParameters.LuminiscenceAdjustment;
+        float const effectiveLampLight = calculateEffectiveLampLight(lamps[l]);
 
-        float const lampLightSpread = mElectricalElements.GetLightSpread(lampIndex);
+        vec2f const & lampPosition = mPoints.GetPosition(lampPointIndex);
+
+        // Remember the state of this lamp
+        mDiffusedLampLights[l] = effectiveLampLight;
+        mDiffusedLampPositions[l] = lampPosition;
+
+        if (effectiveLampLight < LightEpsilon)
+        {
+            // Too dim to light anything
+            continue;
+        }
+
+        mIsAnyDiffusedLampLit = true;
+
+        float const lampLightSpread = mElectricalElements.GetLightSpread(lamps[l]);
         if (lampLightSpread == 0.0f)
         {
             // No spread, just the lamp point itself
-            mPoints.GetLight(lampPointIndex) = effectiveLampLight;
+            mPoints.GetLight(lampPointIndex) = std::max(
+                mPoints.GetLight(lampPointIndex),
+                effectiveLampLight);
         }
         else
         {
@@ -1696,32 +1937,150 @@ void Ship::DiffuseLight(GameParameters const & gameParameters)
                 * gameParameters.LightSpreadAdjustment
                 / 2.0f; // We piggyback on the power to avoid taking a sqrt for distance
 
-            vec2f const & lampPosition = mPoints.GetPosition(lampPointIndex);
+            // The distance at which light drops below epsilon:
+            //  L / (1 + d^(2*e)) < epsilon <=> d^2 > (L / epsilon - 1)^(1/e)
+            // (might be infinite, in which case we'll visit all points)
+            float const lightRadius =
+                std::sqrt(std::pow(effectiveLampLight / LightEpsilon - 1.0f, 1.0f / effectiveExponent))
+                + LightSearchRadiusMargin;
+
             PlaneId const lampPlaneId = mPoints.GetPlaneId(lampPointIndex);
 
-            for (auto pointIndex : mPoints)
-            {
-                if (mPoints.GetPlaneId(pointIndex) <= lampPlaneId)
+            // Gather the points within reach
+            mLitPoints.clear();
+            GetPointGrid().VisitPointsInBox(
+                Geometry::AABB(
+                    lampPosition.x - lightRadius,
+                    lampPosition.x + lightRadius,
+                    lampPosition.y + lightRadius,
+                    lampPosition.y - lightRadius),
+                [&](ElementIndex pointIndex)
                 {
-                    float const squareDistance = (mPoints.GetPosition(pointIndex) - lampPosition).squareLength();
-
-                    float const newLight =
-                        effectiveLampLight
-                        / (1.0f + FastPow(squareDistance, effectiveExponent));
+                    if (mPoints.GetPlaneId(pointIndex) <= lampPlaneId)
+                    {
+                        mLitPoints.push_back(pointIndex);
+                    }
+                });
 
-                    mPoints.GetLight(pointIndex) = std::max(
-                        mPoints.GetLight(pointIndex),
-                        newLight);
-                }
+            // Pad to a multiple of four points with the lamp point itself, which
+            // gets the full light of the lamp anyway
+            while (0 != (mLitPoints.size() % 4))
+            {
+                mLitPoints.push_back(lampPointIndex);
             }
+
+            DiffuseLampLight_Vectorized(
+                lampPosition,
+                effectiveLampLight,
+                effectiveExponent,
+                mLitPoints.data(),
+                mLitPoints.size());
         }
     }
 }
 
+void Ship::DiffuseLampLight_Vectorized(
+    vec2f const & lampPosition,
+    float effectiveLampLight,
+    float effectiveExponent,
+    ElementIndex const * restrict pointIndices,
+    size_t pointCount)
+{
+    //
+    // Processes points four at a time, with vectorized versions of FastLog2 and FastPow2
+    //
+
+    assert(0 == (pointCount % 4));
+
+    vec2f const * const restrict positionBuffer = mPoints.GetPositionBufferAsVec2();
+
+    // Loads two vec2f's into one register: x0,y0,x1,y1
+    auto const loadPair = [](vec2f const * restrict v0, vec2f const * restrict v1) -> __m128
+    {
+        return _mm_loadh_pi(
+            _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const *>(v0))),
+            reinterpret_cast<__m64 const *>(v1));
+    };
+
+    // See FastLog2()
+    auto const fastLog2 = [](__m128 x) -> __m128
+    {
+        __m128i const xi = _mm_castps_si128(x);
+        __m128 const mx = _mm_castsi128_ps(
+            _mm_or_si128(
+                _mm_and_si128(xi, _mm_set1_epi32(0x007FFFFF)),
+                _mm_set1_epi32(0x3f000000)));
+        __m128 const y = _mm_mul_ps(_mm_cvtepi32_ps(xi), _mm_set1_ps(1.1920928955078125e-7f));
+
+        return _mm_sub_ps(
+            _mm_sub_ps(
+                _mm_sub_ps(y, _mm_set1_ps(124.22551499f)),
+                _mm_mul_ps(_mm_set1_ps(1.498030302f), mx)),
+            _mm_div_ps(_mm_set1_ps(1.72587999f), _mm_add_ps(_mm_set1_ps(0.3520887068f), mx)));
+    };
+
+    // See FastPow2(); also clamps from above, so that the result always fits the conversion to integer
+    auto const fastPow2 = [](__m128 p) -> __m128
+    {
+        __m128 const offset = _mm_and_ps(_mm_cmplt_ps(p, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+        __m128 const clipp = _mm_min_ps(_mm_max_ps(p, _mm_set1_ps(-126.0f)), _mm_set1_ps(126.0f));
+        __m128 const w = _mm_cvtepi32_ps(_mm_cvttps_epi32(clipp));
+        __m128 const z = _mm_add_ps(_mm_sub_ps(clipp, w), offset);
+
+        __m128 const v = _mm_mul_ps(
+            _mm_set1_ps(static_cast<float>(1 << 23)),
+            _mm_sub_ps(
+                _mm_add_ps(
+                    _mm_add_ps(clipp, _mm_set1_ps(121.2740575f)),
+                    _mm_div_ps(_mm_set1_ps(27.7280233f), _mm_sub_ps(_mm_set1_ps(4.84252568f), z))),
+                _mm_mul_ps(_mm_set1_ps(1.49012907f), z)));
+
+        return _mm_castsi128_ps(_mm_cvttps_epi32(v));
+    };
+
+    __m128 const lampX = _mm_set1_ps(lampPosition.x);
+    __m128 const lampY = _mm_set1_ps(lampPosition.y);
+    __m128 const lampLight = _mm_set1_ps(effectiveLampLight);
+    __m128 const exponent = _mm_set1_ps(effectiveExponent);
+    __m128 const one = _mm_set1_ps(1.0f);
+
+    alignas(16) float newLights[4];
+
+    for (size_t i = 0; i < pointCount; i += 4)
+    {
+        ElementIndex const p0 = pointIndices[i];
+        ElementIndex const p1 = pointIndices[i + 1];
+        ElementIndex const p2 = pointIndices[i + 2];
+        ElementIndex const p3 = pointIndices[i + 3];
+
+        __m128 const p0p1 = loadPair(&(positionBuffer[p0]), &(positionBuffer[p1])); // x0,y0,x1,y1
+        __m128 const p2p3 = loadPair(&(positionBuffer[p2]), &(positionBuffer[p3])); // x2,y2,x3,y3
+
+        __m128 const deltaX = _mm_sub_ps(_mm_shuffle_ps(p0p1, p2p3, _MM_SHUFFLE(2, 0, 2, 0)), lampX); // x0,x1,x2,x3
+        __m128 const deltaY = _mm_sub_ps(_mm_shuffle_ps(p0p1, p2p3, _MM_SHUFFLE(3, 1, 3, 1)), lampY); // y0,y1,y2,y3
+
+        __m128 const squareDistance = _mm_add_ps(_mm_mul_ps(deltaX, deltaX), _mm_mul_ps(deltaY, deltaY));
+
+        // L / (1 + d^(2*e))
+        _mm_store_ps(
+            newLights,
+            _mm_div_ps(
+                lampLight,
+                _mm_add_ps(one, fastPow2(_mm_mul_ps(exponent, fastLog2(squareDistance))))));
+
+        mPoints.GetLight(p0) = std::max(mPoints.GetLight(p0), newLights[0]);
+        mPoints.GetLight(p1) = std::max(mPoints.GetLight(p1), newLights[1]);
+        mPoints.GetLight(p2) = std::max(mPoints.GetLight(p2), newLights[2]);
+        mPoints.GetLight(p3) = std::max(mPoints.GetLight(p3), newLights[3]);
+    }
+}
+
 void Ship::UpdateEphemeralParticles(
     float currentSimulationTime,
     GameParameters const & gameParameters)
 {
+    PROFILE_PHASE(EphemeralParticles);
+
     //
     // Update existing particles
     //
@@ -1778,145 +2137,282 @@ void Ship::DecaySprings(
     }
 }
 
-///////////////////////////////////////////////////////////////////////////////////////////////
-// Private helpers
-///////////////////////////////////////////////////////////////////////////////////////////////
-
-//#define RENDER_FLOOD_DISTANCE
+///////////////////////////////////////////////////////////////////////////////////
+// Sleep
+///////////////////////////////////////////////////////////////////////////////////
 
-void Ship::RunConnectivityVisit()
+void Ship::UpdateSleep(GameParameters const & gameParameters)
 {
+    PROFILE_PHASE(Sleep);
+
     //
+    // A connected component that has been resting on the sea floor - i.e. that has been barely
+    // moving and barely taking any water - for a while is put to sleep, and the dynamics skip
+    // its points and springs until it's woken up by something happening to it
     //
-    // Here we visit the entire network of points (NOT including the ephemerals - they'll be assigned
-    // their own plane ID's at creation time) and propagate connectivity information:
-    //
-    // - PlaneID: all points belonging to the same connected component, including "strings",
-    //            are assigned the same plane ID
+
+    if (!gameParameters.DoSleepSettledComponents)
+    {
+        WakeAllConnectedComponents();
+        return;
+    }
+
     //
-    // - Connected Component ID: at this moment we assign the same value as the plane ID; in the future
-    //                           we might want to only assign a connected component ID to "solids" by only
-    //                           assigning it to points that are not string points
-    //                           (this will then require a separate visit pass)
+    // 1. Measure the components that are awake
     //
-    // At the end of a visit *ALL* (non-ephemeral) points will have a Plane ID.
+
+    VisitRuns(
+        mAwakePointRuns,
+        0,
+        mPoints.GetElementCount(),
+        [this](ElementIndex startPointIndex, ElementIndex endPointIndex)
+        {
+            for (ElementIndex pointIndex = startPointIndex; pointIndex < endPointIndex; ++pointIndex)
+            {
+                // Ephemeral points do not belong to any component
+                ConnectedComponentId const connectedComponentId = mPoints.GetConnectedComponentId(pointIndex);
+                if (connectedComponentId < mConnectedComponentSleepStates.size()
+                    && !mPoints.IsDeleted(pointIndex))
+                {
+                    auto & sleepState = mConnectedComponentSleepStates[connectedComponentId];
+
+                    ++(sleepState.PointCount);
+
+                    sleepState.TotalSquareVelocity += mPoints.GetVelocity(pointIndex).squareLength();
+
+                    // Ocean floor heights are as of the last mechanical iteration
+                    if (mPoints.GetPosition(pointIndex).y - mPoints.GetOceanFloorHeight(pointIndex) <= SleepMaxSeaFloorDistance)
+                        sleepState.IsOnSeaFloor = true;
+                }
+            }
+        });
+
     //
-    // We also piggyback the visit to create the array containing the counts of triangles in each plane,
-    // so that we can later upload triangles in {PlaneID, Tessellation Order} order.
+    // 2. Once in a while, check whether the components that are asleep are still resting
+    //    on the sea floor, which might have moved in the meantime
     //
 
-    // Generate a new visit sequence number
-    auto const visitSequenceNumber = ++mCurrentConnectivityVisitSequenceNumber;
-
-    // Initialize plane ID
-    PlaneId currentPlaneId = 0; // Also serves as Connected Component ID
-    float currentPlaneIdFloat = 0.0f;
+    bool const doCheckSleepingComponents = mCurrentSimulationSequenceNumber.IsStepOf(37, 50);
 
-#ifdef RENDER_FLOOD_DISTANCE
-    std::optional<float> floodDistanceColor;
-#endif
+    if (doCheckSleepingComponents)
+    {
+        for (auto pointIndex : mPoints.NonEphemeralPoints())
+        {
+            if (mPoints.IsAsleep(pointIndex)
+                && !mPoints.IsDeleted(pointIndex))
+            {
+                ConnectedComponentId const connectedComponentId = mPoints.GetConnectedComponentId(pointIndex);
+                if (connectedComponentId < mConnectedComponentSleepStates.size())
+                {
+                    auto & sleepState = mConnectedComponentSleepStates[connectedComponentId];
 
-    // The set of (already) marked points, from which we still
-    // have to propagate out
-    std::queue<ElementIndex> pointsToPropagateFrom;
+                    vec2f const & position = mPoints.GetPosition(pointIndex);
+                    if (!sleepState.IsOnSeaFloor
+                        && position.y - mParentWorld.GetOceanFloorHeightAt(position.x) <= SleepMaxSeaFloorDistance)
+                    {
+                        sleepState.IsOnSeaFloor = true;
+                    }
+                }
+            }
+        }
+    }
 
-    // Reset per-plane triangle indices
-    size_t totalPlaneTrianglesCount = 0;
-    mPlaneTrianglesRenderIndices.clear();
-    mPlaneTrianglesRenderIndices.push_back(totalPlaneTrianglesCount); // First plane starts at zero, and we have zero triangles
+    //
+    // 3. Put settled components to sleep, and wake up unsupported ones
+    //
 
-    // Visit all non-ephemeral points
-    for (auto pointIndex : mPoints.NonEphemeralPointsReverse())
+    for (auto & sleepState : mConnectedComponentSleepStates)
     {
-        // Don't visit destroyed points, or we run the risk of creating a zillion planes for nothing;
-        // also, don't re-visit already-visited points
-        if (!mPoints.IsDeleted(pointIndex)
-            && mPoints.GetCurrentConnectivityVisitSequenceNumber(pointIndex) != visitSequenceNumber)
+        if (sleepState.IsAsleep)
         {
-            //
-            // Flood a new plane from this point
-            //
+            if (doCheckSleepingComponents && !sleepState.IsOnSeaFloor)
+            {
+                sleepState.IsAsleep = false;
+                sleepState.SettledStepCount = 0;
 
-            // Visit this point first
-            mPoints.SetPlaneId(pointIndex, currentPlaneId, currentPlaneIdFloat);
-            mPoints.SetConnectedComponentId(pointIndex, static_cast<ConnectedComponentId>(currentPlaneId));
-            mPoints.SetCurrentConnectivityVisitSequenceNumber(pointIndex, visitSequenceNumber);
+                mAreAwakeRunsDirty = true;
+            }
+        }
+        else if (sleepState.PointCount > 0)
+        {
+            float const pointCount = static_cast<float>(sleepState.PointCount);
 
-            // Add point to queue
-            assert(pointsToPropagateFrom.empty());
-            pointsToPropagateFrom.push(pointIndex);
+            bool const isSettled =
+                sleepState.IsOnSeaFloor
+                && sleepState.TotalSquareVelocity <= SleepMaxMeanSquareVelocity * pointCount
+                && sleepState.TotalWaterTaken <= SleepMaxMeanWaterTaken * pointCount;
 
-            // Visit all points reachable from this point via springs
-            while (!pointsToPropagateFrom.empty())
+            if (!isSettled)
             {
-                // Pop point that we have to propagate from
-                auto const currentPointIndex = pointsToPropagateFrom.front();
-                pointsToPropagateFrom.pop();
+                sleepState.SettledStepCount = 0;
+            }
+            else if (++(sleepState.SettledStepCount) >= SleepSettledStepCount)
+            {
+                sleepState.IsAsleep = true;
 
-                // This point has been visited already
-                assert(visitSequenceNumber == mPoints.GetCurrentConnectivityVisitSequenceNumber(currentPointIndex));
+                mAreAwakeRunsDirty = true;
+            }
+        }
 
-#ifdef RENDER_FLOOD_DISTANCE
-                if (!floodDistanceColor)
-                {
-                    mPoints.GetColor(currentPointIndex) = vec4f(0.0f, 0.0f, 0.75f, 1.0f);
-                    floodDistanceColor = 0.0f;
-                }
-                else
-                    mPoints.GetColor(currentPointIndex) = vec4f(*floodDistanceColor, 0.0f, 0.0f, 1.0f);
-                floodDistanceColor = *floodDistanceColor + 1.0f / 128.0f;
-                if (*floodDistanceColor > 1.0f)
-                    floodDistanceColor = 0.0f;
-#endif
+        // Start measuring the next step
+        sleepState.PointCount = 0;
+        sleepState.TotalSquareVelocity = 0.0f;
+        sleepState.TotalWaterTaken = 0.0f;
+        sleepState.IsOnSeaFloor = false;
+    }
+}
 
-                // Visit all its non-visited connected points
-                for (auto const & cs : mPoints.GetConnectedSprings(currentPointIndex).ConnectedSprings)
-                {
-                    assert(!mPoints.IsDeleted(cs.OtherEndpointIndex));
+void Ship::WakeConnectedComponent(ConnectedComponentId connectedComponentId)
+{
+    // Ephemeral points and points not visited yet do not belong to any component
+    if (connectedComponentId < mConnectedComponentSleepStates.size())
+    {
+        auto & sleepState = mConnectedComponentSleepStates[connectedComponentId];
 
-                    if (visitSequenceNumber != mPoints.GetCurrentConnectivityVisitSequenceNumber(cs.OtherEndpointIndex))
-                    {
-                        //
-                        // Visit point
-                        //
+        // Whatever happened, the component is not settled anymore
+        sleepState.SettledStepCount = 0;
 
-                        mPoints.SetPlaneId(cs.OtherEndpointIndex, currentPlaneId, currentPlaneIdFloat);
-                        mPoints.SetConnectedComponentId(cs.OtherEndpointIndex, static_cast<ConnectedComponentId>(currentPlaneId));
-                        mPoints.SetCurrentConnectivityVisitSequenceNumber(cs.OtherEndpointIndex, visitSequenceNumber);
+        if (sleepState.IsAsleep)
+        {
+            sleepState.IsAsleep = false;
 
-                        // Add point to queue
-                        pointsToPropagateFrom.push(cs.OtherEndpointIndex);
-                    }
-                }
+            mAreAwakeRunsDirty = true;
+        }
+    }
+}
+
+void Ship::WakeAllConnectedComponents()
+{
+    for (ConnectedComponentId c = 0; c < mConnectedComponentSleepStates.size(); ++c)
+    {
+        WakeConnectedComponent(c);
+    }
+}
+
+void Ship::UpdateAwakeRuns()
+{
+    //
+    // Points: a point is asleep when its connected component is, while ephemeral
+    // points never sleep
+    //
+
+    mAwakePointRuns.clear();
+
+    for (auto pointIndex : mPoints)
+    {
+        ConnectedComponentId const connectedComponentId = mPoints.GetConnectedComponentId(pointIndex);
+
+        bool const isAsleep =
+            !mPoints.IsEphemeral(pointIndex)
+            && connectedComponentId < mConnectedComponentSleepStates.size()
+            && mConnectedComponentSleepStates[connectedComponentId].IsAsleep;
+
+        if (isAsleep != mPoints.IsAsleep(pointIndex))
+        {
+            mPoints.SetAsleep(pointIndex, isAsleep);
 
-                // Update count of triangles with this points's triangles
-                totalPlaneTrianglesCount += mPoints.GetConnectedOwnedTrianglesCount(currentPointIndex);
+            if (isAsleep)
+            {
+                // Stop the point right where it is
+                mPoints.GetVelocity(pointIndex) = vec2f::zero();
             }
+            else
+            {
+                // Discard the forces the point might have received while asleep
+                mPoints.GetForce(pointIndex) = vec2f::zero();
 
-            // Remember the starting index of the triangles in the next plane
-            assert(mPlaneTrianglesRenderIndices.size() == static_cast<size_t>(currentPlaneId + 1));
-            mPlaneTrianglesRenderIndices.push_back(totalPlaneTrianglesCount);
+                // Resume moving the point's water
+                if (mPoints.GetWater(pointIndex) != 0.0f)
+                    mPoints.AddToWaterActiveSet(pointIndex);
+            }
+        }
 
-            //
-            // Flood completed
-            //
+        if (!isAsleep)
+        {
+            if (!mAwakePointRuns.empty() && mAwakePointRuns.back().End == pointIndex)
+                ++(mAwakePointRuns.back().End);
+            else
+                mAwakePointRuns.emplace_back(pointIndex, pointIndex + 1);
+        }
+    }
 
-            // Remember max plane ID ever
-            mMaxMaxPlaneId = std::max(mMaxMaxPlaneId, currentPlaneId);
+    // The buffer's padding goes along with the last point, so that integration
+    // may still run on whole buffers
+    if (!mAwakePointRuns.empty() && mAwakePointRuns.back().End == mPoints.GetElementCount())
+        mAwakePointRuns.back().End = mPoints.GetBufferElementCount();
+
+    //
+    // Springs: a spring is asleep when its endpoints are - which always share the component;
+    // runs are widened to whole SIMD batches, as the vectorized kernel may only process those
+    //
 
-            // Next we begin a new plane and connected component
-            ++currentPlaneId;
-            currentPlaneIdFloat = static_cast<float>(currentPlaneId);
+    mAwakeSpringRuns.clear();
+
+    for (auto springIndex : mSprings)
+    {
+        if (!mPoints.IsAsleep(mSprings.GetPointAIndex(springIndex)))
+        {
+            ElementIndex const batchStartSpringIndex = springIndex - (springIndex % Springs::SimdBatchSize);
+            ElementIndex const batchEndSpringIndex = std::min(batchStartSpringIndex + Springs::SimdBatchSize, mSprings.GetElementCount());
+
+            if (!mAwakeSpringRuns.empty() && mAwakeSpringRuns.back().End >= batchStartSpringIndex)
+                mAwakeSpringRuns.back().End = std::max(mAwakeSpringRuns.back().End, batchEndSpringIndex);
+            else
+                mAwakeSpringRuns.emplace_back(batchStartSpringIndex, batchEndSpringIndex);
         }
     }
 
-#ifdef RENDER_FLOOD_DISTANCE
-    // Remember colors are dirty
-    mPoints.MarkColorBufferAsDirty();
-#endif
+    mAreAwakeRunsDirty = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Private helpers
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+void Ship::RunConnectivityVisit()
+{
+    PROFILE_PHASE(ConnectivityVisit);
+
+    //
+    // Here we propagate connectivity information to the network of points - see ConnectivityVisit
+    // for how plane IDs are assigned, and why they keep their order between full and incremental visits
+    //
+
+    if (mConnectivityVisit.Run(mPoints))
+    {
+        // Connected component IDs have been re-assigned, hence we start over with all components awake
+        mConnectedComponentSleepStates.assign(mConnectivityVisit.GetPlaneCount(), ConnectedComponentSleepState());
+        mAreAwakeRunsDirty = true;
+    }
+    else
+    {
+        // The components that have split were woken up when they lost springs, and the
+        // new components start awake
+        mConnectedComponentSleepStates.resize(mConnectivityVisit.GetPlaneCount());
+    }
 
-    // Remember non-ephemeral portion of plane IDs is dirty
-    mPoints.MarkPlaneIdBufferNonEphemeralAsDirty();
+    mIsConnectivityDirty = false;
+
+    //
+    // Calculate the starting index of the triangles of each plane, so that we can later upload
+    // triangles in {PlaneID, Tessellation Order} order
+    //
+
+    auto const & planeTrianglesCounts = mConnectivityVisit.GetPlaneTrianglesCounts();
+
+    mPlaneTrianglesRenderIndices.resize(planeTrianglesCounts.size() + 1);
+
+    size_t totalPlaneTrianglesCount = 0;
+    for (size_t p = 0; p < planeTrianglesCounts.size(); ++p)
+    {
+        mPlaneTrianglesRenderIndices[p] = totalPlaneTrianglesCount;
+        totalPlaneTrianglesCount += planeTrianglesCounts[p];
+    }
+
+    mPlaneTrianglesRenderIndices.back() = totalPlaneTrianglesCount;
+
+    // Light depends on plane IDs
+    mIsLightDirty = true;
 }
 
 void Ship::DestroyConnectedTriangles(ElementIndex pointElementIndex)
@@ -1979,14 +2475,15 @@ void Ship::PointDestroyHandler(
     //
 
     // Note: we can't simply iterate and destroy, as destroying a spring causes
-    // that spring to be removed from the vector being iterated
-    auto & connectedSprings = mPoints.GetConnectedSprings(pointElementIndex).ConnectedSprings;
-    while (!connectedSprings.empty())
+    // that spring to be removed from the list being iterated
+    while (!mPoints.GetConnectedSprings(pointElementIndex).empty())
     {
-        assert(!mSprings.IsDeleted(connectedSprings.back().SpringIndex));
+        ElementIndex const springElementIndex = mPoints.GetConnectedSprings(pointElementIndex).back().SpringIndex;
+
+        assert(!mSprings.IsDeleted(springElementIndex));
 
         mSprings.Destroy(
-            connectedSprings.back().SpringIndex,
+            springElementIndex,
             Springs::DestroyOptions::DoNotFireBreakEvent // We're already firing the Destroy event for the point
             | Springs::DestroyOptions::DestroyAllTriangles,
             currentSimulationTime,
@@ -1994,7 +2491,7 @@ void Ship::PointDestroyHandler(
             mPoints);
     }
 
-    assert(mPoints.GetConnectedSprings(pointElementIndex).ConnectedSprings.empty());
+    assert(mPoints.GetConnectedSprings(pointElementIndex).empty());
 
 
     //
@@ -2028,6 +2525,9 @@ void Ship::PointDestroyHandler(
         mElectricalElements.Destroy(mPoints.GetElectricalElement(pointElementIndex));
     }
 
+    // Wake up the point's component, as it has changed
+    WakeConnectedComponent(mPoints.GetConnectedComponentId(pointElementIndex));
+
     // Notify bombs
     mBombs.OnPointDestroyed(pointElementIndex);
 
@@ -2045,6 +2545,7 @@ void Ship::PointDestroyHandler(
 
     // Remember the structure is now dirty
     mIsStructureDirty = true;
+    mIsConnectivityDirty = true;
 }
 
 void Ship::SpringDestroyHandler(
@@ -2136,8 +2637,15 @@ void Ship::SpringDestroyHandler(
     // Notify pinned points
     mPinnedPoints.OnSpringDestroyed(springElementIndex);
 
+    // Remember the endpoints may now belong to different components
+    mConnectivityVisit.OnSpringDestroyed(pointAIndex, pointBIndex);
+
+    // Wake up the endpoints' component, as it has changed
+    WakeConnectedComponent(mPoints.GetConnectedComponentId(pointAIndex));
+
     // Remember our structure is now dirty
     mIsStructureDirty = true;
+    mIsConnectivityDirty = true;
 }
 
 void Ship::TriangleDestroyHandler(ElementIndex triangleElementIndex)
@@ -2151,6 +2659,10 @@ void Ship::TriangleDestroyHandler(ElementIndex triangleElementIndex)
     // Let's be neat
     mTriangles.ClearSubSprings(triangleElementIndex);
 
+    // Remove triangle from the count of its plane (== plane of its owner)
+    PlaneId const planeId = mPoints.GetPlaneId(mTriangles.GetPointAIndex(triangleElementIndex));
+    mConnectivityVisit.OnTriangleDestroyed(planeId);
+
     // Remove triangle from its endpoints
     mPoints.RemoveConnectedTriangle(mTriangles.GetPointAIndex(triangleElementIndex), triangleElementIndex, true); // Owner
     mPoints.RemoveConnectedTriangle(mTriangles.GetPointBIndex(triangleElementIndex), triangleElementIndex, false); // Not owner
@@ -2158,12 +2670,14 @@ void Ship::TriangleDestroyHandler(ElementIndex triangleElementIndex)
 
     // Remember our structure is now dirty
     mIsStructureDirty = true;
+    mIsConnectivityDirty = true;
 }
 
 void Ship::ElectricalElementDestroyHandler(ElementIndex /*electricalElementIndex*/)
 {
     // Remember our structure is now dirty
     mIsStructureDirty = true;
+    mIsConnectivityDirty = true;
 }
 
 void Ship::GenerateAirBubbles(
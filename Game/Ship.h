@@ -11,12 +11,14 @@
 #include "RenderContext.h"
 #include "ShipDefinition.h"
 
+#include <GameCore/Buffer.h>
 #include <GameCore/GameTypes.h>
 #include <GameCore/RunningAverage.h>
 #include <GameCore/Vectors.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
-#include <optional>
 #include <vector>
 
 namespace Physics
@@ -139,12 +141,31 @@ public:
     void Update(
         float currentSimulationTime,
         GameParameters const & gameParameters,
-        Render::RenderContext const & renderContext);
+        VectorFieldRenderMode vectorFieldRenderMode);
 
+    /*
+     * Renders the ship as of its last acquired render snapshot.
+     */
     void Render(
         GameParameters const & gameParameters,
         Render::RenderContext & renderContext);
 
+    /*
+     * Publishes the state of the ship as of the end of the last step - including its
+     * plane IDs, which are re-calculated here if needed - for the renderer to acquire.
+     */
+    void PublishRenderSnapshot(VectorFieldRenderMode vectorFieldRenderMode);
+
+    void HandOverRenderSnapshot()
+    {
+        mRenderSnapshot.HandOver();
+    }
+
+    void AcquireRenderSnapshot(bool doInterpolatePositions)
+    {
+        mRenderSnapshot.Acquire(doInterpolatePositions);
+    }
+
 public:
 
     /////////////////////////////////////////////////////////////////////////
@@ -156,15 +177,42 @@ public:
     void UpdateMechanicalDynamics(
         float currentSimulationTime,
         GameParameters const & gameParameters,
-        Render::RenderContext const & renderContext);
+        VectorFieldRenderMode vectorFieldRenderMode);
+
+    void UpdateMechanicalDynamicsIterationsFraction(
+        bool isAtLeastOneSpringBroken,
+        GameParameters const & gameParameters);
 
-    void UpdatePointForces(GameParameters const & gameParameters);
+    void UpdatePointForces(
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex,
+        GameParameters const & gameParameters);
 
-    void UpdateSpringForces(GameParameters const & gameParameters);
+    void UpdateSpringForces(
+        ElementIndex startSpringIndex,
+        ElementIndex endSpringIndex,
+        vec2f * restrict forceBuffer,
+        GameParameters const & gameParameters);
 
-    void IntegrateAndResetPointForces(GameParameters const & gameParameters);
+    void UpdateSpringForces_Naive(
+        ElementIndex startSpringIndex,
+        ElementIndex endSpringIndex,
+        vec2f * restrict forceBuffer);
 
-    void HandleCollisionsWithSeaFloor(GameParameters const & gameParameters);
+    void UpdateSpringForces_Vectorized(
+        ElementIndex startSpringIndex,
+        ElementIndex endSpringIndex,
+        vec2f * restrict forceBuffer);
+
+    void IntegrateAndResetPointForces(
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex,
+        GameParameters const & gameParameters);
+
+    void HandleCollisionsWithSeaFloor(
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex,
+        GameParameters const & gameParameters);
 
     void TrimForWorldBounds(
         float currentSimulationTime,
@@ -195,6 +243,13 @@ public:
 
     void DiffuseLight(GameParameters const & gameParameters);
 
+    void DiffuseLampLight_Vectorized(
+        vec2f const & lampPosition,
+        float effectiveLampLight,
+        float effectiveExponent,
+        ElementIndex const * restrict pointIndices,
+        size_t pointCount);
+
     // Ephemeral particles
 
     void UpdateEphemeralParticles(
@@ -211,8 +266,40 @@ public:
         float currentSimulationTime,
         GameParameters const & gameParameters);
 
+    // Sleep
+
+    void UpdateSleep(GameParameters const & gameParameters);
+
+    void WakeConnectedComponent(ConnectedComponentId connectedComponentId);
+
+    void WakeAllConnectedComponents();
+
+    void UpdateAwakeRuns();
+
 private:
 
+    /*
+     * Returns the grid over the current point positions, rebuilding it if needed.
+     */
+    PointGrid const & GetPointGrid() const
+    {
+        if (!mPointGrid.IsValid())
+            mPointGrid.Rebuild(mPoints);
+
+        return mPointGrid;
+    }
+
+    /*
+     * Returns the hierarchy over the current spring positions, refitting it if needed.
+     */
+    SpringBvh const & GetSpringBvh() const
+    {
+        if (!mSpringBvh.IsValid())
+            mSpringBvh.Refit(mSprings, mPoints);
+
+        return mSpringBvh;
+    }
+
     void RunConnectivityVisit();
 
     void DestroyConnectedTriangles(ElementIndex pointElementIndex);
@@ -287,6 +374,104 @@ private:
     void VerifyInvariants();
 #endif
 
+private:
+
+    // Ships with less springs than this (times the number of threads) are not
+    // worth splitting among threads
+    static constexpr size_t MinSpringsPerMechanicalDynamicsPartition = 4096;
+
+    // The adaptive number of mechanical iterations is halved, down to this fraction of the
+    // configured number, after this many consecutive steps in which no spring is strained
+    // more than this...
+    static constexpr float MinMechanicalDynamicsIterationsFraction = 0.25f;
+    static constexpr std::uint32_t AdaptiveIterationsCalmStepCount = 64;
+    static constexpr float AdaptiveIterationsMaxCalmStrain = 0.01f;
+
+    // ...and it's brought back to the configured number as soon as a spring is strained more
+    // than this; the gap keeps the softer body of fewer iterations from bouncing between the two
+    static constexpr float AdaptiveIterationsMinAgitatedStrain = 0.03f;
+
+    // Chunks of active points smaller than this are not worth diffusing water
+    // on a separate thread
+    static constexpr ElementCount MinWaterDiffusionChunkSize = 1024;
+
+    /*
+     * A run of consecutive elements, [Start, End).
+     */
+    struct ElementRun
+    {
+        ElementIndex Start;
+        ElementIndex End;
+
+        ElementRun(
+            ElementIndex start,
+            ElementIndex end)
+            : Start(start)
+            , End(end)
+        {}
+    };
+
+    /*
+     * Invokes the visitor as visitor(start, end) with each of the runs, clipped
+     * to the [startIndex, endIndex) range.
+     */
+    template<typename TVisitor>
+    static inline void VisitRuns(
+        std::vector<ElementRun> const & runs,
+        ElementIndex startIndex,
+        ElementIndex endIndex,
+        TVisitor && visitor)
+    {
+        for (auto const & run : runs)
+        {
+            if (run.Start >= endIndex)
+                break;
+
+            ElementIndex const clippedStartIndex = std::max(run.Start, startIndex);
+            ElementIndex const clippedEndIndex = std::min(run.End, endIndex);
+            if (clippedStartIndex < clippedEndIndex)
+                visitor(clippedStartIndex, clippedEndIndex);
+        }
+    }
+
+    /*
+     * The sleep state of a connected component.
+     */
+    struct ConnectedComponentSleepState
+    {
+        bool IsAsleep;
+
+        // The number of consecutive steps the component has been settled for
+        std::uint32_t SettledStepCount;
+
+        // Measures taken during the current step
+        ElementCount PointCount;
+        float TotalSquareVelocity;
+        float TotalWaterTaken;
+        bool IsOnSeaFloor;
+
+        ConnectedComponentSleepState()
+            : IsAsleep(false)
+            , SettledStepCount(0)
+            , PointCount(0)
+            , TotalSquareVelocity(0.0f)
+            , TotalWaterTaken(0.0f)
+            , IsOnSeaFloor(false)
+        {}
+    };
+
+    // A connected component is settled when any of its points is at most this far above the sea floor...
+    static constexpr float SleepMaxSeaFloorDistance = 1.0f;
+
+    // ...their mean square velocity is at most this much (m^2/s^2)...
+    static constexpr float SleepMaxMeanSquareVelocity = 0.09f;
+
+    // ...and the mean water they take in is at most this much per step
+    static constexpr float SleepMaxMeanWaterTaken = 0.0005f;
+
+    // The number of consecutive settled steps after which a connected component is put to sleep
+    static constexpr std::uint32_t SleepSettledStepCount = 128;
+
 private:
 
     ShipId const mId;
@@ -303,24 +488,22 @@ private:
     // The current simulation sequence number
     SequenceNumber mCurrentSimulationSequenceNumber;
 
-    // The current connectivity visit sequence number
-    SequenceNumber mCurrentConnectivityVisitSequenceNumber;
-
-    // The max plane ID we have seen - ever
-    PlaneId mMaxMaxPlaneId;
+    // The connectivity visit, which owns plane IDs and the count of triangles in each;
+    // plane IDs are always compact between zero and its max plane ID
+    ConnectivityVisit mConnectivityVisit;
 
     // The current electrical connectivity visit sequence number
     SequenceNumber mCurrentElectricalVisitSequenceNumber;
 
     // Flag remembering whether the structure of the ship (i.e. the connectivity between elements)
-    // has changed since the last step.
-    // When this flag is set, we'll re-detect connected components and planes, and re-upload elements
-    // to the rendering context
+    // has changed since the last render snapshot.
+    // When this flag is set, we'll re-publish elements to the render snapshot
     bool mIsStructureDirty;
 
-    // The debug ship render mode that was in effect the last time we've uploaded elements;
-    // used to detect changes and eventually re-upload
-    std::optional<DebugShipRenderMode> mLastDebugShipRenderMode;
+    // Flag remembering whether connected components and planes have to be re-detected;
+    // unlike the structure flag, it's cleared as soon as they have been, which might
+    // happen before rendering
+    bool mIsConnectivityDirty;
 
     // Initial indices of the triangles for each plane ID;
     // last extra element contains total number of triangles
@@ -333,6 +516,24 @@ private:
     float mTotalWater;
     RunningAverage<30> mWaterSplashedRunningAverage;
 
+    // Light, as of the last time we've diffused it: the effective light and the position
+    // of each lamp, and the light spread adjustment
+    std::vector<float> mDiffusedLampLights;
+    std::vector<vec2f> mDiffusedLampPositions;
+    float mDiffusedLightSpreadAdjustment;
+
+    // Flag remembering whether light has to be diffused again regardless of the lamps,
+    // i.e. because plane IDs have changed
+    bool mIsLightDirty;
+
+    // The number of steps since we've last diffused light, and whether any lamp was lit
+    // then - in which case we diffuse light again periodically, as lit points move
+    unsigned int mStepsSinceLightDiffusion;
+    bool mIsAnyDiffusedLampLit;
+
+    // Scratch buffer with the points within reach of a lamp
+    std::vector<ElementIndex> mLitPoints;
+
     // Pinned points
     PinnedPoints mPinnedPoints;
 
@@ -341,6 +542,41 @@ private:
 
     // Force fields to apply at next iteration
     std::vector<std::unique_ptr<ForceField>> mCurrentForceFields;
+
+    // The spatial index of the points, for interactions and force fields;
+    // only kept up-to-date while it's being used
+    mutable PointGrid mPointGrid;
+
+    // The spatial index of the springs, for interactions;
+    // only kept up-to-date while it's being used
+    mutable SpringBvh mSpringBvh;
+
+    // The work buffers of the pull kernel of water diffusion
+    WaterDiffusion mWaterDiffusion;
+
+    // The state of the ship to render
+    RenderSnapshot mRenderSnapshot;
+
+    // The iterations of the mechanical dynamics update, and their partitions
+    // when the update is split among threads
+    MechanicalDynamics mMechanicalDynamics;
+
+    // The fraction of the configured number of mechanical iterations that we currently run,
+    // and the number of consecutive calm steps run with it
+    float mMechanicalDynamicsIterationsFraction;
+    std::uint32_t mAdaptiveIterationsCalmStepCount;
+
+    // The sleep state of each connected component
+    std::vector<ConnectedComponentSleepState> mConnectedComponentSleepStates;
+
+    // The runs of points and springs that are awake, i.e. that the dynamics visit;
+    // spring runs are widened to whole SIMD batches
+    std::vector<ElementRun> mAwakePointRuns;
+    std::vector<ElementRun> mAwakeSpringRuns;
+
+    // Flag remembering whether the awake runs have to be rebuilt, because connected
+    // components have fallen asleep or woken up
+    bool mAreAwakeRunsDirty;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,939 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-04-04
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "ShipBuildCache.h"
+
+#include <GameCore/ContentHasher.h>
+#include <GameCore/Log.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace /* anonymous */ {
+
+    // Changes whenever the builder changes the way it lays out ships
+    constexpr uint32_t BuilderVersion = 1;
+
+    // Changes whenever the format of the files changes
+    constexpr uint32_t FileMagic = 0x43425346; // "FSBC"
+    constexpr uint32_t FileFormatVersion = 3;
+
+    // Protects us from silly section tables in corrupted files
+    constexpr uint32_t MaxSectionCount = 64;
+
+    enum class SectionType : uint32_t
+    {
+        StructuralMaterialColorKeys = 1,
+        ElectricalMaterialColorKeys = 2,
+        PointPositions = 3,
+        PointTextureCoordinates = 4,
+        PointRenderColors = 5,
+        PointMaterials = 6,
+        PointFlags = 7,
+        Springs = 8,
+        Triangles = 9,
+        PointIndexRemap = 10
+    };
+
+    //
+    // The file starts with the header, which is followed by the section descriptors;
+    // the sections follow, one after the other
+    //
+
+    struct FileHeader
+    {
+        uint32_t Magic;
+        uint32_t FormatVersion;
+        uint64_t Key;
+        uint64_t BatchedSpringCount;
+        uint32_t SectionCount;
+        uint32_t Reserved;
+    };
+
+    static_assert(sizeof(FileHeader) == 32);
+
+    struct SectionDescriptor
+    {
+        uint32_t Type;
+        uint32_t ElementSize;
+        uint64_t ElementCount;
+        uint64_t Offset;
+    };
+
+    static_assert(sizeof(SectionDescriptor) == 24);
+
+    //
+    // Records
+    //
+
+    struct ColorKeyRecord
+    {
+        uint8_t r;
+        uint8_t g;
+        uint8_t b;
+        uint8_t Reserved;
+    };
+
+    // Indices into the material color key sections
+    struct PointMaterialsRecord
+    {
+        uint16_t StructuralMaterialOrdinal;
+        uint16_t ElectricalMaterialOrdinal;
+    };
+
+    constexpr uint16_t NoneMaterialOrdinal = 0xffff;
+
+    // Point flags
+    constexpr uint8_t IsRopeFlag = 0x01;
+    constexpr uint8_t IsLeakingFlag = 0x02;
+
+    struct SpringRecord
+    {
+        ElementIndex PointAIndex1;
+        ElementIndex PointBIndex1;
+        uint32_t SuperTriangles2Count;
+        ElementIndex SuperTriangles2[2];
+    };
+
+    struct TriangleRecord
+    {
+        ElementIndex PointIndices1[3];
+        uint32_t SubSprings2Count;
+        ElementIndex SubSprings2[4];
+    };
+
+    //
+    // Writing
+    //
+
+    struct SectionSource
+    {
+        SectionType Type;
+        uint32_t ElementSize;
+        uint64_t ElementCount;
+        void const * Data;
+    };
+
+    template<typename TRecord>
+    SectionSource MakeSectionSource(
+        SectionType type,
+        std::vector<TRecord> const & records)
+    {
+        static_assert(std::is_trivially_copyable<TRecord>::value, "Sections may only contain trivially-copyable records");
+
+        return SectionSource{
+            type,
+            static_cast<uint32_t>(sizeof(TRecord)),
+            static_cast<uint64_t>(records.size()),
+            records.data() };
+    }
+
+    std::vector<unsigned char> MakeFileContent(
+        uint64_t key,
+        uint64_t batchedSpringCount,
+        std::vector<SectionSource> const & sectionSources)
+    {
+        //
+        // Lay out the sections
+        //
+
+        std::vector<SectionDescriptor> sectionDescriptors;
+
+        size_t offset = sizeof(FileHeader) + sectionSources.size() * sizeof(SectionDescriptor);
+        for (auto const & sectionSource : sectionSources)
+        {
+            sectionDescriptors.push_back(
+                SectionDescriptor{
+                    static_cast<uint32_t>(sectionSource.Type),
+                    sectionSource.ElementSize,
+                    sectionSource.ElementCount,
+                    static_cast<uint64_t>(offset) });
+
+            offset += static_cast<size_t>(sectionSource.ElementSize * sectionSource.ElementCount);
+        }
+
+        //
+        // Fill-in the content
+        //
+
+        std::vector<unsigned char> content(offset, 0);
+
+        FileHeader const fileHeader{
+            FileMagic,
+            FileFormatVersion,
+            key,
+            batchedSpringCount,
+            static_cast<uint32_t>(sectionDescriptors.size()),
+            0 };
+
+        std::memcpy(content.data(), &fileHeader, sizeof(FileHeader));
+
+        std::memcpy(
+            content.data() + sizeof(FileHeader),
+            sectionDescriptors.data(),
+            sectionDescriptors.size() * sizeof(SectionDescriptor));
+
+        for (size_t s = 0; s < sectionSources.size(); ++s)
+        {
+            if (0 == sectionSources[s].ElementCount)
+                continue;
+
+            std::memcpy(
+                content.data() + sectionDescriptors[s].Offset,
+                sectionSources[s].Data,
+                static_cast<size_t>(sectionSources[s].ElementSize * sectionSources[s].ElementCount));
+        }
+
+        return content;
+    }
+
+    //
+    // Reading
+    //
+
+    /*
+     * The content of a whole file, from which the sections are then copied out.
+     */
+    class FileContent
+    {
+    public:
+
+        explicit FileContent(size_t size)
+            : mData(size)
+            , mSize(size)
+            , mBatchedSpringCount(0)
+            , mSectionDescriptors()
+        {
+        }
+
+        unsigned char * GetData()
+        {
+            return mData.data();
+        }
+
+        /*
+         * Validates the header against the expected key, and prepares the sections.
+         */
+        bool Open(uint64_t key)
+        {
+            if (mSize < sizeof(FileHeader))
+                return false;
+
+            FileHeader fileHeader;
+            std::memcpy(&fileHeader, mData.data(), sizeof(FileHeader));
+
+            if (fileHeader.Magic != FileMagic
+                || fileHeader.FormatVersion != FileFormatVersion
+                || fileHeader.Key != key
+                || fileHeader.SectionCount > MaxSectionCount
+                || mSize < sizeof(FileHeader) + fileHeader.SectionCount * sizeof(SectionDescriptor))
+            {
+                return false;
+            }
+
+            mBatchedSpringCount = fileHeader.BatchedSpringCount;
+
+            mSectionDescriptors.resize(fileHeader.SectionCount);
+            std::memcpy(
+                mSectionDescriptors.data(),
+                mData.data() + sizeof(FileHeader),
+                mSectionDescriptors.size() * sizeof(SectionDescriptor));
+
+            for (auto const & sectionDescriptor : mSectionDescriptors)
+            {
+                if (sectionDescriptor.Offset > mSize
+                    || sectionDescriptor.ElementSize == 0
+                    || sectionDescriptor.ElementCount > (mSize - sectionDescriptor.Offset) / sectionDescriptor.ElementSize)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        uint64_t GetBatchedSpringCount() const
+        {
+            return mBatchedSpringCount;
+        }
+
+        /*
+         * Copies out the records of the specified section; returns false if the section
+         * is missing or if its records are not of the expected size.
+         */
+        template<typename TRecord>
+        bool GetSection(
+            SectionType type,
+            std::vector<TRecord> & records) const
+        {
+            static_assert(std::is_trivially_copyable<TRecord>::value, "Sections may only contain trivially-copyable records");
+
+            for (auto const & sectionDescriptor : mSectionDescriptors)
+            {
+                if (sectionDescriptor.Type == static_cast<uint32_t>(type))
+                {
+                    if (sectionDescriptor.ElementSize != sizeof(TRecord))
+                        return false;
+
+                    records.resize(static_cast<size_t>(sectionDescriptor.ElementCount));
+
+                    if (!records.empty())
+                    {
+                        std::memcpy(
+                            records.data(),
+                            mData.data() + sectionDescriptor.Offset,
+                            records.size() * sizeof(TRecord));
+                    }
+
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+    private:
+
+        std::vector<unsigned char> mData;
+        size_t const mSize;
+
+        uint64_t mBatchedSpringCount;
+        std::vector<SectionDescriptor> mSectionDescriptors;
+    };
+
+    /*
+     * Checks that all of the specified indices refer to existing elements; the files' element
+     * indices are trusted by the builder, hence a corrupted file must never get that far.
+     */
+    inline bool AreIndicesInRange(
+        ElementIndex const * indices,
+        size_t indexCount,
+        size_t elementCount)
+    {
+        for (size_t i = 0; i < indexCount; ++i)
+        {
+            if (static_cast<size_t>(indices[i]) >= elementCount)
+                return false;
+        }
+
+        return true;
+    }
+
+    template<typename TMaterial>
+    bool ResolveMaterials(
+        FileContent const & fileContent,
+        SectionType sectionType,
+        TMaterial const * (MaterialDatabase::*findMaterial)(MaterialDatabase::ColorKey const &) const,
+        MaterialDatabase const & materialDatabase,
+        std::vector<TMaterial const *> & materials)
+    {
+        std::vector<ColorKeyRecord> colorKeyRecords;
+        if (!fileContent.GetSection(sectionType, colorKeyRecords))
+            return false;
+
+        for (size_t m = 0; m < colorKeyRecords.size(); ++m)
+        {
+            TMaterial const * const material = (materialDatabase.*findMaterial)(
+                MaterialDatabase::ColorKey(colorKeyRecords[m].r, colorKeyRecords[m].g, colorKeyRecords[m].b));
+
+            if (nullptr == material)
+                return false;
+
+            materials.push_back(material);
+        }
+
+        return true;
+    }
+
+    /*
+     * Tells whether the specified file is a cache file of the current format, regardless
+     * of its key and of its content.
+     */
+    bool IsCurrentFormatFile(std::filesystem::path const & filePath)
+    {
+        std::ifstream file(filePath, std::ios::in | std::ios::binary);
+        if (!file.is_open())
+            return false;
+
+        FileHeader fileHeader;
+        file.read(reinterpret_cast<char *>(&fileHeader), sizeof(FileHeader));
+
+        return !!file
+            && fileHeader.Magic == FileMagic
+            && fileHeader.FormatVersion == FileFormatVersion;
+    }
+
+    void AddImage(
+        ContentHasher & contentHasher,
+        RgbImageData const & image)
+    {
+        contentHasher.Add(image.Size.Width);
+        contentHasher.Add(image.Size.Height);
+
+        for (size_t i = 0; i < static_cast<size_t>(image.Size.Width * image.Size.Height); ++i)
+        {
+            contentHasher.Add(image.Data[i].r);
+            contentHasher.Add(image.Data[i].g);
+            contentHasher.Add(image.Data[i].b);
+        }
+    }
+}
+
+uint64_t ShipBuildCache::CalculateKey(
+    ShipDefinition const & shipDefinition,
+    MaterialDatabase const & materialDatabase)
+{
+    ContentHasher contentHasher;
+
+    // Builder
+    contentHasher.Add(BuilderVersion);
+    contentHasher.Add(Physics::Springs::SimdBatchSize);
+
+    // Materials
+    contentHasher.Add(materialDatabase.GetContentHash());
+
+    // Ship
+    AddImage(contentHasher, shipDefinition.StructuralLayerImage);
+
+    contentHasher.Add(!!shipDefinition.RopesLayerImage);
+    if (!!shipDefinition.RopesLayerImage)
+        AddImage(contentHasher, *shipDefinition.RopesLayerImage);
+
+    contentHasher.Add(!!shipDefinition.ElectricalLayerImage);
+    if (!!shipDefinition.ElectricalLayerImage)
+        AddImage(contentHasher, *shipDefinition.ElectricalLayerImage);
+
+    contentHasher.Add(shipDefinition.Metadata.Offset.x);
+    contentHasher.Add(shipDefinition.Metadata.Offset.y);
+
+    return contentHasher.GetHash();
+}
+
+std::shared_ptr<ShipBuilder::ShipLayout const> ShipBuildCache::TryLoad(
+    uint64_t key,
+    MaterialDatabase const & materialDatabase) const
+{
+    {
+        std::lock_guard<std::mutex> const lock(mLastLayoutMutex);
+
+        if (!!mLastLayout
+            && mLastLayoutKey == key
+            && mLastLayoutMaterialDatabase == &materialDatabase)
+        {
+            return mLastLayout;
+        }
+    }
+
+    auto shipLayout = TryLoadFile(key, materialDatabase);
+    if (!!shipLayout)
+    {
+        RememberLastLayout(key, shipLayout, materialDatabase);
+    }
+
+    return shipLayout;
+}
+
+void ShipBuildCache::Store(
+    uint64_t key,
+    std::shared_ptr<ShipBuilder::ShipLayout const> shipLayout,
+    MaterialDatabase const & materialDatabase) const
+{
+    assert(!!shipLayout);
+
+    StoreFile(key, *shipLayout, materialDatabase);
+
+    RememberLastLayout(key, std::move(shipLayout), materialDatabase);
+}
+
+std::shared_ptr<ShipBuilder::ShipLayout const> ShipBuildCache::TryLoadFile(
+    uint64_t key,
+    MaterialDatabase const & materialDatabase) const
+{
+    auto const filePath = GetCacheFilePath(key);
+
+    std::error_code errorCode;
+    auto const fileSize = std::filesystem::file_size(filePath, errorCode);
+    if (!!errorCode)
+    {
+        // Not there
+        return nullptr;
+    }
+
+    // Files that cannot be used would never become usable, hence we get rid of them
+    auto const discardFile = [&filePath](char const * reason)
+    {
+        LogMessage("Deleting ", reason, " ship build cache file \"", filePath.string(), "\"");
+
+        std::error_code removeErrorCode;
+        std::filesystem::remove(filePath, removeErrorCode);
+    };
+
+    if (0 == fileSize)
+    {
+        discardFile("unrecognized");
+        return nullptr;
+    }
+
+    //
+    // Read the whole file at once
+    //
+
+    FileContent fileContent(static_cast<size_t>(fileSize));
+
+    bool isFileRead;
+
+    {
+        std::ifstream file(filePath, std::ios::in | std::ios::binary);
+        if (!file.is_open())
+        {
+            return nullptr;
+        }
+
+        file.read(reinterpret_cast<char *>(fileContent.GetData()), static_cast<std::streamsize>(fileSize));
+        isFileRead = !!file;
+    }
+
+    if (!isFileRead)
+    {
+        discardFile("truncated");
+        return nullptr;
+    }
+
+    if (!fileContent.Open(key))
+    {
+        discardFile("unrecognized");
+        return nullptr;
+    }
+
+    //
+    // Materials - resolved once for all the points that use them
+    //
+
+    std::vector<StructuralMaterial const *> structuralMaterials;
+    std::vector<ElectricalMaterial const *> electricalMaterials;
+
+    if (!ResolveMaterials(fileContent, SectionType::StructuralMaterialColorKeys, &MaterialDatabase::FindStructuralMaterial, materialDatabase, structuralMaterials)
+        || !ResolveMaterials(fileContent, SectionType::ElectricalMaterialColorKeys, &MaterialDatabase::FindElectricalMaterial, materialDatabase, electricalMaterials))
+    {
+        discardFile("stale");
+        return nullptr;
+    }
+
+    //
+    // Sections
+    //
+
+    std::vector<vec2f> positions;
+    std::vector<vec2f> textureCoordinates;
+    std::vector<vec4f> renderColors;
+    std::vector<PointMaterialsRecord> pointMaterials;
+    std::vector<uint8_t> pointFlags;
+    std::vector<SpringRecord> springRecords;
+    std::vector<TriangleRecord> triangleRecords;
+    std::vector<ElementIndex> pointIndexRemap;
+
+    if (!fileContent.GetSection(SectionType::PointPositions, positions)
+        || !fileContent.GetSection(SectionType::PointTextureCoordinates, textureCoordinates)
+        || !fileContent.GetSection(SectionType::PointRenderColors, renderColors)
+        || !fileContent.GetSection(SectionType::PointMaterials, pointMaterials)
+        || !fileContent.GetSection(SectionType::PointFlags, pointFlags)
+        || !fileContent.GetSection(SectionType::Springs, springRecords)
+        || !fileContent.GetSection(SectionType::Triangles, triangleRecords)
+        || !fileContent.GetSection(SectionType::PointIndexRemap, pointIndexRemap)
+        || textureCoordinates.size() != positions.size()
+        || renderColors.size() != positions.size()
+        || pointMaterials.size() != positions.size()
+        || pointFlags.size() != positions.size()
+        || pointIndexRemap.size() != positions.size()
+        || fileContent.GetBatchedSpringCount() > springRecords.size())
+    {
+        discardFile("unrecognized");
+        return nullptr;
+    }
+
+    size_t const pointCount = positions.size();
+    size_t const springCount = springRecords.size();
+    size_t const triangleCount = triangleRecords.size();
+
+    //
+    // Element indices - all of them must refer to existing elements
+    //
+
+    bool areIndicesInRange = AreIndicesInRange(pointIndexRemap.data(), pointIndexRemap.size(), pointCount);
+
+    for (size_t s = 0; s < springCount && areIndicesInRange; ++s)
+    {
+        areIndicesInRange =
+            AreIndicesInRange(&(springRecords[s].PointAIndex1), 1, pointCount)
+            && AreIndicesInRange(&(springRecords[s].PointBIndex1), 1, pointCount)
+            && springRecords[s].SuperTriangles2Count <= 2
+            && AreIndicesInRange(springRecords[s].SuperTriangles2, springRecords[s].SuperTriangles2Count, triangleCount);
+    }
+
+    for (size_t t = 0; t < triangleCount && areIndicesInRange; ++t)
+    {
+        areIndicesInRange =
+            AreIndicesInRange(triangleRecords[t].PointIndices1, 3, pointCount)
+            && triangleRecords[t].SubSprings2Count <= 4
+            && AreIndicesInRange(triangleRecords[t].SubSprings2, triangleRecords[t].SubSprings2Count, springCount);
+    }
+
+    for (size_t p = 0; p < pointCount && areIndicesInRange; ++p)
+    {
+        areIndicesInRange =
+            pointMaterials[p].StructuralMaterialOrdinal < structuralMaterials.size()
+            && (pointMaterials[p].ElectricalMaterialOrdinal == NoneMaterialOrdinal
+                || pointMaterials[p].ElectricalMaterialOrdinal < electricalMaterials.size());
+    }
+
+    if (!areIndicesInRange)
+    {
+        discardFile("corrupted");
+        return nullptr;
+    }
+
+    auto shipLayout = std::make_shared<ShipBuilder::ShipLayout>();
+
+    //
+    // Points
+    //
+
+    shipLayout->PointInfos.reserve(pointCount);
+
+    for (size_t p = 0; p < pointCount; ++p)
+    {
+        auto & pointInfo = shipLayout->PointInfos.emplace_back(
+            positions[p],
+            textureCoordinates[p],
+            renderColors[p],
+            *(structuralMaterials[pointMaterials[p].StructuralMaterialOrdinal]),
+            0 != (pointFlags[p] & IsRopeFlag));
+
+        pointInfo.IsLeaking = (0 != (pointFlags[p] & IsLeakingFlag));
+
+        if (pointMaterials[p].ElectricalMaterialOrdinal != NoneMaterialOrdinal)
+            pointInfo.ElectricalMtl = electricalMaterials[pointMaterials[p].ElectricalMaterialOrdinal];
+    }
+
+    //
+    // Springs
+    //
+
+    shipLayout->SpringInfos.reserve(springCount);
+
+    for (size_t s = 0; s < springCount; ++s)
+    {
+        auto & springInfo = shipLayout->SpringInfos.emplace_back(
+            springRecords[s].PointAIndex1,
+            springRecords[s].PointBIndex1);
+
+        for (uint32_t t = 0; t < springRecords[s].SuperTriangles2Count; ++t)
+            springInfo.SuperTriangles2.push_back(springRecords[s].SuperTriangles2[t]);
+    }
+
+    //
+    // Triangles
+    //
+
+    shipLayout->TriangleInfos.reserve(triangleCount);
+
+    for (size_t t = 0; t < triangleCount; ++t)
+    {
+        auto & triangleInfo = shipLayout->TriangleInfos.emplace_back(
+            std::array<ElementIndex, 3>{
+                triangleRecords[t].PointIndices1[0],
+                triangleRecords[t].PointIndices1[1],
+                triangleRecords[t].PointIndices1[2] });
+
+        for (uint32_t s = 0; s < triangleRecords[t].SubSprings2Count; ++s)
+            triangleInfo.SubSprings2.push_back(triangleRecords[t].SubSprings2[s]);
+    }
+
+    //
+    // Batching and remap
+    //
+
+    shipLayout->BatchedSpringCount = static_cast<size_t>(fileContent.GetBatchedSpringCount());
+
+    shipLayout->PointIndexRemap = std::move(pointIndexRemap);
+
+    // Mark the file as recently used, so that it's among the last ones to be evicted
+    std::filesystem::last_write_time(filePath, std::filesystem::file_time_type::clock::now(), errorCode);
+
+    return shipLayout;
+}
+
+void ShipBuildCache::StoreFile(
+    uint64_t key,
+    ShipBuilder::ShipLayout const & shipLayout,
+    MaterialDatabase const & materialDatabase) const
+{
+    //
+    // Materials are stored by their color keys, in tables indexed by the points
+    //
+
+    std::vector<ColorKeyRecord> structuralMaterialColorKeys;
+    std::unordered_map<StructuralMaterial const *, uint16_t> structuralMaterialOrdinals;
+    for (auto const & entry : materialDatabase.GetStructuralMaterials())
+    {
+        structuralMaterialOrdinals[&(entry.second)] = static_cast<uint16_t>(structuralMaterialColorKeys.size());
+        structuralMaterialColorKeys.push_back(ColorKeyRecord{ entry.first.r, entry.first.g, entry.first.b, 0 });
+    }
+
+    std::vector<ColorKeyRecord> electricalMaterialColorKeys;
+    std::unordered_map<ElectricalMaterial const *, uint16_t> electricalMaterialOrdinals;
+    for (auto const & entry : materialDatabase.GetElectricalMaterials())
+    {
+        electricalMaterialOrdinals[&(entry.second)] = static_cast<uint16_t>(electricalMaterialColorKeys.size());
+        electricalMaterialColorKeys.push_back(ColorKeyRecord{ entry.first.r, entry.first.g, entry.first.b, 0 });
+    }
+
+    assert(structuralMaterialColorKeys.size() < NoneMaterialOrdinal);
+    assert(electricalMaterialColorKeys.size() < NoneMaterialOrdinal);
+
+    //
+    // Points
+    //
+
+    size_t const pointCount = shipLayout.PointInfos.size();
+
+    std::vector<vec2f> positions;
+    positions.reserve(pointCount);
+    std::vector<vec2f> textureCoordinates;
+    textureCoordinates.reserve(pointCount);
+    std::vector<vec4f> renderColors;
+    renderColors.reserve(pointCount);
+    std::vector<PointMaterialsRecord> pointMaterials;
+    pointMaterials.reserve(pointCount);
+    std::vector<uint8_t> pointFlags;
+    pointFlags.reserve(pointCount);
+
+    for (auto const & pointInfo : shipLayout.PointInfos)
+    {
+        positions.push_back(pointInfo.Position);
+        textureCoordinates.push_back(pointInfo.TextureCoordinates);
+        renderColors.push_back(pointInfo.RenderColor);
+
+        assert(structuralMaterialOrdinals.count(&(pointInfo.StructuralMtl)) == 1);
+        assert(nullptr == pointInfo.ElectricalMtl || electricalMaterialOrdinals.count(pointInfo.ElectricalMtl) == 1);
+
+        pointMaterials.push_back(
+            PointMaterialsRecord{
+                structuralMaterialOrdinals[&(pointInfo.StructuralMtl)],
+                nullptr != pointInfo.ElectricalMtl ? electricalMaterialOrdinals[pointInfo.ElectricalMtl] : NoneMaterialOrdinal });
+
+        pointFlags.push_back(
+            (pointInfo.IsRope ? IsRopeFlag : 0)
+            | (pointInfo.IsLeaking ? IsLeakingFlag : 0));
+    }
+
+    //
+    // Springs
+    //
+
+    std::vector<SpringRecord> springRecords;
+    springRecords.reserve(shipLayout.SpringInfos.size());
+
+    for (auto const & springInfo : shipLayout.SpringInfos)
+    {
+        SpringRecord springRecord{
+            springInfo.PointAIndex1,
+            springInfo.PointBIndex1,
+            static_cast<uint32_t>(springInfo.SuperTriangles2.size()),
+            { NoneElementIndex, NoneElementIndex } };
+
+        for (size_t t = 0; t < springInfo.SuperTriangles2.size(); ++t)
+            springRecord.SuperTriangles2[t] = springInfo.SuperTriangles2[t];
+
+        springRecords.push_back(springRecord);
+    }
+
+    //
+    // Triangles
+    //
+
+    std::vector<TriangleRecord> triangleRecords;
+    triangleRecords.reserve(shipLayout.TriangleInfos.size());
+
+    for (auto const & triangleInfo : shipLayout.TriangleInfos)
+    {
+        TriangleRecord triangleRecord{
+            { triangleInfo.PointIndices1[0], triangleInfo.PointIndices1[1], triangleInfo.PointIndices1[2] },
+            static_cast<uint32_t>(triangleInfo.SubSprings2.size()),
+            { NoneElementIndex, NoneElementIndex, NoneElementIndex, NoneElementIndex } };
+
+        for (size_t s = 0; s < triangleInfo.SubSprings2.size(); ++s)
+            triangleRecord.SubSprings2[s] = triangleInfo.SubSprings2[s];
+
+        triangleRecords.push_back(triangleRecord);
+    }
+
+    //
+    // Serialize
+    //
+
+    auto const content = MakeFileContent(
+        key,
+        static_cast<uint64_t>(shipLayout.BatchedSpringCount),
+        {
+            MakeSectionSource(SectionType::StructuralMaterialColorKeys, structuralMaterialColorKeys),
+            MakeSectionSource(SectionType::ElectricalMaterialColorKeys, electricalMaterialColorKeys),
+            MakeSectionSource(SectionType::PointPositions, positions),
+            MakeSectionSource(SectionType::PointTextureCoordinates, textureCoordinates),
+            MakeSectionSource(SectionType::PointRenderColors, renderColors),
+            MakeSectionSource(SectionType::PointMaterials, pointMaterials),
+            MakeSectionSource(SectionType::PointFlags, pointFlags),
+            MakeSectionSource(SectionType::Springs, springRecords),
+            MakeSectionSource(SectionType::Triangles, triangleRecords),
+            MakeSectionSource(SectionType::PointIndexRemap, shipLayout.PointIndexRemap)
+        });
+
+    //
+    // Save - via a temporary file, so that a half-written file never looks like a good one
+    //
+
+    auto const filePath = GetCacheFilePath(key);
+    auto const temporaryFilePath = std::filesystem::path(filePath).concat(".tmp");
+
+    std::error_code errorCode;
+
+    try
+    {
+        std::filesystem::create_directories(mCacheFolderPath);
+
+        {
+            std::ofstream file(temporaryFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                LogMessage("Cannot create ship build cache file \"", temporaryFilePath.string(), "\"");
+                return;
+            }
+
+            file.write(reinterpret_cast<char const *>(content.data()), static_cast<std::streamsize>(content.size()));
+            file.close();
+            if (!file)
+            {
+                LogMessage("Cannot write ship build cache file \"", temporaryFilePath.string(), "\"");
+                std::filesystem::remove(temporaryFilePath, errorCode);
+                return;
+            }
+        }
+
+        std::filesystem::rename(temporaryFilePath, filePath);
+    }
+    catch (std::filesystem::filesystem_error const & ex)
+    {
+        LogMessage("Cannot store ship build cache file \"", filePath.string(), "\": ", ex.what());
+        return;
+    }
+
+    EvictFiles(filePath);
+}
+
+void ShipBuildCache::EvictFiles(std::filesystem::path const & keptFilePath) const
+{
+    struct CacheFile
+    {
+        std::filesystem::path Path;
+        std::uintmax_t Size;
+        std::filesystem::file_time_type LastWriteTime;
+    };
+
+    std::vector<CacheFile> cacheFiles;
+    std::uintmax_t totalFileSize = 0;
+
+    std::error_code errorCode;
+
+    try
+    {
+        for (auto const & entry : std::filesystem::directory_iterator(mCacheFolderPath))
+        {
+            if (!entry.is_regular_file(errorCode)
+                || entry.path().extension() != ".shipcache")
+            {
+                continue;
+            }
+
+            if (!IsCurrentFormatFile(entry.path()))
+            {
+                // Left by a different version of the game, hence we'd never use it
+                LogMessage("Deleting obsolete ship build cache file \"", entry.path().string(), "\"");
+                std::filesystem::remove(entry.path(), errorCode);
+                continue;
+            }
+
+            auto const fileSize = entry.file_size(errorCode);
+            if (!!errorCode)
+                continue;
+
+            auto const lastWriteTime = entry.last_write_time(errorCode);
+            if (!!errorCode)
+                continue;
+
+            cacheFiles.push_back(CacheFile{ entry.path(), fileSize, lastWriteTime });
+            totalFileSize += fileSize;
+        }
+    }
+    catch (std::filesystem::filesystem_error const & ex)
+    {
+        LogMessage("Cannot visit ship build cache folder \"", mCacheFolderPath.string(), "\": ", ex.what());
+        return;
+    }
+
+    //
+    // Delete the least recently used files until we fit, but never the one we've just stored
+    //
+
+    std::sort(
+        cacheFiles.begin(),
+        cacheFiles.end(),
+        [](CacheFile const & a, CacheFile const & b)
+        {
+            return a.LastWriteTime < b.LastWriteTime;
+        });
+
+    for (auto const & cacheFile : cacheFiles)
+    {
+        if (totalFileSize <= mMaxTotalFileSize)
+            break;
+
+        if (cacheFile.Path == keptFilePath)
+            continue;
+
+        if (std::filesystem::remove(cacheFile.Path, errorCode))
+        {
+            LogMessage("Evicted ship build cache file \"", cacheFile.Path.string(), "\"");
+            totalFileSize -= cacheFile.Size;
+        }
+    }
+}
+
+void ShipBuildCache::RememberLastLayout(
+    uint64_t key,
+    std::shared_ptr<ShipBuilder::ShipLayout const> shipLayout,
+    MaterialDatabase const & materialDatabase) const
+{
+    std::lock_guard<std::mutex> const lock(mLastLayoutMutex);
+
+    mLastLayoutKey = key;
+    mLastLayoutMaterialDatabase = &materialDatabase;
+    mLastLayout = std::move(shipLayout);
+}
+
+std::filesystem::path ShipBuildCache::GetCacheFilePath(uint64_t key) const
+{
+    std::ostringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << key << ".shipcache";
+
+    return mCacheFolderPath / ss.str();
+}
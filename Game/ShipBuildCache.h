@@ -0,0 +1,106 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-04-04
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "MaterialDatabase.h"
+#include "ShipBuilder.h"
+#include "ShipDefinition.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+
+/*
+ * A folder of binary files, each containing the layout of a ship's elements as
+ * calculated by the ship builder.
+ *
+ * Layouts are keyed by a hash of everything they depend on - the ship's layers, the
+ * material definitions, and the version of the builder - hence a layout is never
+ * used for a ship or for materials that have changed since it was stored.
+ *
+ * Files are made of sections, each being a flat array of fixed-size records - one
+ * section per attribute - so that a file is loaded with one read, and each section
+ * is then copied out with one copy before being turned into the layout's elements.
+ *
+ * The most recent layout is also kept in memory and shared - read-only - among all
+ * subsequent loads of the same ship, which then need no file at all.
+ *
+ * The cache is best-effort: files that cannot be read are treated as missing, and
+ * files that cannot be written are just not written.
+ *
+ * The folder is kept within a maximum size: whenever a file is stored, files of other
+ * formats are deleted, and then the least recently used files are deleted until the
+ * total size of the remaining ones fits. Files that cannot be used are deleted when
+ * they are found.
+ */
+class ShipBuildCache
+{
+public:
+
+    static constexpr std::uintmax_t DefaultMaxTotalFileSize = 128 * 1024 * 1024;
+
+    explicit ShipBuildCache(
+        std::filesystem::path const & cacheFolderPath,
+        std::uintmax_t maxTotalFileSize = DefaultMaxTotalFileSize)
+        : mCacheFolderPath(cacheFolderPath)
+        , mMaxTotalFileSize(maxTotalFileSize)
+        , mLastLayoutMutex()
+        , mLastLayoutKey(0)
+        , mLastLayoutMaterialDatabase(nullptr)
+        , mLastLayout()
+    {}
+
+    static uint64_t CalculateKey(
+        ShipDefinition const & shipDefinition,
+        MaterialDatabase const & materialDatabase);
+
+    /*
+     * Returns nullptr when the layout is not in the cache.
+     */
+    std::shared_ptr<ShipBuilder::ShipLayout const> TryLoad(
+        uint64_t key,
+        MaterialDatabase const & materialDatabase) const;
+
+    void Store(
+        uint64_t key,
+        std::shared_ptr<ShipBuilder::ShipLayout const> shipLayout,
+        MaterialDatabase const & materialDatabase) const;
+
+private:
+
+    friend class ShipBuildCacheTests;
+
+    std::shared_ptr<ShipBuilder::ShipLayout const> TryLoadFile(
+        uint64_t key,
+        MaterialDatabase const & materialDatabase) const;
+
+    void StoreFile(
+        uint64_t key,
+        ShipBuilder::ShipLayout const & shipLayout,
+        MaterialDatabase const & materialDatabase) const;
+
+    void EvictFiles(std::filesystem::path const & keptFilePath) const;
+
+    void RememberLastLayout(
+        uint64_t key,
+        std::shared_ptr<ShipBuilder::ShipLayout const> shipLayout,
+        MaterialDatabase const & materialDatabase) const;
+
+    std::filesystem::path GetCacheFilePath(uint64_t key) const;
+
+private:
+
+    std::filesystem::path const mCacheFolderPath;
+    std::uintmax_t const mMaxTotalFileSize;
+
+    // The most recent layout; layouts refer to the materials of the
+    // database they have been made with, hence we remember that too
+    mutable std::mutex mLastLayoutMutex;
+    mutable uint64_t mLastLayoutKey;
+    mutable MaterialDatabase const * mLastLayoutMaterialDatabase;
+    mutable std::shared_ptr<ShipBuilder::ShipLayout const> mLastLayout;
+};
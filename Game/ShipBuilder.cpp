@@ -7,9 +7,12 @@
 ***************************************************************************************/
 #include "ShipBuilder.h"
 
+#include "ShipBuildCache.h"
+
 #include <GameCore/Log.h>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <limits>
 #include <unordered_map>
@@ -26,23 +29,64 @@ std::unique_ptr<Ship> ShipBuilder::Create(
     std::shared_ptr<IGameEventHandler> gameEventHandler,
     ShipDefinition const & shipDefinition,
     MaterialDatabase const & materialDatabase,
-    GameParameters const & gameParameters)
+    GameParameters const & gameParameters,
+    ShipBuildCache const * shipBuildCache,
+    std::shared_ptr<ShipPristineState const> * pristineState)
 {
+    //
+    // Check whether we have the layout already
+    //
+
+    uint64_t shipBuildCacheKey = 0;
+
+    if (nullptr != shipBuildCache)
+    {
+        shipBuildCacheKey = ShipBuildCache::CalculateKey(shipDefinition, materialDatabase);
+
+        std::shared_ptr<ShipLayout const> cachedShipLayout = shipBuildCache->TryLoad(
+            shipBuildCacheKey,
+            materialDatabase);
+
+        if (!!cachedShipLayout)
+        {
+            LogMessage("Using ship layout from build cache");
+
+            Points points = CreatePoints(
+                cachedShipLayout->PointInfos,
+                parentWorld,
+                gameEventHandler,
+                gameParameters);
+
+            return CreateShip(
+                shipId,
+                parentWorld,
+                gameEventHandler,
+                shipDefinition,
+                materialDatabase,
+                gameParameters,
+                *cachedShipLayout,
+                std::move(points),
+                pristineState);
+        }
+    }
+
     int const structureWidth = shipDefinition.StructuralLayerImage.Size.Width;
     float const halfWidth = static_cast<float>(structureWidth) / 2.0f;
     int const structureHeight = shipDefinition.StructuralLayerImage.Size.Height;
 
+    auto shipLayout = std::make_shared<ShipLayout>();
+
     // PointInfo's
-    std::vector<PointInfo> pointInfos;
+    std::vector<PointInfo> & pointInfos = shipLayout->PointInfos;
 
     // SpringInfo's
-    std::vector<SpringInfo> springInfos;
+    std::vector<SpringInfo> & springInfos = shipLayout->SpringInfos;
 
     // RopeSegment's, indexed by the rope color key
     std::map<MaterialDatabase::ColorKey, RopeSegment> ropeSegments;
 
     // TriangleInfo's
-    std::vector<TriangleInfo> triangleInfos;
+    std::vector<TriangleInfo> & triangleInfos = shipLayout->TriangleInfos;
 
 
     //
@@ -218,6 +262,21 @@ std::unique_ptr<Ship> ShipBuilder::Create(
     LogMessage("Spring ACMR: original=", originalSpringACMR, ", optimized=", optimizedSpringACMR);
 
 
+    //
+    // Arrange springs in batches that may be processed together by vectorized code
+    //
+
+    size_t & batchedSpringCount = shipLayout->BatchedSpringCount;
+
+    springInfos = ReorderSpringsOptimally_SimdBatching<Springs::SimdBatchSize>(
+        springInfos,
+        pointInfos.size(),
+        batchedSpringCount);
+
+    LogMessage("Spring batching: ", batchedSpringCount, " batched springs out of ", springInfos.size(),
+        "; ACMR=", CalculateACMR(springInfos));
+
+
     // Note: we don't optimize triangles, as tests indicate that performance gets (marginally) worse,
     // and at the same time, it makes sense to use the natural order of the triangles as it ensures
     // that higher elements in the ship cover lower elements when they are semi-detached
@@ -227,7 +286,7 @@ std::unique_ptr<Ship> ShipBuilder::Create(
     // Now reorder points to improve data locality when visiting springs
     //
 
-    std::vector<ElementIndex> pointIndexRemap;
+    std::vector<ElementIndex> & pointIndexRemap = shipLayout->PointIndexRemap;
 
     pointInfos = ReorderPointsOptimally_FollowingSprings(
         pointInfos,
@@ -266,14 +325,55 @@ std::unique_ptr<Ship> ShipBuilder::Create(
         triangleInfos);
 
 
+    //
+    // Store the layout for the next time
+    //
+
+    if (nullptr != shipBuildCache)
+    {
+        shipBuildCache->Store(
+            shipBuildCacheKey,
+            shipLayout,
+            materialDatabase);
+    }
+
+
+    //
+    // Create the ship's elements out of the layout
+    //
+
+    return CreateShip(
+        shipId,
+        parentWorld,
+        gameEventHandler,
+        shipDefinition,
+        materialDatabase,
+        gameParameters,
+        *shipLayout,
+        std::move(points),
+        pristineState);
+}
+
+std::unique_ptr<Ship> ShipBuilder::CreateShip(
+    ShipId shipId,
+    World & parentWorld,
+    std::shared_ptr<IGameEventHandler> gameEventHandler,
+    ShipDefinition const & shipDefinition,
+    MaterialDatabase const & materialDatabase,
+    GameParameters const & gameParameters,
+    ShipLayout const & shipLayout,
+    Physics::Points && points,
+    std::shared_ptr<ShipPristineState const> * pristineState)
+{
     //
     // Create Springs for all SpringInfo's
     //
 
     Springs springs = CreateSprings(
-        springInfos,
+        shipLayout.SpringInfos,
+        shipLayout.BatchedSpringCount,
         points,
-        pointIndexRemap,
+        shipLayout.PointIndexRemap,
         parentWorld,
         gameEventHandler,
         gameParameters);
@@ -284,9 +384,9 @@ std::unique_ptr<Ship> ShipBuilder::Create(
     //
 
     Triangles triangles = CreateTriangles(
-        triangleInfos,
+        shipLayout.TriangleInfos,
         points,
-        pointIndexRemap);
+        shipLayout.PointIndexRemap);
 
 
     //
@@ -307,6 +407,26 @@ std::unique_ptr<Ship> ShipBuilder::Create(
         points.GetElementCount(), " points, ", springs.GetElementCount(), " springs, ", triangles.GetElementCount(), " triangles, ",
         electricalElements.GetElementCount(), " electrical elements.");
 
+    if (nullptr != pristineState)
+    {
+        // Keep the elements as they are now, and make the ship out of copies of them
+        auto newPristineState = std::make_shared<ShipPristineState>(
+            std::move(points),
+            std::move(springs),
+            std::move(triangles),
+            std::move(electricalElements));
+
+        auto ship = newPristineState->MakeShip(
+            shipId,
+            parentWorld,
+            gameEventHandler,
+            materialDatabase);
+
+        *pristineState = std::move(newPristineState);
+
+        return ship;
+    }
+
     return std::make_unique<Ship>(
         shipId,
         parentWorld,
@@ -818,6 +938,109 @@ std::vector<ShipBuilder::SpringInfo> ShipBuilder::ReorderSpringsOptimally_Tiling
     return springInfos2;
 }
 
+template <size_t BatchSize>
+std::vector<ShipBuilder::SpringInfo> ShipBuilder::ReorderSpringsOptimally_SimdBatching(
+    std::vector<SpringInfo> const & springInfos1,
+    size_t pointCount,
+    size_t & batchedSpringCount)
+{
+    //
+    // Greedily build batches of BatchSize springs such that no two springs in a batch
+    // share an endpoint, picking springs as close as possible to the head of the current
+    // order so to preserve the locality established by the previous reorderings.
+    //
+    // We first look for candidates in a small window; only if that fails we extend the
+    // search to all the remaining springs. When not even that works - which may only
+    // happen towards the very end - we stop batching and append all remaining springs
+    // in their original order; those will be processed by scalar code.
+    //
+
+    static constexpr size_t LookAheadWindowSize = 64;
+
+    std::vector<SpringInfo> springInfos2;
+    springInfos2.reserve(springInfos1.size());
+
+    std::vector<bool> addedSprings;
+    addedSprings.resize(springInfos1.size(), false);
+
+    // The batch each point has last been used in
+    static constexpr size_t NoneBatch = std::numeric_limits<size_t>::max();
+    std::vector<size_t> pointBatches;
+    pointBatches.resize(pointCount, NoneBatch);
+
+    size_t firstPendingSpring = 0;
+    for (size_t currentBatch = 0; ; ++currentBatch)
+    {
+        // Skip springs already taken
+        while (firstPendingSpring < springInfos1.size() && addedSprings[firstPendingSpring])
+            ++firstPendingSpring;
+
+        if (firstPendingSpring == springInfos1.size())
+            break;
+
+        std::array<size_t, BatchSize> batch;
+        size_t batchSize = 0;
+
+        auto const fillBatch = [&](size_t searchEnd)
+        {
+            for (size_t s = firstPendingSpring; s < searchEnd && batchSize < BatchSize; ++s)
+            {
+                if (!addedSprings[s]
+                    && pointBatches[springInfos1[s].PointAIndex1] != currentBatch
+                    && pointBatches[springInfos1[s].PointBIndex1] != currentBatch)
+                {
+                    batch[batchSize++] = s;
+                    pointBatches[springInfos1[s].PointAIndex1] = currentBatch;
+                    pointBatches[springInfos1[s].PointBIndex1] = currentBatch;
+                }
+            }
+        };
+
+        fillBatch(std::min(firstPendingSpring + LookAheadWindowSize, springInfos1.size()));
+
+        if (batchSize < BatchSize)
+        {
+            // Try harder
+            fillBatch(springInfos1.size());
+
+            if (batchSize < BatchSize)
+            {
+                // Give up
+                break;
+            }
+        }
+
+        for (size_t s : batch)
+        {
+            springInfos2.push_back(springInfos1[s]);
+            addedSprings[s] = true;
+        }
+    }
+
+    batchedSpringCount = springInfos2.size();
+
+    assert(0 == (batchedSpringCount % BatchSize));
+
+    //
+    // Append all remaining springs
+    //
+
+    for (size_t s = firstPendingSpring; s < springInfos1.size(); ++s)
+    {
+        if (!addedSprings[s])
+            springInfos2.push_back(springInfos1[s]);
+    }
+
+    assert(springInfos2.size() == springInfos1.size());
+
+    return springInfos2;
+}
+
+template std::vector<ShipBuilder::SpringInfo> ShipBuilder::ReorderSpringsOptimally_SimdBatching<Springs::SimdBatchSize>(
+    std::vector<SpringInfo> const & springInfos1,
+    size_t pointCount,
+    size_t & batchedSpringCount);
+
 std::vector<ShipBuilder::PointInfo> ShipBuilder::ReorderPointsOptimally_FollowingSprings(
     std::vector<ShipBuilder::PointInfo> const & pointInfos1,
     std::vector<ShipBuilder::SpringInfo> const & springInfos2,
@@ -1139,6 +1362,7 @@ void ShipBuilder::ConnectSpringsAndTriangles(
 
 Physics::Springs ShipBuilder::CreateSprings(
     std::vector<SpringInfo> const & springInfos2,
+    size_t batchedSpringCount,
     Physics::Points & points,
     std::vector<ElementIndex> const & pointIndexRemap,
     World & parentWorld,
@@ -1147,6 +1371,7 @@ Physics::Springs ShipBuilder::CreateSprings(
 {
     Physics::Springs springs(
         static_cast<ElementIndex>(springInfos2.size()),
+        static_cast<ElementIndex>(batchedSpringCount),
         parentWorld,
         std::move(gameEventHandler),
         gameParameters);
@@ -1188,6 +1413,9 @@ Physics::Springs ShipBuilder::CreateSprings(
             false); // Not owner
     }
 
+    // Now that all springs are connected, lay them out contiguously
+    points.CompactConnectedSprings();
+
     return springs;
 }
 
@@ -1259,7 +1487,7 @@ ElectricalElements ShipBuilder::CreateElectricalElements(
     {
         auto pointIndex = electricalElements.GetPointIndex(electricalElementIndex);
 
-        for (auto const & cs : points.GetConnectedSprings(pointIndex).ConnectedSprings)
+        for (auto const & cs : points.GetConnectedSprings(pointIndex))
         {
             auto otherEndpointElectricalElementIndex = points.GetElectricalElement(cs.OtherEndpointIndex);
             if (NoneElementIndex != otherEndpointElectricalElementIndex)
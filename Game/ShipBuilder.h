@@ -21,6 +21,8 @@
 #include <set>
 #include <vector>
 
+class ShipBuildCache;
+
 /*
  * This class contains all the logic for building a ship out of a ShipDefinition.
  */
@@ -28,16 +30,33 @@ class ShipBuilder
 {
 public:
 
+    /*
+     * When a build cache is specified, the layout of the ship's elements is taken from
+     * the cache if it's there, and stored in the cache otherwise.
+     *
+     * When a pristine state is specified, it receives a copy of the ship's elements as
+     * they are before the ship starts living.
+     */
     static std::unique_ptr<Physics::Ship> Create(
         ShipId shipId,
         Physics::World & parentWorld,
         std::shared_ptr<IGameEventHandler> gameEventHandler,
         ShipDefinition const & shipDefinition,
         MaterialDatabase const & materialDatabase,
-        GameParameters const & gameParameters);
+        GameParameters const & gameParameters,
+        ShipBuildCache const * shipBuildCache = nullptr,
+        std::shared_ptr<Physics::ShipPristineState const> * pristineState = nullptr);
 
 private:
 
+    friend class ShipBuildCache;
+    friend class ShipBuildCacheTests;
+
+    friend class ShipBuilderTests_SimdBatching_Grid_Test;
+    friend class ShipBuilderTests_SimdBatching_Chain_Test;
+    friend class ShipBuilderTests_SimdBatching_Star_Test;
+    friend class ShipBuilderTests_SimdBatching_Random_Test;
+
     struct PointInfo
     {
         vec2f Position;
@@ -152,6 +171,29 @@ private:
         }
     };
 
+    /*
+     * The outcome of the expensive part of a build - i.e. of everything that only depends
+     * on the ship definition and on the materials - from which the ship's elements are
+     * then created.
+     */
+    struct ShipLayout
+    {
+        std::vector<PointInfo> PointInfos;
+        std::vector<SpringInfo> SpringInfos;
+        std::vector<TriangleInfo> TriangleInfos;
+        size_t BatchedSpringCount;
+        std::vector<ElementIndex> PointIndexRemap;
+
+        ShipLayout()
+            : PointInfos()
+            , SpringInfos()
+            , TriangleInfos()
+            , BatchedSpringCount(0)
+            , PointIndexRemap()
+        {
+        }
+    };
+
 private:
 
     /////////////////////////////////////////////////////////////////
@@ -164,7 +206,7 @@ private:
         std::vector<ElementIndex> const & pointIndexRemap,
         std::vector<SpringInfo> const & springInfos)
     {
-        for (auto cs : points.GetConnectedSprings(pointIndex).ConnectedSprings)
+        for (auto cs : points.GetConnectedSprings(pointIndex))
         {
             if (!points.IsRope(pointIndexRemap[springInfos[cs.SpringIndex].PointAIndex1])
                 || !points.IsRope(pointIndexRemap[springInfos[cs.SpringIndex].PointBIndex1]))
@@ -227,6 +269,12 @@ private:
         ImageSize const & structureImageSize,
         std::vector<PointInfo> const & pointInfos1);
 
+    template <size_t BatchSize>
+    static std::vector<SpringInfo> ReorderSpringsOptimally_SimdBatching(
+        std::vector<SpringInfo> const & springInfos1,
+        size_t pointCount,
+        size_t & batchedSpringCount);
+
     static std::vector<PointInfo> ReorderPointsOptimally_FollowingSprings(
         std::vector<PointInfo> const & pointInfos1,
         std::vector<SpringInfo> const & springInfos2,
@@ -236,6 +284,17 @@ private:
         std::vector<PointInfo> const & pointInfos1,
         std::vector<ElementIndex> & pointIndexRemap);
 
+    static std::unique_ptr<Physics::Ship> CreateShip(
+        ShipId shipId,
+        Physics::World & parentWorld,
+        std::shared_ptr<IGameEventHandler> gameEventHandler,
+        ShipDefinition const & shipDefinition,
+        MaterialDatabase const & materialDatabase,
+        GameParameters const & gameParameters,
+        ShipLayout const & shipLayout,
+        Physics::Points && points,
+        std::shared_ptr<Physics::ShipPristineState const> * pristineState);
+
     static Physics::Points CreatePoints(
         std::vector<PointInfo> const & pointInfos2,
         Physics::World & parentWorld,
@@ -254,6 +313,7 @@ private:
 
     static Physics::Springs CreateSprings(
         std::vector<SpringInfo> const & springInfos2,
+        size_t batchedSpringCount,
         Physics::Points & points,
         std::vector<ElementIndex> const & pointIndexRemap,
         Physics::World & parentWorld,
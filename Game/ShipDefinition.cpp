@@ -8,6 +8,7 @@
 #include "ImageFileTools.h"
 #include "ShipDefinitionFile.h"
 
+#include <algorithm>
 #include <cassert>
 
 ShipDefinition ShipDefinition::Load(std::filesystem::path const & filepath)
@@ -138,4 +139,36 @@ ShipDefinition ShipDefinition::Load(std::filesystem::path const & filepath)
         std::move(*textureImage),
         textureOrigin,
         *shipMetadata);
-}
\ No newline at end of file
+}
+
+std::filesystem::file_time_type ShipDefinition::GetLastWriteTime(std::filesystem::path const & filepath)
+{
+    std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time(filepath);
+
+    if (ShipDefinitionFile::IsShipDefinitionFile(filepath))
+    {
+        ShipDefinitionFile sdf = ShipDefinitionFile::Create(filepath);
+
+        std::filesystem::path basePath = filepath.parent_path();
+
+        auto const visitLayerImageFile = [&](std::filesystem::path const & layerImageFilePath)
+        {
+            lastWriteTime = std::max(
+                lastWriteTime,
+                std::filesystem::last_write_time(basePath / layerImageFilePath));
+        };
+
+        visitLayerImageFile(sdf.StructuralLayerImageFilePath);
+
+        if (!!sdf.RopesLayerImageFilePath)
+            visitLayerImageFile(*sdf.RopesLayerImageFilePath);
+
+        if (!!sdf.ElectricalLayerImageFilePath)
+            visitLayerImageFile(*sdf.ElectricalLayerImageFilePath);
+
+        if (!!sdf.TextureLayerImageFilePath)
+            visitLayerImageFile(*sdf.TextureLayerImageFilePath);
+    }
+
+    return lastWriteTime;
+}
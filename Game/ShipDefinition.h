@@ -45,6 +45,11 @@ public:
 
     static ShipDefinition Load(std::filesystem::path const & filepath);
 
+    /*
+     * Returns the latest modification time among the files that make up the ship definition.
+     */
+    static std::filesystem::file_time_type GetLastWriteTime(std::filesystem::path const & filepath);
+
 private:
 
     ShipDefinition(
@@ -0,0 +1,27 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-04-05
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "Physics.h"
+
+namespace Physics {
+
+std::unique_ptr<Ship> ShipPristineState::MakeShip(
+    ShipId shipId,
+    World & parentWorld,
+    std::shared_ptr<IGameEventHandler> gameEventHandler,
+    MaterialDatabase const & materialDatabase) const
+{
+    return std::make_unique<Ship>(
+        shipId,
+        parentWorld,
+        gameEventHandler,
+        materialDatabase,
+        Points(mPoints, parentWorld, gameEventHandler),
+        Springs(mSprings, parentWorld, gameEventHandler),
+        Triangles(mTriangles),
+        ElectricalElements(mElectricalElements, parentWorld, gameEventHandler));
+}
+
+}
@@ -0,0 +1,57 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-04-05
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "IGameEventHandler.h"
+#include "MaterialDatabase.h"
+#include "Physics.h"
+
+#include <GameCore/GameTypes.h>
+
+#include <memory>
+
+namespace Physics
+{
+
+/*
+ * The elements of a ship as they are right after the ship has been built, from which
+ * the ship may be re-created - by bulk-copying the elements' buffers - without building
+ * it again.
+ *
+ * The elements are immutable: they are never simulated, hence they never use the world
+ * they have been created for, which might even be gone.
+ */
+class ShipPristineState
+{
+public:
+
+    ShipPristineState(
+        Points && points,
+        Springs && springs,
+        Triangles && triangles,
+        ElectricalElements && electricalElements)
+        : mPoints(std::move(points))
+        , mSprings(std::move(springs))
+        , mTriangles(std::move(triangles))
+        , mElectricalElements(std::move(electricalElements))
+    {
+    }
+
+    std::unique_ptr<Ship> MakeShip(
+        ShipId shipId,
+        World & parentWorld,
+        std::shared_ptr<IGameEventHandler> gameEventHandler,
+        MaterialDatabase const & materialDatabase) const;
+
+private:
+
+    Points const mPoints;
+    Springs const mSprings;
+    Triangles const mTriangles;
+    ElectricalElements const mElectricalElements;
+};
+
+}
@@ -10,6 +10,7 @@
 #include <GameCore/GameException.h>
 #include <GameCore/GameMath.h>
 #include <GameCore/Log.h>
+#include <GameCore/Profiler.h>
 
 namespace Render {
 
@@ -640,7 +641,7 @@ void ShipRenderContext::RenderStart(PlaneId maxMaxPlaneId)
 
 
     //
-    // Check if the max ever plane ID has changed
+    // Check if the max plane ID has changed
     //
 
     if (maxMaxPlaneId != mMaxMaxPlaneId)
@@ -952,6 +953,8 @@ void ShipRenderContext::UploadVectors(
 
 void ShipRenderContext::RenderEnd()
 {
+    PROFILE_PHASE(ShipDraw);
+
     //
     // Draw ship elements
     //
@@ -0,0 +1,91 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2019-03-27
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "Physics.h"
+
+#include <algorithm>
+
+namespace Physics {
+
+SpringBvh::SpringBvh()
+    : mIsValid(false)
+    , mIsInUse(false)
+    , mSpringCount(0)
+    , mFirstLeafNode(0)
+    , mNodes()
+{
+}
+
+void SpringBvh::Refit(
+    Springs const & springs,
+    Points const & points)
+{
+    //
+    // Allocate tree, if this is the first time
+    //
+
+    if (mNodes.empty() && springs.GetElementCount() > 0)
+    {
+        mSpringCount = springs.GetElementCount();
+
+        size_t const leafCount = (mSpringCount + SpringsPerLeaf - 1) / SpringsPerLeaf;
+
+        mFirstLeafNode = 1;
+        while (mFirstLeafNode < leafCount)
+            mFirstLeafNode *= 2;
+
+        mNodes.assign(2 * mFirstLeafNode, MakeEmptyBox());
+    }
+
+    assert(springs.GetElementCount() == mSpringCount);
+
+    if (!mNodes.empty())
+    {
+        //
+        // Refit leaves
+        //
+
+        for (ElementIndex startSpringIndex = 0; startSpringIndex < mSpringCount; startSpringIndex += SpringsPerLeaf)
+        {
+            ElementIndex const endSpringIndex = std::min(startSpringIndex + SpringsPerLeaf, mSpringCount);
+
+            Geometry::AABB leafBox = MakeEmptyBox();
+
+            for (ElementIndex s = startSpringIndex; s < endSpringIndex; ++s)
+            {
+                // Deleted springs cannot be sawed anymore
+                if (!springs.IsDeleted(s))
+                {
+                    vec2f const & pointAPosition = springs.GetPointAPosition(s, points);
+                    vec2f const & pointBPosition = springs.GetPointBPosition(s, points);
+
+                    leafBox.ExtendTo(
+                        Geometry::AABB(
+                            std::min(pointAPosition.x, pointBPosition.x),
+                            std::max(pointAPosition.x, pointBPosition.x),
+                            std::max(pointAPosition.y, pointBPosition.y),
+                            std::min(pointAPosition.y, pointBPosition.y)));
+                }
+            }
+
+            mNodes[mFirstLeafNode + startSpringIndex / SpringsPerLeaf] = leafBox;
+        }
+
+        //
+        // Refit inner nodes, bottom-up
+        //
+
+        for (size_t node = mFirstLeafNode - 1; node >= 1; --node)
+        {
+            mNodes[node] = mNodes[2 * node];
+            mNodes[node].ExtendTo(mNodes[2 * node + 1]);
+        }
+    }
+
+    mIsValid = true;
+    mIsInUse = false;
+}
+
+}
@@ -0,0 +1,170 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2019-03-27
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "Physics.h"
+
+#include <GameCore/AABB.h>
+#include <GameCore/GameTypes.h>
+#include <GameCore/Vectors.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace Physics
+{
+
+/*
+ * A bounding volume hierarchy over the springs of a ship, for finding the springs
+ * that might be crossed by a segment without testing all of them.
+ *
+ * The hierarchy is a complete binary tree, stored implicitly in an array, whose leaves
+ * are runs of consecutive springs; it relies on the ship builder laying out springs
+ * so that consecutive springs are close to each other. Since the topology of the tree
+ * never changes, the tree is never rebuilt - it is merely refit to the current positions
+ * of the springs' endpoints, which costs a single pass over the springs.
+ */
+class SpringBvh
+{
+public:
+
+    SpringBvh();
+
+    SpringBvh(SpringBvh && other) = default;
+
+    bool IsValid() const
+    {
+        return mIsValid;
+    }
+
+    void Invalidate()
+    {
+        mIsValid = false;
+    }
+
+    /*
+     * Whether the hierarchy has been queried since the last refit.
+     */
+    bool IsInUse() const
+    {
+        return mIsInUse;
+    }
+
+    void Refit(
+        Springs const & springs,
+        Points const & points);
+
+    /*
+     * Invokes the visitor with the index of each spring, in index order, whose leaf
+     * might intersect the specified segment; the springs are not otherwise tested, and
+     * they might be deleted.
+     */
+    template<typename TVisitor>
+    void VisitSpringsNearSegment(
+        vec2f const & startPos,
+        vec2f const & endPos,
+        TVisitor && visitor) const
+    {
+        assert(mIsValid);
+
+        mIsInUse = true;
+
+        if (mNodes.empty())
+            return;
+
+        // Depth-first, left to right, so that springs are visited in index order
+        size_t nodeStack[MaxDepth + 1];
+        size_t stackSize = 0;
+
+        nodeStack[stackSize++] = 1;
+
+        while (stackSize > 0)
+        {
+            size_t const node = nodeStack[--stackSize];
+
+            if (!MayIntersect(mNodes[node], startPos, endPos))
+                continue;
+
+            if (node >= mFirstLeafNode)
+            {
+                ElementIndex const startSpringIndex = static_cast<ElementIndex>((node - mFirstLeafNode) * SpringsPerLeaf);
+                ElementIndex const endSpringIndex = std::min(startSpringIndex + SpringsPerLeaf, mSpringCount);
+
+                for (ElementIndex s = startSpringIndex; s < endSpringIndex; ++s)
+                {
+                    visitor(s);
+                }
+            }
+            else
+            {
+                assert(stackSize + 2 <= MaxDepth + 1);
+
+                nodeStack[stackSize++] = 2 * node + 1;
+                nodeStack[stackSize++] = 2 * node;
+            }
+        }
+    }
+
+private:
+
+    static constexpr ElementCount SpringsPerLeaf = 16;
+
+    // Depth-first traversal holds at most one node per level, plus one
+    static constexpr size_t MaxDepth = std::numeric_limits<ElementCount>::digits;
+
+    static Geometry::AABB MakeEmptyBox()
+    {
+        return Geometry::AABB(
+            std::numeric_limits<float>::max(),      // Left
+            std::numeric_limits<float>::lowest(),   // Right
+            std::numeric_limits<float>::lowest(),   // Top
+            std::numeric_limits<float>::max());     // Bottom
+    }
+
+    static inline bool MayIntersect(
+        Geometry::AABB const & box,
+        vec2f const & startPos,
+        vec2f const & endPos)
+    {
+        // Boxes must overlap (this also rejects empty boxes)
+        if (std::max(startPos.x, endPos.x) < box.BottomLeft.x
+            || std::min(startPos.x, endPos.x) > box.TopRight.x
+            || std::max(startPos.y, endPos.y) < box.BottomLeft.y
+            || std::min(startPos.y, endPos.y) > box.TopRight.y)
+        {
+            return false;
+        }
+
+        // The segment's line must not leave all of the box's corners on the same side
+        vec2f const segment = endPos - startPos;
+        float const c1 = segment.cross(box.BottomLeft - startPos);
+        float const c2 = segment.cross(box.TopRight - startPos);
+        float const c3 = segment.cross(vec2f(box.BottomLeft.x, box.TopRight.y) - startPos);
+        float const c4 = segment.cross(vec2f(box.TopRight.x, box.BottomLeft.y) - startPos);
+
+        return !((c1 > 0.0f && c2 > 0.0f && c3 > 0.0f && c4 > 0.0f)
+            || (c1 < 0.0f && c2 < 0.0f && c3 < 0.0f && c4 < 0.0f));
+    }
+
+private:
+
+    bool mIsValid;
+    mutable bool mIsInUse;
+
+    ElementCount mSpringCount;
+
+    // Index of the first leaf node; also the number of leaves, including padding
+    size_t mFirstLeafNode;
+
+    // The nodes of the tree: node 1 is the root, and the children of node n are
+    // nodes 2n and 2n+1; node 0 is unused
+    std::vector<Geometry::AABB> mNodes;
+};
+
+}
@@ -5,6 +5,7 @@
  ***************************************************************************************/
 #include "Physics.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace Physics {
@@ -149,38 +150,30 @@ void Springs::UpdateGameParameters(
     }
 }
 
-void Springs::UploadElements(
-    ShipId shipId,
-    Render::RenderContext & renderContext) const
+void Springs::UploadElements(RenderSnapshot & renderSnapshot) const
 {
-    // Either upload all springs, or just the edge springs
-    bool const doUploadAllSprings = (DebugShipRenderMode::Springs == renderContext.GetDebugShipRenderMode());
-
-    // Ropes are uploaded as springs only if DebugRenderMode is springs or edge springs
-    bool const doUploadRopesAsSprings = (
-        DebugShipRenderMode::Springs == renderContext.GetDebugShipRenderMode()
-        || DebugShipRenderMode::EdgeSprings == renderContext.GetDebugShipRenderMode());
-
+    // All springs are published, classified by how they're rendered; the snapshot
+    // then picks the ones to upload based on the current debug render mode
     for (ElementIndex i : *this)
     {
-        // Only upload non-deleted springs that are not covered by two super-triangles, unless
-        // we are in springs render mode
         if (!mIsDeletedBuffer[i])
         {
-            if (IsRope(i) && !doUploadRopesAsSprings)
+            if (IsRope(i))
+            {
+                renderSnapshot.UploadElementRope(
+                    GetPointAIndex(i),
+                    GetPointBIndex(i));
+            }
+            else if (mSuperTrianglesBuffer[i].size() < 2)
             {
-                renderContext.UploadShipElementRope(
-                    shipId,
+                renderSnapshot.UploadElementSpring(
                     GetPointAIndex(i),
                     GetPointBIndex(i));
             }
-            else if (
-                mSuperTrianglesBuffer[i].size() < 2
-                || doUploadAllSprings
-                || IsRope(i))
+            else
             {
-                renderContext.UploadShipElementSpring(
-                    shipId,
+                // Covered by two super-triangles
+                renderSnapshot.UploadElementInnerSpring(
                     GetPointAIndex(i),
                     GetPointBIndex(i));
             }
@@ -188,9 +181,7 @@ void Springs::UploadElements(
     }
 }
 
-void Springs::UploadStressedSpringElements(
-    ShipId shipId,
-    Render::RenderContext & renderContext) const
+void Springs::UploadStressedSpringElements(RenderSnapshot & renderSnapshot) const
 {
     for (ElementIndex i : *this)
     {
@@ -198,8 +189,7 @@ void Springs::UploadStressedSpringElements(
         {
             if (mIsStressedBuffer[i])
             {
-                renderContext.UploadShipElementStressedSpring(
-                    shipId,
+                renderSnapshot.UploadElementStressedSpring(
                     GetPointAIndex(i),
                     GetPointBIndex(i));
             }
@@ -241,6 +231,9 @@ bool Springs::UpdateStrains(
     // Flag remembering whether at least one spring broke
     bool isAtLeastOneBroken = false;
 
+    // The largest strain, including the strain of the springs that break
+    float maxStrain = 0.0f;
+
     // Visit all springs
     for (ElementIndex s : *this)
     {
@@ -253,6 +246,8 @@ bool Springs::UpdateStrains(
             float dx = (points.GetPosition(mEndpointsBuffer[s].PointAIndex) - points.GetPosition(mEndpointsBuffer[s].PointBIndex)).length();
             float const strain = fabs(mRestLengthBuffer[s] - dx) / mRestLengthBuffer[s];
 
+            maxStrain = std::max(maxStrain, strain);
+
             // Check against strength
             float const effectiveStrength = effectiveStrengthAdjustment * mStrengthBuffer[s];
             if (strain > effectiveStrength)
@@ -301,6 +296,8 @@ bool Springs::UpdateStrains(
         }
     }
 
+    mMaxStrain = maxStrain;
+
     return isAtLeastOneBroken;
 }
 
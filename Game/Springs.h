@@ -8,7 +8,7 @@
 #include "GameParameters.h"
 #include "IGameEventHandler.h"
 #include "Materials.h"
-#include "RenderContext.h"
+#include "RenderSnapshot.h"
 
 #include <GameCore/Buffer.h>
 #include <GameCore/BufferAllocator.h>
@@ -49,8 +49,6 @@ public:
         float /*currentSimulationTime*/,
         GameParameters const &)>;
 
-private:
-
     /*
      * The endpoints of a spring.
      */
@@ -67,6 +65,13 @@ private:
         {}
     };
 
+    /*
+     * The number of springs processed together by the vectorized spring force kernel.
+     */
+    static constexpr ElementCount SimdBatchSize = 4;
+
+private:
+
     using SuperTrianglesVector = FixedSizeVector<ElementIndex, 2>;
 
     /*
@@ -89,10 +94,12 @@ public:
 
     Springs(
         ElementCount elementCount,
+        ElementCount simdBatchedElementCount,
         World & parentWorld,
         std::shared_ptr<IGameEventHandler> gameEventHandler,
         GameParameters const & gameParameters)
         : ElementContainer(elementCount)
+        , mSimdBatchedElementCount(simdBatchedElementCount)
         //////////////////////////////////
         // Buffers
         //////////////////////////////////
@@ -124,6 +131,56 @@ public:
         , mCurrentNumMechanicalDynamicsIterations(gameParameters.NumMechanicalDynamicsIterations<float>())
         , mCurrentSpringStiffnessAdjustment(gameParameters.SpringStiffnessAdjustment)
         , mCurrentSpringDampingAdjustment(gameParameters.SpringDampingAdjustment)
+        , mMaxStrain(0.0f)
+        , mFloatBufferAllocator(mBufferElementCount)
+        , mVec2fBufferAllocator(mBufferElementCount)
+    {
+        assert(mSimdBatchedElementCount <= mElementCount);
+        assert(0 == (mSimdBatchedElementCount % SimdBatchSize));
+    }
+
+    /*
+     * Makes a copy of the specified springs - bulk-copying all of their buffers - which
+     * belongs to the specified world. The copy has no destroy handler.
+     */
+    Springs(
+        Springs const & other,
+        World & parentWorld,
+        std::shared_ptr<IGameEventHandler> gameEventHandler)
+        : ElementContainer(other)
+        , mSimdBatchedElementCount(other.mSimdBatchedElementCount)
+        //////////////////////////////////
+        // Buffers
+        //////////////////////////////////
+        , mIsDeletedBuffer(other.mIsDeletedBuffer)
+        // Endpoints
+        , mEndpointsBuffer(other.mEndpointsBuffer)
+        // Super triangles
+        , mSuperTrianglesBuffer(other.mSuperTrianglesBuffer)
+        // Physical
+        , mStrengthBuffer(other.mStrengthBuffer)
+        , mMaterialStrengthBuffer(other.mMaterialStrengthBuffer)
+        , mStiffnessBuffer(other.mStiffnessBuffer)
+        , mRestLengthBuffer(other.mRestLengthBuffer)
+        , mCoefficientsBuffer(other.mCoefficientsBuffer)
+        , mCharacteristicsBuffer(other.mCharacteristicsBuffer)
+        , mBaseStructuralMaterialBuffer(other.mBaseStructuralMaterialBuffer)
+        // Water
+        , mWaterPermeabilityBuffer(other.mWaterPermeabilityBuffer)
+        // Stress
+        , mIsStressedBuffer(other.mIsStressedBuffer)
+        // Bombs
+        , mIsBombAttachedBuffer(other.mIsBombAttachedBuffer)
+        //////////////////////////////////
+        // Container
+        //////////////////////////////////
+        , mParentWorld(parentWorld)
+        , mGameEventHandler(std::move(gameEventHandler))
+        , mDestroyHandler()
+        , mCurrentNumMechanicalDynamicsIterations(other.mCurrentNumMechanicalDynamicsIterations)
+        , mCurrentSpringStiffnessAdjustment(other.mCurrentSpringStiffnessAdjustment)
+        , mCurrentSpringDampingAdjustment(other.mCurrentSpringDampingAdjustment)
+        , mMaxStrain(other.mMaxStrain)
         , mFloatBufferAllocator(mBufferElementCount)
         , mVec2fBufferAllocator(mBufferElementCount)
     {
@@ -201,20 +258,35 @@ public:
         GameParameters const & gameParameters,
         Points & points);
 
+    /*
+     * Returns the largest strain - i.e. relative displacement from the rest length - found
+     * by the last UpdateStrains(), among springs that are neither deleted nor bomb-attached.
+     */
+    float GetMaxStrain() const
+    {
+        return mMaxStrain;
+    }
+
     //
     // Render
     //
 
-    void UploadElements(
-        ShipId shipId,
-        Render::RenderContext & renderContext) const;
+    void UploadElements(RenderSnapshot & renderSnapshot) const;
 
-    void UploadStressedSpringElements(
-        ShipId shipId,
-        Render::RenderContext & renderContext) const;
+    void UploadStressedSpringElements(RenderSnapshot & renderSnapshot) const;
 
 public:
 
+    /*
+     * Gets the number of springs - starting from the first one - that have been arranged
+     * at build time in batches of SimdBatchSize springs such that no two springs in the
+     * same batch share an endpoint. Always a multiple of SimdBatchSize.
+     */
+    ElementCount GetSimdBatchedElementCount() const
+    {
+        return mSimdBatchedElementCount;
+    }
+
     //
     // IsDeleted
     //
@@ -238,6 +310,11 @@ public:
         return mEndpointsBuffer[springElementIndex].PointBIndex;
     }
 
+    Endpoints const * restrict GetEndpointsBuffer() const
+    {
+        return mEndpointsBuffer.data();
+    }
+
     // Returns +1.0 if the spring is directed outward from the specified point;
     // otherwise, -1.0.
     float GetSpringDirectionFrom(
@@ -344,6 +421,11 @@ public:
         return mRestLengthBuffer[springElementIndex];
     }
 
+    float const * restrict GetRestLengthBufferAsFloat() const
+    {
+        return mRestLengthBuffer.data();
+    }
+
     float GetStiffnessCoefficient(ElementIndex springElementIndex) const
     {
         return mCoefficientsBuffer[springElementIndex].StiffnessCoefficient;
@@ -354,6 +436,12 @@ public:
         return mCoefficientsBuffer[springElementIndex].DampingCoefficient;
     }
 
+    // Stiffness and damping coefficients, interleaved
+    float const * restrict GetCoefficientsBufferAsFloat() const
+    {
+        return reinterpret_cast<float const *>(mCoefficientsBuffer.data());
+    }
+
     StructuralMaterial const & GetBaseStructuralMaterial(ElementIndex springElementIndex) const
     {
         // If this method is invoked, this is not a placeholder
@@ -459,6 +547,9 @@ private:
 
 private:
 
+    // The number of springs that are laid out in conflict-free batches
+    ElementCount const mSimdBatchedElementCount;
+
     //////////////////////////////////////////////////////////
     // Buffers
     //////////////////////////////////////////////////////////
@@ -526,6 +617,9 @@ private:
     float mCurrentSpringStiffnessAdjustment;
     float mCurrentSpringDampingAdjustment;
 
+    // The largest strain found by the last UpdateStrains()
+    float mMaxStrain;
+
     // Allocators for work buffers
     BufferAllocator<float> mFloatBufferAllocator;
     BufferAllocator<vec2f> mVec2fBufferAllocator;
@@ -6,7 +6,7 @@
 #pragma once
 
 #include "GameParameters.h"
-#include "RenderContext.h"
+#include "RenderSnapshot.h"
 
 #include <memory>
 
@@ -32,19 +32,17 @@ public:
         }
     }
 
-    void Upload(Render::RenderContext & renderContext) const
+    void Upload(WorldRenderSnapshot & renderSnapshot) const
     {
         if (mIsDirty)
         {
-            renderContext.UploadStarsStart(mStars.size());
+            renderSnapshot.UploadStarsStart(mStars.size());
 
             for (auto const & star : mStars)
             {
-                renderContext.UploadStar(star.ndcX, star.ndcY, star.brightness);
+                renderSnapshot.UploadStar(star.ndcX, star.ndcY, star.brightness);
             }
 
-            renderContext.UploadStarsEnd();
-
             mIsDirty = false;
         }
     }
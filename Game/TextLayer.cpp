@@ -38,7 +38,9 @@ void TextLayer::SetStatusText(
     float zoom,
     float totalUpdateToRenderDurationRatio,
     float lastUpdateToRenderDurationRatio,
-    Render::RenderStatistics const & renderStatistics)
+    float simulationSpeedMultiplier,
+    Render::RenderStatistics const & renderStatistics,
+    std::vector<Profiler::PhaseStatistics> const & phaseStatistics)
 {
     int elapsedSecondsGameInt = static_cast<int>(roundf(elapsedGameSeconds.count()));
     int minutesGame = elapsedSecondsGameInt / 60;
@@ -62,6 +64,8 @@ void TextLayer::SetStatusText(
 
         if (isPaused)
             ss << " (PAUSED)";
+        else
+            ss << " x" << simulationSpeedMultiplier;
 
         mStatusTextLines.emplace_back(ss.str());
     }
@@ -89,6 +93,22 @@ void TextLayer::SetStatusText(
             << " EPH:" << renderStatistics.LastRenderedShipEphemeralPoints;
 
         mStatusTextLines.emplace_back(ss.str());
+
+        // One line per profiled phase: min/mean/p95/max in milliseconds
+        for (auto const & ps : phaseStatistics)
+        {
+            ss.str("");
+
+            ss
+                << Profiler::GetPhaseName(ps.Phase) << ":"
+                << " " << ps.MinMillis
+                << "/" << ps.MeanMillis
+                << "/" << ps.P95Millis
+                << "/" << ps.MaxMillis
+                << "ms";
+
+            mStatusTextLines.emplace_back(ss.str());
+        }
     }
 
     mIsStatusTextDirty = true;
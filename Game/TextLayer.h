@@ -8,6 +8,7 @@
 #include "RenderContext.h"
 
 #include <GameCore/GameTypes.h>
+#include <GameCore/Profiler.h>
 
 #include <chrono>
 #include <string>
@@ -33,7 +34,9 @@ public:
         float zoom,
         float totalUpdateToRenderDurationRatio,
         float lastUpdateToRenderDurationRatio,
-        Render::RenderStatistics const & renderStatistics);
+        float simulationSpeedMultiplier,
+        Render::RenderStatistics const & renderStatistics,
+        std::vector<Profiler::PhaseStatistics> const & phaseStatistics);
 
     void Update();
 
@@ -239,17 +239,14 @@ void TimerBomb::OnNeighborhoodDisturbed()
     }
 }
 
-void TimerBomb::Upload(
-    ShipId shipId,
-    Render::RenderContext & renderContext) const
+void TimerBomb::Upload(RenderSnapshot & renderSnapshot) const
 {
     switch (mState)
     {
         case State::SlowFuseBurning:
         case State::FastFuseBurning:
         {
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::TimerBomb, mFuseStepCounter / FuseFramesPerFuseLengthCount),
                 GetPosition(),
@@ -258,8 +255,7 @@ void TimerBomb::Upload(
                 GetRotationOffsetAxis(),
                 1.0f);
 
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::TimerBombFuse, mFuseFlameFrameIndex),
                 GetPosition(),
@@ -280,8 +276,7 @@ void TimerBomb::Upload(
                     ? vec2f(-ShakeOffset, 0.0f)
                     : vec2f(ShakeOffset, 0.0f));
 
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::TimerBomb, FuseLengthStepCount),
                 shakenPosition,
@@ -297,8 +292,7 @@ void TimerBomb::Upload(
         {
             assert(mExplodingStepCounter < ExplosionStepsCount);
 
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::TimerBombExplosion, mExplodingStepCounter),
                 GetPosition(),
@@ -312,8 +306,7 @@ void TimerBomb::Upload(
 
         case State::Defusing:
         {
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::TimerBomb, mFuseStepCounter / FuseFramesPerFuseLengthCount),
                 GetPosition(),
@@ -322,8 +315,7 @@ void TimerBomb::Upload(
                 GetRotationOffsetAxis(),
                 1.0f);
 
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::TimerBombDefuse, mDefuseStepCounter),
                 GetPosition(),
@@ -337,8 +329,7 @@ void TimerBomb::Upload(
 
         case State::Defused:
         {
-            renderContext.UploadShipGenericTextureRenderSpecification(
-                shipId,
+            renderSnapshot.UploadGenericTextureRenderSpecification(
                 GetPlaneId(),
                 TextureFrameId(TextureGroupType::TimerBomb, mFuseStepCounter / FuseFramesPerFuseLengthCount),
                 GetPosition(),
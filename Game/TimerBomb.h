@@ -66,9 +66,7 @@ public:
 
     virtual void OnNeighborhoodDisturbed() override;
 
-    virtual void Upload(
-        ShipId shipId,
-        Render::RenderContext & renderContext) const override;
+    virtual void Upload(RenderSnapshot & renderSnapshot) const override;
 
 private:
 
@@ -6,7 +6,7 @@
 #pragma once
 
 #include "GameParameters.h"
-#include "RenderContext.h"
+#include "RenderSnapshot.h"
 
 #include <GameCore/Buffer.h>
 #include <GameCore/ElementContainer.h>
@@ -66,6 +66,27 @@ public:
     {
     }
 
+    /*
+     * Makes a copy of the specified triangles - bulk-copying all of their buffers. The
+     * copy has no destroy handler.
+     */
+    Triangles(Triangles const & other)
+        : ElementContainer(other)
+        //////////////////////////////////
+        // Buffers
+        //////////////////////////////////
+        , mIsDeletedBuffer(other.mIsDeletedBuffer)
+        // Endpoints
+        , mEndpointsBuffer(other.mEndpointsBuffer)
+        // Sub springs
+        , mSubSpringsBuffer(other.mSubSpringsBuffer)
+        //////////////////////////////////
+        // Container
+        //////////////////////////////////
+        , mDestroyHandler()
+    {
+    }
+
     Triangles(Triangles && other) = default;
 
     /*
@@ -99,7 +120,7 @@ public:
     //
 
     /*
-     * Uploads triangle elements.
+     * Uploads triangle elements to the render snapshot.
      *
      * The planeIndices container contains, for each plane, the starting index of the triangles in that plane into a single
      * buffer for all triangles. The last element contains the total number of (non-deleted) triangles.
@@ -109,9 +130,8 @@ public:
     template<typename TIndices>
     void UploadElements(
         TIndices & planeIndices,
-        ShipId shipId,
         Points const & points,
-        Render::RenderContext & renderContext) const
+        RenderSnapshot & renderSnapshot) const
     {
         for (ElementIndex i : *this)
         {
@@ -123,8 +143,7 @@ public:
 
                 // Send triangle to its index
                 assert(planeId < planeIndices.size());
-                renderContext.UploadShipElementTriangle(
-                    shipId,
+                renderSnapshot.UploadElementTriangle(
                     planeIndices[planeId],
                     GetPointAIndex(i),
                     GetPointBIndex(i),
@@ -0,0 +1,582 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2019-03-29
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameParameters.h"
+
+#include <GameCore/GameMath.h>
+#include <GameCore/GameTypes.h>
+#include <GameCore/SysSpecifics.h>
+#include <GameCore/Vectors.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+namespace Physics
+{
+
+/*
+ * The kernels that diffuse water among the points of a ship, moving water and its
+ * momentum along springs.
+ *
+ * Implementation of https://gabrielegiuseppini.wordpress.com/2018/09/08/momentum-based-simulation-of-water-flooding-2d-spaces/
+ *
+ * The push kernel visits each wet point and moves its outbound water straight into
+ * the other endpoints of its springs; since each point writes to its neighbors, it may
+ * only run serially.
+ *
+ * The pull kernel does the same in two phases: first each wet point calculates its
+ * outbound flows into a buffer indexed by spring direction, and then each point gathers
+ * the flows directed towards itself. Each phase only writes to the elements owned by the
+ * point being visited, hence both may be split among threads. The results differ from
+ * the push kernel's only by the order in which flows are summed.
+ *
+ * Both kernels rely on all wet points being in the list of active points, and they
+ * invoke the receiver callback with each point that receives water, in the same order.
+ *
+ * The kernels are templates over the points and the springs containers, so that they may
+ * be exercised on their own.
+ */
+class WaterDiffusion
+{
+public:
+
+    WaterDiffusion()
+        : mSpringOutboundQuantitiesOfWater()
+        , mSpringOutboundWaterVelocities()
+        , mPointOutboundQuantitiesOfWater()
+        , mPointOutboundWaterMomenta()
+        , mPointWaterSplashed()
+    {}
+
+    WaterDiffusion(WaterDiffusion && other) = default;
+
+    /*
+     * Moves water from each of the active points to its neighbors, one point at a time.
+     *
+     * Only the points that are active at the moment of the invocation are visited.
+     */
+    template<typename TPoints, typename TSprings, typename TOnWaterReceived>
+    static void Push(
+        TPoints const & points,
+        TSprings const & springs,
+        std::vector<ElementIndex> const & activePoints,
+        float const * restrict oldPointWaterBufferData,
+        vec2f const * restrict oldPointWaterVelocityBufferData,
+        float * restrict newPointWaterBufferData,
+        vec2f * restrict newPointWaterMomentumBufferData,
+        GameParameters const & gameParameters,
+        TOnWaterReceived && onWaterReceived,
+        float & waterSplashed)
+    {
+        std::array<float, GameParameters::MaxSpringsPerPoint> springOutboundQuantitiesOfWater;
+        std::array<vec2f, GameParameters::MaxSpringsPerPoint> springOutboundWaterVelocities;
+
+        // Points are added to the active list as they receive water while we visit it;
+        // these were dry, hence there's no need to visit them
+        size_t const activePointCount = activePoints.size();
+        for (size_t a = 0; a < activePointCount; ++a)
+        {
+            ElementIndex const pointIndex = activePoints[a];
+
+            waterSplashed += CalculateOutflows(
+                pointIndex,
+                points,
+                springs,
+                oldPointWaterBufferData,
+                oldPointWaterVelocityBufferData,
+                gameParameters,
+                springOutboundQuantitiesOfWater.data(),
+                springOutboundWaterVelocities.data());
+
+            //
+            // Move water along all springs according to their flows,
+            // and update destination's momenta accordingly
+            //
+
+            auto const connectedSprings = points.GetConnectedSprings(pointIndex);
+            size_t const connectedSpringCount = connectedSprings.size();
+            for (size_t s = 0; s < connectedSpringCount; ++s)
+            {
+                auto const & cs = connectedSprings[s];
+
+                float const springOutboundQuantityOfWater = springOutboundQuantitiesOfWater[s];
+
+                if (springs.GetWaterPermeability(cs.SpringIndex) != 0.0f)
+                {
+                    //
+                    // Water - and momentum - move from point to endpoint
+                    //
+
+                    // Move water quantity
+                    newPointWaterBufferData[pointIndex] -= springOutboundQuantityOfWater;
+                    newPointWaterBufferData[cs.OtherEndpointIndex] += springOutboundQuantityOfWater;
+
+                    if (springOutboundQuantityOfWater > 0.0f)
+                        onWaterReceived(cs.OtherEndpointIndex);
+
+                    // Remove "old momentum" (old velocity) from point
+                    newPointWaterMomentumBufferData[pointIndex] -=
+                        oldPointWaterVelocityBufferData[pointIndex]
+                        * springOutboundQuantityOfWater;
+
+                    // Add "new momentum" (old velocity + velocity gained) to other endpoint
+                    newPointWaterMomentumBufferData[cs.OtherEndpointIndex] +=
+                        springOutboundWaterVelocities[s]
+                        * springOutboundQuantityOfWater;
+                }
+                else
+                {
+                    //
+                    // New momentum (old velocity + velocity gained) bounces back
+                    // (and zeroes outgoing), assuming perfectly inelastic collision
+                    //
+                    // No changes to other endpoint
+                    //
+
+                    newPointWaterMomentumBufferData[pointIndex] -=
+                        springOutboundWaterVelocities[s]
+                        * springOutboundQuantityOfWater;
+                }
+            }
+        }
+    }
+
+    /*
+     * Moves water from each of the active points to its neighbors, with each of the two
+     * phases split into chunks of active points by the specified parallel-for, which is
+     * invoked as parallelFor(startIndex, endIndex, body) and must invoke body(chunkStartIndex, chunkEndIndex)
+     * on chunks covering the [startIndex, endIndex) range.
+     *
+     * Only the points that are active at the moment of the invocation are visited as sources.
+     */
+    template<typename TPoints, typename TSprings, typename TParallelFor, typename TOnWaterReceived>
+    void Pull(
+        TPoints const & points,
+        TSprings const & springs,
+        std::vector<ElementIndex> const & activePoints,
+        float const * restrict oldPointWaterBufferData,
+        vec2f const * restrict oldPointWaterVelocityBufferData,
+        float * restrict newPointWaterBufferData,
+        vec2f * restrict newPointWaterMomentumBufferData,
+        GameParameters const & gameParameters,
+        TParallelFor && parallelFor,
+        TOnWaterReceived && onWaterReceived,
+        float & waterSplashed)
+    {
+        // Make sure our buffers are large enough; springs and points are never added
+        mSpringOutboundQuantitiesOfWater.resize(2 * springs.GetElementCount());
+        mSpringOutboundWaterVelocities.resize(2 * springs.GetElementCount());
+        mPointOutboundQuantitiesOfWater.resize(points.GetElementCount());
+        mPointOutboundWaterMomenta.resize(points.GetElementCount());
+        mPointWaterSplashed.resize(points.GetElementCount());
+
+        float * restrict const springOutboundQuantitiesOfWaterData = mSpringOutboundQuantitiesOfWater.data();
+        vec2f * restrict const springOutboundWaterVelocitiesData = mSpringOutboundWaterVelocities.data();
+        float * restrict const pointOutboundQuantitiesOfWaterData = mPointOutboundQuantitiesOfWater.data();
+        vec2f * restrict const pointOutboundWaterMomentaData = mPointOutboundWaterMomenta.data();
+        float * restrict const pointWaterSplashedData = mPointWaterSplashed.data();
+
+        size_t const activePointCount = activePoints.size();
+
+        //
+        // 1) Each active point calculates its outbound flows; each flow is stored at the
+        //    spring direction it leaves the point from
+        //
+
+        parallelFor(
+            ElementIndex(0),
+            static_cast<ElementIndex>(activePointCount),
+            [&](ElementIndex startActivePointIndex, ElementIndex endActivePointIndex)
+            {
+                std::array<float, GameParameters::MaxSpringsPerPoint> springOutboundQuantitiesOfWater;
+                std::array<vec2f, GameParameters::MaxSpringsPerPoint> springOutboundWaterVelocities;
+
+                for (ElementIndex a = startActivePointIndex; a < endActivePointIndex; ++a)
+                {
+                    ElementIndex const pointIndex = activePoints[a];
+
+                    pointWaterSplashedData[pointIndex] = CalculateOutflows(
+                        pointIndex,
+                        points,
+                        springs,
+                        oldPointWaterBufferData,
+                        oldPointWaterVelocityBufferData,
+                        gameParameters,
+                        springOutboundQuantitiesOfWater.data(),
+                        springOutboundWaterVelocities.data());
+
+                    float pointOutboundQuantityOfWater = 0.0f;
+                    vec2f pointOutboundWaterMomentum = vec2f::zero();
+
+                    auto const connectedSprings = points.GetConnectedSprings(pointIndex);
+                    size_t const connectedSpringCount = connectedSprings.size();
+                    for (size_t s = 0; s < connectedSpringCount; ++s)
+                    {
+                        auto const & cs = connectedSprings[s];
+
+                        float const springOutboundQuantityOfWater = springOutboundQuantitiesOfWater[s];
+
+                        if (springs.GetWaterPermeability(cs.SpringIndex) != 0.0f)
+                        {
+                            // Water leaves with its "old momentum" (old velocity), and arrives with
+                            // its "new momentum" (old velocity + velocity gained)
+                            pointOutboundQuantityOfWater += springOutboundQuantityOfWater;
+
+                            pointOutboundWaterMomentum +=
+                                oldPointWaterVelocityBufferData[pointIndex]
+                                * springOutboundQuantityOfWater;
+                        }
+                        else
+                        {
+                            // New momentum bounces back
+                            pointOutboundWaterMomentum +=
+                                springOutboundWaterVelocities[s]
+                                * springOutboundQuantityOfWater;
+                        }
+
+                        size_t const springDirectionIndex = GetSpringDirectionIndex(cs.SpringIndex, pointIndex, springs);
+                        springOutboundQuantitiesOfWaterData[springDirectionIndex] = springOutboundQuantityOfWater;
+                        springOutboundWaterVelocitiesData[springDirectionIndex] = springOutboundWaterVelocities[s];
+                    }
+
+                    pointOutboundQuantitiesOfWaterData[pointIndex] = pointOutboundQuantityOfWater;
+                    pointOutboundWaterMomentaData[pointIndex] = pointOutboundWaterMomentum;
+                }
+            });
+
+        //
+        // 2) Activate the points that receive water, and sum up splashes - both in
+        //    the order of the active points
+        //
+
+        for (size_t a = 0; a < activePointCount; ++a)
+        {
+            ElementIndex const pointIndex = activePoints[a];
+
+            for (auto const & cs : points.GetConnectedSprings(pointIndex))
+            {
+                if (springs.GetWaterPermeability(cs.SpringIndex) != 0.0f
+                    && springOutboundQuantitiesOfWaterData[GetSpringDirectionIndex(cs.SpringIndex, pointIndex, springs)] > 0.0f)
+                {
+                    onWaterReceived(cs.OtherEndpointIndex);
+                }
+            }
+
+            waterSplashed += pointWaterSplashedData[pointIndex];
+        }
+
+        //
+        // 3) Each active point - including the ones just activated - gathers the flows
+        //    directed towards itself
+        //
+
+        parallelFor(
+            ElementIndex(0),
+            static_cast<ElementIndex>(activePoints.size()),
+            [&](ElementIndex startActivePointIndex, ElementIndex endActivePointIndex)
+            {
+                for (ElementIndex a = startActivePointIndex; a < endActivePointIndex; ++a)
+                {
+                    ElementIndex const pointIndex = activePoints[a];
+
+                    float newWater = oldPointWaterBufferData[pointIndex];
+                    vec2f newWaterMomentum = newPointWaterMomentumBufferData[pointIndex];
+
+                    // Only wet points have calculated their outflows
+                    if (oldPointWaterBufferData[pointIndex] != 0.0f)
+                    {
+                        newWater -= pointOutboundQuantitiesOfWaterData[pointIndex];
+                        newWaterMomentum -= pointOutboundWaterMomentaData[pointIndex];
+                    }
+
+                    for (auto const & cs : points.GetConnectedSprings(pointIndex))
+                    {
+                        if (springs.GetWaterPermeability(cs.SpringIndex) != 0.0f
+                            && oldPointWaterBufferData[cs.OtherEndpointIndex] != 0.0f)
+                        {
+                            size_t const springDirectionIndex = GetSpringDirectionIndex(cs.SpringIndex, cs.OtherEndpointIndex, springs);
+
+                            float const springInboundQuantityOfWater = springOutboundQuantitiesOfWaterData[springDirectionIndex];
+
+                            newWater += springInboundQuantityOfWater;
+
+                            newWaterMomentum +=
+                                springOutboundWaterVelocitiesData[springDirectionIndex]
+                                * springInboundQuantityOfWater;
+                        }
+                    }
+
+                    newPointWaterBufferData[pointIndex] = newWater;
+                    newPointWaterMomentumBufferData[pointIndex] = newWaterMomentum;
+                }
+            });
+    }
+
+private:
+
+    /*
+     * Returns the index of the direction of the spring that leaves from the specified endpoint.
+     */
+    template<typename TSprings>
+    static inline size_t GetSpringDirectionIndex(
+        ElementIndex springIndex,
+        ElementIndex fromPointIndex,
+        TSprings const & springs)
+    {
+        return 2 * static_cast<size_t>(springIndex)
+            + (fromPointIndex == springs.GetPointAIndex(springIndex) ? 0 : 1);
+    }
+
+    /*
+     * Calculates the quantities of water and the velocities of the water leaving the point
+     * along each of its springs - including impermeable ones - and returns the water splashed
+     * at the point; only reads the old water and velocities of the point and of its neighbors.
+     */
+    template<typename TPoints, typename TSprings>
+    static inline float CalculateOutflows(
+        ElementIndex pointIndex,
+        TPoints const & points,
+        TSprings const & springs,
+        float const * restrict oldPointWaterBufferData,
+        vec2f const * restrict oldPointWaterVelocityBufferData,
+        GameParameters const & gameParameters,
+        float * restrict springOutboundQuantitiesOfWater,
+        vec2f * restrict springOutboundWaterVelocities)
+    {
+        //
+        // 1) Calculate water momenta along all springs
+        //
+
+        // A higher crazyness gives more emphasys to bernoulli's velocity, as if pressures
+        // and gravity were exaggerated
+        //
+        // WV[t] = WV[t-1] + alpha * Bernoulli
+        //
+        // WaterCrazyness=0   -> alpha=1
+        // WaterCrazyness=0.5 -> alpha=0.5 + 0.5*Wh
+        // WaterCrazyness=1   -> alpha=Wh
+        float const alphaCrazyness = 1.0f + gameParameters.WaterCrazyness * (oldPointWaterBufferData[pointIndex] - 1.0f);
+
+        // Count of non-hull free and drowned neighbor points
+        float pointSplashNeighbors = 0.0f;
+        float pointSplashFreeNeighbors = 0.0f;
+
+        // Total weight of outbound water flows; weights are set to zero for springs
+        // whose resultant scalar water velocities are directed towards the point
+        float totalOutboundWaterFlowWeight = 0.0f;
+
+        auto const connectedSprings = points.GetConnectedSprings(pointIndex);
+        size_t const connectedSpringCount = connectedSprings.size();
+        for (size_t s = 0; s < connectedSpringCount; ++s)
+        {
+            auto const & cs = connectedSprings[s];
+
+            // Normalized spring vector, oriented point -> other endpoint
+            vec2f const springNormalizedVector = (points.GetPosition(cs.OtherEndpointIndex) - points.GetPosition(pointIndex)).normalise();
+
+            // Component of the point's own water velocity along the spring
+            float const pointWaterVelocityAlongSpring =
+                oldPointWaterVelocityBufferData[pointIndex]
+                .dot(springNormalizedVector);
+
+            //
+            // Calulate Bernoulli's velocity gained along this spring, from this point to
+            // the other endpoint
+            //
+
+            // Pressure difference (positive implies point -> other endpoint flow)
+            float const dw = oldPointWaterBufferData[pointIndex] - oldPointWaterBufferData[cs.OtherEndpointIndex];
+
+            // Gravity potential difference (positive implies point -> other endpoint flow)
+            float const dy = points.GetPosition(pointIndex).y - points.GetPosition(cs.OtherEndpointIndex).y;
+
+            // Calculate gained water velocity along this spring, from point to other endpoint
+            // (Bernoulli, 1738)
+            float bernoulliVelocityAlongSpring;
+            float const dwy = dw + dy;
+            if (dwy >= 0.0f)
+            {
+                // Gained velocity goes from point to other endpoint
+                bernoulliVelocityAlongSpring = sqrtf(2.0f * GameParameters::GravityMagnitude * dwy);
+            }
+            else
+            {
+                // Gained velocity goes from other endpoint to point
+                bernoulliVelocityAlongSpring = -sqrtf(2.0f * GameParameters::GravityMagnitude * -dwy);
+            }
+
+            // Resultant scalar velocity along spring; outbound only, as
+            // if this were inbound it wouldn't result in any movement of the point's
+            // water between these two springs. Morevoer, Bernoulli's velocity injected
+            // along this spring will be picked up later also by the other endpoint,
+            // and at that time it would move water if it agrees with its velocity
+            float const springOutboundScalarWaterVelocity = std::max(
+                pointWaterVelocityAlongSpring + bernoulliVelocityAlongSpring * alphaCrazyness,
+                0.0f);
+
+            // Store weight along spring - for now in place of the quantity of water - scaling
+            // for the greater distance traveled along diagonal springs
+            springOutboundQuantitiesOfWater[s] =
+                springOutboundScalarWaterVelocity
+                / springs.GetRestLength(cs.SpringIndex);
+
+            // Resultant outbound velocity along spring
+            springOutboundWaterVelocities[s] =
+                springNormalizedVector
+                * springOutboundScalarWaterVelocity;
+
+            // Update total outbound flow weight
+            totalOutboundWaterFlowWeight += springOutboundQuantitiesOfWater[s];
+
+
+            //
+            // Update splash neighbors counts
+            //
+
+            // The "freeness factor" of the other endpoint, i.e. how much its quantity of water
+            // "suppresses" splashes from adjacent kinetic energy losses
+            float const otherEndpointFreenessFactor = FastExp(-oldPointWaterBufferData[cs.OtherEndpointIndex] * 10.0f);
+
+            pointSplashFreeNeighbors +=
+                springs.GetWaterPermeability(cs.SpringIndex)
+                * otherEndpointFreenessFactor;
+
+            pointSplashNeighbors += springs.GetWaterPermeability(cs.SpringIndex);
+        }
+
+
+        //
+        // 2) Calculate normalization factor for water flows:
+        //    the quantity of water along a spring is proportional to the weight of the spring
+        //    (resultant velocity along that spring), and the sum of all outbound water flows must
+        //    match the water currently at the point times the water speed fraction and the adjustment
+        //
+
+        assert(totalOutboundWaterFlowWeight >= 0.0f);
+
+        float waterQuantityNormalizationFactor = 0.0f;
+        if (totalOutboundWaterFlowWeight != 0.0f)
+        {
+            waterQuantityNormalizationFactor =
+                oldPointWaterBufferData[pointIndex]
+                * points.GetWaterDiffusionSpeed(pointIndex)
+                * gameParameters.WaterDiffusionSpeedAdjustment
+                / totalOutboundWaterFlowWeight;
+        }
+
+
+        //
+        // 3) Calculate quantities of water along all springs, and the kinetic energy
+        //    they lose
+        //
+
+        // Kinetic energy lost at this point
+        float pointKineticEnergyLoss = 0.0f;
+
+        for (size_t s = 0; s < connectedSpringCount; ++s)
+        {
+            auto const & cs = connectedSprings[s];
+
+            // Calculate quantity of water directed outwards
+            springOutboundQuantitiesOfWater[s] *= waterQuantityNormalizationFactor;
+
+            assert(springOutboundQuantitiesOfWater[s] >= 0.0f);
+
+            if (springs.GetWaterPermeability(cs.SpringIndex) != 0.0f)
+            {
+                //
+                // Update point's kinetic energy loss:
+                // splintered water colliding with whole other endpoint
+                //
+
+                // FUTURE: get rid of this re-calculation once we pre-calculate all spring normalized vectors
+                vec2f const springNormalizedVector = (points.GetPosition(cs.OtherEndpointIndex) - points.GetPosition(pointIndex)).normalise();
+
+                float ma = springOutboundQuantitiesOfWater[s];
+                float va = springOutboundWaterVelocities[s].length();
+                float mb = oldPointWaterBufferData[cs.OtherEndpointIndex];
+                float vb = oldPointWaterVelocityBufferData[cs.OtherEndpointIndex].dot(springNormalizedVector);
+
+                float vf = 0.0f;
+                if (ma + mb != 0.0f)
+                    vf = (ma * va + mb * vb) / (ma + mb);
+
+                float deltaKa =
+                    0.5f
+                    * ma
+                    * (va * va - vf * vf);
+
+                // Note: deltaKa might be negative, in which case deltaKb would have been
+                // more positive (perfectly inelastic -> deltaK == max); we will pickup
+                // deltaKb later
+                pointKineticEnergyLoss += std::max(deltaKa, 0.0f);
+            }
+            else
+            {
+                // Deleted springs are removed from points' connected springs
+                assert(!springs.IsDeleted(cs.SpringIndex));
+
+                //
+                // Update point's kinetic energy loss:
+                // entire splintered water
+                //
+
+                float ma = springOutboundQuantitiesOfWater[s];
+                float va = springOutboundWaterVelocities[s].length();
+
+                float deltaKa =
+                    0.5f
+                    * ma
+                    * va * va;
+
+                assert(deltaKa >= 0.0f);
+                pointKineticEnergyLoss += deltaKa;
+            }
+        }
+
+        //
+        // 4) Calculate water splash
+        //
+
+        if (pointSplashNeighbors != 0.0f)
+        {
+            // Water splashed is proportional to kinetic energy loss that took
+            // place near free points (i.e. not drowned by water)
+            return
+                pointKineticEnergyLoss
+                * pointSplashFreeNeighbors
+                / pointSplashNeighbors;
+        }
+        else
+        {
+            return 0.0f;
+        }
+    }
+
+private:
+
+    //
+    // Pull kernel work buffers
+    //
+
+    // Quantity of water and its velocity leaving along each spring direction: at 2s
+    // for the direction leaving from the spring's endpoint A, at 2s+1 for B
+    std::vector<float> mSpringOutboundQuantitiesOfWater;
+    std::vector<vec2f> mSpringOutboundWaterVelocities;
+
+    // Total quantity of water and total momentum leaving each point
+    std::vector<float> mPointOutboundQuantitiesOfWater;
+    std::vector<vec2f> mPointOutboundWaterMomenta;
+
+    // Water splashed at each point
+    std::vector<float> mPointWaterSplashed;
+};
+
+}
@@ -5,6 +5,8 @@
 ***************************************************************************************/
 #include "Physics.h"
 
+#include "PeriodicSamples.h"
+
 namespace Physics {
 
 WaterSurface::WaterSurface()
@@ -67,4 +69,17 @@ void WaterSurface::Update(
     mSamples[SamplesCount - 1].SampleValuePlusOneMinusSampleValue = mSamples[0].SampleValue - previousSampleValue;
 }
 
-}
\ No newline at end of file
+void WaterSurface::GetWaterHeightsAt(
+    vec2f const * restrict positions,
+    float * restrict heights,
+    size_t count) const
+{
+    SamplePeriodicHeightsAt<SamplesCount>(
+        mSamples.get(),
+        Dx,
+        positions,
+        heights,
+        count);
+}
+
+}
@@ -6,9 +6,12 @@
 #pragma once
 
 #include "GameParameters.h"
+#include "PeriodicSamples.h"
 
 #include <GameCore/GameMath.h>
 #include <GameCore/RunningAverage.h>
+#include <GameCore/SysSpecifics.h>
+#include <GameCore/Vectors.h>
 
 #include <memory>
 
@@ -59,6 +62,25 @@ public:
              + mSamples[sampleIndexI].SampleValuePlusOneMinusSampleValue * sampleIndexDx;
     }
 
+    /*
+     * Samples the height of the water at the x coordinates of the specified positions,
+     * storing the results in the specified height buffer; equivalent to - but faster than -
+     * invoking GetWaterHeightAt() for each position.
+     */
+    void GetWaterHeightsAt(
+        vec2f const * restrict positions,
+        float * restrict heights,
+        size_t count) const;
+
+    /*
+     * Copies the samples of the water surface, so that its height may be sampled
+     * without it - e.g. by the renderer.
+     */
+    void CopySamplesTo(PeriodicSamplesCopy & samples) const
+    {
+        samples.CopyFrom(mSamples.get(), SamplesCount, Dx);
+    }
+
 private:
 
     // Spatial frequencies of the wave components
@@ -5,12 +5,15 @@
  ***************************************************************************************/
 #include "Physics.h"
 
+#include "ShipBuildCache.h"
 #include "ShipBuilder.h"
 
 #include <GameCore/GameRandomEngine.h>
+#include <GameCore/Profiler.h>
 
 #include <algorithm>
 #include <cassert>
+#include <exception>
 
 namespace Physics {
 
@@ -19,13 +22,17 @@ World::World(
     GameParameters const & gameParameters,
     ResourceLoader & resourceLoader)
     : mAllShips()
+    , mAllShipGameEventBuffers()
+    , mAllShipRandomEngines()
     , mStars()
     , mClouds()
     , mWaterSurface()
     , mOceanFloor(resourceLoader)
     , mWind(gameEventHandler)
+    , mRenderSnapshot()
     , mCurrentSimulationTime(0.0f)
     , mGameEventHandler(std::move(gameEventHandler))
+    , mThreadPool(std::make_unique<ThreadPool>(gameParameters.NumberOfSimulationThreads))
 {
     // Initialize world pieces
     mStars.Update(gameParameters);
@@ -38,19 +45,54 @@ World::World(
 ShipId World::AddShip(
     ShipDefinition const & shipDefinition,
     MaterialDatabase const & materialDatabase,
-    GameParameters const & gameParameters)
+    GameParameters const & gameParameters,
+    ShipBuildCache const * shipBuildCache,
+    std::shared_ptr<ShipPristineState const> * pristineState)
 {
     ShipId shipId = static_cast<ShipId>(mAllShips.size());
 
+    // The ship publishes its events via its own buffer, so that
+    // ships may be updated in parallel
+    auto gameEventBuffer = std::make_shared<GameEventBuffer>(mGameEventHandler);
+
     auto ship = ShipBuilder::Create(
         shipId,
         *this,
-        mGameEventHandler,
+        gameEventBuffer,
         shipDefinition,
         materialDatabase,
-        gameParameters);
+        gameParameters,
+        shipBuildCache,
+        pristineState);
 
     mAllShips.push_back(std::move(ship));
+    mAllShipGameEventBuffers.push_back(std::move(gameEventBuffer));
+    mAllShipRandomEngines.push_back(std::make_unique<GameRandomEngine>(static_cast<uint32_t>(shipId)));
+
+    return shipId;
+}
+
+ShipId World::AddShip(
+    std::shared_ptr<ShipPristineState const> pristineState,
+    MaterialDatabase const & materialDatabase)
+{
+    assert(!!pristineState);
+
+    ShipId shipId = static_cast<ShipId>(mAllShips.size());
+
+    // The ship publishes its events via its own buffer, so that
+    // ships may be updated in parallel
+    auto gameEventBuffer = std::make_shared<GameEventBuffer>(mGameEventHandler);
+
+    auto ship = pristineState->MakeShip(
+        shipId,
+        *this,
+        gameEventBuffer,
+        materialDatabase);
+
+    mAllShips.push_back(std::move(ship));
+    mAllShipGameEventBuffers.push_back(std::move(gameEventBuffer));
+    mAllShipRandomEngines.push_back(std::make_unique<GameRandomEngine>(static_cast<uint32_t>(shipId)));
 
     return shipId;
 }
@@ -373,11 +415,19 @@ void World::QueryNearestPointAt(
 
 void World::Update(
     GameParameters const & gameParameters,
-    Render::RenderContext const & renderContext)
+    VectorFieldRenderMode vectorFieldRenderMode)
 {
+    PROFILE_PHASE(WorldUpdate);
+
     // Update current time
     mCurrentSimulationTime += GameParameters::SimulationStepTimeDuration<float>;
 
+    // Resize thread pool if needed
+    if (mThreadPool->GetParallelism() != gameParameters.NumberOfSimulationThreads)
+    {
+        mThreadPool = std::make_unique<ThreadPool>(gameParameters.NumberOfSimulationThreads);
+    }
+
     // Update world parts
     mStars.Update(gameParameters);
     mWind.Update(gameParameters);
@@ -386,25 +436,94 @@ void World::Update(
     mOceanFloor.Update(gameParameters);
 
     // Update all ships
-    for (auto & ship : mAllShips)
+    if (mAllShips.size() > 1 && mThreadPool->GetParallelism() > 1)
     {
-        ship->Update(
-            mCurrentSimulationTime,
-            gameParameters,
-            renderContext);
+        //
+        // Ships do not interact with each other, hence we update them in parallel;
+        // their events are buffered while updating, and published afterwards
+        // in ship order, so that the sequence of events is the same regardless
+        // of the number of threads
+        //
+
+        std::vector<ThreadPool::Task> tasks;
+        tasks.reserve(mAllShips.size());
+
+        for (size_t s = 0; s < mAllShips.size(); ++s)
+        {
+            mAllShipGameEventBuffers[s]->BeginBuffering();
+
+            tasks.emplace_back(
+                [this, s, &gameParameters, vectorFieldRenderMode]()
+                {
+                    UpdateShip(s, gameParameters, vectorFieldRenderMode);
+                });
+        }
+
+        std::exception_ptr exception;
+        try
+        {
+            mThreadPool->Run(tasks);
+        }
+        catch (...)
+        {
+            exception = std::current_exception();
+        }
+
+        for (auto & gameEventBuffer : mAllShipGameEventBuffers)
+        {
+            gameEventBuffer->EndBuffering();
+        }
+
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+    else
+    {
+        for (size_t s = 0; s < mAllShips.size(); ++s)
+        {
+            UpdateShip(s, gameParameters, vectorFieldRenderMode);
+        }
     }
 }
 
+void World::UpdateShip(
+    size_t shipIndex,
+    GameParameters const & gameParameters,
+    VectorFieldRenderMode vectorFieldRenderMode)
+{
+    assert(shipIndex < mAllShips.size());
+
+    // Each ship draws from its own random sequence, which keeps the simulation
+    // reproducible regardless of which thread updates which ship
+    GameRandomEngine::ThreadInstanceScope randomEngineScope(*(mAllShipRandomEngines[shipIndex]));
+
+    mAllShips[shipIndex]->Update(
+        mCurrentSimulationTime,
+        gameParameters,
+        vectorFieldRenderMode);
+}
+
 void World::Render(
     GameParameters const & gameParameters,
-    Render::RenderContext & renderContext) const
+    Render::RenderContext & renderContext)
 {
+    PROFILE_PHASE(WorldRender);
+
     //
     // Upload land and ocean data (before clouds and stars are rendered, as the latters
     // need the ocean stencil)
     //
 
-    UploadLandAndOcean(gameParameters, renderContext);
+    if (mRenderSnapshot.IsAcquired())
+    {
+        PROFILE_PHASE(LandAndOceanUpload);
+
+        mRenderSnapshot.UploadLandAndOcean(
+            gameParameters.SeaDepth,
+            renderContext);
+    }
 
 
     //
@@ -414,10 +533,10 @@ void World::Render(
     renderContext.RenderSkyStart();
 
     // Upload stars
-    mStars.Upload(renderContext);
+    mRenderSnapshot.UploadStars(renderContext);
 
     // Upload clouds
-    mClouds.Upload(renderContext);
+    mRenderSnapshot.UploadClouds(renderContext);
 
     renderContext.RenderSkyEnd();
 
@@ -465,34 +584,41 @@ void World::Render(
     renderContext.RenderLand();
 }
 
-///////////////////////////////////////////////////////////////////////////////////
-// Private Helpers
-///////////////////////////////////////////////////////////////////////////////////
-
-void World::UploadLandAndOcean(
-    GameParameters const & gameParameters,
-    Render::RenderContext & renderContext) const
+void World::PublishRenderSnapshots(VectorFieldRenderMode vectorFieldRenderMode)
 {
-    size_t constexpr SlicesCount = 500;
+    mRenderSnapshot.PublishStart();
+
+    mStars.Upload(mRenderSnapshot);
+    mClouds.Upload(mRenderSnapshot);
+    mOceanFloor.CopySamplesTo(mRenderSnapshot.GetOceanFloorSamples());
+    mWaterSurface.CopySamplesTo(mRenderSnapshot.GetWaterSurfaceSamples());
 
-    float const visibleWorldWidth = renderContext.GetVisibleWorldWidth();
-    float const sliceWidth = visibleWorldWidth / static_cast<float>(SlicesCount);
-    float sliceX = renderContext.GetCameraWorldPosition().x - (visibleWorldWidth / 2.0f);
+    mRenderSnapshot.PublishEnd();
+
+    for (auto & ship : mAllShips)
+    {
+        ship->PublishRenderSnapshot(vectorFieldRenderMode);
+    }
+}
 
-    renderContext.UploadLandAndOceanStart(SlicesCount);
+void World::HandOverRenderSnapshots()
+{
+    mRenderSnapshot.HandOver();
 
-    // We do one extra iteration as the number of slices is the number of quads, and the last vertical
-    // quad side must be at the end of the width
-    for (size_t i = 0; i <= SlicesCount; ++i, sliceX += sliceWidth)
+    for (auto & ship : mAllShips)
     {
-        renderContext.UploadLandAndOcean(
-            sliceX,
-            mOceanFloor.GetFloorHeightAt(sliceX),
-            mWaterSurface.GetWaterHeightAt(sliceX),
-            gameParameters.SeaDepth);
+        ship->HandOverRenderSnapshot();
     }
+}
 
-    renderContext.UploadLandAndOceanEnd();
+void World::AcquireRenderSnapshots(bool doInterpolateShipPositions)
+{
+    mRenderSnapshot.Acquire();
+
+    for (auto & ship : mAllShips)
+    {
+        ship->AcquireRenderSnapshot(doInterpolateShipPositions);
+    }
 }
 
 }
\ No newline at end of file
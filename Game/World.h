@@ -5,6 +5,7 @@
  ***************************************************************************************/
 #pragma once
 
+#include "GameEventBuffer.h"
 #include "GameParameters.h"
 #include "IGameEventHandler.h"
 #include "MaterialDatabase.h"
@@ -14,6 +15,8 @@
 #include "ShipDefinition.h"
 
 #include <GameCore/AABB.h>
+#include <GameCore/GameRandomEngine.h>
+#include <GameCore/ThreadPool.h>
 #include <GameCore/Vectors.h>
 
 #include <cstdint>
@@ -21,6 +24,8 @@
 #include <set>
 #include <vector>
 
+class ShipBuildCache;
+
 namespace Physics
 {
 
@@ -33,10 +38,24 @@ public:
         GameParameters const & gameParameters,
         ResourceLoader & resourceLoader);
 
+    /*
+     * Adds a ship built out of the specified definition; when requested, also returns the
+     * state of the ship as it was right after it had been built.
+     */
     ShipId AddShip(
         ShipDefinition const & shipDefinition,
         MaterialDatabase const & materialDatabase,
-        GameParameters const & gameParameters);
+        GameParameters const & gameParameters,
+        ShipBuildCache const * shipBuildCache = nullptr,
+        std::shared_ptr<ShipPristineState const> * pristineState = nullptr);
+
+    /*
+     * Adds a ship made out of the pristine state of a ship built earlier, possibly
+     * in another world.
+     */
+    ShipId AddShip(
+        std::shared_ptr<ShipPristineState const> pristineState,
+        MaterialDatabase const & materialDatabase);
 
     size_t GetShipCount() const;
 
@@ -47,6 +66,14 @@ public:
         return mWaterSurface.GetWaterHeightAt(x);
     }
 
+    inline void GetWaterHeightsAt(
+        vec2f const * restrict positions,
+        float * restrict heights,
+        size_t count) const
+    {
+        mWaterSurface.GetWaterHeightsAt(positions, heights, count);
+    }
+
     inline bool IsUnderwater(vec2f const & position) const
     {
         return position.y < GetWaterHeightAt(position.x);
@@ -57,11 +84,24 @@ public:
         return mOceanFloor.GetFloorHeightAt(x);
     }
 
+    inline void GetOceanFloorHeightsAt(
+        vec2f const * restrict positions,
+        float * restrict heights,
+        size_t count) const
+    {
+        mOceanFloor.GetFloorHeightsAt(positions, heights, count);
+    }
+
     inline vec2f const & GetCurrentWindSpeed() const
     {
         return mWind.GetCurrentWindSpeed();
     }
 
+    inline ThreadPool & GetThreadPool()
+    {
+        return *mThreadPool;
+    }
+
     void MoveBy(
         ShipId shipId,
         vec2f const & offset,
@@ -143,35 +183,72 @@ public:
         vec2f const & targetPos,
         float radius) const;
 
+    /*
+     * Runs one simulation step. The vector field render mode is only needed to know
+     * which vectors to capture for rendering; the simulation needs no render context.
+     */
     void Update(
         GameParameters const & gameParameters,
-        Render::RenderContext const & renderContext);
+        VectorFieldRenderMode vectorFieldRenderMode);
 
+    /*
+     * Renders the world as of the last acquired render snapshots; reads nothing
+     * of the live world.
+     */
     void Render(
         GameParameters const & gameParameters,
-        Render::RenderContext & renderContext) const;
+        Render::RenderContext & renderContext);
+
+    /*
+     * Publishes the state of the world as of the end of the last update, for the
+     * renderer to acquire later - possibly from a different thread. The vector field
+     * render mode tells which vectors to capture.
+     */
+    void PublishRenderSnapshots(VectorFieldRenderMode vectorFieldRenderMode);
+
+    /*
+     * Hands the published render snapshots over to the renderer; to be serialized
+     * with AcquireRenderSnapshots().
+     */
+    void HandOverRenderSnapshots();
+
+    /*
+     * Acquires the render snapshots that have been handed over last; when the
+     * simulation runs on a thread of its own, ship positions may be interpolated
+     * between the last two acquired steps.
+     */
+    void AcquireRenderSnapshots(bool doInterpolateShipPositions);
 
 private:
 
-    void UploadLandAndOcean(
+    void UpdateShip(
+        size_t shipIndex,
         GameParameters const & gameParameters,
-        Render::RenderContext & renderContext) const;
+        VectorFieldRenderMode vectorFieldRenderMode);
 
 private:
 
     // Repository
     std::vector<std::unique_ptr<Ship>> mAllShips;
+    std::vector<std::shared_ptr<GameEventBuffer>> mAllShipGameEventBuffers;
+    std::vector<std::unique_ptr<GameRandomEngine>> mAllShipRandomEngines;
     Stars mStars;
     Clouds mClouds;
     WaterSurface mWaterSurface;
     OceanFloor mOceanFloor;
     Wind mWind;
 
+    // The state of the world - besides the ships - to render
+    WorldRenderSnapshot mRenderSnapshot;
+
     // The current simulation time
     float mCurrentSimulationTime;
 
     // The game event handler
     std::shared_ptr<IGameEventHandler> mGameEventHandler;
+
+    // The threads shared by all simulation tasks
+    std::unique_ptr<ThreadPool> mThreadPool;
 };
 
 }
@@ -0,0 +1,292 @@
+/***************************************************************************************
+* Original Author:		Gabriele Giuseppini
+* Created:				2019-03-28
+* Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+/*
+ * This class holds, for each of a fixed number of nodes, a list of value elements - e.g.
+ * the springs connected to each point.
+ *
+ * The lists of all nodes are stored in a single array, one after the other (a "compressed
+ * sparse row" layout), so that visiting the lists of consecutive nodes streams through
+ * contiguous memory.
+ *
+ * Erasing an element shifts the rest of its list down, leaving a dead slot ("tombstone")
+ * at the end of the list; a list that outgrows its slots is moved to the end of the array,
+ * leaving all of its old slots dead. Dead slots are only reclaimed by Compact(), which
+ * is to be invoked periodically - e.g. whenever IsFragmented().
+ *
+ * Lists returned by the accessors are invalidated by any change to the container.
+ */
+template<typename TElement>
+class AdjacencyList
+{
+public:
+
+    /*
+     * A read-only view of the list of a node.
+     */
+    class List
+    {
+    public:
+
+        inline TElement const * begin() const noexcept
+        {
+            return mElements;
+        }
+
+        inline TElement const * end() const noexcept
+        {
+            return mElements + mSize;
+        }
+
+        inline size_t size() const noexcept
+        {
+            return mSize;
+        }
+
+        inline bool empty() const noexcept
+        {
+            return mSize == 0;
+        }
+
+        inline TElement const & operator[](size_t index) const noexcept
+        {
+            assert(index < mSize);
+            return mElements[index];
+        }
+
+        inline TElement const & front() const noexcept
+        {
+            assert(mSize > 0);
+            return mElements[0];
+        }
+
+        inline TElement const & back() const noexcept
+        {
+            assert(mSize > 0);
+            return mElements[mSize - 1];
+        }
+
+    private:
+
+        friend class AdjacencyList<TElement>;
+
+        List(
+            TElement const * elements,
+            size_t size)
+            : mElements(elements)
+            , mSize(size)
+        {}
+
+        TElement const * const mElements;
+        size_t const mSize;
+    };
+
+public:
+
+    explicit AdjacencyList(size_t nodeCount)
+        : mRanges(nodeCount)
+        , mElements()
+        , mLiveElementCount(0)
+    {
+    }
+
+    AdjacencyList(AdjacencyList const & other) = default;
+
+    AdjacencyList(AdjacencyList && other) = default;
+
+    AdjacencyList & operator=(AdjacencyList && other) = default;
+
+    inline size_t GetNodeCount() const noexcept
+    {
+        return mRanges.size();
+    }
+
+    inline List operator[](size_t node) const noexcept
+    {
+        assert(node < mRanges.size());
+
+        Range const & range = mRanges[node];
+        return List(mElements.data() + range.Start, range.Size);
+    }
+
+    /*
+     * Returns the total number of elements in all lists.
+     */
+    inline size_t GetElementCount() const noexcept
+    {
+        return mLiveElementCount;
+    }
+
+    /*
+     * Returns the number of dead slots in the array.
+     */
+    inline size_t GetTombstoneCount() const noexcept
+    {
+        return mElements.size() - mLiveElementCount;
+    }
+
+    /*
+     * Whether dead slots make up more than a quarter of the array.
+     */
+    inline bool IsFragmented() const noexcept
+    {
+        return GetTombstoneCount() * 4 > mElements.size();
+    }
+
+    void push_back(
+        size_t node,
+        TElement const & element)
+    {
+        assert(node < mRanges.size());
+
+        EnsureRoomForOneMore(node);
+
+        Range & range = mRanges[node];
+        mElements[range.Start + range.Size] = element;
+        ++range.Size;
+
+        ++mLiveElementCount;
+    }
+
+    void push_front(
+        size_t node,
+        TElement const & element)
+    {
+        assert(node < mRanges.size());
+
+        EnsureRoomForOneMore(node);
+
+        Range & range = mRanges[node];
+        std::move_backward(
+            mElements.begin() + range.Start,
+            mElements.begin() + range.Start + range.Size,
+            mElements.begin() + range.Start + range.Size + 1);
+        mElements[range.Start] = element;
+        ++range.Size;
+
+        ++mLiveElementCount;
+    }
+
+    /*
+     * Erases the first element of the list of the node that satisfies the predicate,
+     * preserving the order of the remaining elements.
+     */
+    template<typename UnaryPredicate>
+    bool erase_first(
+        size_t node,
+        UnaryPredicate p)
+    {
+        assert(node < mRanges.size());
+
+        Range & range = mRanges[node];
+
+        auto const listBegin = mElements.begin() + range.Start;
+        auto const listEnd = listBegin + range.Size;
+
+        auto const it = std::find_if(listBegin, listEnd, p);
+        if (it == listEnd)
+            return false;
+
+        // Shift remaining elements, leaving a tombstone at the end
+        std::move(it + 1, listEnd, it);
+        --range.Size;
+
+        --mLiveElementCount;
+
+        return true;
+    }
+
+    /*
+     * Reclaims all dead slots, laying out the lists in node order.
+     */
+    void Compact()
+    {
+        std::vector<TElement> newElements;
+        newElements.reserve(mLiveElementCount);
+
+        for (Range & range : mRanges)
+        {
+            std::uint32_t const newStart = static_cast<std::uint32_t>(newElements.size());
+
+            newElements.insert(
+                newElements.end(),
+                mElements.begin() + range.Start,
+                mElements.begin() + range.Start + range.Size);
+
+            range.Start = newStart;
+            range.Capacity = range.Size;
+        }
+
+        assert(newElements.size() == mLiveElementCount);
+
+        mElements = std::move(newElements);
+    }
+
+private:
+
+    void EnsureRoomForOneMore(size_t node)
+    {
+        Range & range = mRanges[node];
+
+        if (range.Size < range.Capacity)
+        {
+            // There's room already
+            return;
+        }
+
+        if (range.Start + range.Capacity == mElements.size())
+        {
+            // This list is at the end of the array, hence we may simply grow it
+            mElements.emplace_back();
+            ++range.Capacity;
+        }
+        else
+        {
+            // Move the list to the end of the array, making room for more
+            std::uint32_t const newStart = static_cast<std::uint32_t>(mElements.size());
+            std::uint32_t const newCapacity = std::max(std::uint32_t(2), range.Capacity * 2);
+
+            mElements.resize(mElements.size() + newCapacity);
+
+            std::copy(
+                mElements.begin() + range.Start,
+                mElements.begin() + range.Start + range.Size,
+                mElements.begin() + newStart);
+
+            range.Start = newStart;
+            range.Capacity = newCapacity;
+        }
+    }
+
+private:
+
+    // The slots of a node: [Start, Start + Size) are the elements of the list,
+    // [Start + Size, Start + Capacity) are dead
+    struct Range
+    {
+        std::uint32_t Start;
+        std::uint32_t Size;
+        std::uint32_t Capacity;
+
+        Range()
+            : Start(0)
+            , Size(0)
+            , Capacity(0)
+        {}
+    };
+
+    std::vector<Range> mRanges;
+
+    std::vector<TElement> mElements;
+
+    size_t mLiveElementCount;
+};
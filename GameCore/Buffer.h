@@ -48,6 +48,16 @@ public:
             mBuffer[i] = fillValue;
     }
 
+    /*
+     * Makes a copy of a buffer, by bulk-copying its content.
+     */
+    Buffer(Buffer const & other)
+        : Buffer(other.mSize)
+    {
+        std::memcpy(mBuffer, other.mBuffer, mSize * sizeof(TElement));
+        mCurrentPopulatedSize = other.mCurrentPopulatedSize;
+    }
+
     Buffer(Buffer && other)
         : mBuffer(other.mBuffer)
         , mSize(other.mSize)
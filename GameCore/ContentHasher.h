@@ -0,0 +1,62 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-04-04
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+/*
+ * Calculates a 64-bit FNV-1a hash of arbitrary content, for detecting changes
+ * in content; not suitable for anything cryptographic.
+ */
+class ContentHasher
+{
+public:
+
+    ContentHasher()
+        : mHash(OffsetBasis)
+    {}
+
+    void Add(
+        void const * data,
+        size_t size)
+    {
+        unsigned char const * bytes = static_cast<unsigned char const *>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            mHash ^= static_cast<uint64_t>(bytes[i]);
+            mHash *= Prime;
+        }
+    }
+
+    template<typename T>
+    void Add(T const & value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially-copyable values may be hashed as they are");
+
+        Add(&value, sizeof(T));
+    }
+
+    void Add(std::string const & value)
+    {
+        Add(value.size());
+        Add(value.data(), value.size());
+    }
+
+    uint64_t GetHash() const
+    {
+        return mHash;
+    }
+
+private:
+
+    static constexpr uint64_t OffsetBasis = 14695981039346656037ull;
+    static constexpr uint64_t Prime = 1099511628211ull;
+
+    uint64_t mHash;
+};
@@ -0,0 +1,200 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-04-03
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * This class counts durations into logarithmic buckets, from which it calculates
+ * percentiles without having to keep the individual durations.
+ *
+ * Durations are counted in microseconds; each power of two is split into
+ * SubBucketCount linear buckets, hence percentiles are accurate to within
+ * 1/SubBucketCount of their value. Durations longer than the largest bucket are
+ * counted in the largest bucket, while the maximum duration is kept exactly.
+ *
+ * The histogram also counts the durations that exceed a budget.
+ */
+class DurationHistogram
+{
+public:
+
+    struct Statistics
+    {
+        size_t Count;
+        size_t OverBudgetCount;
+        float P50Millis;
+        float P95Millis;
+        float P99Millis;
+        float MaxMillis;
+
+        Statistics()
+            : Count(0)
+            , OverBudgetCount(0)
+            , P50Millis(0.0f)
+            , P95Millis(0.0f)
+            , P99Millis(0.0f)
+            , MaxMillis(0.0f)
+        {}
+    };
+
+public:
+
+    explicit DurationHistogram(std::chrono::steady_clock::duration budget)
+        : mBudgetMicros(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(budget).count()))
+    {
+        Reset();
+    }
+
+    void Record(std::chrono::steady_clock::duration duration)
+    {
+        uint64_t const micros = static_cast<uint64_t>(std::max(
+            std::chrono::duration_cast<std::chrono::microseconds>(duration).count(),
+            std::chrono::microseconds::rep(0)));
+
+        ++mBucketCounts[GetBucketIndex(micros)];
+        ++mCount;
+
+        if (micros > mBudgetMicros)
+            ++mOverBudgetCount;
+
+        mMaxMicros = std::max(mMaxMicros, micros);
+    }
+
+    size_t GetCount() const
+    {
+        return mCount;
+    }
+
+    size_t GetOverBudgetCount() const
+    {
+        return mOverBudgetCount;
+    }
+
+    /*
+     * Returns the duration, in milliseconds, that the specified fraction of the recorded
+     * durations does not exceed.
+     */
+    float GetPercentileMillis(float percentile) const
+    {
+        assert(percentile >= 0.0f && percentile <= 1.0f);
+
+        if (mCount == 0)
+            return 0.0f;
+
+        // The rank of the sought duration, 1-based
+        size_t const rank = std::clamp(
+            static_cast<size_t>(std::ceil(percentile * static_cast<float>(mCount))),
+            size_t(1),
+            mCount);
+
+        size_t cumulativeCount = 0;
+        for (size_t b = 0; b < BucketCount; ++b)
+        {
+            cumulativeCount += mBucketCounts[b];
+            if (cumulativeCount >= rank)
+            {
+                // Report the upper end of the bucket, but never more than what we've seen;
+                // the last bucket has no upper end
+                return b < BucketCount - 1
+                    ? MicrosToMillis(std::min(GetBucketUpperBoundMicros(b), mMaxMicros))
+                    : MicrosToMillis(mMaxMicros);
+            }
+        }
+
+        assert(false);
+        return MicrosToMillis(mMaxMicros);
+    }
+
+    float GetMaxMillis() const
+    {
+        return MicrosToMillis(mMaxMicros);
+    }
+
+    Statistics GetStatistics() const
+    {
+        Statistics statistics;
+
+        statistics.Count = mCount;
+        statistics.OverBudgetCount = mOverBudgetCount;
+        statistics.P50Millis = GetPercentileMillis(0.50f);
+        statistics.P95Millis = GetPercentileMillis(0.95f);
+        statistics.P99Millis = GetPercentileMillis(0.99f);
+        statistics.MaxMillis = GetMaxMillis();
+
+        return statistics;
+    }
+
+    void Reset()
+    {
+        mBucketCounts.fill(0);
+        mCount = 0;
+        mOverBudgetCount = 0;
+        mMaxMicros = 0;
+    }
+
+private:
+
+    static constexpr size_t SubBucketBits = 3;
+    static constexpr size_t SubBucketCount = 1 << SubBucketBits;
+
+    // Enough for durations of up to 2^(SubBucketBits + ExponentCount) microseconds, i.e. ~268 seconds
+    static constexpr size_t ExponentCount = 25;
+
+    static constexpr size_t BucketCount = SubBucketCount + ExponentCount * SubBucketCount;
+
+    static inline size_t GetBucketIndex(uint64_t micros)
+    {
+        // The first SubBucketCount buckets are one microsecond each
+        if (micros < SubBucketCount)
+            return static_cast<size_t>(micros);
+
+        // Position of the most significant bit
+        size_t msb = 0;
+        for (uint64_t v = micros; v > 1; v >>= 1)
+            ++msb;
+
+        size_t const exponent = msb - SubBucketBits;
+        if (exponent >= ExponentCount)
+            return BucketCount - 1;
+
+        // Between SubBucketCount and 2 * SubBucketCount - 1
+        size_t const mantissa = static_cast<size_t>(micros >> exponent);
+
+        return SubBucketCount + exponent * SubBucketCount + (mantissa - SubBucketCount);
+    }
+
+    static inline uint64_t GetBucketUpperBoundMicros(size_t bucketIndex)
+    {
+        if (bucketIndex < SubBucketCount)
+            return static_cast<uint64_t>(bucketIndex);
+
+        size_t const exponent = (bucketIndex - SubBucketCount) / SubBucketCount;
+        uint64_t const mantissa = static_cast<uint64_t>(SubBucketCount + (bucketIndex - SubBucketCount) % SubBucketCount);
+
+        return ((mantissa + 1) << exponent) - 1;
+    }
+
+    static inline float MicrosToMillis(uint64_t micros)
+    {
+        return static_cast<float>(micros) / 1000.0f;
+    }
+
+private:
+
+    uint64_t const mBudgetMicros;
+
+    std::array<size_t, BucketCount> mBucketCounts;
+    size_t mCount;
+    size_t mOverBudgetCount;
+    uint64_t mMaxMicros;
+};
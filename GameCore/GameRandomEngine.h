@@ -5,6 +5,7 @@
 ***************************************************************************************/
 #pragma once
 
+#include <cstdint>
 #include <random>
 /*
  * The random engine for the entire game.
@@ -12,7 +13,9 @@
  * Not so random - always uses the same seed. On purpose! We want two instances
  * of the game to be identical to each other.
  *
- * Singleton.
+ * Singleton; however, a thread may temporarily replace the singleton with a
+ * private instance (see ThreadInstanceScope), so that work running on multiple
+ * threads remains both thread-safe and reproducible.
  */
 class GameRandomEngine
 {
@@ -20,11 +23,52 @@ public:
 
     static GameRandomEngine & GetInstance()
     {
+        GameRandomEngine * const threadInstance = GetThreadInstance();
+        if (nullptr != threadInstance)
+            return *threadInstance;
+
         static GameRandomEngine * instance = new GameRandomEngine();
 
         return *instance;
     }
 
+    /*
+     * Makes GetInstance() return the specified instance on the current thread,
+     * for as long as the scope is alive.
+     */
+    class ThreadInstanceScope
+    {
+    public:
+
+        explicit ThreadInstanceScope(GameRandomEngine & instance)
+            : mPreviousInstance(GetThreadInstance())
+        {
+            GetThreadInstance() = &instance;
+        }
+
+        ~ThreadInstanceScope()
+        {
+            GetThreadInstance() = mPreviousInstance;
+        }
+
+        ThreadInstanceScope(ThreadInstanceScope const & other) = delete;
+        ThreadInstanceScope & operator=(ThreadInstanceScope const & other) = delete;
+
+    private:
+
+        GameRandomEngine * const mPreviousInstance;
+    };
+
+    /*
+     * Creates a private instance, whose sequence is determined by the specified seed.
+     */
+    explicit GameRandomEngine(uint32_t seed)
+    {
+        std::seed_seq seed_seq({ uint32_t(1), uint32_t(242), uint32_t(19730528), seed });
+        mRandomEngine = std::ranlux48_base(seed_seq);
+        mRandomUniformDistribution = std::uniform_real_distribution<float>(0.0f, 1.0f);
+    }
+
     /*
      * Returns a value between 0 and count - 1, included.
      */
@@ -103,6 +147,13 @@ public:
 
 private:
 
+    static GameRandomEngine * & GetThreadInstance()
+    {
+        static thread_local GameRandomEngine * threadInstance = nullptr;
+
+        return threadInstance;
+    }
+
     GameRandomEngine()
     {
         std::seed_seq seed_seq({ 1, 242, 19730528 });
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <chrono>
+#include <mutex>
 #include <optional>
 
 /*
@@ -13,6 +14,8 @@
  *
  * Note: it's not really a wall clock - its values do not measure time.
  *
+ * Thread-safe, as the simulation may run on a thread other than the one that pauses it.
+ *
  * Singleton.
  */
 class GameWallClock
@@ -33,16 +36,9 @@ public:
 
     inline time_point Now() const
     {
-        if (!!mLastResumeTime)
-        {
-            // We're running
-            return mLastPauseTime + (std::chrono::steady_clock::now() - *mLastResumeTime);
-        }
-        else
-        {
-            // We're paused
-            return mLastPauseTime;
-        }
+        std::lock_guard<std::mutex> const lock(mMutex);
+
+        return UnlockedNow();
     }
 
     inline duration Elapsed(time_point previousTimePoint) const
@@ -52,11 +48,13 @@ public:
 
     void SetPaused(bool isPaused)
     {
+        std::lock_guard<std::mutex> const lock(mMutex);
+
         if (isPaused)
         {
             if (!!mLastResumeTime)
             {
-                mLastPauseTime = Now();
+                mLastPauseTime = UnlockedNow();
                 mLastResumeTime.reset();
             }
         }
@@ -71,13 +69,30 @@ public:
 
 private:
 
+    inline time_point UnlockedNow() const
+    {
+        if (!!mLastResumeTime)
+        {
+            // We're running
+            return mLastPauseTime + (std::chrono::steady_clock::now() - *mLastResumeTime);
+        }
+        else
+        {
+            // We're paused
+            return mLastPauseTime;
+        }
+    }
+
     GameWallClock()
         : mLastPauseTime(std::chrono::steady_clock::now())
         , mLastResumeTime(mLastPauseTime)
+        , mMutex()
     {
 
     }
 
     time_point mLastPauseTime;
     std::optional<time_point> mLastResumeTime;
+
+    mutable std::mutex mMutex;
 };
@@ -8,6 +8,7 @@
 #include "Colors.h"
 #include "ImageSize.h"
 
+#include <algorithm>
 #include <memory>
 
 template <typename TColor>
@@ -44,6 +45,16 @@ public:
         , Data(std::move(other.Data))
     {
     }
+
+    ImageData Clone() const
+    {
+        size_t const linearSize = static_cast<size_t>(Size.Width) * static_cast<size_t>(Size.Height);
+
+        auto clonedData = std::make_unique<color_type[]>(linearSize);
+        std::copy(Data.get(), Data.get() + linearSize, clonedData.get());
+
+        return ImageData(Size, std::move(clonedData));
+    }
 };
 
 using RgbImageData = ImageData<rgbColor>;
@@ -0,0 +1,22 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2018-12-02
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+/*
+ * Single point of inclusion for libsimdpp, so that all of our vectorized code
+ * is compiled against the same instruction set.
+ *
+ * SSE2 is the minimum we require; SSSE3 may be enabled from the build.
+ */
+
+#if !defined(SIMDPP_ARCH_X86_SSE2) && !defined(SIMDPP_ARCH_X86_SSSE3)
+#define SIMDPP_ARCH_X86_SSE2
+#endif
+
+#include "simdpp/simd.h"
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
@@ -0,0 +1,155 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-04-01
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cassert>
+
+std::vector<Profiler::PhaseStatistics> Profiler::GetStatistics() const
+{
+    std::vector<PhaseStatistics> statistics;
+
+    std::vector<float> sortedMillis;
+
+    std::lock_guard<std::mutex> const lock(mMutex);
+
+    for (size_t p = 0; p < PhaseCount; ++p)
+    {
+        //
+        // Merge the windows of all threads; a writer might be in the middle of
+        // recording a sample, which goes into the slot of the oldest sample, hence
+        // we skip that slot once the window has wrapped
+        //
+
+        sortedMillis.clear();
+
+        for (auto const & threadSamples : mThreadSamples)
+        {
+            auto const & phaseSamples = threadSamples->Phases[p];
+
+            uint64_t const writeCount = phaseSamples.WriteCount.load(std::memory_order_acquire);
+            uint64_t const firstSample = std::max(
+                phaseSamples.ReadStart.load(std::memory_order_relaxed),
+                writeCount >= WindowSize ? writeCount - WindowSize + 1 : 0);
+
+            for (uint64_t s = firstSample; s < writeCount; ++s)
+            {
+                sortedMillis.push_back(phaseSamples.Millis[s % WindowSize].load(std::memory_order_relaxed));
+            }
+        }
+
+        if (sortedMillis.empty())
+            continue;
+
+        std::sort(sortedMillis.begin(), sortedMillis.end());
+
+        float totalMillis = 0.0f;
+        for (float millis : sortedMillis)
+            totalMillis += millis;
+
+        size_t const p95Index = std::min(
+            sortedMillis.size() * 95 / 100,
+            sortedMillis.size() - 1);
+
+        statistics.emplace_back(
+            static_cast<ProfilePhase>(p),
+            sortedMillis.front(),
+            totalMillis / static_cast<float>(sortedMillis.size()),
+            sortedMillis[p95Index],
+            sortedMillis.back());
+    }
+
+    return statistics;
+}
+
+void Profiler::Reset()
+{
+    std::lock_guard<std::mutex> const lock(mMutex);
+
+    for (auto & threadSamples : mThreadSamples)
+    {
+        for (auto & phaseSamples : threadSamples->Phases)
+        {
+            phaseSamples.ReadStart.store(
+                phaseSamples.WriteCount.load(std::memory_order_acquire),
+                std::memory_order_relaxed);
+        }
+    }
+}
+
+Profiler::ThreadSamples * Profiler::RegisterCurrentThread()
+{
+    std::lock_guard<std::mutex> const lock(mMutex);
+
+    if (!mFreeThreadSamples.empty())
+    {
+        ThreadSamples * const threadSamples = mFreeThreadSamples.back();
+        mFreeThreadSamples.pop_back();
+
+        return threadSamples;
+    }
+
+    mThreadSamples.emplace_back(new ThreadSamples());
+
+    return mThreadSamples.back().get();
+}
+
+void Profiler::UnregisterThread(ThreadSamples * threadSamples)
+{
+    std::lock_guard<std::mutex> const lock(mMutex);
+
+    mFreeThreadSamples.push_back(threadSamples);
+}
+
+char const * Profiler::GetPhaseName(ProfilePhase phase)
+{
+    switch (phase)
+    {
+        case ProfilePhase::WorldUpdate:
+            return "World Update";
+        case ProfilePhase::ShipUpdate:
+            return "Ship Update";
+        case ProfilePhase::MechanicalDynamics:
+            return "Mechanics";
+        case ProfilePhase::Bombs:
+            return "Bombs";
+        case ProfilePhase::Strains:
+            return "Strains";
+        case ProfilePhase::WaterDynamics:
+            return "Water";
+        case ProfilePhase::Sleep:
+            return "Sleep";
+        case ProfilePhase::ElectricalDynamics:
+            return "Electricals";
+        case ProfilePhase::EphemeralParticles:
+            return "Ephemerals";
+        case ProfilePhase::SpatialIndices:
+            return "Spatial Indices";
+        case ProfilePhase::WorldRender:
+            return "World Render";
+        case ProfilePhase::SkyDraw:
+            return "Sky Draw";
+        case ProfilePhase::LandAndOceanUpload:
+            return "Land/Ocean Upload";
+        case ProfilePhase::OceanDraw:
+            return "Ocean Draw";
+        case ProfilePhase::LandDraw:
+            return "Land Draw";
+        case ProfilePhase::ShipRender:
+            return "Ship Render";
+        case ProfilePhase::ConnectivityVisit:
+            return "Connectivity";
+        case ProfilePhase::ShipPointsUpload:
+            return "Points Upload";
+        case ProfilePhase::ShipElementsUpload:
+            return "Elements Upload";
+        case ProfilePhase::ShipDraw:
+            return "Ship Draw";
+    }
+
+    assert(false);
+    return "";
+}
@@ -0,0 +1,306 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-04-01
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "TraceRecorder.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*
+ * The phases of the simulation and of the rendering that we time.
+ */
+enum class ProfilePhase : size_t
+{
+    // Simulation
+    WorldUpdate = 0,
+    ShipUpdate,
+    MechanicalDynamics,
+    Bombs,
+    Strains,
+    WaterDynamics,
+    Sleep,
+    ElectricalDynamics,
+    EphemeralParticles,
+    SpatialIndices,
+
+    // Rendering
+    WorldRender,
+    SkyDraw,
+    LandAndOceanUpload,
+    OceanDraw,
+    LandDraw,
+    ShipRender,
+    ConnectivityVisit,
+    ShipPointsUpload,
+    ShipElementsUpload,
+    ShipDraw,
+
+    _Last = ShipDraw
+};
+
+/*
+ * Collects the durations of the profiled phases, and maintains rolling statistics
+ * over the last samples of each phase.
+ *
+ * Phases are timed with PROFILE_PHASE, which only feeds the profiler when ENABLE_PROFILING
+ * is defined; when it's not, the profiler simply never gets any samples, while the trace
+ * recorder still gets the phases' executions whenever it is recording.
+ *
+ * Draw phases only measure the time it takes to submit the draw calls, as the GPU
+ * executes them asynchronously.
+ *
+ * Thread-safe, as phases run on the simulation threads and on the render thread; each
+ * thread records into its own slots, which only that thread writes to, hence recording a
+ * sample takes no locks. Statistics merge the samples of all threads at reading time.
+ *
+ * Singleton.
+ */
+class Profiler
+{
+public:
+
+    struct PhaseStatistics
+    {
+        ProfilePhase Phase;
+        float MinMillis;
+        float MeanMillis;
+        float P95Millis;
+        float MaxMillis;
+
+        PhaseStatistics(
+            ProfilePhase phase,
+            float minMillis,
+            float meanMillis,
+            float p95Millis,
+            float maxMillis)
+            : Phase(phase)
+            , MinMillis(minMillis)
+            , MeanMillis(meanMillis)
+            , P95Millis(p95Millis)
+            , MaxMillis(maxMillis)
+        {}
+    };
+
+public:
+
+    static Profiler & GetInstance()
+    {
+        static Profiler * instance = new Profiler();
+
+        return *instance;
+    }
+
+    inline void RecordSample(
+        ProfilePhase phase,
+        std::chrono::steady_clock::duration duration)
+    {
+        GetCurrentThreadSamples().Record(
+            phase,
+            std::chrono::duration<float, std::milli>(duration).count());
+    }
+
+    /*
+     * Returns the statistics of the phases that have samples, in phase order; the statistics
+     * of each phase are calculated on the most recent samples of each thread.
+     */
+    std::vector<PhaseStatistics> GetStatistics() const;
+
+    /*
+     * Discards all samples recorded so far.
+     */
+    void Reset();
+
+    static char const * GetPhaseName(ProfilePhase phase);
+
+    // The number of most recent samples of each thread that statistics are calculated on
+    static constexpr size_t WindowSize = 128;
+
+private:
+
+    Profiler()
+        : mThreadSamples()
+        , mFreeThreadSamples()
+        , mMutex()
+    {}
+
+    static constexpr size_t PhaseCount = static_cast<size_t>(ProfilePhase::_Last) + 1;
+
+    struct PhaseSamples
+    {
+        std::array<std::atomic<float>, WindowSize> Millis;
+
+        // The number of samples ever recorded; the next sample goes at WriteCount % WindowSize
+        std::atomic<uint64_t> WriteCount;
+
+        // Samples before this one have been discarded by a reset
+        std::atomic<uint64_t> ReadStart;
+
+        PhaseSamples()
+            : WriteCount(0)
+            , ReadStart(0)
+        {
+            for (auto & millis : Millis)
+                millis.store(0.0f, std::memory_order_relaxed);
+        }
+    };
+
+    struct ThreadSamples
+    {
+        std::array<PhaseSamples, PhaseCount> Phases;
+
+        // Invoked only by the thread owning the samples
+        inline void Record(
+            ProfilePhase phase,
+            float millis)
+        {
+            auto & phaseSamples = Phases[static_cast<size_t>(phase)];
+
+            uint64_t const writeCount = phaseSamples.WriteCount.load(std::memory_order_relaxed);
+
+            phaseSamples.Millis[writeCount % WindowSize].store(millis, std::memory_order_relaxed);
+
+            // Publish the sample
+            phaseSamples.WriteCount.store(writeCount + 1, std::memory_order_release);
+        }
+    };
+
+    /*
+     * Holds the samples of a thread for as long as the thread lives, giving them back
+     * to the profiler - for other threads to re-use - when the thread exits.
+     */
+    struct ThreadSamplesHolder
+    {
+        ThreadSamples * Samples;
+
+        ThreadSamplesHolder()
+            : Samples(nullptr)
+        {}
+
+        ~ThreadSamplesHolder()
+        {
+            if (nullptr != Samples)
+                Profiler::GetInstance().UnregisterThread(Samples);
+        }
+    };
+
+    ThreadSamples & GetCurrentThreadSamples()
+    {
+        static thread_local ThreadSamplesHolder threadSamplesHolder;
+
+        if (nullptr == threadSamplesHolder.Samples)
+            threadSamplesHolder.Samples = RegisterCurrentThread();
+
+        return *(threadSamplesHolder.Samples);
+    }
+
+    ThreadSamples * RegisterCurrentThread();
+
+    void UnregisterThread(ThreadSamples * threadSamples);
+
+private:
+
+    // Owned here, as threads might go away before statistics are read; the samples
+    // of threads that went away are re-used by new threads, keeping their samples
+    std::vector<std::unique_ptr<ThreadSamples>> mThreadSamples;
+    std::vector<ThreadSamples *> mFreeThreadSamples;
+
+    // Guards the registration of threads, and the reading and resetting of samples
+    mutable std::mutex mMutex;
+};
+
+/*
+ * Times the scope it lives in, recording the duration with the profiler - and the
+ * execution with the trace recorder - at scope exit.
+ */
+class ScopedPhaseTimer
+{
+public:
+
+    explicit ScopedPhaseTimer(ProfilePhase phase)
+        : mPhase(phase)
+        , mStartTime(std::chrono::steady_clock::now())
+    {}
+
+    ~ScopedPhaseTimer()
+    {
+        auto const endTime = std::chrono::steady_clock::now();
+
+        Profiler::GetInstance().RecordSample(
+            mPhase,
+            endTime - mStartTime);
+
+        TraceRecorder::GetInstance().RecordEvent(
+            mPhase,
+            mStartTime,
+            endTime);
+    }
+
+    ScopedPhaseTimer(ScopedPhaseTimer const & other) = delete;
+    ScopedPhaseTimer & operator=(ScopedPhaseTimer const & other) = delete;
+
+private:
+
+    ProfilePhase const mPhase;
+    std::chrono::steady_clock::time_point const mStartTime;
+};
+
+/*
+ * Records the execution of the scope it lives in with the trace recorder, only
+ * if the recorder is recording; used in place of ScopedPhaseTimer when profiling
+ * is not compiled in, so that traces may still be recorded.
+ */
+class ScopedTraceTimer
+{
+public:
+
+    explicit ScopedTraceTimer(ProfilePhase phase)
+        : mPhase(phase)
+        , mIsRecording(TraceRecorder::GetInstance().IsRecording())
+        , mStartTime(mIsRecording ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point())
+    {}
+
+    ~ScopedTraceTimer()
+    {
+        if (mIsRecording)
+        {
+            TraceRecorder::GetInstance().RecordEvent(
+                mPhase,
+                mStartTime,
+                std::chrono::steady_clock::now());
+        }
+    }
+
+    ScopedTraceTimer(ScopedTraceTimer const & other) = delete;
+    ScopedTraceTimer & operator=(ScopedTraceTimer const & other) = delete;
+
+private:
+
+    ProfilePhase const mPhase;
+    bool const mIsRecording;
+    std::chrono::steady_clock::time_point const mStartTime;
+};
+
+#define PROFILE_PHASE_CONCAT_INNER(a, b) a##b
+#define PROFILE_PHASE_CONCAT(a, b) PROFILE_PHASE_CONCAT_INNER(a, b)
+
+#ifdef ENABLE_PROFILING
+
+#define PROFILE_PHASE(phase) \
+    ScopedPhaseTimer const PROFILE_PHASE_CONCAT(_scopedPhaseTimer, __LINE__)(ProfilePhase::phase)
+
+#else
+
+#define PROFILE_PHASE(phase) \
+    ScopedTraceTimer const PROFILE_PHASE_CONCAT(_scopedTraceTimer, __LINE__)(ProfilePhase::phase)
+
+#endif
@@ -0,0 +1,310 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-03-24
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "ThreadPool.h"
+
+#include "TraceRecorder.h"
+
+#include <string>
+
+namespace /* anonymous */ {
+
+    // The pool that the current thread belongs to, if any, and its queue in that pool
+    thread_local ThreadPool const * tCurrentPool = nullptr;
+    thread_local size_t tCurrentQueueIndex = 0;
+}
+
+ThreadPool::ThreadPool(size_t parallelism)
+    : mThreads()
+    , mQueues()
+    , mQueuedItemCount(0)
+    , mSignalLock()
+    , mSignal()
+    , mIsStop(false)
+{
+    assert(parallelism > 0);
+
+    for (size_t q = 0; q < parallelism; ++q)
+    {
+        mQueues.emplace_back(new WorkQueue());
+    }
+
+    for (size_t t = 1; t < parallelism; ++t)
+    {
+        mThreads.emplace_back(&ThreadPool::ThreadLoop, this, t);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mSignalLock);
+        mIsStop = true;
+    }
+
+    mSignal.notify_all();
+
+    for (auto & thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::Run(std::vector<Task> const & tasks)
+{
+    if (tasks.empty())
+        return;
+
+    if (mThreads.empty() || tasks.size() == 1)
+    {
+        // Run inline, no point in waking anyone up
+        RunInline(
+            tasks.size(),
+            [&tasks](size_t t)
+            {
+                tasks[t]();
+            });
+
+        return;
+    }
+
+    TaskGroup taskGroup(tasks.size());
+
+    for (auto const & task : tasks)
+    {
+        Submit(
+            WorkItem(
+                [&task]()
+                {
+                    task();
+                },
+                &taskGroup));
+    }
+
+    Wait(taskGroup);
+}
+
+void ThreadPool::Run(TaskGraph & taskGraph)
+{
+    if (taskGraph.mNodes.empty())
+        return;
+
+    if (mThreads.empty())
+    {
+        // Run inline; the insertion order is a topological order
+        RunInline(
+            taskGraph.mNodes.size(),
+            [&taskGraph](size_t t)
+            {
+                taskGraph.mNodes[t]->Function();
+            });
+
+        return;
+    }
+
+    // Reset dependency counts from previous runs
+    for (auto & node : taskGraph.mNodes)
+    {
+        node->PendingDependencyCount = node->DependencyCount;
+    }
+
+    TaskGroup taskGroup(taskGraph.mNodes.size());
+
+    // Kick off roots
+    for (TaskGraph::TaskId taskId = 0; taskId < taskGraph.mNodes.size(); ++taskId)
+    {
+        if (0 == taskGraph.mNodes[taskId]->DependencyCount)
+        {
+            SubmitGraphTask(taskGraph, taskId, taskGroup);
+        }
+    }
+
+    Wait(taskGroup);
+}
+
+void ThreadPool::ThreadLoop(size_t queueIndex)
+{
+    tCurrentPool = this;
+    tCurrentQueueIndex = queueIndex;
+
+    TraceRecorder::GetInstance().SetCurrentThreadName("Worker " + std::to_string(queueIndex));
+
+    while (true)
+    {
+        WorkItem workItem;
+        if (TryPop(queueIndex, workItem))
+        {
+            Execute(workItem);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mSignalLock);
+
+        mSignal.wait(
+            lock,
+            [this]()
+            {
+                return mIsStop || mQueuedItemCount > 0;
+            });
+
+        if (mIsStop)
+            break;
+    }
+}
+
+size_t ThreadPool::GetCurrentQueueIndex() const
+{
+    return (tCurrentPool == this) ? tCurrentQueueIndex : 0;
+}
+
+void ThreadPool::Submit(WorkItem && workItem)
+{
+    auto & queue = *(mQueues[GetCurrentQueueIndex()]);
+
+    {
+        std::lock_guard<std::mutex> lock(queue.Lock);
+        queue.Items.emplace_back(std::move(workItem));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mSignalLock);
+        ++mQueuedItemCount;
+    }
+
+    mSignal.notify_one();
+}
+
+bool ThreadPool::TryPop(
+    size_t queueIndex,
+    WorkItem & workItem)
+{
+    if (0 == mQueuedItemCount)
+        return false;
+
+    // Own queue first, newest item first
+    {
+        auto & queue = *(mQueues[queueIndex]);
+
+        std::lock_guard<std::mutex> lock(queue.Lock);
+        if (!queue.Items.empty())
+        {
+            workItem = std::move(queue.Items.back());
+            queue.Items.pop_back();
+            --mQueuedItemCount;
+            return true;
+        }
+    }
+
+    // Steal from others, oldest item first
+    for (size_t i = 1; i < mQueues.size(); ++i)
+    {
+        auto & queue = *(mQueues[(queueIndex + i) % mQueues.size()]);
+
+        std::lock_guard<std::mutex> lock(queue.Lock);
+        if (!queue.Items.empty())
+        {
+            workItem = std::move(queue.Items.front());
+            queue.Items.pop_front();
+            --mQueuedItemCount;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::Execute(WorkItem & workItem)
+{
+    assert(nullptr != workItem.Group);
+
+    TaskGroup & taskGroup = *(workItem.Group);
+
+    try
+    {
+        workItem.Function();
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(taskGroup.ExceptionLock);
+        if (!taskGroup.Exception)
+            taskGroup.Exception = std::current_exception();
+    }
+
+    if (1 == taskGroup.PendingTaskCount.fetch_sub(1))
+    {
+        // Last task of the group, wake up the waiter
+        {
+            std::lock_guard<std::mutex> lock(mSignalLock);
+        }
+
+        mSignal.notify_all();
+    }
+}
+
+void ThreadPool::Wait(TaskGroup & taskGroup)
+{
+    size_t const queueIndex = GetCurrentQueueIndex();
+
+    while (taskGroup.PendingTaskCount > 0)
+    {
+        // Help out
+        WorkItem workItem;
+        if (TryPop(queueIndex, workItem))
+        {
+            Execute(workItem);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mSignalLock);
+
+        mSignal.wait(
+            lock,
+            [this, &taskGroup]()
+            {
+                return 0 == taskGroup.PendingTaskCount || mQueuedItemCount > 0;
+            });
+    }
+
+    if (taskGroup.Exception)
+    {
+        std::rethrow_exception(taskGroup.Exception);
+    }
+}
+
+void ThreadPool::SubmitGraphTask(
+    TaskGraph & taskGraph,
+    TaskGraph::TaskId taskId,
+    TaskGroup & taskGroup)
+{
+    Submit(
+        WorkItem(
+            [this, &taskGraph, taskId, &taskGroup]()
+            {
+                auto & node = *(taskGraph.mNodes[taskId]);
+
+                // Successors are released also when this task throws
+                struct SuccessorReleaser
+                {
+                    ThreadPool & Pool;
+                    TaskGraph & Graph;
+                    TaskGraph::Node const & Node;
+                    TaskGroup & Group;
+
+                    ~SuccessorReleaser()
+                    {
+                        for (TaskGraph::TaskId successorId : Node.Successors)
+                        {
+                            if (1 == Graph.mNodes[successorId]->PendingDependencyCount.fetch_sub(1))
+                            {
+                                Pool.SubmitGraphTask(Graph, successorId, Group);
+                            }
+                        }
+                    }
+                } successorReleaser{ *this, taskGraph, node, taskGroup };
+
+                node.Function();
+            },
+            &taskGroup));
+}
@@ -0,0 +1,298 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-03-24
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "ElementContainer.h"
+#include "GameTypes.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * A fixed-size pool of threads with work stealing.
+ *
+ * Each pool thread owns a queue of tasks; tasks submitted from a pool thread go to its
+ * own queue, while tasks submitted from any other thread go to a shared queue. Threads
+ * pick tasks from the back of their own queue first and, when that is empty, steal tasks
+ * from the front of the other queues.
+ *
+ * All of the Run() flavors block until their tasks have completed; while waiting, the
+ * calling thread takes part in the execution of tasks - hence a pool with parallelism N
+ * only spawns N-1 threads, and tasks may safely Run() more tasks on the same pool.
+ *
+ * If any of the tasks throws, one of the exceptions is re-thrown by Run() after all
+ * of the tasks have completed.
+ */
+class ThreadPool
+{
+public:
+
+    using Task = std::function<void()>;
+
+    /*
+     * A set of tasks with dependencies among them.
+     *
+     * A task may only depend on tasks added before it, which guarantees that the graph
+     * is acyclic. The graph may be run any number of times.
+     */
+    class TaskGraph
+    {
+    public:
+
+        using TaskId = size_t;
+
+        TaskId AddTask(
+            Task task,
+            std::vector<TaskId> const & dependencies = {})
+        {
+            TaskId const taskId = mNodes.size();
+
+            mNodes.emplace_back(new Node(std::move(task), dependencies.size()));
+
+            for (TaskId dependency : dependencies)
+            {
+                assert(dependency < taskId);
+                mNodes[dependency]->Successors.push_back(taskId);
+            }
+
+            return taskId;
+        }
+
+        size_t GetTaskCount() const
+        {
+            return mNodes.size();
+        }
+
+    private:
+
+        friend class ThreadPool;
+
+        struct Node
+        {
+            Task Function;
+            std::vector<TaskId> Successors;
+            size_t const DependencyCount;
+            std::atomic<size_t> PendingDependencyCount;
+
+            Node(
+                Task && function,
+                size_t dependencyCount)
+                : Function(std::move(function))
+                , Successors()
+                , DependencyCount(dependencyCount)
+                , PendingDependencyCount(dependencyCount)
+            {}
+        };
+
+        std::vector<std::unique_ptr<Node>> mNodes;
+    };
+
+public:
+
+    explicit ThreadPool(size_t parallelism);
+
+    ~ThreadPool();
+
+    ThreadPool(ThreadPool const & other) = delete;
+    ThreadPool & operator=(ThreadPool const & other) = delete;
+
+    size_t GetParallelism() const
+    {
+        return mThreads.size() + 1;
+    }
+
+    /*
+     * Runs the specified independent tasks.
+     */
+    void Run(std::vector<Task> const & tasks);
+
+    /*
+     * Runs the tasks of the specified graph, starting each task only after
+     * all of its dependencies have completed.
+     */
+    void Run(TaskGraph & taskGraph);
+
+    /*
+     * Invokes the body on chunks of the [startIndex, endIndex) range, in parallel.
+     *
+     * The body is invoked as body(chunkStartIndex, chunkEndIndex); chunks are never
+     * smaller than minChunkSize elements, except for the last one.
+     */
+    template <typename TBody>
+    void ParallelFor(
+        ElementIndex startIndex,
+        ElementIndex endIndex,
+        ElementCount minChunkSize,
+        TBody const & body)
+    {
+        assert(startIndex <= endIndex);
+        assert(minChunkSize > 0);
+
+        ElementCount const count = endIndex - startIndex;
+
+        // Make a few more chunks than threads, so that stealing can even out imbalances
+        ElementCount const chunkCount = std::max(
+            ElementCount(1),
+            std::min(
+                static_cast<ElementCount>(GetParallelism() * ChunksPerThread),
+                count / minChunkSize));
+
+        if (chunkCount == 1)
+        {
+            if (count > 0)
+                body(startIndex, endIndex);
+
+            return;
+        }
+
+        std::vector<Task> tasks;
+        tasks.reserve(chunkCount);
+
+        for (ElementCount c = 0; c < chunkCount; ++c)
+        {
+            ElementIndex const chunkStartIndex = startIndex + static_cast<ElementIndex>(static_cast<uint64_t>(count) * c / chunkCount);
+            ElementIndex const chunkEndIndex = startIndex + static_cast<ElementIndex>(static_cast<uint64_t>(count) * (c + 1) / chunkCount);
+
+            tasks.emplace_back(
+                [&body, chunkStartIndex, chunkEndIndex]()
+                {
+                    body(chunkStartIndex, chunkEndIndex);
+                });
+        }
+
+        Run(tasks);
+    }
+
+    /*
+     * Invokes the body on chunks of the indices of the specified container, in parallel.
+     */
+    template <typename TBody>
+    void ParallelFor(
+        ElementContainer const & container,
+        ElementCount minChunkSize,
+        TBody const & body)
+    {
+        ParallelFor(0, container.GetElementCount(), minChunkSize, body);
+    }
+
+private:
+
+    static constexpr size_t ChunksPerThread = 4;
+
+    // The state shared by all the tasks of a Run()
+    struct TaskGroup
+    {
+        std::atomic<size_t> PendingTaskCount;
+
+        std::mutex ExceptionLock;
+        std::exception_ptr Exception;
+
+        explicit TaskGroup(size_t taskCount)
+            : PendingTaskCount(taskCount)
+            , ExceptionLock()
+            , Exception()
+        {}
+    };
+
+    struct WorkItem
+    {
+        Task Function;
+        TaskGroup * Group;
+
+        WorkItem()
+            : Function()
+            , Group(nullptr)
+        {}
+
+        WorkItem(
+            Task && function,
+            TaskGroup * group)
+            : Function(std::move(function))
+            , Group(group)
+        {}
+    };
+
+    struct WorkQueue
+    {
+        std::mutex Lock;
+        std::deque<WorkItem> Items;
+    };
+
+private:
+
+    template <typename TTaskRunner>
+    static void RunInline(
+        size_t taskCount,
+        TTaskRunner const & taskRunner)
+    {
+        std::exception_ptr exception;
+
+        for (size_t t = 0; t < taskCount; ++t)
+        {
+            try
+            {
+                taskRunner(t);
+            }
+            catch (...)
+            {
+                if (!exception)
+                    exception = std::current_exception();
+            }
+        }
+
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    void ThreadLoop(size_t queueIndex);
+
+    size_t GetCurrentQueueIndex() const;
+
+    void Submit(WorkItem && workItem);
+
+    bool TryPop(
+        size_t queueIndex,
+        WorkItem & workItem);
+
+    void Execute(WorkItem & workItem);
+
+    void Wait(TaskGroup & taskGroup);
+
+    void SubmitGraphTask(
+        TaskGraph & taskGraph,
+        TaskGraph::TaskId taskId,
+        TaskGroup & taskGroup);
+
+private:
+
+    std::vector<std::thread> mThreads;
+
+    // Queue 0 is shared among all threads that are not pool threads;
+    // queue i (i > 0) belongs to pool thread i
+    std::vector<std::unique_ptr<WorkQueue>> mQueues;
+
+    // The number of work items currently queued, in any queue
+    std::atomic<size_t> mQueuedItemCount;
+
+    // Sleeping threads - both pool threads and waiters - are woken up via
+    // this signal whenever new work is available or a task group completes
+    std::mutex mSignalLock;
+    std::condition_variable mSignal;
+
+    bool mIsStop;
+};
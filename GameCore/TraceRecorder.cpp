@@ -0,0 +1,142 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-04-02
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "TraceRecorder.h"
+
+#include "Profiler.h"
+#include "Utils.h"
+
+#include <iomanip>
+#include <sstream>
+
+void TraceRecorder::StartRecording()
+{
+    std::lock_guard<std::mutex> const lock(mMutex);
+
+    mRecordingStartTime = std::chrono::steady_clock::now();
+
+    mIsRecording.store(true, std::memory_order_release);
+}
+
+void TraceRecorder::StopRecording()
+{
+    mIsRecording.store(false, std::memory_order_release);
+}
+
+void TraceRecorder::SetCurrentThreadName(std::string const & threadName)
+{
+    GetCurrentThreadName() = threadName;
+
+    ThreadBuffer * const threadBuffer = GetCurrentThreadBufferPointer();
+    if (nullptr != threadBuffer)
+    {
+        std::lock_guard<std::mutex> const lock(mMutex);
+
+        threadBuffer->ThreadName = threadName;
+    }
+}
+
+void TraceRecorder::SaveTrace(std::filesystem::path const & filePath)
+{
+    //
+    // Suspend recording while we read the buffers, so that writers do not
+    // overwrite the events we're reading. A writer might still be in the middle
+    // of recording one event, which goes into the slot of the oldest event; we
+    // thus skip that slot.
+    //
+
+    bool const wasRecording = mIsRecording.exchange(false, std::memory_order_acq_rel);
+
+    std::ostringstream ss;
+
+    {
+        std::lock_guard<std::mutex> const lock(mMutex);
+
+        ss << std::fixed << std::setprecision(3);
+
+        ss << "{\"traceEvents\":[";
+
+        bool isFirstEvent = true;
+        auto const beginEvent = [&]()
+        {
+            if (!isFirstEvent)
+                ss << ",";
+
+            ss << "\n";
+
+            isFirstEvent = false;
+        };
+
+        for (auto const & threadBuffer : mThreadBuffers)
+        {
+            // Thread name
+            beginEvent();
+            ss << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadBuffer->ThreadId
+                << ",\"args\":{\"name\":\"" << threadBuffer->ThreadName << "\"}}";
+
+            uint64_t const writeCount = threadBuffer->WriteCount.load(std::memory_order_acquire);
+            uint64_t const firstEvent = writeCount >= ThreadBuffer::Capacity
+                ? writeCount - ThreadBuffer::Capacity + 1
+                : 0;
+
+            for (uint64_t e = firstEvent; e < writeCount; ++e)
+            {
+                auto const & traceEvent = threadBuffer->Events[e % ThreadBuffer::Capacity];
+                if (traceEvent.StartTime < mRecordingStartTime)
+                    continue;
+
+                beginEvent();
+                ss << "{\"name\":\"" << Profiler::GetPhaseName(traceEvent.Phase) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadBuffer->ThreadId
+                    << ",\"ts\":" << std::chrono::duration<double, std::micro>(traceEvent.StartTime - mRecordingStartTime).count()
+                    << ",\"dur\":" << std::chrono::duration<double, std::micro>(traceEvent.EndTime - traceEvent.StartTime).count()
+                    << "}";
+            }
+        }
+
+        ss << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
+    if (wasRecording)
+        mIsRecording.store(true, std::memory_order_release);
+
+    Utils::SaveTextFile(
+        ss.str(),
+        filePath);
+}
+
+TraceRecorder::ThreadBuffer * TraceRecorder::RegisterCurrentThread()
+{
+    std::lock_guard<std::mutex> const lock(mMutex);
+
+    if (!mFreeThreadBuffers.empty())
+    {
+        // Re-use the buffer of a thread that went away; both threads are shown as one,
+        // as they never ran at the same time
+        ThreadBuffer * const threadBuffer = mFreeThreadBuffers.back();
+        mFreeThreadBuffers.pop_back();
+
+        if (!GetCurrentThreadName().empty())
+            threadBuffer->ThreadName = GetCurrentThreadName();
+
+        return threadBuffer;
+    }
+
+    uint32_t const threadId = static_cast<uint32_t>(mThreadBuffers.size()) + 1;
+
+    std::string threadName = GetCurrentThreadName();
+    if (threadName.empty())
+        threadName = "Thread " + std::to_string(threadId);
+
+    mThreadBuffers.emplace_back(new ThreadBuffer(threadId, threadName));
+
+    return mThreadBuffers.back().get();
+}
+
+void TraceRecorder::UnregisterThread(ThreadBuffer * threadBuffer)
+{
+    std::lock_guard<std::mutex> const lock(mMutex);
+
+    mFreeThreadBuffers.push_back(threadBuffer);
+}
@@ -0,0 +1,193 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-04-02
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+enum class ProfilePhase : size_t;
+
+/*
+ * Records the individual executions of the profiled phases - when they began and
+ * when they ended, and on which thread - so that single frames may be inspected.
+ *
+ * Each thread records into its own ring buffer, which only that thread writes to;
+ * recording an event is lock-free, and when the ring buffer is full the oldest events
+ * are dropped. Recording is off by default, in which case recording an event costs
+ * just the check of a flag.
+ *
+ * Recordings are saved in the Chrome trace event format, which may be opened with
+ * chrome://tracing or with Perfetto.
+ *
+ * Singleton.
+ */
+class TraceRecorder
+{
+public:
+
+    static TraceRecorder & GetInstance()
+    {
+        static TraceRecorder * instance = new TraceRecorder();
+
+        return *instance;
+    }
+
+    bool IsRecording() const
+    {
+        return mIsRecording.load(std::memory_order_acquire);
+    }
+
+    /*
+     * Starts a new recording; events recorded earlier are discarded.
+     */
+    void StartRecording();
+
+    void StopRecording();
+
+    inline void RecordEvent(
+        ProfilePhase phase,
+        std::chrono::steady_clock::time_point startTime,
+        std::chrono::steady_clock::time_point endTime)
+    {
+        if (!mIsRecording.load(std::memory_order_relaxed))
+            return;
+
+        GetCurrentThreadBuffer().Record(phase, startTime, endTime);
+    }
+
+    /*
+     * Sets the name that the calling thread is shown with in saved traces.
+     */
+    void SetCurrentThreadName(std::string const & threadName);
+
+    /*
+     * Saves the events of the current recording - whether or not the recording has been
+     * stopped - to the specified file.
+     */
+    void SaveTrace(std::filesystem::path const & filePath);
+
+private:
+
+    TraceRecorder()
+        : mIsRecording(false)
+        , mRecordingStartTime(std::chrono::steady_clock::now())
+        , mThreadBuffers()
+        , mFreeThreadBuffers()
+        , mMutex()
+    {}
+
+    struct TraceEvent
+    {
+        ProfilePhase Phase;
+        std::chrono::steady_clock::time_point StartTime;
+        std::chrono::steady_clock::time_point EndTime;
+    };
+
+    struct ThreadBuffer
+    {
+        // The number of most recent events that we keep for each thread
+        static constexpr size_t Capacity = 65536;
+
+        std::unique_ptr<TraceEvent[]> Events;
+
+        // The number of events ever recorded; the next event goes at WriteCount % Capacity
+        std::atomic<uint64_t> WriteCount;
+
+        uint32_t const ThreadId;
+        std::string ThreadName;
+
+        ThreadBuffer(
+            uint32_t threadId,
+            std::string const & threadName)
+            : Events(new TraceEvent[Capacity])
+            , WriteCount(0)
+            , ThreadId(threadId)
+            , ThreadName(threadName)
+        {}
+
+        // Invoked only by the thread owning the buffer
+        inline void Record(
+            ProfilePhase phase,
+            std::chrono::steady_clock::time_point startTime,
+            std::chrono::steady_clock::time_point endTime)
+        {
+            uint64_t const writeCount = WriteCount.load(std::memory_order_relaxed);
+
+            Events[writeCount % Capacity] = { phase, startTime, endTime };
+
+            // Publish the event
+            WriteCount.store(writeCount + 1, std::memory_order_release);
+        }
+    };
+
+    /*
+     * Holds the buffer of a thread for as long as the thread lives, giving it back
+     * to the recorder - for other threads to re-use - when the thread exits.
+     */
+    struct ThreadBufferHolder
+    {
+        ThreadBuffer * Buffer;
+
+        ThreadBufferHolder()
+            : Buffer(nullptr)
+        {}
+
+        ~ThreadBufferHolder()
+        {
+            if (nullptr != Buffer)
+                TraceRecorder::GetInstance().UnregisterThread(Buffer);
+        }
+    };
+
+    ThreadBuffer & GetCurrentThreadBuffer()
+    {
+        ThreadBuffer * & threadBuffer = GetCurrentThreadBufferPointer();
+        if (nullptr == threadBuffer)
+            threadBuffer = RegisterCurrentThread();
+
+        return *threadBuffer;
+    }
+
+    static ThreadBuffer * & GetCurrentThreadBufferPointer()
+    {
+        static thread_local ThreadBufferHolder threadBufferHolder;
+
+        return threadBufferHolder.Buffer;
+    }
+
+    static std::string & GetCurrentThreadName()
+    {
+        static thread_local std::string threadName;
+
+        return threadName;
+    }
+
+    ThreadBuffer * RegisterCurrentThread();
+
+    void UnregisterThread(ThreadBuffer * threadBuffer);
+
+private:
+
+    std::atomic<bool> mIsRecording;
+
+    // Events that started before this time belong to earlier recordings
+    std::chrono::steady_clock::time_point mRecordingStartTime;
+
+    // Owned here, as threads might go away before the trace is saved; the buffers
+    // of threads that went away are re-used by new threads, keeping their events
+    std::vector<std::unique_ptr<ThreadBuffer>> mThreadBuffers;
+    std::vector<ThreadBuffer *> mFreeThreadBuffers;
+
+    // Guards the registration of threads and the saving of traces
+    std::mutex mMutex;
+};
@@ -0,0 +1,106 @@
+/***************************************************************************************
+ * Original Author:		Gabriele Giuseppini
+ * Created:				2019-03-31
+ * Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#pragma once
+
+#include <Game/IGameEventHandler.h>
+
+#include <cstddef>
+#include <optional>
+
+/*
+ * Tallies the game events raised during a run.
+ */
+class EventStatistics final : public IGameEventHandler
+{
+public:
+
+    EventStatistics()
+        : DestroyedCount(0)
+        , SawedCount(0)
+        , BrokenCount(0)
+        , StressedCount(0)
+        , BombExplosionCount(0)
+        , TotalWaterTaken(0.0f)
+        , TotalWaterSplashed(0.0f)
+        , SinkingBeginStep()
+        , mCurrentStep(0)
+    {}
+
+    void SetCurrentStep(size_t step)
+    {
+        mCurrentStep = step;
+    }
+
+    void OnDestroy(
+        StructuralMaterial const & /*structuralMaterial*/,
+        bool /*isUnderwater*/,
+        unsigned int size) override
+    {
+        DestroyedCount += size;
+    }
+
+    void OnSawed(
+        bool /*isMetal*/,
+        unsigned int size) override
+    {
+        SawedCount += size;
+    }
+
+    void OnStress(
+        StructuralMaterial const & /*structuralMaterial*/,
+        bool /*isUnderwater*/,
+        unsigned int size) override
+    {
+        StressedCount += size;
+    }
+
+    void OnBreak(
+        StructuralMaterial const & /*structuralMaterial*/,
+        bool /*isUnderwater*/,
+        unsigned int size) override
+    {
+        BrokenCount += size;
+    }
+
+    void OnSinkingBegin(ShipId /*shipId*/) override
+    {
+        if (!SinkingBeginStep)
+            SinkingBeginStep = mCurrentStep;
+    }
+
+    void OnWaterTaken(float waterTaken) override
+    {
+        TotalWaterTaken += waterTaken;
+    }
+
+    void OnWaterSplashed(float waterSplashed) override
+    {
+        TotalWaterSplashed += waterSplashed;
+    }
+
+    void OnBombExplosion(
+        BombType /*bombType*/,
+        bool /*isUnderwater*/,
+        unsigned int size) override
+    {
+        BombExplosionCount += size;
+    }
+
+public:
+
+    size_t DestroyedCount;
+    size_t SawedCount;
+    size_t BrokenCount;
+    size_t StressedCount;
+    size_t BombExplosionCount;
+    float TotalWaterTaken;
+    float TotalWaterSplashed;
+    std::optional<size_t> SinkingBeginStep;
+
+private:
+
+    size_t mCurrentStep;
+};
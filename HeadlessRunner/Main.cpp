@@ -0,0 +1,321 @@
+/***************************************************************************************
+ * Original Author:		Gabriele Giuseppini
+ * Created:				2019-03-31
+ * Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+
+#include "EventStatistics.h"
+#include "Script.h"
+
+#include <Game/GameEventDispatcher.h>
+#include <Game/GameParameters.h>
+#include <Game/MaterialDatabase.h>
+#include <Game/Physics.h>
+#include <Game/ResourceLoader.h>
+#include <Game/ShipDefinition.h>
+
+#include <GameCore/Profiler.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#define SEPARATOR "------------------------------------------------------"
+
+/*
+ * Runs the simulation of a ship without any rendering - hence without an OpenGL context -
+ * and reports how long it took.
+ *
+ * Resources are looked up relative to the current directory, hence the runner is to be
+ * started from the game's root directory.
+ *
+ * The timings of the individual simulation phases come from the profiler, hence the runner
+ * refuses to run unless the game has been built with ENABLE_PROFILING.
+ */
+
+int DoRun(int argc, char ** argv);
+
+void PrintUsage();
+
+int main(int argc, char ** argv)
+{
+    if (argc == 1)
+    {
+        PrintUsage();
+        return 0;
+    }
+
+    try
+    {
+        return DoRun(argc, argv);
+    }
+    catch (std::exception & ex)
+    {
+        std::cout << "ERROR: " << ex.what() << std::endl;
+        return -1;
+    }
+}
+
+template<typename TAction>
+float TimeMillis(TAction && action)
+{
+    auto const startTime = std::chrono::steady_clock::now();
+
+    action();
+
+    auto const endTime = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<float, std::milli>(endTime - startTime).count();
+}
+
+float GetPercentile(
+    std::vector<float> const & sortedValues,
+    float percentile)
+{
+    assert(!sortedValues.empty());
+
+    size_t const index = std::min(
+        static_cast<size_t>(percentile * static_cast<float>(sortedValues.size())),
+        sortedValues.size() - 1);
+
+    return sortedValues[index];
+}
+
+int DoRun(int argc, char ** argv)
+{
+#ifndef ENABLE_PROFILING
+    throw std::runtime_error("The headless runner reports per-phase timings, hence it requires a build with ENABLE_PROFILING=ON");
+#endif
+
+    std::string shipFile(argv[1]);
+
+    size_t stepCount = 1000;
+    std::optional<std::string> scriptFile;
+    GameParameters gameParameters;
+
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string option(argv[i]);
+
+        auto const getOptionValue = [&]()
+        {
+            ++i;
+            if (i == argc)
+            {
+                throw std::runtime_error(option + " option specified without a value");
+            }
+
+            return std::string(argv[i]);
+        };
+
+        if (option == "-n" || option == "--steps")
+        {
+            stepCount = static_cast<size_t>(std::stoul(getOptionValue()));
+        }
+        else if (option == "-s" || option == "--script")
+        {
+            scriptFile = getOptionValue();
+        }
+        else if (option == "-t" || option == "--threads")
+        {
+            gameParameters.NumberOfSimulationThreads = std::clamp(
+                static_cast<size_t>(std::stoul(getOptionValue())),
+                GameParameters::MinNumberOfSimulationThreads,
+                GameParameters::MaxNumberOfSimulationThreads);
+        }
+        else if (option == "--sleep")
+        {
+            gameParameters.DoSleepSettledComponents = true;
+        }
+        else
+        {
+            throw std::runtime_error("Unrecognized option '" + option + "'");
+        }
+    }
+
+    std::cout << SEPARATOR << std::endl;
+    std::cout << "Running simulation:" << std::endl;
+    std::cout << "  ship file  : " << shipFile << std::endl;
+    std::cout << "  steps      : " << stepCount << std::endl;
+    std::cout << "  threads    : " << gameParameters.NumberOfSimulationThreads << std::endl;
+    std::cout << "  sleep      : " << (gameParameters.DoSleepSettledComponents ? "on" : "off") << std::endl;
+    if (!!scriptFile)
+        std::cout << "  script file: " << *scriptFile << std::endl;
+
+    //
+    // Load
+    //
+
+    ResourceLoader resourceLoader;
+
+    std::optional<Script> script;
+    if (!!scriptFile)
+        script.emplace(Script::Load(*scriptFile));
+
+    std::optional<MaterialDatabase> materialDatabase;
+    float const materialsLoadMillis = TimeMillis(
+        [&]()
+        {
+            materialDatabase.emplace(MaterialDatabase::Load(resourceLoader));
+        });
+
+    std::optional<ShipDefinition> shipDefinition;
+    float const shipLoadMillis = TimeMillis(
+        [&]()
+        {
+            shipDefinition.emplace(ShipDefinition::Load(shipFile));
+        });
+
+    //
+    // Build world
+    //
+
+    auto gameEventDispatcher = std::make_shared<GameEventDispatcher>();
+
+    EventStatistics eventStatistics;
+    gameEventDispatcher->RegisterSink(&eventStatistics);
+
+    std::unique_ptr<Physics::World> world;
+    ShipId shipId = 0;
+    float const shipBuildMillis = TimeMillis(
+        [&]()
+        {
+            world = std::make_unique<Physics::World>(
+                gameEventDispatcher,
+                gameParameters,
+                resourceLoader);
+
+            shipId = world->AddShip(
+                *shipDefinition,
+                *materialDatabase,
+                gameParameters);
+        });
+
+    size_t const initialPointCount = world->GetShipPointCount(shipId);
+
+    //
+    // Simulate
+    //
+
+    std::vector<float> stepMillis;
+    stepMillis.reserve(stepCount);
+
+    // Only time the phases of the simulation
+    Profiler::GetInstance().Reset();
+
+    size_t appliedActionCount = 0;
+    float actionsMillis = 0.0f;
+
+    for (size_t step = 0; step < stepCount; ++step)
+    {
+        eventStatistics.SetCurrentStep(step);
+
+        if (!!script)
+        {
+            actionsMillis += TimeMillis(
+                [&]()
+                {
+                    appliedActionCount += script->ApplyActions(step, *world, gameParameters);
+                });
+        }
+
+        stepMillis.push_back(
+            TimeMillis(
+                [&]()
+                {
+                    world->Update(
+                        gameParameters,
+                        VectorFieldRenderMode::None);
+                }));
+
+        gameEventDispatcher->Flush();
+    }
+
+    //
+    // Report
+    //
+
+    std::cout << SEPARATOR << std::endl;
+
+    std::cout << std::fixed << std::setprecision(3);
+
+    std::cout << "Phases (ms):" << std::endl;
+    std::cout << "  materials load: " << materialsLoadMillis << std::endl;
+    std::cout << "  ship load     : " << shipLoadMillis << std::endl;
+    std::cout << "  ship build    : " << shipBuildMillis << std::endl;
+    std::cout << "  actions       : " << actionsMillis << std::endl;
+
+    if (!stepMillis.empty())
+    {
+        float totalStepMillis = 0.0f;
+        for (float const millis : stepMillis)
+            totalStepMillis += millis;
+
+        std::sort(stepMillis.begin(), stepMillis.end());
+
+        float const simulatedMillis = 1000.0f * GameParameters::SimulationStepTimeDuration<float> * static_cast<float>(stepMillis.size());
+
+        std::cout << "  simulation    : " << totalStepMillis << std::endl;
+        std::cout << "Steps (ms):" << std::endl;
+        std::cout << "  mean          : " << (totalStepMillis / static_cast<float>(stepMillis.size())) << std::endl;
+        std::cout << "  min           : " << stepMillis.front() << std::endl;
+        std::cout << "  p50           : " << GetPercentile(stepMillis, 0.50f) << std::endl;
+        std::cout << "  p95           : " << GetPercentile(stepMillis, 0.95f) << std::endl;
+        std::cout << "  p99           : " << GetPercentile(stepMillis, 0.99f) << std::endl;
+        std::cout << "  max           : " << stepMillis.back() << std::endl;
+        std::cout << "  speed         : x" << (totalStepMillis != 0.0f ? simulatedMillis / totalStepMillis : 0.0f) << std::endl;
+    }
+
+    auto const phaseStatistics = Profiler::GetInstance().GetStatistics();
+    if (!phaseStatistics.empty())
+    {
+        std::cout << "Simulation phases (ms, last " << Profiler::WindowSize << " samples of each thread):" << std::endl;
+        std::cout << "  " << std::left << std::setw(16) << "phase" << std::right
+            << std::setw(10) << "mean"
+            << std::setw(10) << "p95"
+            << std::setw(10) << "max" << std::endl;
+
+        for (auto const & ps : phaseStatistics)
+        {
+            std::cout << "  " << std::left << std::setw(16) << Profiler::GetPhaseName(ps.Phase) << std::right
+                << std::setw(10) << ps.MeanMillis
+                << std::setw(10) << ps.P95Millis
+                << std::setw(10) << ps.MaxMillis << std::endl;
+        }
+    }
+
+    std::cout << "Summary:" << std::endl;
+    std::cout << "  points        : " << initialPointCount << " -> " << world->GetShipPointCount(shipId) << std::endl;
+    std::cout << "  actions       : " << appliedActionCount << std::endl;
+    std::cout << "  destroyed     : " << eventStatistics.DestroyedCount << std::endl;
+    std::cout << "  sawed         : " << eventStatistics.SawedCount << std::endl;
+    std::cout << "  stressed      : " << eventStatistics.StressedCount << std::endl;
+    std::cout << "  broken        : " << eventStatistics.BrokenCount << std::endl;
+    std::cout << "  explosions    : " << eventStatistics.BombExplosionCount << std::endl;
+    std::cout << "  water taken   : " << eventStatistics.TotalWaterTaken << std::endl;
+    std::cout << "  water splashed: " << eventStatistics.TotalWaterSplashed << std::endl;
+    std::cout << "  sinking step  : ";
+    if (!!eventStatistics.SinkingBeginStep)
+        std::cout << *eventStatistics.SinkingBeginStep << std::endl;
+    else
+        std::cout << "none" << std::endl;
+
+    return 0;
+}
+
+void PrintUsage()
+{
+    std::cout << std::endl;
+    std::cout << "Usage:" << std::endl;
+    std::cout << " HeadlessRunner <ship_file> [-n, --steps <step_count>] [-s, --script <script_file>]" << std::endl;
+    std::cout << "                [-t, --threads <thread_count>] [--sleep]" << std::endl;
+    std::cout << std::endl;
+    std::cout << " Run from the game's root directory." << std::endl;
+}
@@ -0,0 +1,250 @@
+/***************************************************************************************
+ * Original Author:		Gabriele Giuseppini
+ * Created:				2019-03-31
+ * Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#include "Script.h"
+
+#include <GameCore/Vectors.h>
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+    struct VerbInfo
+    {
+        size_t MinArgumentCount;
+        size_t MaxArgumentCount;
+    };
+
+    std::map<std::string, VerbInfo> const Verbs = {
+        { "destroy", { 2, 3 } },
+        { "saw", { 4, 4 } },
+        { "draw", { 2, 3 } },
+        { "swirl", { 2, 3 } },
+        { "pin", { 2, 2 } },
+        { "bubbles", { 2, 2 } },
+        { "flood", { 2, 3 } },
+        { "antimatter_bomb", { 2, 2 } },
+        { "impact_bomb", { 2, 2 } },
+        { "rc_bomb", { 2, 2 } },
+        { "timer_bomb", { 2, 2 } },
+        { "detonate_rc_bombs", { 0, 0 } },
+        { "detonate_antimatter_bombs", { 0, 0 } }
+    };
+
+    float GetOptionalArgument(
+        std::vector<float> const & arguments,
+        size_t index,
+        float defaultValue)
+    {
+        return index < arguments.size()
+            ? arguments[index]
+            : defaultValue;
+    }
+}
+
+Script Script::Load(std::filesystem::path const & scriptFilePath)
+{
+    std::ifstream scriptFile(scriptFilePath);
+    if (!scriptFile.is_open())
+    {
+        throw std::runtime_error("Cannot open script file \"" + scriptFilePath.string() + "\"");
+    }
+
+    std::vector<Action> actions;
+
+    std::string line;
+    for (int lineNumber = 1; std::getline(scriptFile, line); ++lineNumber)
+    {
+        std::istringstream lineStream(line);
+
+        std::string stepStr;
+        if (!(lineStream >> stepStr) || stepStr[0] == '#')
+        {
+            // Empty line or comment
+            continue;
+        }
+
+        auto const makeError = [&](std::string const & message)
+        {
+            return std::runtime_error(
+                "Error at line " + std::to_string(lineNumber) + " of script file \"" + scriptFilePath.string() + "\": " + message);
+        };
+
+        size_t step;
+        try
+        {
+            step = static_cast<size_t>(std::stoul(stepStr));
+        }
+        catch (std::exception const &)
+        {
+            throw makeError("invalid step '" + stepStr + "'");
+        }
+
+        std::string verb;
+        if (!(lineStream >> verb))
+        {
+            throw makeError("missing action");
+        }
+
+        auto const verbIt = Verbs.find(verb);
+        if (verbIt == Verbs.end())
+        {
+            throw makeError("unrecognized action '" + verb + "'");
+        }
+
+        std::vector<float> arguments;
+        std::string argumentStr;
+        while (lineStream >> argumentStr)
+        {
+            try
+            {
+                arguments.push_back(std::stof(argumentStr));
+            }
+            catch (std::exception const &)
+            {
+                throw makeError("invalid argument '" + argumentStr + "'");
+            }
+        }
+
+        if (arguments.size() < verbIt->second.MinArgumentCount
+            || arguments.size() > verbIt->second.MaxArgumentCount)
+        {
+            throw makeError("wrong number of arguments for action '" + verb + "'");
+        }
+
+        actions.emplace_back(
+            step,
+            verb,
+            std::move(arguments));
+    }
+
+    // Keep actions for the same step in script order
+    std::stable_sort(
+        actions.begin(),
+        actions.end(),
+        [](Action const & a1, Action const & a2)
+        {
+            return a1.Step < a2.Step;
+        });
+
+    return Script(std::move(actions));
+}
+
+size_t Script::ApplyActions(
+    size_t step,
+    Physics::World & world,
+    GameParameters const & gameParameters)
+{
+    size_t appliedActionCount = 0;
+
+    for (; mNextActionIndex < mActions.size() && mActions[mNextActionIndex].Step <= step; ++mNextActionIndex)
+    {
+        ApplyAction(
+            mActions[mNextActionIndex],
+            world,
+            gameParameters);
+
+        ++appliedActionCount;
+    }
+
+    return appliedActionCount;
+}
+
+void Script::ApplyAction(
+    Action const & action,
+    Physics::World & world,
+    GameParameters const & gameParameters)
+{
+    auto const & args = action.Arguments;
+
+    // Strengths are scaled the same way the game controller scales the tools' ones
+
+    if (action.Verb == "destroy")
+    {
+        world.DestroyAt(
+            vec2f(args[0], args[1]),
+            GetOptionalArgument(args, 2, 1.0f),
+            gameParameters);
+    }
+    else if (action.Verb == "saw")
+    {
+        world.SawThrough(
+            vec2f(args[0], args[1]),
+            vec2f(args[2], args[3]),
+            gameParameters);
+    }
+    else if (action.Verb == "draw")
+    {
+        world.DrawTo(
+            vec2f(args[0], args[1]),
+            2000.0f * GetOptionalArgument(args, 2, 1.0f),
+            gameParameters);
+    }
+    else if (action.Verb == "swirl")
+    {
+        world.SwirlAt(
+            vec2f(args[0], args[1]),
+            30.0f * GetOptionalArgument(args, 2, 1.0f),
+            gameParameters);
+    }
+    else if (action.Verb == "pin")
+    {
+        world.TogglePinAt(
+            vec2f(args[0], args[1]),
+            gameParameters);
+    }
+    else if (action.Verb == "bubbles")
+    {
+        world.InjectBubblesAt(
+            vec2f(args[0], args[1]),
+            gameParameters);
+    }
+    else if (action.Verb == "flood")
+    {
+        world.FloodAt(
+            vec2f(args[0], args[1]),
+            GetOptionalArgument(args, 2, 1.0f),
+            gameParameters);
+    }
+    else if (action.Verb == "antimatter_bomb")
+    {
+        world.ToggleAntiMatterBombAt(
+            vec2f(args[0], args[1]),
+            gameParameters);
+    }
+    else if (action.Verb == "impact_bomb")
+    {
+        world.ToggleImpactBombAt(
+            vec2f(args[0], args[1]),
+            gameParameters);
+    }
+    else if (action.Verb == "rc_bomb")
+    {
+        world.ToggleRCBombAt(
+            vec2f(args[0], args[1]),
+            gameParameters);
+    }
+    else if (action.Verb == "timer_bomb")
+    {
+        world.ToggleTimerBombAt(
+            vec2f(args[0], args[1]),
+            gameParameters);
+    }
+    else if (action.Verb == "detonate_rc_bombs")
+    {
+        world.DetonateRCBombs();
+    }
+    else
+    {
+        assert(action.Verb == "detonate_antimatter_bombs");
+
+        world.DetonateAntiMatterBombs();
+    }
+}
@@ -0,0 +1,94 @@
+/***************************************************************************************
+ * Original Author:		Gabriele Giuseppini
+ * Created:				2019-03-31
+ * Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#pragma once
+
+#include <Game/GameParameters.h>
+#include <Game/Physics.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/*
+ * A sequence of tool actions to be applied to the world at given simulation steps.
+ *
+ * Scripts are text files with one action per line, in the form:
+ *
+ *      <step> <action> [<argument> ...]
+ *
+ * where coordinates are in world units; empty lines and lines starting with '#' are ignored.
+ * The actions, with their arguments - optional ones in brackets - are:
+ *
+ *      destroy <x> <y> [<radius_multiplier>]
+ *      saw <start_x> <start_y> <end_x> <end_y>
+ *      draw <x> <y> [<strength_multiplier>]
+ *      swirl <x> <y> [<strength_multiplier>]
+ *      pin <x> <y>
+ *      bubbles <x> <y>
+ *      flood <x> <y> [<water_quantity_multiplier>]
+ *      antimatter_bomb <x> <y>
+ *      impact_bomb <x> <y>
+ *      rc_bomb <x> <y>
+ *      timer_bomb <x> <y>
+ *      detonate_rc_bombs
+ *      detonate_antimatter_bombs
+ */
+class Script
+{
+public:
+
+    static Script Load(std::filesystem::path const & scriptFilePath);
+
+    size_t GetActionCount() const
+    {
+        return mActions.size();
+    }
+
+    /*
+     * Applies all the actions scheduled for the specified step, returning
+     * how many they were.
+     */
+    size_t ApplyActions(
+        size_t step,
+        Physics::World & world,
+        GameParameters const & gameParameters);
+
+private:
+
+    struct Action
+    {
+        size_t Step;
+        std::string Verb;
+        std::vector<float> Arguments;
+
+        Action(
+            size_t step,
+            std::string verb,
+            std::vector<float> arguments)
+            : Step(step)
+            , Verb(std::move(verb))
+            , Arguments(std::move(arguments))
+        {}
+    };
+
+    explicit Script(std::vector<Action> actions)
+        : mActions(std::move(actions))
+        , mNextActionIndex(0)
+    {}
+
+    static void ApplyAction(
+        Action const & action,
+        Physics::World & world,
+        GameParameters const & gameParameters);
+
+private:
+
+    // Sorted by step
+    std::vector<Action> mActions;
+
+    size_t mNextActionIndex;
+};
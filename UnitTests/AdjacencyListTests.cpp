@@ -0,0 +1,175 @@
+#include <GameCore/AdjacencyList.h>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+    std::vector<int> ToVector(AdjacencyList<int>::List const & list)
+    {
+        return std::vector<int>(list.begin(), list.end());
+    }
+}
+
+TEST(AdjacencyListTests, Empty)
+{
+    AdjacencyList<int> adjacency(3);
+
+    EXPECT_EQ(3u, adjacency.GetNodeCount());
+    EXPECT_EQ(0u, adjacency.GetElementCount());
+    EXPECT_EQ(0u, adjacency.GetTombstoneCount());
+
+    EXPECT_TRUE(adjacency[0].empty());
+    EXPECT_TRUE(adjacency[1].empty());
+    EXPECT_TRUE(adjacency[2].empty());
+}
+
+TEST(AdjacencyListTests, PushBack_Interleaved)
+{
+    AdjacencyList<int> adjacency(3);
+
+    adjacency.push_back(0, 1);
+    adjacency.push_back(1, 10);
+    adjacency.push_back(0, 2);
+    adjacency.push_back(2, 20);
+    adjacency.push_back(1, 11);
+    adjacency.push_back(0, 3);
+
+    EXPECT_EQ(6u, adjacency.GetElementCount());
+
+    EXPECT_EQ(std::vector<int>({ 1, 2, 3 }), ToVector(adjacency[0]));
+    EXPECT_EQ(std::vector<int>({ 10, 11 }), ToVector(adjacency[1]));
+    EXPECT_EQ(std::vector<int>({ 20 }), ToVector(adjacency[2]));
+
+    EXPECT_EQ(3u, adjacency[0].size());
+    EXPECT_EQ(1, adjacency[0].front());
+    EXPECT_EQ(3, adjacency[0].back());
+    EXPECT_EQ(2, adjacency[0][1]);
+}
+
+TEST(AdjacencyListTests, PushFront)
+{
+    AdjacencyList<int> adjacency(2);
+
+    adjacency.push_back(0, 1);
+    adjacency.push_back(1, 10);
+    adjacency.push_front(0, 2);
+    adjacency.push_back(0, 3);
+    adjacency.push_front(1, 11);
+
+    EXPECT_EQ(std::vector<int>({ 2, 1, 3 }), ToVector(adjacency[0]));
+    EXPECT_EQ(std::vector<int>({ 11, 10 }), ToVector(adjacency[1]));
+}
+
+TEST(AdjacencyListTests, EraseFirst_PreservesOrder)
+{
+    AdjacencyList<int> adjacency(2);
+
+    adjacency.push_back(0, 1);
+    adjacency.push_back(0, 2);
+    adjacency.push_back(0, 3);
+    adjacency.push_back(0, 2);
+    adjacency.push_back(1, 10);
+
+    size_t const tombstonesBefore = adjacency.GetTombstoneCount();
+
+    EXPECT_TRUE(adjacency.erase_first(0, [](int e) { return e == 2; }));
+
+    EXPECT_EQ(std::vector<int>({ 1, 3, 2 }), ToVector(adjacency[0]));
+    EXPECT_EQ(std::vector<int>({ 10 }), ToVector(adjacency[1]));
+    EXPECT_EQ(4u, adjacency.GetElementCount());
+    EXPECT_EQ(tombstonesBefore + 1, adjacency.GetTombstoneCount());
+
+    EXPECT_FALSE(adjacency.erase_first(0, [](int e) { return e == 10; }));
+
+    EXPECT_EQ(4u, adjacency.GetElementCount());
+}
+
+TEST(AdjacencyListTests, PushBack_ReusesTombstones)
+{
+    AdjacencyList<int> adjacency(2);
+
+    adjacency.push_back(0, 1);
+    adjacency.push_back(0, 2);
+    adjacency.push_back(1, 10);
+
+    adjacency.Compact();
+
+    ASSERT_EQ(0u, adjacency.GetTombstoneCount());
+
+    EXPECT_TRUE(adjacency.erase_first(0, [](int e) { return e == 1; }));
+
+    EXPECT_EQ(1u, adjacency.GetTombstoneCount());
+
+    adjacency.push_back(0, 3);
+
+    EXPECT_EQ(0u, adjacency.GetTombstoneCount());
+    EXPECT_EQ(std::vector<int>({ 2, 3 }), ToVector(adjacency[0]));
+    EXPECT_EQ(std::vector<int>({ 10 }), ToVector(adjacency[1]));
+}
+
+TEST(AdjacencyListTests, Compact)
+{
+    AdjacencyList<int> adjacency(3);
+
+    for (int i = 0; i < 8; ++i)
+    {
+        adjacency.push_back(0, i);
+        adjacency.push_back(1, 10 + i);
+        adjacency.push_back(2, 20 + i);
+    }
+
+    for (int i = 0; i < 6; ++i)
+    {
+        adjacency.erase_first(1, [](int) { return true; });
+    }
+
+    EXPECT_TRUE(adjacency.IsFragmented());
+
+    adjacency.Compact();
+
+    EXPECT_FALSE(adjacency.IsFragmented());
+    EXPECT_EQ(0u, adjacency.GetTombstoneCount());
+    EXPECT_EQ(18u, adjacency.GetElementCount());
+
+    EXPECT_EQ(std::vector<int>({ 0, 1, 2, 3, 4, 5, 6, 7 }), ToVector(adjacency[0]));
+    EXPECT_EQ(std::vector<int>({ 16, 17 }), ToVector(adjacency[1]));
+    EXPECT_EQ(std::vector<int>({ 20, 21, 22, 23, 24, 25, 26, 27 }), ToVector(adjacency[2]));
+
+    // Lists are now laid out contiguously, in node order
+    EXPECT_EQ(adjacency[0].end(), adjacency[1].begin());
+    EXPECT_EQ(adjacency[1].end(), adjacency[2].begin());
+
+    // And may still grow
+    adjacency.push_back(1, 18);
+    adjacency.push_front(0, -1);
+
+    EXPECT_EQ(std::vector<int>({ -1, 0, 1, 2, 3, 4, 5, 6, 7 }), ToVector(adjacency[0]));
+    EXPECT_EQ(std::vector<int>({ 16, 17, 18 }), ToVector(adjacency[1]));
+    EXPECT_EQ(std::vector<int>({ 20, 21, 22, 23, 24, 25, 26, 27 }), ToVector(adjacency[2]));
+}
+
+TEST(AdjacencyListTests, Copy_IsIndependent)
+{
+    AdjacencyList<int> adjacency(2);
+
+    adjacency.push_back(0, 1);
+    adjacency.push_back(0, 2);
+    adjacency.push_back(1, 10);
+
+    size_t const tombstonesBefore = adjacency.GetTombstoneCount();
+
+    AdjacencyList<int> copy(adjacency);
+
+    adjacency.erase_first(0, [](int e) { return e == 1; });
+    adjacency.push_back(1, 11);
+
+    EXPECT_EQ(std::vector<int>({ 1, 2 }), ToVector(copy[0]));
+    EXPECT_EQ(std::vector<int>({ 10 }), ToVector(copy[1]));
+    EXPECT_EQ(3u, copy.GetElementCount());
+    EXPECT_EQ(tombstonesBefore, copy.GetTombstoneCount());
+
+    EXPECT_EQ(std::vector<int>({ 2 }), ToVector(adjacency[0]));
+    EXPECT_EQ(std::vector<int>({ 10, 11 }), ToVector(adjacency[1]));
+}
@@ -0,0 +1,310 @@
+#include <Game/ConnectivityVisit.h>
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace Physics;
+
+namespace {
+
+    struct TestPoints
+    {
+        struct ConnectedSpring
+        {
+            ElementIndex OtherEndpointIndex;
+        };
+
+        ElementIndex NonEphemeralPointCount;
+        std::vector<ElementIndex> NonEphemeralIndices;
+        std::vector<ElementIndex> NonEphemeralReverseIndices;
+        std::vector<ElementIndex> EphemeralIndices;
+
+        std::vector<bool> IsDeletedFlags;
+        std::vector<PlaneId> PlaneIds;
+        std::vector<ConnectedComponentId> ConnectedComponentIds;
+        std::vector<SequenceNumber> VisitSequenceNumbers;
+        std::vector<std::vector<ConnectedSpring>> ConnectedSprings;
+        std::vector<size_t> OwnedTrianglesCounts;
+
+        TestPoints(
+            ElementIndex nonEphemeralPointCount,
+            ElementIndex ephemeralPointCount)
+            : NonEphemeralPointCount(nonEphemeralPointCount)
+            , NonEphemeralIndices(nonEphemeralPointCount)
+            , NonEphemeralReverseIndices(nonEphemeralPointCount)
+            , EphemeralIndices(ephemeralPointCount)
+            , IsDeletedFlags(nonEphemeralPointCount + ephemeralPointCount, false)
+            , PlaneIds(nonEphemeralPointCount + ephemeralPointCount, NonePlaneId)
+            , ConnectedComponentIds(nonEphemeralPointCount + ephemeralPointCount, NoneConnectedComponentId)
+            , VisitSequenceNumbers(nonEphemeralPointCount + ephemeralPointCount)
+            , ConnectedSprings(nonEphemeralPointCount + ephemeralPointCount)
+            , OwnedTrianglesCounts(nonEphemeralPointCount + ephemeralPointCount, 0)
+        {
+            std::iota(NonEphemeralIndices.begin(), NonEphemeralIndices.end(), ElementIndex(0));
+            std::copy(NonEphemeralIndices.crbegin(), NonEphemeralIndices.crend(), NonEphemeralReverseIndices.begin());
+            std::iota(EphemeralIndices.begin(), EphemeralIndices.end(), nonEphemeralPointCount);
+        }
+
+        std::vector<ElementIndex> const & NonEphemeralPoints() const { return NonEphemeralIndices; }
+        std::vector<ElementIndex> const & NonEphemeralPointsReverse() const { return NonEphemeralReverseIndices; }
+        std::vector<ElementIndex> const & EphemeralPoints() const { return EphemeralIndices; }
+        bool IsDeleted(ElementIndex p) const { return IsDeletedFlags[p]; }
+
+        PlaneId GetPlaneId(ElementIndex p) const { return PlaneIds[p]; }
+        void SetPlaneId(ElementIndex p, PlaneId planeId, float /*planeIdFloat*/) { PlaneIds[p] = planeId; }
+        void SetConnectedComponentId(ElementIndex p, ConnectedComponentId id) { ConnectedComponentIds[p] = id; }
+        void MarkPlaneIdBufferNonEphemeralAsDirty() {}
+        void MarkPlaneIdBufferEphemeralAsDirty() {}
+
+        SequenceNumber GetCurrentConnectivityVisitSequenceNumber(ElementIndex p) const { return VisitSequenceNumbers[p]; }
+        void SetCurrentConnectivityVisitSequenceNumber(ElementIndex p, SequenceNumber n) { VisitSequenceNumbers[p] = n; }
+
+        std::vector<ConnectedSpring> const & GetConnectedSprings(ElementIndex p) const { return ConnectedSprings[p]; }
+        size_t GetConnectedOwnedTrianglesCount(ElementIndex p) const { return OwnedTrianglesCounts[p]; }
+    };
+
+    /*
+     * A width x height lattice of points with horizontal and vertical springs, whose points own
+     * a few triangles each, plus a few ephemeral points; springs and points are destroyed at random
+     * and after each round we compare an incremental visit with a full visit of the same network.
+     */
+    class ConnectivityVisitTests : public testing::Test
+    {
+    protected:
+
+        static constexpr int Width = 23;
+        static constexpr int Height = 19;
+        static constexpr int EphemeralPointCount = 40;
+
+        ConnectivityVisitTests()
+            : mPoints(Width * Height, EphemeralPointCount)
+            , mVisit()
+        {}
+
+        void SetUp() override
+        {
+            std::mt19937 random(17);
+
+            for (int y = 0; y < Height; ++y)
+            {
+                for (int x = 0; x < Width; ++x)
+                {
+                    if (x + 1 < Width)
+                        AddSpring(ToPointIndex(x, y), ToPointIndex(x + 1, y));
+                    if (y + 1 < Height)
+                        AddSpring(ToPointIndex(x, y), ToPointIndex(x, y + 1));
+
+                    mPoints.OwnedTrianglesCounts[ToPointIndex(x, y)] = random() % 3;
+                }
+            }
+
+            mVisit.RunFull(mPoints);
+        }
+
+        static ElementIndex ToPointIndex(int x, int y)
+        {
+            return static_cast<ElementIndex>(x + y * Width);
+        }
+
+        void AddSpring(ElementIndex a, ElementIndex b)
+        {
+            mPoints.ConnectedSprings[a].push_back({ b });
+            mPoints.ConnectedSprings[b].push_back({ a });
+        }
+
+        void DestroySpring(ElementIndex a, ElementIndex b)
+        {
+            auto removeFrom = [this](ElementIndex p, ElementIndex other)
+            {
+                auto & springs = mPoints.ConnectedSprings[p];
+                springs.erase(
+                    std::find_if(springs.begin(), springs.end(), [other](auto const & cs) { return cs.OtherEndpointIndex == other; }));
+            };
+
+            removeFrom(a, b);
+            removeFrom(b, a);
+
+            mVisit.OnSpringDestroyed(a, b);
+        }
+
+        void DestroyPoint(ElementIndex p)
+        {
+            // Like the ship does, first the triangles and then the springs
+            for (; mPoints.OwnedTrianglesCounts[p] > 0; --mPoints.OwnedTrianglesCounts[p])
+                mVisit.OnTriangleDestroyed(mPoints.PlaneIds[p]);
+
+            while (!mPoints.ConnectedSprings[p].empty())
+                DestroySpring(p, mPoints.ConnectedSprings[p].back().OtherEndpointIndex);
+
+            mPoints.IsDeletedFlags[p] = true;
+        }
+
+        void DestroyAtRandom(std::mt19937 & random)
+        {
+            std::uniform_int_distribution<ElementIndex> pointDistribution(0, mPoints.NonEphemeralPointCount - 1);
+
+            for (int i = 0; i < 40; ++i)
+            {
+                ElementIndex const p = pointDistribution(random);
+                if (!mPoints.ConnectedSprings[p].empty())
+                    DestroySpring(p, mPoints.ConnectedSprings[p][random() % mPoints.ConnectedSprings[p].size()].OtherEndpointIndex);
+            }
+
+            for (int i = 0; i < 3; ++i)
+            {
+                ElementIndex const p = pointDistribution(random);
+                if (!mPoints.IsDeleted(p))
+                    DestroyPoint(p);
+            }
+        }
+
+        // Gives each ephemeral point the plane ID of a random non-ephemeral point, or the max plane ID
+        void AssignEphemeralPlaneIds(std::mt19937 & random)
+        {
+            for (auto const e : mPoints.EphemeralPoints())
+            {
+                ElementIndex const p = random() % mPoints.NonEphemeralPointCount;
+                mPoints.PlaneIds[e] = mPoints.IsDeleted(p)
+                    ? mVisit.GetMaxPlaneId()
+                    : mPoints.PlaneIds[p];
+            }
+        }
+
+        // Labels the connected components of the points from scratch
+        std::vector<ElementIndex> CalculateComponentRoots() const
+        {
+            std::vector<ElementIndex> roots(mPoints.NonEphemeralPointCount, NoneElementIndex);
+            for (ElementIndex p = 0; p < mPoints.NonEphemeralPointCount; ++p)
+            {
+                if (!mPoints.IsDeleted(p) && NoneElementIndex == roots[p])
+                {
+                    std::vector<ElementIndex> stack{ p };
+                    roots[p] = p;
+                    while (!stack.empty())
+                    {
+                        auto const q = stack.back();
+                        stack.pop_back();
+                        for (auto const & cs : mPoints.ConnectedSprings[q])
+                        {
+                            if (NoneElementIndex == roots[cs.OtherEndpointIndex])
+                            {
+                                roots[cs.OtherEndpointIndex] = p;
+                                stack.push_back(cs.OtherEndpointIndex);
+                            }
+                        }
+                    }
+                }
+            }
+
+            return roots;
+        }
+
+        TestPoints mPoints;
+        ConnectivityVisit mVisit;
+    };
+}
+
+TEST_F(ConnectivityVisitTests, FullVisitKeepsIncrementalVisitPlanes)
+{
+    std::mt19937 random(42);
+
+    for (int round = 0; round < 12; ++round)
+    {
+        AssignEphemeralPlaneIds(random);
+        DestroyAtRandom(random);
+
+        TestPoints fullPoints = mPoints;
+        ConnectivityVisit fullVisit = mVisit;
+
+        mVisit.RunIncremental(mPoints);
+        fullVisit.RunFull(fullPoints);
+
+        //
+        // Both visits find the true components
+        //
+
+        auto const roots = CalculateComponentRoots();
+
+        std::map<ElementIndex, PlaneId> incrementalPlaneByRoot;
+        std::map<ElementIndex, PlaneId> fullPlaneByRoot;
+        std::map<PlaneId, size_t> incrementalTrianglesCountByPlane;
+        for (ElementIndex p = 0; p < mPoints.NonEphemeralPointCount; ++p)
+        {
+            if (mPoints.IsDeleted(p))
+                continue;
+
+            auto const incrementalPlaneId = mPoints.PlaneIds[p];
+            auto const fullPlaneId = fullPoints.PlaneIds[p];
+
+            EXPECT_EQ(incrementalPlaneByRoot.emplace(roots[p], incrementalPlaneId).first->second, incrementalPlaneId);
+            EXPECT_EQ(fullPlaneByRoot.emplace(roots[p], fullPlaneId).first->second, fullPlaneId);
+            EXPECT_EQ(fullPoints.ConnectedComponentIds[p], static_cast<ConnectedComponentId>(fullPlaneId));
+
+            incrementalTrianglesCountByPlane[incrementalPlaneId] += mPoints.OwnedTrianglesCounts[p];
+        }
+
+        ASSERT_EQ(incrementalPlaneByRoot.size(), fullPlaneByRoot.size());
+
+        //
+        // The full visit only compacts the incremental visit's plane IDs, keeping their order
+        //
+
+        std::map<PlaneId, PlaneId> fullPlaneByIncrementalPlane;
+        for (auto const & [root, incrementalPlaneId] : incrementalPlaneByRoot)
+        {
+            EXPECT_TRUE(fullPlaneByIncrementalPlane.emplace(incrementalPlaneId, fullPlaneByRoot[root]).second);
+        }
+
+        PlaneId expectedFullPlaneId = 0;
+        for (auto const & [incrementalPlaneId, fullPlaneId] : fullPlaneByIncrementalPlane)
+        {
+            EXPECT_EQ(fullPlaneId, expectedFullPlaneId);
+            ++expectedFullPlaneId;
+
+            EXPECT_EQ(mVisit.GetPlaneTrianglesCounts()[incrementalPlaneId], incrementalTrianglesCountByPlane[incrementalPlaneId]);
+            EXPECT_EQ(fullVisit.GetPlaneTrianglesCounts()[fullPlaneId], incrementalTrianglesCountByPlane[incrementalPlaneId]);
+        }
+
+        EXPECT_EQ(fullVisit.GetPlaneCount(), fullPlaneByIncrementalPlane.size());
+        EXPECT_EQ(fullVisit.GetMaxPlaneId(), static_cast<PlaneId>(fullPlaneByIncrementalPlane.size() - 1));
+
+        //
+        // Ephemeral points move along with their planes
+        //
+
+        for (auto const e : mPoints.EphemeralPoints())
+        {
+            auto const it = fullPlaneByIncrementalPlane.find(mPoints.PlaneIds[e]);
+            if (it != fullPlaneByIncrementalPlane.end())
+                EXPECT_EQ(fullPoints.PlaneIds[e], it->second);
+            else
+                EXPECT_EQ(fullPoints.PlaneIds[e], fullVisit.GetMaxPlaneId());
+        }
+    }
+}
+
+TEST_F(ConnectivityVisitTests, RunKeepsPlaneIdsWithinMax)
+{
+    std::mt19937 random(7);
+
+    for (int round = 0; round < 30; ++round)
+    {
+        AssignEphemeralPlaneIds(random);
+        DestroyAtRandom(random);
+
+        mVisit.Run(mPoints);
+
+        for (ElementIndex p = 0; p < static_cast<ElementIndex>(mPoints.PlaneIds.size()); ++p)
+        {
+            if (!mPoints.IsDeleted(p))
+                EXPECT_LE(mPoints.PlaneIds[p], mVisit.GetMaxPlaneId());
+        }
+
+        EXPECT_EQ(mVisit.GetMaxPlaneId() + 1, mVisit.GetPlaneCount());
+    }
+}
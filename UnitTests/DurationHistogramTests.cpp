@@ -0,0 +1,90 @@
+#include <GameCore/DurationHistogram.h>
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+TEST(DurationHistogramTests, Empty)
+{
+    DurationHistogram histogram(16ms);
+
+    EXPECT_EQ(0u, histogram.GetCount());
+    EXPECT_EQ(0u, histogram.GetOverBudgetCount());
+    EXPECT_EQ(0.0f, histogram.GetPercentileMillis(0.5f));
+    EXPECT_EQ(0.0f, histogram.GetMaxMillis());
+}
+
+TEST(DurationHistogramTests, SmallDurations_AreExact)
+{
+    DurationHistogram histogram(16ms);
+
+    histogram.Record(1us);
+    histogram.Record(3us);
+    histogram.Record(5us);
+    histogram.Record(7us);
+
+    EXPECT_EQ(4u, histogram.GetCount());
+    EXPECT_FLOAT_EQ(0.001f, histogram.GetPercentileMillis(0.0f));
+    EXPECT_FLOAT_EQ(0.003f, histogram.GetPercentileMillis(0.5f));
+    EXPECT_FLOAT_EQ(0.007f, histogram.GetPercentileMillis(1.0f));
+    EXPECT_FLOAT_EQ(0.007f, histogram.GetMaxMillis());
+}
+
+TEST(DurationHistogramTests, Percentiles_WithinBucketAccuracy)
+{
+    DurationHistogram histogram(16ms);
+
+    // 1ms, 2ms, ..., 100ms
+    for (int i = 1; i <= 100; ++i)
+        histogram.Record(std::chrono::milliseconds(i));
+
+    EXPECT_EQ(100u, histogram.GetCount());
+
+    EXPECT_GE(histogram.GetPercentileMillis(0.50f), 50.0f);
+    EXPECT_LE(histogram.GetPercentileMillis(0.50f), 50.0f * 1.125f);
+
+    EXPECT_GE(histogram.GetPercentileMillis(0.95f), 95.0f);
+    EXPECT_LE(histogram.GetPercentileMillis(0.95f), 100.0f);
+
+    EXPECT_GE(histogram.GetPercentileMillis(0.99f), 99.0f);
+    EXPECT_LE(histogram.GetPercentileMillis(0.99f), 100.0f);
+
+    EXPECT_FLOAT_EQ(100.0f, histogram.GetMaxMillis());
+}
+
+TEST(DurationHistogramTests, OverBudgetCount)
+{
+    DurationHistogram histogram(16ms);
+
+    histogram.Record(10ms);
+    histogram.Record(16ms);
+    histogram.Record(17ms);
+    histogram.Record(40ms);
+
+    EXPECT_EQ(2u, histogram.GetOverBudgetCount());
+}
+
+TEST(DurationHistogramTests, HugeDurations_CountedInLastBucket)
+{
+    DurationHistogram histogram(16ms);
+
+    histogram.Record(10min);
+
+    EXPECT_EQ(1u, histogram.GetCount());
+    EXPECT_FLOAT_EQ(600000.0f, histogram.GetPercentileMillis(0.5f));
+    EXPECT_FLOAT_EQ(600000.0f, histogram.GetMaxMillis());
+}
+
+TEST(DurationHistogramTests, Reset)
+{
+    DurationHistogram histogram(16ms);
+
+    histogram.Record(20ms);
+    histogram.Reset();
+
+    EXPECT_EQ(0u, histogram.GetCount());
+    EXPECT_EQ(0u, histogram.GetOverBudgetCount());
+    EXPECT_EQ(0.0f, histogram.GetMaxMillis());
+}
@@ -0,0 +1,102 @@
+#include <Game/GameEventBuffer.h>
+
+#include "gmock/gmock.h"
+
+class _MockBufferTarget : public IGameEventHandler
+{
+public:
+
+    MOCK_METHOD3(OnBreak, void(StructuralMaterial const & material, bool isUnderwater, unsigned int size));
+    MOCK_METHOD1(OnSinkingBegin, void(ShipId shipId));
+    MOCK_METHOD2(OnSawed, void(bool isMetal, unsigned int size));
+    MOCK_METHOD2(OnCustomProbe, void(std::string const & name, float value));
+};
+
+using namespace ::testing;
+
+using MockBufferTarget = StrictMock<_MockBufferTarget>;
+
+/////////////////////////////////////////////////////////////////
+
+TEST(GameEventBufferTests, ForwardsImmediately_WhenNotBuffering)
+{
+    auto target = std::make_shared<MockBufferTarget>();
+
+    GameEventBuffer buffer(target);
+
+    EXPECT_CALL(*target, OnSawed(true, 4)).Times(1);
+
+    buffer.OnSawed(true, 4);
+
+    Mock::VerifyAndClear(target.get());
+}
+
+TEST(GameEventBufferTests, Defers_WhileBuffering)
+{
+    auto target = std::make_shared<MockBufferTarget>();
+
+    GameEventBuffer buffer(target);
+
+    buffer.BeginBuffering();
+
+    EXPECT_CALL(*target, OnSinkingBegin(_)).Times(0);
+
+    buffer.OnSinkingBegin(7);
+
+    Mock::VerifyAndClear(target.get());
+
+    EXPECT_CALL(*target, OnSinkingBegin(7)).Times(1);
+
+    buffer.EndBuffering();
+
+    Mock::VerifyAndClear(target.get());
+
+    // Nothing left to forward
+    buffer.BeginBuffering();
+    buffer.EndBuffering();
+}
+
+TEST(GameEventBufferTests, PreservesOrderAndArguments)
+{
+    auto target = std::make_shared<MockBufferTarget>();
+
+    GameEventBuffer buffer(target);
+
+    StructuralMaterial sm(
+        "Foo",
+        1.0f,
+        1.0f,
+        1.0f,
+        vec4f::zero(),
+        false,
+        1.0f,
+        1.0f,
+        1.0f,
+        1.0f,
+        1.0f,
+        std::nullopt,
+        std::nullopt);
+
+    buffer.BeginBuffering();
+
+    {
+        std::string probeName("Probe");
+        buffer.OnCustomProbe(probeName, 2.5f);
+        probeName = "Changed";
+    }
+
+    buffer.OnBreak(sm, true, 3);
+    buffer.OnSawed(false, 2);
+
+    {
+        InSequence s;
+
+        EXPECT_CALL(*target, OnCustomProbe(std::string("Probe"), 2.5f)).Times(1);
+        EXPECT_CALL(*target, OnBreak(Ref(sm), true, 3)).Times(1);
+        EXPECT_CALL(*target, OnSawed(false, 2)).Times(1);
+    }
+
+    buffer.EndBuffering();
+
+    Mock::VerifyAndClear(target.get());
+}
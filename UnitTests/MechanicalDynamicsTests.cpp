@@ -0,0 +1,317 @@
+#include <Game/MechanicalDynamics.h>
+
+#include <GameCore/Buffer.h>
+#include <GameCore/SysSpecifics.h>
+#include <GameCore/ThreadPool.h>
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+using namespace Physics;
+
+namespace {
+
+    struct TestSprings
+    {
+        std::vector<ElementIndex> PointAIndices;
+        std::vector<ElementIndex> PointBIndices;
+        std::vector<float> RestLengths;
+
+        ElementCount GetElementCount() const { return static_cast<ElementCount>(PointAIndices.size()); }
+    };
+
+    // The state of the points of a ship, as seen by the iterations
+    struct PointState
+    {
+        std::vector<vec2f> Positions;
+        std::vector<vec2f> Velocities;
+        std::vector<vec2f> Forces;
+    };
+
+    /*
+     * A width x height lattice of points with all horizontal, vertical, and diagonal springs,
+     * laid out in tiling order like ShipBuilder does; the points start off their rest positions,
+     * and the bottom rows are below the floor.
+     */
+    class MechanicalDynamicsTests : public testing::Test
+    {
+    protected:
+
+        static constexpr int Width = 37;
+        static constexpr int Height = 23;
+
+        static constexpr size_t SpringBatchSize = 4;
+
+        static constexpr float Dt = 1.0f / (64.0f * 24.0f);
+        static constexpr float Stiffness = 2000.0f;
+        static constexpr float Damping = 5.0f;
+        static constexpr float FloorY = 0.5f;
+
+        MechanicalDynamicsTests()
+            : mPointCount(Width * Height)
+            , mPointBufferCount(static_cast<ElementCount>(make_aligned_element_count(Width * Height)))
+            , mSprings()
+            , mInitialState()
+        {}
+
+        void SetUp() override
+        {
+            std::mt19937 random(42);
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+            mInitialState.Positions.resize(mPointBufferCount, vec2f::zero());
+            mInitialState.Velocities.resize(mPointBufferCount, vec2f::zero());
+            mInitialState.Forces.resize(mPointBufferCount, vec2f::zero());
+
+            for (int y = 0; y < Height; ++y)
+            {
+                for (int x = 0; x < Width; ++x)
+                {
+                    mInitialState.Positions[ToPointIndex(x, y)] = vec2f(
+                        static_cast<float>(x) + 0.2f * (unit(random) - 0.5f),
+                        static_cast<float>(y) + 0.2f * (unit(random) - 0.5f));
+                }
+            }
+
+            for (int y = 0; y < Height; ++y)
+            {
+                for (int x = 0; x < Width; ++x)
+                {
+                    if (x + 1 < Width)
+                        AddSpring(ToPointIndex(x, y), ToPointIndex(x + 1, y), 1.0f);
+                    if (y + 1 < Height)
+                        AddSpring(ToPointIndex(x, y + 1), ToPointIndex(x, y), 1.0f);
+                    if (x + 1 < Width && y + 1 < Height)
+                        AddSpring(ToPointIndex(x, y), ToPointIndex(x + 1, y + 1), std::sqrt(2.0f));
+                    if (x > 0 && y + 1 < Height)
+                        AddSpring(ToPointIndex(x, y + 1), ToPointIndex(x - 1, y), std::sqrt(2.0f));
+                }
+            }
+        }
+
+        /*
+         * Runs the specified number of steps, each one with the specified number of iterations.
+         */
+        PointState Run(
+            PointState state,
+            size_t partitionCount,
+            int stepCount,
+            int iterationCount)
+        {
+            ThreadPool threadPool(std::max(partitionCount, size_t(1)));
+
+            MechanicalDynamics mechanicalDynamics;
+
+            for (int step = 0; step < stepCount; ++step)
+            {
+                mechanicalDynamics.SetPartitionCount(
+                    partitionCount,
+                    mPointBufferCount,
+                    mSprings.GetElementCount(),
+                    SpringBatchSize,
+                    [this]()
+                    {
+                        return std::make_shared<Buffer<vec2f>>(mPointBufferCount);
+                    });
+
+                mechanicalDynamics.RunIterations(
+                    iterationCount,
+                    mPointCount,
+                    mPointBufferCount,
+                    mSprings.GetElementCount(),
+                    state.Forces.data(),
+                    threadPool,
+                    [](int /*iter*/) {},
+                    [&state](ElementIndex startPointIndex, ElementIndex endPointIndex)
+                    {
+                        for (ElementIndex p = startPointIndex; p < endPointIndex; ++p)
+                        {
+                            // Gravity and a bit of drag
+                            state.Forces[p] += vec2f(0.0f, -9.8f) - state.Velocities[p] * 0.1f;
+                        }
+                    },
+                    [this, &state](ElementIndex startSpringIndex, ElementIndex endSpringIndex, vec2f * forceBuffer)
+                    {
+                        for (ElementIndex s = startSpringIndex; s < endSpringIndex; ++s)
+                        {
+                            ElementIndex const pointAIndex = mSprings.PointAIndices[s];
+                            ElementIndex const pointBIndex = mSprings.PointBIndices[s];
+
+                            vec2f const displacement = state.Positions[pointBIndex] - state.Positions[pointAIndex];
+                            float const displacementLength = displacement.length();
+                            vec2f const springDir = displacement.normalise(displacementLength);
+
+                            vec2f const relVelocity = state.Velocities[pointBIndex] - state.Velocities[pointAIndex];
+
+                            vec2f const fA =
+                                springDir * (displacementLength - mSprings.RestLengths[s]) * Stiffness
+                                + springDir * relVelocity.dot(springDir) * Damping;
+
+                            forceBuffer[pointAIndex] += fA;
+                            forceBuffer[pointBIndex] -= fA;
+                        }
+                    },
+                    [](int /*iter*/) {},
+                    [this, &state](ElementIndex startPointIndex, ElementIndex endPointIndex)
+                    {
+                        for (ElementIndex p = startPointIndex; p < endPointIndex; ++p)
+                        {
+                            // Unit masses
+                            state.Velocities[p] += state.Forces[p] * Dt;
+                            state.Positions[p] += state.Velocities[p] * Dt;
+                            state.Forces[p] = vec2f::zero();
+
+                            if (p < mPointCount && state.Positions[p].y < FloorY)
+                            {
+                                state.Positions[p].y = FloorY;
+                                state.Velocities[p] = vec2f::zero();
+                            }
+                        }
+                    });
+            }
+
+            return state;
+        }
+
+        ElementCount const mPointCount;
+        ElementCount const mPointBufferCount;
+        TestSprings mSprings;
+        PointState mInitialState;
+
+    private:
+
+        static ElementIndex ToPointIndex(int x, int y)
+        {
+            return static_cast<ElementIndex>(y * Width + x);
+        }
+
+        void AddSpring(
+            ElementIndex pointAIndex,
+            ElementIndex pointBIndex,
+            float restLength)
+        {
+            mSprings.PointAIndices.push_back(pointAIndex);
+            mSprings.PointBIndices.push_back(pointBIndex);
+            mSprings.RestLengths.push_back(restLength);
+        }
+    };
+}
+
+TEST_F(MechanicalDynamicsTests, SerialWithLessThanTwoPartitions)
+{
+    MechanicalDynamics mechanicalDynamics;
+
+    auto const allocateForceBuffer =
+        [this]()
+        {
+            return std::make_shared<Buffer<vec2f>>(mPointBufferCount);
+        };
+
+    mechanicalDynamics.SetPartitionCount(4, mPointBufferCount, mSprings.GetElementCount(), SpringBatchSize, allocateForceBuffer);
+    EXPECT_EQ(4u, mechanicalDynamics.GetPartitionCount());
+
+    mechanicalDynamics.SetPartitionCount(1, mPointBufferCount, mSprings.GetElementCount(), SpringBatchSize, allocateForceBuffer);
+    EXPECT_EQ(0u, mechanicalDynamics.GetPartitionCount());
+}
+
+TEST_F(MechanicalDynamicsTests, PartitionsVisitEachElementOnce)
+{
+    ThreadPool threadPool(4);
+
+    MechanicalDynamics mechanicalDynamics;
+
+    mechanicalDynamics.SetPartitionCount(
+        4,
+        mPointBufferCount,
+        mSprings.GetElementCount(),
+        SpringBatchSize,
+        [this]()
+        {
+            return std::make_shared<Buffer<vec2f>>(mPointBufferCount);
+        });
+
+    std::mutex visitsMutex;
+    std::vector<int> pointForceVisits(mPointBufferCount, 0);
+    std::vector<int> springForceVisits(mSprings.GetElementCount(), 0);
+    std::vector<int> integrateVisits(mPointBufferCount, 0);
+    std::vector<ElementIndex> springBoundaries;
+
+    auto const recordVisits =
+        [&visitsMutex](std::vector<int> & visits, ElementIndex startIndex, ElementIndex endIndex)
+        {
+            std::lock_guard<std::mutex> const lock(visitsMutex);
+            for (ElementIndex i = startIndex; i < endIndex; ++i)
+                ++visits[i];
+        };
+
+    mechanicalDynamics.RunIterations(
+        1,
+        mPointCount,
+        mPointBufferCount,
+        mSprings.GetElementCount(),
+        mInitialState.Forces.data(),
+        threadPool,
+        [](int /*iter*/) {},
+        [&](ElementIndex startPointIndex, ElementIndex endPointIndex)
+        {
+            recordVisits(pointForceVisits, startPointIndex, endPointIndex);
+        },
+        [&](ElementIndex startSpringIndex, ElementIndex endSpringIndex, vec2f * /*forceBuffer*/)
+        {
+            recordVisits(springForceVisits, startSpringIndex, endSpringIndex);
+
+            std::lock_guard<std::mutex> const lock(visitsMutex);
+            springBoundaries.push_back(startSpringIndex);
+        },
+        [](int /*iter*/) {},
+        [&](ElementIndex startPointIndex, ElementIndex endPointIndex)
+        {
+            recordVisits(integrateVisits, startPointIndex, endPointIndex);
+        });
+
+    // Point forces are only calculated for the points, integration runs on the whole buffer
+    for (ElementIndex p = 0; p < mPointBufferCount; ++p)
+    {
+        EXPECT_EQ(p < mPointCount ? 1 : 0, pointForceVisits[p]) << "point " << p;
+        EXPECT_EQ(1, integrateVisits[p]) << "point " << p;
+    }
+
+    for (ElementIndex s = 0; s < mSprings.GetElementCount(); ++s)
+    {
+        EXPECT_EQ(1, springForceVisits[s]) << "spring " << s;
+    }
+
+    // SIMD batches of springs are never split
+    ASSERT_EQ(4u, springBoundaries.size());
+    for (ElementIndex startSpringIndex : springBoundaries)
+    {
+        EXPECT_EQ(0u, startSpringIndex % SpringBatchSize);
+    }
+}
+
+TEST_F(MechanicalDynamicsTests, PartitionedMatchesSerial)
+{
+    PointState const serialState = Run(mInitialState, 1, 8, 24);
+    PointState const partitionedState = Run(mInitialState, 4, 8, 24);
+
+    for (ElementIndex p = 0; p < mPointCount; ++p)
+    {
+        EXPECT_NEAR(serialState.Positions[p].x, partitionedState.Positions[p].x, 1e-4f) << "point " << p;
+        EXPECT_NEAR(serialState.Positions[p].y, partitionedState.Positions[p].y, 1e-4f) << "point " << p;
+    }
+
+    // The points have actually moved
+    float maxDisplacement = 0.0f;
+    for (ElementIndex p = 0; p < mPointCount; ++p)
+    {
+        maxDisplacement = std::max(maxDisplacement, (serialState.Positions[p] - mInitialState.Positions[p]).length());
+    }
+
+    EXPECT_GT(maxDisplacement, 0.01f);
+}
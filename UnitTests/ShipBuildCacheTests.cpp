@@ -0,0 +1,316 @@
+#include <Game/ShipBuildCache.h>
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+class ShipBuildCacheTests : public ::testing::Test
+{
+protected:
+
+    ShipBuildCacheTests()
+        : mCacheFolderPath(std::filesystem::temp_directory_path() / "ShipBuildCacheTests")
+        , mMaterialDatabase(MakeMaterialDatabase())
+    {}
+
+    void SetUp() override
+    {
+        std::filesystem::remove_all(mCacheFolderPath);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(mCacheFolderPath);
+    }
+
+    static MaterialDatabase MakeMaterialDatabase()
+    {
+        std::map<MaterialDatabase::ColorKey, StructuralMaterial> structuralMaterials;
+
+        auto const makeStructuralMaterial = [](std::string const & name, std::optional<StructuralMaterial::MaterialUniqueType> uniqueType)
+        {
+            return StructuralMaterial(name, 1.0f, 1.0f, 1.0f, vec4f(0.5f, 0.5f, 0.5f, 1.0f), false, 1.0f, 1.0f, 0.5f, 1.0f, 1.0f, uniqueType, std::nullopt);
+        };
+
+        MaterialDatabase::ColorKey const airColorKey(0xff, 0xff, 0xff);
+        MaterialDatabase::ColorKey const ropeColorKey(0x00, 0x00, 0x00);
+        MaterialDatabase::ColorKey const woodColorKey(0x80, 0x40, 0x20);
+
+        structuralMaterials.emplace(airColorKey, makeStructuralMaterial("Air", StructuralMaterial::MaterialUniqueType::Air));
+        structuralMaterials.emplace(ropeColorKey, makeStructuralMaterial("Rope", StructuralMaterial::MaterialUniqueType::Rope));
+        structuralMaterials.emplace(woodColorKey, makeStructuralMaterial("Wood", std::nullopt));
+
+        std::map<MaterialDatabase::ColorKey, ElectricalMaterial> electricalMaterials;
+        electricalMaterials.emplace(
+            MaterialDatabase::ColorKey(0x10, 0x20, 0x30),
+            ElectricalMaterial("Lamp", ElectricalMaterial::ElectricalElementType::Lamp, true, 1.0f, vec4f(1.0f, 1.0f, 1.0f, 1.0f), 1.0f, 0.0f));
+
+        // Map nodes do not move with their maps
+        MaterialDatabase::UniqueMaterialsArray uniqueStructuralMaterials;
+        uniqueStructuralMaterials[static_cast<size_t>(StructuralMaterial::MaterialUniqueType::Air)] = { airColorKey, &(structuralMaterials.at(airColorKey)) };
+        uniqueStructuralMaterials[static_cast<size_t>(StructuralMaterial::MaterialUniqueType::Rope)] = { ropeColorKey, &(structuralMaterials.at(ropeColorKey)) };
+
+        return MaterialDatabase(
+            std::move(structuralMaterials),
+            std::move(electricalMaterials),
+            uniqueStructuralMaterials,
+            0x1234);
+    }
+
+    /*
+     * Makes a layout of a strip of quads, each one made of two triangles.
+     */
+    std::shared_ptr<ShipBuilder::ShipLayout const> MakeShipLayout(size_t quadCount) const
+    {
+        auto const & wood = *(mMaterialDatabase.FindStructuralMaterial(MaterialDatabase::ColorKey(0x80, 0x40, 0x20)));
+        auto const & rope = *(mMaterialDatabase.FindStructuralMaterial(MaterialDatabase::ColorKey(0x00, 0x00, 0x00)));
+        auto const * lamp = mMaterialDatabase.FindElectricalMaterial(MaterialDatabase::ColorKey(0x10, 0x20, 0x30));
+
+        auto shipLayout = std::make_shared<ShipBuilder::ShipLayout>();
+
+        // Points: bottom and top row
+        for (size_t x = 0; x <= quadCount; ++x)
+        {
+            for (size_t y = 0; y < 2; ++y)
+            {
+                auto & pointInfo = shipLayout->PointInfos.emplace_back(
+                    vec2f(static_cast<float>(x), static_cast<float>(y)),
+                    vec2f(static_cast<float>(x) / static_cast<float>(quadCount), static_cast<float>(y)),
+                    vec4f(0.1f * static_cast<float>(y), 0.2f, 0.3f, 1.0f),
+                    (x == 0) ? rope : wood,
+                    x == 0);
+
+                if (x == quadCount && y == 1)
+                    pointInfo.ElectricalMtl = lamp;
+            }
+        }
+
+        // Springs and triangles
+        for (ElementIndex q = 0; q < quadCount; ++q)
+        {
+            ElementIndex const bottomLeft = 2 * q;
+            ElementIndex const topLeft = 2 * q + 1;
+            ElementIndex const bottomRight = 2 * q + 2;
+            ElementIndex const topRight = 2 * q + 3;
+
+            ElementIndex const firstTriangle = static_cast<ElementIndex>(shipLayout->TriangleInfos.size());
+            shipLayout->TriangleInfos.emplace_back(std::array<ElementIndex, 3>{ bottomLeft, bottomRight, topLeft });
+            shipLayout->TriangleInfos.emplace_back(std::array<ElementIndex, 3>{ bottomRight, topRight, topLeft });
+
+            ElementIndex const diagonalSpring = static_cast<ElementIndex>(shipLayout->SpringInfos.size());
+            auto & diagonal = shipLayout->SpringInfos.emplace_back(bottomRight, topLeft);
+            diagonal.SuperTriangles2.push_back(firstTriangle);
+            diagonal.SuperTriangles2.push_back(firstTriangle + 1);
+
+            shipLayout->SpringInfos.emplace_back(bottomLeft, bottomRight);
+            shipLayout->SpringInfos.emplace_back(topLeft, topRight);
+
+            shipLayout->TriangleInfos[firstTriangle].SubSprings2.push_back(diagonalSpring);
+            shipLayout->TriangleInfos[firstTriangle].SubSprings2.push_back(diagonalSpring + 1);
+            shipLayout->TriangleInfos[firstTriangle + 1].SubSprings2.push_back(diagonalSpring);
+            shipLayout->TriangleInfos[firstTriangle + 1].SubSprings2.push_back(diagonalSpring + 2);
+        }
+
+        shipLayout->BatchedSpringCount = (shipLayout->SpringInfos.size() / 4) * 4;
+
+        // Remap: reversed
+        for (size_t p = shipLayout->PointInfos.size(); p > 0; --p)
+            shipLayout->PointIndexRemap.push_back(static_cast<ElementIndex>(p - 1));
+
+        return shipLayout;
+    }
+
+    std::filesystem::path GetCacheFilePath(
+        ShipBuildCache const & shipBuildCache,
+        uint64_t key) const
+    {
+        return shipBuildCache.GetCacheFilePath(key);
+    }
+
+    static void PatchFile(
+        std::filesystem::path const & filePath,
+        std::streamoff offset,
+        std::vector<unsigned char> const & bytes)
+    {
+        std::fstream file(filePath, std::ios::in | std::ios::out | std::ios::binary);
+        ASSERT_TRUE(file.is_open());
+
+        if (offset < 0)
+        {
+            file.seekp(offset, std::ios::end);
+        }
+        else
+        {
+            file.seekp(offset, std::ios::beg);
+        }
+
+        file.write(reinterpret_cast<char const *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    std::filesystem::path const mCacheFolderPath;
+    MaterialDatabase const mMaterialDatabase;
+};
+
+TEST_F(ShipBuildCacheTests, StoreAndLoad_RoundTrip)
+{
+    auto const shipLayout = MakeShipLayout(5);
+
+    ShipBuildCache(mCacheFolderPath).Store(42, shipLayout, mMaterialDatabase);
+
+    // A new cache, so that the layout comes from the file
+    ShipBuildCache shipBuildCache(mCacheFolderPath);
+    auto const loadedShipLayout = shipBuildCache.TryLoad(42, mMaterialDatabase);
+
+    ASSERT_NE(nullptr, loadedShipLayout);
+    ASSERT_NE(shipLayout, loadedShipLayout);
+
+    ASSERT_EQ(shipLayout->PointInfos.size(), loadedShipLayout->PointInfos.size());
+    for (size_t p = 0; p < shipLayout->PointInfos.size(); ++p)
+    {
+        EXPECT_EQ(shipLayout->PointInfos[p].Position, loadedShipLayout->PointInfos[p].Position);
+        EXPECT_EQ(shipLayout->PointInfos[p].TextureCoordinates, loadedShipLayout->PointInfos[p].TextureCoordinates);
+        EXPECT_EQ(shipLayout->PointInfos[p].RenderColor, loadedShipLayout->PointInfos[p].RenderColor);
+        EXPECT_EQ(&(shipLayout->PointInfos[p].StructuralMtl), &(loadedShipLayout->PointInfos[p].StructuralMtl));
+        EXPECT_EQ(shipLayout->PointInfos[p].ElectricalMtl, loadedShipLayout->PointInfos[p].ElectricalMtl);
+        EXPECT_EQ(shipLayout->PointInfos[p].IsRope, loadedShipLayout->PointInfos[p].IsRope);
+        EXPECT_EQ(shipLayout->PointInfos[p].IsLeaking, loadedShipLayout->PointInfos[p].IsLeaking);
+    }
+
+    ASSERT_EQ(shipLayout->SpringInfos.size(), loadedShipLayout->SpringInfos.size());
+    for (size_t s = 0; s < shipLayout->SpringInfos.size(); ++s)
+    {
+        EXPECT_EQ(shipLayout->SpringInfos[s].PointAIndex1, loadedShipLayout->SpringInfos[s].PointAIndex1);
+        EXPECT_EQ(shipLayout->SpringInfos[s].PointBIndex1, loadedShipLayout->SpringInfos[s].PointBIndex1);
+        ASSERT_EQ(shipLayout->SpringInfos[s].SuperTriangles2.size(), loadedShipLayout->SpringInfos[s].SuperTriangles2.size());
+        for (size_t t = 0; t < shipLayout->SpringInfos[s].SuperTriangles2.size(); ++t)
+            EXPECT_EQ(shipLayout->SpringInfos[s].SuperTriangles2[t], loadedShipLayout->SpringInfos[s].SuperTriangles2[t]);
+    }
+
+    ASSERT_EQ(shipLayout->TriangleInfos.size(), loadedShipLayout->TriangleInfos.size());
+    for (size_t t = 0; t < shipLayout->TriangleInfos.size(); ++t)
+    {
+        EXPECT_EQ(shipLayout->TriangleInfos[t].PointIndices1, loadedShipLayout->TriangleInfos[t].PointIndices1);
+        ASSERT_EQ(shipLayout->TriangleInfos[t].SubSprings2.size(), loadedShipLayout->TriangleInfos[t].SubSprings2.size());
+        for (size_t s = 0; s < shipLayout->TriangleInfos[t].SubSprings2.size(); ++s)
+            EXPECT_EQ(shipLayout->TriangleInfos[t].SubSprings2[s], loadedShipLayout->TriangleInfos[t].SubSprings2[s]);
+    }
+
+    EXPECT_EQ(shipLayout->BatchedSpringCount, loadedShipLayout->BatchedSpringCount);
+    EXPECT_EQ(shipLayout->PointIndexRemap, loadedShipLayout->PointIndexRemap);
+
+    // Other keys are not there
+    EXPECT_EQ(nullptr, shipBuildCache.TryLoad(43, mMaterialDatabase));
+}
+
+TEST_F(ShipBuildCacheTests, RejectsTruncatedFile)
+{
+    ShipBuildCache(mCacheFolderPath).Store(42, MakeShipLayout(5), mMaterialDatabase);
+
+    ShipBuildCache shipBuildCache(mCacheFolderPath);
+    auto const filePath = GetCacheFilePath(shipBuildCache, 42);
+    std::filesystem::resize_file(filePath, std::filesystem::file_size(filePath) / 2);
+
+    EXPECT_EQ(nullptr, shipBuildCache.TryLoad(42, mMaterialDatabase));
+    EXPECT_FALSE(std::filesystem::exists(filePath));
+}
+
+TEST_F(ShipBuildCacheTests, RejectsFileWithCorruptedHeader)
+{
+    ShipBuildCache(mCacheFolderPath).Store(42, MakeShipLayout(5), mMaterialDatabase);
+
+    ShipBuildCache shipBuildCache(mCacheFolderPath);
+    auto const filePath = GetCacheFilePath(shipBuildCache, 42);
+    PatchFile(filePath, 0, { 0xde, 0xad, 0xbe, 0xef });
+
+    EXPECT_EQ(nullptr, shipBuildCache.TryLoad(42, mMaterialDatabase));
+    EXPECT_FALSE(std::filesystem::exists(filePath));
+}
+
+TEST_F(ShipBuildCacheTests, RejectsFileWithCorruptedSectionTable)
+{
+    ShipBuildCache(mCacheFolderPath).Store(42, MakeShipLayout(5), mMaterialDatabase);
+
+    ShipBuildCache shipBuildCache(mCacheFolderPath);
+    auto const filePath = GetCacheFilePath(shipBuildCache, 42);
+
+    // The element count of the first section, right after the header
+    PatchFile(filePath, 32 + 8, { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f });
+
+    EXPECT_EQ(nullptr, shipBuildCache.TryLoad(42, mMaterialDatabase));
+    EXPECT_FALSE(std::filesystem::exists(filePath));
+}
+
+TEST_F(ShipBuildCacheTests, RejectsFileWithOutOfRangeIndices)
+{
+    ShipBuildCache(mCacheFolderPath).Store(42, MakeShipLayout(5), mMaterialDatabase);
+
+    ShipBuildCache shipBuildCache(mCacheFolderPath);
+    auto const filePath = GetCacheFilePath(shipBuildCache, 42);
+
+    // The last entry of the point index remap, which is the last section
+    PatchFile(filePath, -4, { 0x00, 0x01, 0x00, 0x00 });
+
+    EXPECT_EQ(nullptr, shipBuildCache.TryLoad(42, mMaterialDatabase));
+    EXPECT_FALSE(std::filesystem::exists(filePath));
+}
+
+TEST_F(ShipBuildCacheTests, Store_DeletesFilesOfOtherFormats)
+{
+    std::filesystem::create_directories(mCacheFolderPath);
+    auto const obsoleteFilePath = mCacheFolderPath / "0000000000000001.shipcache";
+    {
+        std::ofstream file(obsoleteFilePath, std::ios::out | std::ios::binary);
+        file << "An old file of an old format";
+    }
+
+    auto const otherFilePath = mCacheFolderPath / "readme.txt";
+    {
+        std::ofstream file(otherFilePath, std::ios::out);
+        file << "Not ours";
+    }
+
+    ShipBuildCache shipBuildCache(mCacheFolderPath);
+    shipBuildCache.Store(42, MakeShipLayout(5), mMaterialDatabase);
+
+    EXPECT_FALSE(std::filesystem::exists(obsoleteFilePath));
+    EXPECT_TRUE(std::filesystem::exists(otherFilePath));
+    EXPECT_TRUE(std::filesystem::exists(GetCacheFilePath(shipBuildCache, 42)));
+}
+
+TEST_F(ShipBuildCacheTests, Store_EvictsLeastRecentlyUsedFiles)
+{
+    auto const shipLayout = MakeShipLayout(5);
+
+    ShipBuildCache(mCacheFolderPath).Store(1, shipLayout, mMaterialDatabase);
+    auto const fileSize = std::filesystem::file_size(GetCacheFilePath(ShipBuildCache(mCacheFolderPath), 1));
+
+    // Room for three files and a half
+    ShipBuildCache shipBuildCache(mCacheFolderPath, fileSize * 7 / 2);
+
+    shipBuildCache.Store(2, shipLayout, mMaterialDatabase);
+    shipBuildCache.Store(3, shipLayout, mMaterialDatabase);
+
+    // Make file ages unambiguous: 1 is the oldest, but then it gets used
+    auto const now = std::filesystem::file_time_type::clock::now();
+    std::filesystem::last_write_time(GetCacheFilePath(shipBuildCache, 1), now - std::chrono::hours(3));
+    std::filesystem::last_write_time(GetCacheFilePath(shipBuildCache, 2), now - std::chrono::hours(2));
+    std::filesystem::last_write_time(GetCacheFilePath(shipBuildCache, 3), now - std::chrono::hours(1));
+
+    ASSERT_NE(nullptr, ShipBuildCache(mCacheFolderPath).TryLoad(1, mMaterialDatabase));
+
+    shipBuildCache.Store(4, shipLayout, mMaterialDatabase);
+
+    // Only 2 - now the least recently used - has been evicted
+    EXPECT_TRUE(std::filesystem::exists(GetCacheFilePath(shipBuildCache, 1)));
+    EXPECT_FALSE(std::filesystem::exists(GetCacheFilePath(shipBuildCache, 2)));
+    EXPECT_TRUE(std::filesystem::exists(GetCacheFilePath(shipBuildCache, 3)));
+    EXPECT_TRUE(std::filesystem::exists(GetCacheFilePath(shipBuildCache, 4)));
+}
@@ -0,0 +1,157 @@
+#include <Game/ShipBuilder.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+    using SpringEndpoints = std::vector<std::pair<ElementIndex, ElementIndex>>;
+
+    // Checks that the reordered springs are a permutation of the original ones, and that
+    // no two springs in the same batch share an endpoint
+    void VerifyBatching(
+        SpringEndpoints const & originalSprings,
+        SpringEndpoints const & reorderedSprings,
+        size_t pointCount,
+        size_t batchedSpringCount)
+    {
+        static constexpr size_t BatchSize = Physics::Springs::SimdBatchSize;
+
+        ASSERT_EQ(originalSprings.size(), reorderedSprings.size());
+        ASSERT_LE(batchedSpringCount, reorderedSprings.size());
+        EXPECT_EQ(0u, batchedSpringCount % BatchSize);
+
+        // Every spring exactly once
+        auto sortedOriginalSprings = originalSprings;
+        std::sort(sortedOriginalSprings.begin(), sortedOriginalSprings.end());
+        auto sortedReorderedSprings = reorderedSprings;
+        std::sort(sortedReorderedSprings.begin(), sortedReorderedSprings.end());
+        EXPECT_EQ(sortedOriginalSprings, sortedReorderedSprings);
+
+        // No shared endpoints within a batch
+        for (size_t b = 0; b < batchedSpringCount; b += BatchSize)
+        {
+            std::vector<bool> usedPoints(pointCount, false);
+            for (size_t s = b; s < b + BatchSize; ++s)
+            {
+                EXPECT_FALSE(usedPoints[reorderedSprings[s].first]) << "Spring " << s;
+                usedPoints[reorderedSprings[s].first] = true;
+                EXPECT_FALSE(usedPoints[reorderedSprings[s].second]) << "Spring " << s;
+                usedPoints[reorderedSprings[s].second] = true;
+            }
+        }
+    }
+
+    // Makes springs connecting each point of a width x height lattice to its right,
+    // top, and diagonal neighbors - which is what a ship's structure looks like
+    SpringEndpoints MakeGridSprings(
+        ElementIndex width,
+        ElementIndex height)
+    {
+        SpringEndpoints springs;
+        for (ElementIndex y = 0; y < height; ++y)
+        {
+            for (ElementIndex x = 0; x < width; ++x)
+            {
+                ElementIndex const p = y * width + x;
+                if (x + 1 < width)
+                    springs.emplace_back(p, p + 1);
+                if (y + 1 < height)
+                    springs.emplace_back(p, p + width);
+                if (x + 1 < width && y + 1 < height)
+                    springs.emplace_back(p, p + width + 1);
+                if (x > 0 && y + 1 < height)
+                    springs.emplace_back(p, p + width - 1);
+            }
+        }
+
+        return springs;
+    }
+}
+
+#define RUN_BATCHING(springs, pointCount, reorderedSprings, batchedSpringCount) \
+    { \
+        std::vector<ShipBuilder::SpringInfo> springInfos; \
+        for (auto const & s : springs) \
+            springInfos.emplace_back(s.first, s.second); \
+        auto const reorderedSpringInfos = ShipBuilder::ReorderSpringsOptimally_SimdBatching<Physics::Springs::SimdBatchSize>( \
+            springInfos, \
+            pointCount, \
+            batchedSpringCount); \
+        for (auto const & si : reorderedSpringInfos) \
+            reorderedSprings.emplace_back(si.PointAIndex1, si.PointBIndex1); \
+    }
+
+TEST(ShipBuilderTests, SimdBatching_Grid)
+{
+    SpringEndpoints const springs = MakeGridSprings(20, 15);
+
+    SpringEndpoints reorderedSprings;
+    size_t batchedSpringCount = 0;
+    RUN_BATCHING(springs, 20 * 15, reorderedSprings, batchedSpringCount);
+
+    VerifyBatching(springs, reorderedSprings, 20 * 15, batchedSpringCount);
+
+    // A lattice has plenty of independent springs: only a handful may be left over
+    EXPECT_GE(batchedSpringCount, springs.size() - 2 * Physics::Springs::SimdBatchSize);
+}
+
+TEST(ShipBuilderTests, SimdBatching_Chain)
+{
+    // A rope: each spring shares both of its endpoints with its neighbors
+    SpringEndpoints springs;
+    for (ElementIndex p = 0; p < 41; ++p)
+        springs.emplace_back(p, p + 1);
+
+    SpringEndpoints reorderedSprings;
+    size_t batchedSpringCount = 0;
+    RUN_BATCHING(springs, 42, reorderedSprings, batchedSpringCount);
+
+    VerifyBatching(springs, reorderedSprings, 42, batchedSpringCount);
+    EXPECT_GT(batchedSpringCount, 0u);
+}
+
+TEST(ShipBuilderTests, SimdBatching_Star)
+{
+    // All springs share the center: no batch may be built
+    SpringEndpoints springs;
+    for (ElementIndex p = 1; p <= 10; ++p)
+        springs.emplace_back(0, p);
+
+    SpringEndpoints reorderedSprings;
+    size_t batchedSpringCount = 0;
+    RUN_BATCHING(springs, 11, reorderedSprings, batchedSpringCount);
+
+    VerifyBatching(springs, reorderedSprings, 11, batchedSpringCount);
+    EXPECT_EQ(0u, batchedSpringCount);
+    EXPECT_EQ(springs, reorderedSprings);
+}
+
+TEST(ShipBuilderTests, SimdBatching_Random)
+{
+    std::mt19937 random(42);
+
+    for (size_t run = 0; run < 10; ++run)
+    {
+        size_t const pointCount = 8 + run * 13;
+        std::uniform_int_distribution<ElementIndex> pointDistribution(0, static_cast<ElementIndex>(pointCount - 1));
+
+        SpringEndpoints springs;
+        for (size_t s = 0; s < pointCount * 3; ++s)
+        {
+            ElementIndex const a = pointDistribution(random);
+            ElementIndex const b = pointDistribution(random);
+            if (a != b)
+                springs.emplace_back(a, b);
+        }
+
+        SpringEndpoints reorderedSprings;
+        size_t batchedSpringCount = 0;
+        RUN_BATCHING(springs, pointCount, reorderedSprings, batchedSpringCount);
+
+        VerifyBatching(springs, reorderedSprings, pointCount, batchedSpringCount);
+    }
+}
@@ -0,0 +1,272 @@
+#include <GameCore/ElementContainer.h>
+#include <GameCore/ThreadPool.h>
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+class TestElementContainer : public ElementContainer
+{
+public:
+
+    TestElementContainer(ElementCount elementCount)
+        : ElementContainer(elementCount)
+    {}
+};
+
+class ThreadPoolTests : public testing::TestWithParam<size_t>
+{
+};
+
+INSTANTIATE_TEST_CASE_P(
+    ThreadPoolTests,
+    ThreadPoolTests,
+    ::testing::Values(1, 2, 4, 7));
+
+TEST_P(ThreadPoolTests, Run_RunsAllTasks)
+{
+    ThreadPool threadPool(GetParam());
+
+    std::vector<std::atomic<int>> counters(100);
+    for (auto & c : counters)
+        c = 0;
+
+    std::vector<ThreadPool::Task> tasks;
+    for (size_t i = 0; i < counters.size(); ++i)
+    {
+        tasks.emplace_back(
+            [&counters, i]()
+            {
+                ++counters[i];
+            });
+    }
+
+    threadPool.Run(tasks);
+
+    for (auto const & c : counters)
+    {
+        EXPECT_EQ(1, c);
+    }
+}
+
+TEST_P(ThreadPoolTests, Run_Empty)
+{
+    ThreadPool threadPool(GetParam());
+
+    threadPool.Run(std::vector<ThreadPool::Task>());
+}
+
+TEST_P(ThreadPoolTests, Run_PropagatesException)
+{
+    ThreadPool threadPool(GetParam());
+
+    std::atomic<int> completed(0);
+
+    std::vector<ThreadPool::Task> tasks;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        tasks.emplace_back(
+            [&completed, i]()
+            {
+                if (i == 5)
+                    throw std::runtime_error("Test");
+
+                ++completed;
+            });
+    }
+
+    EXPECT_THROW(threadPool.Run(tasks), std::runtime_error);
+
+    // All other tasks have run
+    EXPECT_EQ(9, completed);
+}
+
+TEST_P(ThreadPoolTests, ParallelFor_CoversRangeExactlyOnce)
+{
+    ThreadPool threadPool(GetParam());
+
+    std::vector<int> visits(10000, 0);
+
+    threadPool.ParallelFor(
+        100,
+        9900,
+        16,
+        [&visits](ElementIndex startIndex, ElementIndex endIndex)
+        {
+            for (ElementIndex i = startIndex; i < endIndex; ++i)
+                ++visits[i];
+        });
+
+    for (size_t i = 0; i < visits.size(); ++i)
+    {
+        EXPECT_EQ((i >= 100 && i < 9900) ? 1 : 0, visits[i]);
+    }
+}
+
+TEST_P(ThreadPoolTests, ParallelFor_RespectsMinChunkSize)
+{
+    ThreadPool threadPool(GetParam());
+
+    std::mutex chunksLock;
+    std::vector<ElementCount> chunkSizes;
+
+    threadPool.ParallelFor(
+        0,
+        1000,
+        300,
+        [&](ElementIndex startIndex, ElementIndex endIndex)
+        {
+            std::lock_guard<std::mutex> lock(chunksLock);
+            chunkSizes.push_back(endIndex - startIndex);
+        });
+
+    ASSERT_LE(chunkSizes.size(), 3u);
+    for (auto chunkSize : chunkSizes)
+    {
+        EXPECT_GE(chunkSize, 300u);
+    }
+}
+
+TEST_P(ThreadPoolTests, ParallelFor_EmptyRange)
+{
+    ThreadPool threadPool(GetParam());
+
+    bool invoked = false;
+
+    threadPool.ParallelFor(
+        10,
+        10,
+        1,
+        [&invoked](ElementIndex, ElementIndex)
+        {
+            invoked = true;
+        });
+
+    EXPECT_FALSE(invoked);
+}
+
+TEST_P(ThreadPoolTests, ParallelFor_ElementContainer)
+{
+    ThreadPool threadPool(GetParam());
+
+    TestElementContainer container(1234);
+
+    std::atomic<ElementCount> total(0);
+
+    threadPool.ParallelFor(
+        container,
+        10,
+        [&total](ElementIndex startIndex, ElementIndex endIndex)
+        {
+            total += endIndex - startIndex;
+        });
+
+    EXPECT_EQ(1234u, total);
+}
+
+TEST_P(ThreadPoolTests, ParallelFor_Nested)
+{
+    ThreadPool threadPool(GetParam());
+
+    std::atomic<int> total(0);
+
+    threadPool.ParallelFor(
+        0,
+        16,
+        1,
+        [&](ElementIndex startIndex, ElementIndex endIndex)
+        {
+            for (ElementIndex i = startIndex; i < endIndex; ++i)
+            {
+                threadPool.ParallelFor(
+                    0,
+                    100,
+                    1,
+                    [&total](ElementIndex innerStartIndex, ElementIndex innerEndIndex)
+                    {
+                        total += static_cast<int>(innerEndIndex - innerStartIndex);
+                    });
+            }
+        });
+
+    EXPECT_EQ(1600, total);
+}
+
+TEST_P(ThreadPoolTests, TaskGraph_RespectsDependencies)
+{
+    ThreadPool threadPool(GetParam());
+
+    //
+    // a --> b --> d
+    // |           ^
+    // +---> c ----+
+    //       |
+    //       +---> e
+    //
+
+    std::mutex orderLock;
+    std::vector<char> order;
+
+    auto const makeTask = [&](char name)
+    {
+        return [&, name]()
+        {
+            std::lock_guard<std::mutex> lock(orderLock);
+            order.push_back(name);
+        };
+    };
+
+    ThreadPool::TaskGraph taskGraph;
+    auto const a = taskGraph.AddTask(makeTask('a'));
+    auto const b = taskGraph.AddTask(makeTask('b'), { a });
+    auto const c = taskGraph.AddTask(makeTask('c'), { a });
+    taskGraph.AddTask(makeTask('d'), { b, c });
+    taskGraph.AddTask(makeTask('e'), { c });
+
+    EXPECT_EQ(5u, taskGraph.GetTaskCount());
+
+    // Run twice, to make sure the graph is re-usable
+    for (int run = 0; run < 2; ++run)
+    {
+        order.clear();
+
+        threadPool.Run(taskGraph);
+
+        ASSERT_EQ(5u, order.size());
+
+        auto const positionOf = [&order](char name)
+        {
+            return std::find(order.cbegin(), order.cend(), name) - order.cbegin();
+        };
+
+        EXPECT_EQ(0, positionOf('a'));
+        EXPECT_LT(positionOf('b'), positionOf('d'));
+        EXPECT_LT(positionOf('c'), positionOf('d'));
+        EXPECT_LT(positionOf('c'), positionOf('e'));
+    }
+}
+
+TEST_P(ThreadPoolTests, TaskGraph_PropagatesException)
+{
+    ThreadPool threadPool(GetParam());
+
+    std::atomic<bool> hasRunSuccessor(false);
+
+    ThreadPool::TaskGraph taskGraph;
+    auto const a = taskGraph.AddTask(
+        []()
+        {
+            throw std::runtime_error("Test");
+        });
+    taskGraph.AddTask(
+        [&hasRunSuccessor]()
+        {
+            hasRunSuccessor = true;
+        },
+        { a });
+
+    EXPECT_THROW(threadPool.Run(taskGraph), std::runtime_error);
+}
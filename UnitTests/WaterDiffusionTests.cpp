@@ -0,0 +1,331 @@
+#include <Game/WaterDiffusion.h>
+
+#include <GameCore/AdjacencyList.h>
+#include <GameCore/ThreadPool.h>
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Physics;
+
+namespace {
+
+    struct TestPoints
+    {
+        struct ConnectedSpring
+        {
+            ElementIndex SpringIndex;
+            ElementIndex OtherEndpointIndex;
+        };
+
+        std::vector<vec2f> Positions;
+        std::vector<float> WaterDiffusionSpeeds;
+        AdjacencyList<ConnectedSpring> ConnectedSprings;
+
+        explicit TestPoints(size_t pointCount)
+            : Positions(pointCount)
+            , WaterDiffusionSpeeds(pointCount)
+            , ConnectedSprings(pointCount)
+        {}
+
+        ElementCount GetElementCount() const { return static_cast<ElementCount>(Positions.size()); }
+        vec2f const & GetPosition(ElementIndex p) const { return Positions[p]; }
+        float GetWaterDiffusionSpeed(ElementIndex p) const { return WaterDiffusionSpeeds[p]; }
+        AdjacencyList<ConnectedSpring>::List GetConnectedSprings(ElementIndex p) const { return ConnectedSprings[p]; }
+    };
+
+    struct TestSprings
+    {
+        std::vector<ElementIndex> PointAIndices;
+        std::vector<float> RestLengths;
+        std::vector<float> WaterPermeabilities;
+
+        ElementCount GetElementCount() const { return static_cast<ElementCount>(PointAIndices.size()); }
+        ElementIndex GetPointAIndex(ElementIndex s) const { return PointAIndices[s]; }
+        float GetRestLength(ElementIndex s) const { return RestLengths[s]; }
+        float GetWaterPermeability(ElementIndex s) const { return WaterPermeabilities[s]; }
+        bool IsDeleted(ElementIndex /*s*/) const { return false; }
+    };
+
+    // The state of the water of a ship, as seen by the kernels
+    struct WaterState
+    {
+        std::vector<ElementIndex> ActivePoints;
+        std::vector<float> OldWater;
+        std::vector<vec2f> OldVelocities;
+        std::vector<float> NewWater;
+        std::vector<vec2f> NewMomenta;
+        float WaterSplashed;
+    };
+
+    // Activates the points that receive water, like the ship's water active set does
+    auto MakeOnWaterReceived(WaterState & state)
+    {
+        return [&state](ElementIndex pointIndex)
+        {
+            if (std::find(state.ActivePoints.cbegin(), state.ActivePoints.cend(), pointIndex) == state.ActivePoints.cend())
+                state.ActivePoints.push_back(pointIndex);
+        };
+    }
+
+    /*
+     * A width x height lattice of points with all horizontal, vertical, and diagonal springs,
+     * some of which are impermeable; about half of the points are wet.
+     */
+    class WaterDiffusionTests : public testing::Test
+    {
+    protected:
+
+        static constexpr int Width = 17;
+        static constexpr int Height = 13;
+
+        WaterDiffusionTests()
+            : mPoints(Width * Height)
+            , mSprings()
+            , mInitialState()
+        {}
+
+        void SetUp() override
+        {
+            std::mt19937 random(42);
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+            for (int y = 0; y < Height; ++y)
+            {
+                for (int x = 0; x < Width; ++x)
+                {
+                    ElementIndex const p = ToPointIndex(x, y);
+                    mPoints.Positions[p] = vec2f(
+                        static_cast<float>(x) + 0.1f * (unit(random) - 0.5f),
+                        static_cast<float>(y) + 0.1f * (unit(random) - 0.5f));
+                    mPoints.WaterDiffusionSpeeds[p] = 0.2f + 0.6f * unit(random);
+                }
+            }
+
+            for (int y = 0; y < Height; ++y)
+            {
+                for (int x = 0; x < Width; ++x)
+                {
+                    if (x + 1 < Width)
+                        AddSpring(ToPointIndex(x, y), ToPointIndex(x + 1, y), unit(random));
+                    if (y + 1 < Height)
+                        AddSpring(ToPointIndex(x, y + 1), ToPointIndex(x, y), unit(random));
+                    if (x + 1 < Width && y + 1 < Height)
+                        AddSpring(ToPointIndex(x, y), ToPointIndex(x + 1, y + 1), unit(random));
+                    if (x > 0 && y + 1 < Height)
+                        AddSpring(ToPointIndex(x, y + 1), ToPointIndex(x - 1, y), unit(random));
+                }
+            }
+
+            mInitialState.OldWater.resize(mPoints.GetElementCount(), 0.0f);
+            mInitialState.OldVelocities.resize(mPoints.GetElementCount(), vec2f::zero());
+            mInitialState.NewMomenta.resize(mPoints.GetElementCount(), vec2f::zero());
+
+            for (ElementIndex p = 0; p < mPoints.GetElementCount(); ++p)
+            {
+                if (unit(random) < 0.5f)
+                {
+                    mInitialState.OldWater[p] = 2.0f * unit(random);
+                    mInitialState.OldVelocities[p] = vec2f(unit(random) - 0.5f, unit(random) - 0.5f) * 4.0f;
+                    mInitialState.NewMomenta[p] = mInitialState.OldVelocities[p] * mInitialState.OldWater[p];
+
+                    mInitialState.ActivePoints.push_back(p);
+                }
+            }
+
+            mInitialState.NewWater = mInitialState.OldWater;
+            mInitialState.WaterSplashed = 0.0f;
+        }
+
+        WaterState RunPush(WaterState state) const
+        {
+            WaterDiffusion::Push(
+                mPoints,
+                mSprings,
+                state.ActivePoints,
+                state.OldWater.data(),
+                state.OldVelocities.data(),
+                state.NewWater.data(),
+                state.NewMomenta.data(),
+                mGameParameters,
+                MakeOnWaterReceived(state),
+                state.WaterSplashed);
+
+            return state;
+        }
+
+        template<typename TParallelFor>
+        WaterState RunPull(
+            WaterState state,
+            TParallelFor && parallelFor)
+        {
+            mWaterDiffusion.Pull(
+                mPoints,
+                mSprings,
+                state.ActivePoints,
+                state.OldWater.data(),
+                state.OldVelocities.data(),
+                state.NewWater.data(),
+                state.NewMomenta.data(),
+                mGameParameters,
+                parallelFor,
+                MakeOnWaterReceived(state),
+                state.WaterSplashed);
+
+            return state;
+        }
+
+        void VerifyMatches(
+            WaterState const & expected,
+            WaterState const & actual) const
+        {
+            EXPECT_EQ(expected.ActivePoints, actual.ActivePoints);
+            EXPECT_FLOAT_EQ(expected.WaterSplashed, actual.WaterSplashed);
+
+            for (ElementIndex p = 0; p < mPoints.GetElementCount(); ++p)
+            {
+                EXPECT_NEAR(expected.NewWater[p], actual.NewWater[p], 1e-5f) << "point " << p;
+                EXPECT_NEAR(expected.NewMomenta[p].x, actual.NewMomenta[p].x, 1e-4f) << "point " << p;
+                EXPECT_NEAR(expected.NewMomenta[p].y, actual.NewMomenta[p].y, 1e-4f) << "point " << p;
+            }
+        }
+
+        static double GetTotalWater(std::vector<float> const & water)
+        {
+            double totalWater = 0.0;
+            for (float w : water)
+                totalWater += w;
+
+            return totalWater;
+        }
+
+        TestPoints mPoints;
+        TestSprings mSprings;
+        WaterState mInitialState;
+        GameParameters mGameParameters;
+        WaterDiffusion mWaterDiffusion;
+
+    private:
+
+        static ElementIndex ToPointIndex(int x, int y)
+        {
+            return static_cast<ElementIndex>(y * Width + x);
+        }
+
+        void AddSpring(
+            ElementIndex pointAIndex,
+            ElementIndex pointBIndex,
+            float randomValue)
+        {
+            ElementIndex const s = mSprings.GetElementCount();
+
+            mSprings.PointAIndices.push_back(pointAIndex);
+            mSprings.RestLengths.push_back((mPoints.Positions[pointAIndex] - mPoints.Positions[pointBIndex]).length());
+            mSprings.WaterPermeabilities.push_back(randomValue < 0.15f ? 0.0f : 1.0f);
+
+            mPoints.ConnectedSprings.push_back(pointAIndex, { s, pointBIndex });
+            mPoints.ConnectedSprings.push_back(pointBIndex, { s, pointAIndex });
+        }
+    };
+
+    auto const SerialFor =
+        [](ElementIndex startIndex, ElementIndex endIndex, auto const & body)
+        {
+            body(startIndex, endIndex);
+        };
+}
+
+TEST_F(WaterDiffusionTests, Push_ConservesWater)
+{
+    WaterState const state = RunPush(mInitialState);
+
+    EXPECT_NEAR(GetTotalWater(mInitialState.OldWater), GetTotalWater(state.NewWater), 1e-4);
+
+    // Water has moved, and reached some dry points
+    EXPECT_GT(state.ActivePoints.size(), mInitialState.ActivePoints.size());
+    EXPECT_GT(state.WaterSplashed, 0.0f);
+}
+
+TEST_F(WaterDiffusionTests, Pull_ConservesWater)
+{
+    WaterState const state = RunPull(mInitialState, SerialFor);
+
+    EXPECT_NEAR(GetTotalWater(mInitialState.OldWater), GetTotalWater(state.NewWater), 1e-4);
+}
+
+TEST_F(WaterDiffusionTests, Pull_MatchesPush)
+{
+    VerifyMatches(RunPush(mInitialState), RunPull(mInitialState, SerialFor));
+}
+
+TEST_F(WaterDiffusionTests, Pull_MatchesPush_OutOfOrderChunks)
+{
+    // Visit small chunks backwards, as if threads raced each other
+    auto const backwardsChunkedFor =
+        [](ElementIndex startIndex, ElementIndex endIndex, auto const & body)
+        {
+            for (ElementIndex chunkEndIndex = endIndex; chunkEndIndex > startIndex; )
+            {
+                ElementIndex const chunkStartIndex = chunkEndIndex - std::min(ElementIndex(3), chunkEndIndex - startIndex);
+                body(chunkStartIndex, chunkEndIndex);
+                chunkEndIndex = chunkStartIndex;
+            }
+        };
+
+    VerifyMatches(RunPush(mInitialState), RunPull(mInitialState, backwardsChunkedFor));
+}
+
+TEST_F(WaterDiffusionTests, Pull_MatchesPush_ThreadPool)
+{
+    ThreadPool threadPool(4);
+
+    auto const threadPoolFor =
+        [&threadPool](ElementIndex startIndex, ElementIndex endIndex, auto const & body)
+        {
+            threadPool.ParallelFor(startIndex, endIndex, 8, body);
+        };
+
+    VerifyMatches(RunPush(mInitialState), RunPull(mInitialState, threadPoolFor));
+}
+
+TEST_F(WaterDiffusionTests, Pull_MatchesPush_OverSteps)
+{
+    // Feed each kernel's results back into itself, transforming momenta into velocities
+    auto const advance =
+        [](WaterState & state)
+        {
+            state.OldWater = state.NewWater;
+
+            for (ElementIndex p : state.ActivePoints)
+            {
+                state.OldVelocities[p] = (state.NewWater[p] != 0.0f)
+                    ? state.NewMomenta[p] / state.NewWater[p]
+                    : vec2f::zero();
+            }
+
+            state.WaterSplashed = 0.0f;
+        };
+
+    WaterState pushState = mInitialState;
+    WaterState pullState = mInitialState;
+
+    for (int step = 0; step < 10; ++step)
+    {
+        pushState = RunPush(pushState);
+        advance(pushState);
+
+        pullState = RunPull(pullState, SerialFor);
+        advance(pullState);
+    }
+
+    EXPECT_NEAR(GetTotalWater(pushState.OldWater), GetTotalWater(pullState.OldWater), 1e-3);
+
+    for (ElementIndex p = 0; p < mPoints.GetElementCount(); ++p)
+    {
+        EXPECT_NEAR(pushState.OldWater[p], pullState.OldWater[p], 1e-3f) << "point " << p;
+    }
+}